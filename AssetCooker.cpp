@@ -0,0 +1,132 @@
+#include "AssetCooker.h"
+#include "Debugger.h"
+#include "ThreadPool.h"
+
+#include <chrono>
+
+namespace {
+	// WIC̓XbhƂCOM̏Kv
+	struct ComScope {
+		HRESULT result;
+		ComScope() { result = CoInitializeEx(nullptr, COINIT_MULTITHREADED); }
+		~ComScope() {
+			if (SUCCEEDED(result)) {
+				CoUninitialize();
+			}
+		}
+	};
+}
+
+AssetCooker::AssetCooker(const Options& options) {
+	this->options = options;
+}
+
+std::wstring AssetCooker::GetCookedFileName(const std::wstring& source) {
+	size_t dot = source.find_last_of(L'.');
+	size_t slash = source.find_last_of(L"/\\");
+	if (dot == std::wstring::npos || (slash != std::wstring::npos && dot < slash)) {
+		return source + L".dds";
+	}
+	return source.substr(0, dot) + L".dds";
+}
+
+DXGI_FORMAT AssetCooker::ChooseFormat(const DirectX::ScratchImage& image) {
+	auto& metadata = image.GetMetadata();
+
+	// BCk4x4̃ubNPʂȂ̂ŁAD3D12ł͑傫4̔{łȂƍȂ
+	if (options.compression == Compression::NONE || metadata.width % 4 != 0 || metadata.height % 4 != 0) {
+		return DXGI_FORMAT_R8G8B8A8_UNORM;
+	}
+
+	switch (options.compression) {
+	case Compression::BC1:
+		return DXGI_FORMAT_BC1_UNORM;
+	case Compression::BC3:
+		return DXGI_FORMAT_BC3_UNORM;
+	case Compression::BC7:
+		return DXGI_FORMAT_BC7_UNORM;
+	default:
+		return image.IsAlphaAllOpaque() ? DXGI_FORMAT_BC1_UNORM : DXGI_FORMAT_BC7_UNORM;
+	}
+}
+
+bool AssetCooker::IsUpToDate(const std::wstring& source, const std::wstring& destination) {
+	WIN32_FILE_ATTRIBUTE_DATA sourceData;
+	WIN32_FILE_ATTRIBUTE_DATA destinationData;
+	if (!GetFileAttributesExW(source.c_str(), GetFileExInfoStandard, &sourceData) ||
+		!GetFileAttributesExW(destination.c_str(), GetFileExInfoStandard, &destinationData)) {
+		return false;
+	}
+	return CompareFileTime(&destinationData.ftLastWriteTime, &sourceData.ftLastWriteTime) >= 0;
+}
+
+AssetCooker::Result AssetCooker::Cook(const std::wstring& source, const std::wstring& destination) {
+	thread_local ComScope com;
+
+	auto startTime = std::chrono::steady_clock::now();
+
+	Result result = {};
+	result.source = source;
+	result.destination = destination;
+	result.result = S_OK;
+	result.format = DXGI_FORMAT_UNKNOWN;
+
+	if (!options.force && IsUpToDate(source, destination)) {
+		result.skipped = true;
+		return result;
+	}
+
+	try {
+		DirectX::ScratchImage image;
+		Debugger::ErrorCheck(DirectX::LoadFromWICFile(source.c_str(), DirectX::WIC_FLAGS_NONE, nullptr, image));
+
+		// VF[_[R8G8B8A8Ƃēǂނ̂ŁApbgȂǂ̌`͑Ă
+		if (image.GetMetadata().format != DXGI_FORMAT_R8G8B8A8_UNORM) {
+			DirectX::ScratchImage converted;
+			Debugger::ErrorCheck(DirectX::Convert(image.GetImages(), image.GetImageCount(), image.GetMetadata(), DXGI_FORMAT_R8G8B8A8_UNORM, DirectX::TEX_FILTER_DEFAULT, DirectX::TEX_THRESHOLD_DEFAULT, converted));
+			image = std::move(converted);
+		}
+		result.sourceBytes = image.GetPixelsSize();
+
+		if (options.generateMips && (image.GetMetadata().width > 1 || image.GetMetadata().height > 1)) {
+			DirectX::ScratchImage mipChain;
+			Debugger::ErrorCheck(DirectX::GenerateMipMaps(image.GetImages(), image.GetImageCount(), image.GetMetadata(), DirectX::TEX_FILTER_DEFAULT, 0, mipChain));
+			image = std::move(mipChain);
+		}
+
+		DXGI_FORMAT format = ChooseFormat(image);
+		if (DirectX::IsCompressed(format)) {
+			DirectX::TEX_COMPRESS_FLAGS flags = DirectX::TEX_COMPRESS_DEFAULT;
+			if (options.quick) {
+				flags |= DirectX::TEX_COMPRESS_BC7_QUICK;
+			}
+			DirectX::ScratchImage compressed;
+			Debugger::ErrorCheck(DirectX::Compress(image.GetImages(), image.GetImageCount(), image.GetMetadata(), format, flags, DirectX::TEX_THRESHOLD_DEFAULT, compressed));
+			image = std::move(compressed);
+		}
+
+		Debugger::ErrorCheck(DirectX::SaveToDDSFile(image.GetImages(), image.GetImageCount(), image.GetMetadata(), DirectX::DDS_FLAGS_NONE, destination.c_str()));
+
+		result.format = format;
+		result.mipLevels = image.GetMetadata().mipLevels;
+		result.cookedBytes = image.GetPixelsSize();
+	}
+	catch (HRESULT error) {
+		result.result = error;
+	}
+
+	result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+	return result;
+}
+
+std::vector<AssetCooker::Result> AssetCooker::CookAll(const std::vector<std::wstring>& sources) {
+	std::vector<Result> results(sources.size());
+
+	// kԏd̂ŁAt@CPʂŕɂ
+	ThreadPool threadPool(options.threadCount);
+	threadPool.ParallelFor((int)sources.size(), [&](int i) {
+		results[i] = Cook(sources[i], GetCookedFileName(sources[i]));
+	});
+
+	return results;
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <windows.h>
+#include "DirectXTex.h"
+
+#include <string>
+#include <vector>
+
+// PNGEJPEGȂǂ~bv}bvtEBCkς݂DDSɕϊis̃fR[hȂ߁j
+// GPU͎gȂ̂ŁAc[rh̓rŎg
+class AssetCooker
+{
+public:
+	enum class Compression {
+		AUTO,	// sȂBC1ABC7
+		BC1,
+		BC3,
+		BC7,
+		NONE	// R8G8B8A8̂܂
+	};
+
+	typedef struct Options {
+		Compression compression = Compression::AUTO;
+		bool generateMips = true;
+		bool quick = false;			// BC7𑬂[hňkii͏j
+		bool force = false;			// o͂̕VĂϊ
+		int threadCount = 0;		// 0ȂRA
+	};
+
+	typedef struct Result {
+		std::wstring source;
+		std::wstring destination;
+		HRESULT result;
+		bool skipped;				// o͂ŐV
+		DXGI_FORMAT format;
+		size_t mipLevels;
+		size_t sourceBytes;			// WJR8G8B8A8̑傫
+		size_t cookedBytes;			// ~bv}bv܂ޑ傫
+		double seconds;
+	};
+
+private:
+	Options options;
+
+public:
+	AssetCooker(const Options& options = Options());
+
+private:
+	DXGI_FORMAT ChooseFormat(const DirectX::ScratchImage& image);
+	bool IsUpToDate(const std::wstring& source, const std::wstring& destination);
+
+public:
+	/// <summary>
+	/// 1ϊ
+	/// </summary>
+	Result Cook(const std::wstring& source, const std::wstring& destination);
+	/// <summary>
+	/// ɕϊBo͐͊gq.ddsɕς
+	/// </summary>
+	std::vector<Result> CookAll(const std::vector<std::wstring>& sources);
+
+	/// <summary>
+	/// ϊ̃t@Cigq.ddsɂj
+	/// </summary>
+	static std::wstring GetCookedFileName(const std::wstring& source);
+};
@@ -0,0 +1,212 @@
+#include "AssetPack.h"
+#include "Lz4.h"
+
+#include <algorithm>
+#include <cstring>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static_assert(sizeof(AssetPack::Header) == 32, "AssetPack::Header must match the file layout");
+static_assert(sizeof(AssetPack::Entry) == 40, "AssetPack::Entry must match the file layout");
+
+AssetPack::AssetPack() {
+	data = nullptr;
+	size = 0;
+	entries = nullptr;
+	entryCount = 0;
+	names = nullptr;
+}
+
+AssetPack::~AssetPack() {
+	Close();
+}
+
+bool AssetPack::Open(const std::string& fileName) {
+	Close();
+
+#ifdef _WIN32
+	HANDLE file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+		CloseHandle(file);
+		return false;
+	}
+	// r[}bsÔŁAnh͂ɕĂ悢
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	CloseHandle(file);
+	if (mapping == nullptr) {
+		return false;
+	}
+	void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	CloseHandle(mapping);
+	if (view == nullptr) {
+		return false;
+	}
+	data = static_cast<const uint8_t*>(view);
+	size = (size_t)fileSize.QuadPart;
+#else
+	int file = open(fileName.c_str(), O_RDONLY);
+	if (file < 0) {
+		return false;
+	}
+	struct stat status;
+	if (fstat(file, &status) != 0 || status.st_size == 0) {
+		close(file);
+		return false;
+	}
+	void* view = mmap(nullptr, (size_t)status.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+	close(file);
+	if (view == MAP_FAILED) {
+		return false;
+	}
+	// Nɂ܂Ƃ߂ēǂނƂ̂ŁAǂ݂Ă
+	madvise(view, (size_t)status.st_size, MADV_WILLNEED);
+	data = static_cast<const uint8_t*>(view);
+	size = (size_t)status.st_size;
+#endif
+
+	if (!Validate()) {
+		Close();
+		return false;
+	}
+	return true;
+}
+
+void AssetPack::Close() {
+	if (data != nullptr) {
+#ifdef _WIN32
+		UnmapViewOfFile(data);
+#else
+		munmap(const_cast<uint8_t*>(data), size);
+#endif
+	}
+	data = nullptr;
+	size = 0;
+	entries = nullptr;
+	entryCount = 0;
+	names = nullptr;
+}
+
+bool AssetPack::Validate() {
+	if (size < sizeof(Header)) {
+		return false;
+	}
+	Header header;
+	std::memcpy(&header, data, sizeof(header));
+	if (header.magic != MAGIC || header.version != VERSION) {
+		return false;
+	}
+
+	// ͈͊Oǂ܂Ȃ悤ɁAڎƖOƃf[^̈ʒuJɂׂĊm߂Ă
+	if (header.tocOffset % alignof(Entry) != 0 || header.tocOffset > size || (size - header.tocOffset) / sizeof(Entry) < header.entryCount) {
+		return false;
+	}
+	if (header.nameTableOffset > size || size - header.nameTableOffset < header.nameTableSize) {
+		return false;
+	}
+
+	entries = reinterpret_cast<const Entry*>(data + header.tocOffset);
+	entryCount = header.entryCount;
+	names = reinterpret_cast<const char*>(data + header.nameTableOffset);
+
+	for (uint32_t i = 0; i < entryCount; i++) {
+		const Entry& entry = entries[i];
+		if (entry.offset > size || size - entry.offset < entry.storedSize) {
+			return false;
+		}
+		if ((uint64_t)entry.nameOffset + entry.nameLength > header.nameTableSize) {
+			return false;
+		}
+		if ((entry.flags & ENTRY_LZ4) == 0 && entry.storedSize != entry.size) {
+			return false;
+		}
+		// LZ41oCgő255oCgɂȂȂ̂ŁA傫WJ̑傫͉Ă
+		// î܂ܐMƓWJ̊mۂŋȃvĂ܂j
+		if ((entry.flags & ENTRY_LZ4) != 0 && entry.size > entry.storedSize * 255 + 16) {
+			return false;
+		}
+		if (i > 0 && entries[i - 1].hash > entry.hash) {
+			return false;
+		}
+	}
+	return true;
+}
+
+std::string AssetPack::NormalizeName(const std::string& name) {
+	std::string normalized = name;
+	for (auto& c : normalized) {
+		if (c == '\\') {
+			c = '/';
+		}
+		else if (c >= 'A' && c <= 'Z') {
+			c = (char)(c - 'A' + 'a');
+		}
+	}
+	return normalized;
+}
+
+uint64_t AssetPack::HashName(const std::string& normalizedName) {
+	// FNV-1a
+	uint64_t hash = 14695981039346656037ull;
+	for (auto c : normalizedName) {
+		hash ^= (uint8_t)c;
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
+
+const AssetPack::Entry* AssetPack::Find(const std::string& name) {
+	if (data == nullptr) {
+		return nullptr;
+	}
+
+	std::string normalized = NormalizeName(name);
+	uint64_t hash = HashName(normalized);
+
+	const Entry* end = entries + entryCount;
+	const Entry* found = std::lower_bound(entries, end, hash, [](const Entry& entry, uint64_t hash) { return entry.hash < hash; });
+
+	// nbVՓ˂ĂꍇɔĖOׂ
+	for (; found != end && found->hash == hash; ++found) {
+		if (found->nameLength == normalized.size() && std::memcmp(names + found->nameOffset, normalized.data(), normalized.size()) == 0) {
+			return found;
+		}
+	}
+	return nullptr;
+}
+
+AssetSpan AssetPack::Get(const Entry* entry, std::vector<uint8_t>& storage) {
+	if (entry == nullptr) {
+		return { nullptr, 0 };
+	}
+
+	const uint8_t* stored = data + entry->offset;
+	if ((entry->flags & ENTRY_LZ4) == 0) {
+		return { stored, (size_t)entry->size };
+	}
+
+	storage.resize((size_t)entry->size);
+	if (!Lz4::Decompress(stored, (size_t)entry->storedSize, storage.data(), storage.size())) {
+		storage.clear();
+		return { nullptr, 0 };
+	}
+	return { storage.data(), storage.size() };
+}
+
+AssetSpan AssetPack::Get(const std::string& name, std::vector<uint8_t>& storage) {
+	return Get(Find(name), storage);
+}
+
+std::string AssetPack::GetName(const Entry* entry) {
+	return std::string(names + entry->nameOffset, entry->nameLength);
+}
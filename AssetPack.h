@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// AZbgpbN̒1̃f[^
+typedef struct AssetSpan {
+	const uint8_t* data;	// ȂEĂꍇnullptr
+	size_t size;
+};
+
+// ̃AZbg1̃t@Cɂ܂Ƃ߂́Bt@C̓}bvēǂ
+// [wb_[] [ڎ nbV] [O] [f[^ ALIGNMENTE]...
+// f[^͖kLZ4ŁAk̂̂̓}bv̂܂ܕԂ
+class AssetPack
+{
+public:
+	static const uint32_t MAGIC = 0x414c474d;	// "MGLA"
+	static const uint32_t VERSION = 1;
+	static const uint32_t ALIGNMENT = 64;
+
+	enum EntryFlag : uint16_t {
+		ENTRY_LZ4 = 1,
+	};
+
+	typedef struct Header {
+		uint32_t magic;
+		uint32_t version;
+		uint32_t entryCount;
+		uint32_t nameTableSize;
+		uint64_t tocOffset;
+		uint64_t nameTableOffset;
+	};
+
+	typedef struct Entry {
+		uint64_t hash;
+		uint64_t offset;
+		uint64_t storedSize;	// t@C̑傫
+		uint64_t size;			// WJ̑傫
+		uint32_t nameOffset;
+		uint16_t nameLength;
+		uint16_t flags;
+	};
+
+private:
+	const uint8_t* data;
+	size_t size;
+	const Entry* entries;
+	uint32_t entryCount;
+	const char* names;
+
+public:
+	AssetPack();
+	~AssetPack();
+
+	AssetPack(const AssetPack&) = delete;
+	AssetPack& operator=(const AssetPack&) = delete;
+
+private:
+	bool Validate();
+
+public:
+	/// <summary>
+	/// t@C}bvB`ႤEĂꍇfalse
+	/// </summary>
+	bool Open(const std::string& fileName);
+	void Close();
+
+	/// <summary>
+	/// 啶Ƌ؂蕶i\/jʂȂ
+	/// </summary>
+	static std::string NormalizeName(const std::string& name);
+	static uint64_t HashName(const std::string& normalizedName);
+
+	const Entry* Find(const std::string& name);
+	/// <summary>
+	/// gԂBkȂ}bvwALZ4ȂstorageɓWJĂw
+	/// k̏ꍇ̓pbN܂ŗL
+	/// </summary>
+	AssetSpan Get(const Entry* entry, std::vector<uint8_t>& storage);
+	AssetSpan Get(const std::string& name, std::vector<uint8_t>& storage);
+
+	std::string GetName(const Entry* entry);
+	uint32_t GetEntryCount() { return entryCount; }
+	const Entry* GetEntry(uint32_t index) { return &entries[index]; }
+	bool IsOpen() { return data != nullptr; }
+};
@@ -0,0 +1,128 @@
+#include "AssetPackWriter.h"
+#include "AssetPack.h"
+#include "Lz4.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace {
+	uint64_t AlignUp(uint64_t value, uint64_t alignment) {
+		return (value + alignment - 1) / alignment * alignment;
+	}
+}
+
+AssetPackWriter::AssetPackWriter() {
+	statistics = {};
+}
+
+bool AssetPackWriter::Add(const std::string& name, const void* data, size_t size, bool compress) {
+	std::string normalized = AssetPack::NormalizeName(name);
+	if (normalized.size() > 0xffff || !names.insert(normalized).second) {
+		return false;
+	}
+
+	Item item;
+	item.name = normalized;
+	item.hash = AssetPack::HashName(normalized);
+	item.data.assign(static_cast<const uint8_t*>(data), static_cast<const uint8_t*>(data) + size);
+	item.compress = compress;
+	items.push_back(std::move(item));
+	return true;
+}
+
+bool AssetPackWriter::AddFile(const std::string& fileName, const std::string& name, bool compress) {
+	std::ifstream file(fileName, std::ios::binary | std::ios::ate);
+	if (!file) {
+		return false;
+	}
+	std::vector<uint8_t> data((size_t)file.tellg());
+	file.seekg(0);
+	file.read(reinterpret_cast<char*>(data.data()), data.size());
+	if (!file) {
+		return false;
+	}
+	return Add(name, data.data(), data.size(), compress);
+}
+
+bool AssetPackWriter::Save(const std::string& fileName) {
+	statistics = {};
+
+	// ǂޑ͓񕪒T̂ŁAڎ̓nbVɕׂ
+	std::sort(items.begin(), items.end(), [](const Item& a, const Item& b) {
+		return a.hash != b.hash ? a.hash < b.hash : a.name < b.name;
+	});
+
+	std::vector<AssetPack::Entry> entries(items.size());
+	std::vector<char> nameTable;
+	std::vector<std::vector<uint8_t>> stored(items.size());
+
+	for (size_t i = 0; i < items.size(); i++) {
+		const Item& item = items[i];
+		AssetPack::Entry& entry = entries[i];
+		entry = {};
+		entry.hash = item.hash;
+		entry.size = item.data.size();
+		entry.nameOffset = (uint32_t)nameTable.size();
+		entry.nameLength = (uint16_t)item.name.size();
+		nameTable.insert(nameTable.end(), item.name.begin(), item.name.end());
+
+		// 1/16ȏk܂Ȃ͓̂WJ̎ԂɌȂ̂Ŗkɂ
+		if (item.compress && !item.data.empty()) {
+			std::vector<uint8_t> compressed(Lz4::GetMaxCompressedSize(item.data.size()));
+			size_t compressedSize = Lz4::Compress(item.data.data(), item.data.size(), compressed.data(), compressed.size());
+			if (compressedSize != 0 && compressedSize < item.data.size() - item.data.size() / 16) {
+				compressed.resize(compressedSize);
+				stored[i] = std::move(compressed);
+				entry.flags |= AssetPack::ENTRY_LZ4;
+				statistics.compressed++;
+			}
+		}
+		entry.storedSize = (entry.flags & AssetPack::ENTRY_LZ4) ? stored[i].size() : item.data.size();
+
+		statistics.entries++;
+		statistics.rawBytes += entry.size;
+		statistics.storedBytes += entry.storedSize;
+	}
+
+	AssetPack::Header header = {};
+	header.magic = AssetPack::MAGIC;
+	header.version = AssetPack::VERSION;
+	header.entryCount = (uint32_t)entries.size();
+	header.nameTableSize = (uint32_t)nameTable.size();
+	header.tocOffset = sizeof(AssetPack::Header);
+	header.nameTableOffset = header.tocOffset + sizeof(AssetPack::Entry) * entries.size();
+
+	uint64_t offset = AlignUp(header.nameTableOffset + nameTable.size(), AssetPack::ALIGNMENT);
+	for (auto& entry : entries) {
+		entry.offset = offset;
+		offset = AlignUp(offset + entry.storedSize, AssetPack::ALIGNMENT);
+	}
+
+	std::ofstream file(fileName, std::ios::binary);
+	if (!file) {
+		return false;
+	}
+
+	uint64_t written = 0;
+	auto write = [&](const void* value, size_t size) {
+		file.write(static_cast<const char*>(value), size);
+		written += size;
+	};
+	auto pad = [&](uint64_t position) {
+		static const char zeros[AssetPack::ALIGNMENT] = {};
+		write(zeros, (size_t)(position - written));
+	};
+
+	write(&header, sizeof(header));
+	write(entries.data(), sizeof(AssetPack::Entry) * entries.size());
+	write(nameTable.data(), nameTable.size());
+	for (size_t i = 0; i < items.size(); i++) {
+		pad(entries[i].offset);
+		const auto& data = (entries[i].flags & AssetPack::ENTRY_LZ4) ? stored[i] : items[i].data;
+		write(data.data(), data.size());
+	}
+
+	statistics.fileBytes = written;
+	return (bool)file;
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+// AssetPack̃t@CipbN쐬c[pj
+class AssetPackWriter
+{
+public:
+	typedef struct Statistics {
+		uint32_t entries;
+		uint32_t compressed;	// LZ4ŕۑ
+		uint64_t rawBytes;
+		uint64_t storedBytes;
+		uint64_t fileBytes;
+	};
+
+private:
+	typedef struct Item {
+		std::string name;		// Kς
+		uint64_t hash;
+		std::vector<uint8_t> data;
+		bool compress;
+	};
+
+	std::vector<Item> items;
+	std::unordered_set<std::string> names;
+	Statistics statistics;
+
+public:
+	AssetPackWriter();
+
+	/// <summary>
+	/// ǉBOɂꍇfalse
+	/// compresstruełAk܂Ȃꍇ͖kŕۑ
+	/// </summary>
+	bool Add(const std::string& name, const void* data, size_t size, bool compress);
+	bool AddFile(const std::string& fileName, const std::string& name, bool compress);
+
+	bool Save(const std::string& fileName);
+
+	Statistics GetStatistics() { return statistics; }
+};
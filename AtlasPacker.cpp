@@ -0,0 +1,220 @@
+#include "AtlasPacker.h"
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+
+AtlasPacker::AtlasPacker(int pageWidth, int pageHeight, int padding, bool allowRotation) {
+	this->pageWidth = pageWidth;
+	this->pageHeight = pageHeight;
+	this->padding = padding < 0 ? 0 : padding;
+	this->allowRotation = allowRotation;
+	statistics = {};
+}
+
+int AtlasPacker::Add(int width, int height) {
+	sizes.push_back({ 0, 0, width, height });
+	placements.push_back({ -1, 0, 0, width, height, false });
+	return (int)sizes.size() - 1;
+}
+
+void AtlasPacker::NewPage() {
+	// [ɂ]󂯂邽߁A炵AE͊e`ɑ]ŋ󂯂
+	Page page;
+	page.freeRects.push_back({ padding, padding, pageWidth - padding, pageHeight - padding });
+	pages.push_back(page);
+}
+
+bool AtlasPacker::FindPosition(const Page& page, int width, int height, Rect& result, bool& rotated, int& bestShort, int& bestLong) {
+	bool found = false;
+
+	auto test = [&](const Rect& free, int w, int h, bool rotate) {
+		if (w > free.width || h > free.height) {
+			return;
+		}
+		int leftoverX = free.width - w;
+		int leftoverY = free.height - h;
+		int shortSide = leftoverX < leftoverY ? leftoverX : leftoverY;
+		int longSide = leftoverX < leftoverY ? leftoverY : leftoverX;
+		if (shortSide < bestShort || (shortSide == bestShort && longSide < bestLong)) {
+			result = { free.x, free.y, w, h };
+			rotated = rotate;
+			bestShort = shortSide;
+			bestLong = longSide;
+			found = true;
+		}
+	};
+
+	for (auto& free : page.freeRects) {
+		test(free, width, height, false);
+		if (allowRotation && width != height) {
+			test(free, height, width, true);
+		}
+	}
+
+	return found;
+}
+
+void AtlasPacker::PlaceRect(Page& page, const Rect& used) {
+	// g`ƏdȂ󂫗̈AdȂȂő̋`iő4jɕ
+	std::vector<Rect> split;
+	for (size_t i = 0; i < page.freeRects.size();) {
+		Rect free = page.freeRects[i];
+		if (used.x >= free.x + free.width || used.x + used.width <= free.x ||
+			used.y >= free.y + free.height || used.y + used.height <= free.y) {
+			i++;
+			continue;
+		}
+
+		if (used.x > free.x) {
+			split.push_back({ free.x, free.y, used.x - free.x, free.height });
+		}
+		if (used.x + used.width < free.x + free.width) {
+			split.push_back({ used.x + used.width, free.y, free.x + free.width - (used.x + used.width), free.height });
+		}
+		if (used.y > free.y) {
+			split.push_back({ free.x, free.y, free.width, used.y - free.y });
+		}
+		if (used.y + used.height < free.y + free.height) {
+			split.push_back({ free.x, used.y + used.height, free.width, free.y + free.height - (used.y + used.height) });
+		}
+
+		page.freeRects[i] = page.freeRects.back();
+		page.freeRects.pop_back();
+	}
+
+	PruneFreeRects(page, split);
+}
+
+void AtlasPacker::PruneFreeRects(Page& page, std::vector<Rect>& split) {
+	// ̋󂫗̈ɊSɊ܂܂̂
+	// ̋󂫗̈擯m͑O܂łɐς݂Ȃ̂ŁAĂł`ւgݍ킹𒲂ׂ
+	auto contains = [](const Rect& a, const Rect& b) {
+		return b.x >= a.x && b.y >= a.y && b.x + b.width <= a.x + a.width && b.y + b.height <= a.y + a.height;
+	};
+
+	for (size_t i = 0; i < split.size();) {
+		bool removed = false;
+		for (size_t j = 0; j < split.size(); j++) {
+			if (i != j && contains(split[j], split[i]) && (!contains(split[i], split[j]) || j < i)) {
+				removed = true;
+				break;
+			}
+		}
+		if (removed) {
+			split[i] = split.back();
+			split.pop_back();
+		}
+		else {
+			i++;
+		}
+	}
+
+	auto& rects = page.freeRects;
+	size_t oldCount = rects.size();
+	for (auto& rect : split) {
+		bool inside = false;
+		for (size_t i = 0; i < oldCount; i++) {
+			if (contains(rects[i], rect)) {
+				inside = true;
+				break;
+			}
+		}
+		if (inside) {
+			continue;
+		}
+
+		for (size_t i = 0; i < oldCount;) {
+			if (contains(rect, rects[i])) {
+				rects[i] = rects[oldCount - 1];
+				rects[oldCount - 1] = rects.back();
+				rects.pop_back();
+				oldCount--;
+			}
+			else {
+				i++;
+			}
+		}
+		rects.push_back(rect);
+	}
+}
+
+bool AtlasPacker::Pack() {
+	auto startTime = std::chrono::steady_clock::now();
+
+	pages.clear();
+
+	// ӂ傫ɋl߂Ƌ󂫂ȂȂ
+	std::vector<int> order(sizes.size());
+	for (size_t i = 0; i < order.size(); i++) {
+		order[i] = (int)i;
+	}
+	std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+		int sideA = sizes[a].width > sizes[a].height ? sizes[a].width : sizes[a].height;
+		int sideB = sizes[b].width > sizes[b].height ? sizes[b].width : sizes[b].height;
+		if (sideA != sideB) {
+			return sideA > sideB;
+		}
+		return sizes[a].width * sizes[a].height > sizes[b].width * sizes[b].height;
+	});
+
+	bool allPacked = true;
+	uint64_t usedArea = 0;
+
+	for (int id : order) {
+		int width = sizes[id].width + padding;
+		int height = sizes[id].height + padding;
+		Placement& placement = placements[id];
+		placement = { -1, 0, 0, sizes[id].width, sizes[id].height, false };
+
+		// Sy[W̒ňԂ҂ꏊT
+		int bestPage = -1;
+		Rect bestRect = {};
+		bool bestRotated = false;
+		int bestShort = INT_MAX;
+		int bestLong = INT_MAX;
+		for (int p = 0; p < (int)pages.size(); p++) {
+			if (FindPosition(pages[p], width, height, bestRect, bestRotated, bestShort, bestLong)) {
+				bestPage = p;
+			}
+		}
+
+		if (bestPage < 0) {
+			NewPage();
+			int p = (int)pages.size() - 1;
+			if (!FindPosition(pages[p], width, height, bestRect, bestRotated, bestShort, bestLong)) {
+				// y[W傫
+				pages.pop_back();
+				allPacked = false;
+				continue;
+			}
+			bestPage = p;
+		}
+
+		PlaceRect(pages[bestPage], bestRect);
+
+		placement.page = bestPage;
+		placement.x = bestRect.x;
+		placement.y = bestRect.y;
+		placement.width = bestRect.width - padding;
+		placement.height = bestRect.height - padding;
+		placement.rotated = bestRotated;
+		usedArea += (uint64_t)sizes[id].width * sizes[id].height;
+	}
+
+	statistics.rects = sizes.size();
+	statistics.pages = pages.size();
+	statistics.usedArea = usedArea;
+	statistics.pageArea = (uint64_t)pages.size() * pageWidth * pageHeight;
+	statistics.efficiency = statistics.pageArea > 0 ? (double)usedArea / (double)statistics.pageArea : 0.0;
+	statistics.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+	return allPacked;
+}
+
+void AtlasPacker::Clear() {
+	sizes.clear();
+	placements.clear();
+	pages.clear();
+	statistics = {};
+}
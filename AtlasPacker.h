@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// `MaxRects@iBest Short Side FitjŃy[Wɋl߂ifoCXsvj
+// ȂȂVy[Wǉ
+class AtlasPacker
+{
+public:
+	typedef struct Rect {
+		int x;
+		int y;
+		int width;
+		int height;
+	};
+
+	typedef struct Placement {
+		int page;		// Ȃꍇ-1
+		int x;
+		int y;
+		int width;		// y[W̑傫i]ꍇ͌̕ƍւj
+		int height;
+		bool rotated;	// v90x񂵂Ēu
+	};
+
+	typedef struct Statistics {
+		uint64_t rects;
+		uint64_t pages;
+		uint64_t usedArea;		// ]܂܂Ȃ`̖ʐς̍v
+		uint64_t pageArea;
+		double efficiency;		// usedArea / pageArea
+		double seconds;
+	};
+
+private:
+	typedef struct Page {
+		std::vector<Rect> freeRects;
+	};
+
+	int pageWidth;
+	int pageHeight;
+	int padding;
+	bool allowRotation;
+
+	std::vector<Rect> sizes;
+	std::vector<Placement> placements;
+	std::vector<Page> pages;
+
+	Statistics statistics;
+
+public:
+	/// <param name="padding">`mƃy[W̒[̊Ԃɋ󂯂sNZ</param>
+	AtlasPacker(int pageWidth, int pageHeight, int padding = 1, bool allowRotation = false);
+
+private:
+	bool FindPosition(const Page& page, int width, int height, Rect& result, bool& rotated, int& bestShort, int& bestLong);
+	void PlaceRect(Page& page, const Rect& used);
+	void PruneFreeRects(Page& page, std::vector<Rect>& split);
+	void NewPage();
+
+public:
+	int Add(int width, int height);
+
+	/// <summary>
+	/// ǉ`傫ɋl߂By[W傫`ꍇfalseԂi̋`͋l߂j
+	/// </summary>
+	bool Pack();
+	void Clear();
+
+	const Placement& GetPlacement(int id) { return placements[id]; }
+	size_t GetCount() { return sizes.size(); }
+	int GetPageCount() { return (int)pages.size(); }
+	int GetPageWidth() { return pageWidth; }
+	int GetPageHeight() { return pageHeight; }
+
+	Statistics GetStatistics() { return statistics; }
+};
@@ -28,6 +28,7 @@ Box::Box(int sx, int sy, int ex, int ey, ID3D12Device* device, DirectX::XMFLOAT3
 	indices[5] = 2;
 
 	CreateShape(vertices, indices, device);
+	SetShapeType(ShapeType::BOX, DirectX::XMFLOAT2((float)(ex - sx), (float)(ey - sy)));
 
 	SetTransform(DirectX::XMMatrixTranslation(sx, sy, 0), DirectX::XMMatrixIdentity(), DirectX::XMMatrixIdentity());
 }
\ No newline at end of file
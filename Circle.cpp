@@ -33,6 +33,7 @@ Circle::Circle(int x, int y, int r, ID3D12Device* device, DirectX::XMFLOAT3 colo
 	indices[359 * 3 + 2] = 1;
 
 	CreateShape(vertices, indices, device);
+	SetShapeType(ShapeType::CIRCLE, DirectX::XMFLOAT2((float)r, (float)r));
 
 	SetTransform(DirectX::XMMatrixTranslation(x, y, 0), DirectX::XMMatrixIdentity(), DirectX::XMMatrixIdentity());
 }
\ No newline at end of file
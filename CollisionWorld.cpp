@@ -0,0 +1,587 @@
+#include "CollisionWorld.h"
+#include "Shape.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+CollisionWorld::CollisionWorld() {
+	sortedCount = 0;
+	axis = 0;
+	removed = false;
+	statistics = {};
+}
+
+uint32_t CollisionWorld::NewBody(BodyType type, uint32_t vertexCount) {
+	uint32_t capacity = (vertexCount + 3) & ~3u;
+
+	uint32_t id;
+	if (!freeBodies.empty()) {
+		id = freeBodies.back();
+		freeBodies.pop_back();
+	}
+	else {
+		id = (uint32_t)bodies.size();
+		bodies.push_back({});
+		worlds.push_back(DirectX::XMMatrixIdentity());
+	}
+
+	// OɎgĂ_̏ꏊɓȂΖɎ蒼
+	Body& body = bodies[id];
+	if (body.vertexCapacity < capacity) {
+		body.firstVertex = (uint32_t)localXs.size();
+		body.vertexCapacity = capacity;
+		localXs.resize(localXs.size() + capacity);
+		localYs.resize(localYs.size() + capacity);
+	}
+	body.shape = nullptr;
+	body.type = type;
+	body.active = true;
+	body.rectangle = false;
+	body.center = { 0.0f, 0.0f };
+	body.radius = 0.0f;
+	body.vertexCount = 0;
+	worlds[id] = DirectX::XMMatrixIdentity();
+
+	// V͖̂ɒuAUpdateŕׂĂ獬
+	// 菜Oɔԍgꍇ͑Ȍꏊ̂܂܎g
+	if (!body.sorted) {
+		body.sorted = true;
+		order.push_back({ 0.0f, 0.0f, 0.0f, 0.0f, id });
+	}
+	return id;
+}
+
+void CollisionWorld::SetVertices(uint32_t body, const DirectX::XMFLOAT2* points, uint32_t count) {
+	// ʕ߂iAndrew̃mg[`F[j
+	std::vector<DirectX::XMFLOAT2> sorted(points, points + count);
+	std::sort(sorted.begin(), sorted.end(), [](const DirectX::XMFLOAT2& a, const DirectX::XMFLOAT2& b) {
+		return a.x != b.x ? a.x < b.x : a.y < b.y;
+	});
+	auto cross = [](const DirectX::XMFLOAT2& o, const DirectX::XMFLOAT2& a, const DirectX::XMFLOAT2& b) {
+		return (a.x - o.x) * (b.y - o.y) - (a.y - o.y) * (b.x - o.x);
+	};
+
+	std::vector<DirectX::XMFLOAT2> hull;
+	for (int pass = 0; pass < 2; pass++) {
+		size_t start = hull.size();
+		for (size_t i = 0; i < sorted.size(); i++) {
+			const DirectX::XMFLOAT2& point = sorted[pass == 0 ? i : sorted.size() - 1 - i];
+			while (hull.size() >= start + 2 && cross(hull[hull.size() - 2], hull.back(), point) <= 0.0f) {
+				hull.pop_back();
+			}
+			hull.push_back(point);
+		}
+		// I_͎̍̎n_Ɠ
+		hull.pop_back();
+	}
+	if (hull.empty()) {
+		hull.push_back(count > 0 ? points[0] : DirectX::XMFLOAT2(0.0f, 0.0f));
+	}
+
+	Body& target = bodies[body];
+	target.vertexCount = (uint32_t)hull.size();
+	if (target.vertexCapacity < ((target.vertexCount + 3) & ~3u)) {
+		target.vertexCapacity = (target.vertexCount + 3) & ~3u;
+		target.firstVertex = (uint32_t)localXs.size();
+		localXs.resize(localXs.size() + target.vertexCapacity);
+		localYs.resize(localYs.size() + target.vertexCapacity);
+	}
+
+	// 4ǂނ̂ŁA]͍Ō̒_Ŗ߂iŏEő͕ςȂj
+	for (uint32_t i = 0; i < target.vertexCapacity; i++) {
+		const DirectX::XMFLOAT2& point = hull[i < hull.size() ? i : hull.size() - 1];
+		localXs[target.firstVertex + i] = point.x;
+		localYs[target.firstVertex + i] = point.y;
+	}
+
+	target.rectangle = hull.size() == 4;
+	for (size_t i = 0; i < hull.size() && target.rectangle; i++) {
+		const DirectX::XMFLOAT2& a = hull[i];
+		const DirectX::XMFLOAT2& b = hull[(i + 1) % hull.size()];
+		target.rectangle = a.x == b.x || a.y == b.y;
+	}
+}
+
+uint32_t CollisionWorld::Add(Shape* shape) {
+	uint32_t id;
+	if (shape->GetShapeType() == ShapeType::CIRCLE) {
+		const ViewCuller::Bounds& bounds = shape->GetLocalBounds();
+		id = AddCircle(bounds.extents.x > bounds.extents.y ? bounds.extents.x : bounds.extents.y, { bounds.center.x, bounds.center.y });
+	}
+	else {
+		auto& vertices = shape->GetVertices();
+		std::vector<DirectX::XMFLOAT2> points(vertices.size());
+		for (size_t i = 0; i < vertices.size(); i++) {
+			points[i] = { vertices[i].position.x, vertices[i].position.y };
+		}
+		id = AddPolygon(points.data(), (uint32_t)points.size());
+	}
+
+	bodies[id].shape = shape;
+	return id;
+}
+
+uint32_t CollisionWorld::AddCircle(float radius, DirectX::XMFLOAT2 center) {
+	uint32_t id = NewBody(BodyType::CIRCLE, 0);
+	bodies[id].center = center;
+	bodies[id].radius = radius;
+	return id;
+}
+
+uint32_t CollisionWorld::AddPolygon(const DirectX::XMFLOAT2* points, uint32_t count) {
+	uint32_t id = NewBody(BodyType::POLYGON, count);
+	SetVertices(id, points, count);
+	return id;
+}
+
+void CollisionWorld::Remove(uint32_t body) {
+	if (body == INVALID_BODY || !bodies[body].active) {
+		return;
+	}
+
+	bodies[body].active = false;
+	bodies[body].shape = nullptr;
+	freeBodies.push_back(body);
+	removed = true;
+}
+
+void CollisionWorld::UpdateGeometry(uint32_t id) {
+	const Body& body = bodies[id];
+	if (body.shape != nullptr) {
+		worlds[id] = body.shape->GetWorldMatrix();
+	}
+	const DirectX::XMMATRIX& world = worlds[id];
+
+	DirectX::XMFLOAT4 row0, row1, row3;
+	DirectX::XMStoreFloat4(&row0, world.r[0]);
+	DirectX::XMStoreFloat4(&row1, world.r[1]);
+	DirectX::XMStoreFloat4(&row3, world.r[3]);
+
+	if (body.type == BodyType::CIRCLE) {
+		// g傪cňႤꍇ͑傫̉~ɂ
+		float x = body.center.x * row0.x + body.center.y * row1.x + row3.x;
+		float y = body.center.x * row0.y + body.center.y * row1.y + row3.y;
+		float scaleX = std::sqrt(row0.x * row0.x + row0.y * row0.y);
+		float scaleY = std::sqrt(row1.x * row1.x + row1.y * row1.y);
+		float radius = body.radius * (scaleX > scaleY ? scaleX : scaleY);
+		circles[id] = { x, y, radius };
+		boxes[id] = { x - radius, y - radius, x + radius, y + radius };
+		aligned[id] = 0;
+		return;
+	}
+
+	// _4ϊȂŏEő߂
+	DirectX::XMVECTOR m00 = DirectX::XMVectorReplicate(row0.x);
+	DirectX::XMVECTOR m01 = DirectX::XMVectorReplicate(row0.y);
+	DirectX::XMVECTOR m10 = DirectX::XMVectorReplicate(row1.x);
+	DirectX::XMVECTOR m11 = DirectX::XMVectorReplicate(row1.y);
+	DirectX::XMVECTOR tx = DirectX::XMVectorReplicate(row3.x);
+	DirectX::XMVECTOR ty = DirectX::XMVectorReplicate(row3.y);
+	DirectX::XMVECTOR minX = DirectX::XMVectorReplicate(INFINITY);
+	DirectX::XMVECTOR minY = DirectX::XMVectorReplicate(INFINITY);
+	DirectX::XMVECTOR maxX = DirectX::XMVectorReplicate(-INFINITY);
+	DirectX::XMVECTOR maxY = DirectX::XMVectorReplicate(-INFINITY);
+	uint32_t end = body.firstVertex + ((body.vertexCount + 3) & ~3u);
+	for (uint32_t i = body.firstVertex; i < end; i += 4) {
+		DirectX::XMVECTOR lx = DirectX::XMLoadFloat4(reinterpret_cast<const DirectX::XMFLOAT4*>(&localXs[i]));
+		DirectX::XMVECTOR ly = DirectX::XMLoadFloat4(reinterpret_cast<const DirectX::XMFLOAT4*>(&localYs[i]));
+		DirectX::XMVECTOR x = DirectX::XMVectorMultiplyAdd(lx, m00, DirectX::XMVectorMultiplyAdd(ly, m10, tx));
+		DirectX::XMVECTOR y = DirectX::XMVectorMultiplyAdd(lx, m01, DirectX::XMVectorMultiplyAdd(ly, m11, ty));
+		DirectX::XMStoreFloat4(reinterpret_cast<DirectX::XMFLOAT4*>(&worldXs[i]), x);
+		DirectX::XMStoreFloat4(reinterpret_cast<DirectX::XMFLOAT4*>(&worldYs[i]), y);
+		minX = DirectX::XMVectorMin(minX, x);
+		minY = DirectX::XMVectorMin(minY, y);
+		maxX = DirectX::XMVectorMax(maxX, x);
+		maxY = DirectX::XMVectorMax(maxY, y);
+	}
+
+	// 4vf̍ŏEő1ɂ܂Ƃ߂
+	minX = DirectX::XMVectorMin(minX, DirectX::XMVectorSwizzle<2, 3, 0, 1>(minX));
+	minY = DirectX::XMVectorMin(minY, DirectX::XMVectorSwizzle<2, 3, 0, 1>(minY));
+	maxX = DirectX::XMVectorMax(maxX, DirectX::XMVectorSwizzle<2, 3, 0, 1>(maxX));
+	maxY = DirectX::XMVectorMax(maxY, DirectX::XMVectorSwizzle<2, 3, 0, 1>(maxY));
+	minX = DirectX::XMVectorMin(minX, DirectX::XMVectorSwizzle<1, 0, 3, 2>(minX));
+	minY = DirectX::XMVectorMin(minY, DirectX::XMVectorSwizzle<1, 0, 3, 2>(minY));
+	maxX = DirectX::XMVectorMax(maxX, DirectX::XMVectorSwizzle<1, 0, 3, 2>(maxX));
+	maxY = DirectX::XMVectorMax(maxY, DirectX::XMVectorSwizzle<1, 0, 3, 2>(maxY));
+	boxes[id] = { DirectX::XMVectorGetX(minX), DirectX::XMVectorGetX(minY), DirectX::XMVectorGetX(maxX), DirectX::XMVectorGetX(maxY) };
+
+	// ]ĂȂs̋`́Aϊs̋`
+	aligned[id] = body.rectangle && row0.y == 0.0f && row1.x == 0.0f;
+}
+
+void CollisionWorld::SortAndSweep() {
+	// S̎U΂肪傫ŕׂBpɂɐ؂ւȂ悤2{̍t؂ւ
+	double sums[2] = {};
+	double squares[2] = {};
+	for (auto& entry : order) {
+		const DirectX::XMFLOAT4& box = boxes[entry.body];
+		double x = (box.x + box.z) * 0.5;
+		double y = (box.y + box.w) * 0.5;
+		sums[0] += x;
+		sums[1] += y;
+		squares[0] += x * x;
+		squares[1] += y * y;
+	}
+	double bodyCount = order.empty() ? 1.0 : (double)order.size();
+	double variances[2] = {
+		squares[0] / bodyCount - (sums[0] / bodyCount) * (sums[0] / bodyCount),
+		squares[1] / bodyCount - (sums[1] / bodyCount) * (sums[1] / bodyCount)
+	};
+	bool switched = variances[1 - axis] > variances[axis] * 2.0;
+	if (switched) {
+		axis = 1 - axis;
+	}
+
+	for (auto& entry : order) {
+		const DirectX::XMFLOAT4& box = boxes[entry.body];
+		entry.minimum = axis == 0 ? box.x : box.y;
+		entry.maximum = axis == 0 ? box.z : box.w;
+		entry.lower = axis == 0 ? box.y : box.x;
+		entry.upper = axis == 0 ? box.w : box.z;
+	}
+
+	auto less = [](const SortEntry& a, const SortEntry& b) { return a.minimum < b.minimum; };
+	uint64_t swaps = 0;
+	if (switched) {
+		std::sort(order.begin(), order.end(), less);
+	}
+	else {
+		// Õt[̕т͂قڐ̂ő}\[gŒ
+		for (size_t i = 1; i < sortedCount; i++) {
+			SortEntry entry = order[i];
+			size_t j = i;
+			while (j > 0 && order[j - 1].minimum > entry.minimum) {
+				order[j] = order[j - 1];
+				j--;
+			}
+			order[j] = entry;
+			swaps += i - j;
+		}
+
+		// V͕̂ʂɕׂĂ獬i܂Ƃ߂đꍇɑ}\[g2ɂȂȂ悤Ɂj
+		if (sortedCount < order.size()) {
+			std::sort(order.begin() + sortedCount, order.end(), less);
+			std::inplace_merge(order.begin(), order.begin() + sortedCount, order.end(), less);
+		}
+	}
+	sortedCount = (uint32_t)order.size();
+	statistics.swaps = swaps;
+	statistics.axis = axis;
+
+	// Ԃ4ׂ悤ɕĕׂB̖ߑ͍ŏlȂ̂ŕK͈͊OɂȂ
+	size_t count = order.size();
+	sweepMinimums.resize(count + 4);
+	sweepMaximums.resize(count + 4);
+	sweepLowers.resize(count + 4);
+	sweepUppers.resize(count + 4);
+	for (size_t i = 0; i < count; i++) {
+		sweepMinimums[i] = order[i].minimum;
+		sweepMaximums[i] = order[i].maximum;
+		sweepLowers[i] = order[i].lower;
+		sweepUppers[i] = order[i].upper;
+	}
+	for (size_t i = count; i < count + 4; i++) {
+		sweepMinimums[i] = INFINITY;
+		sweepMaximums[i] = -INFINITY;
+		sweepLowers[i] = INFINITY;
+		sweepUppers[i] = -INFINITY;
+	}
+
+	// ׂŋԂdȂԂāA1̎dȂgނƂɕ
+	circlePairs.clear();
+	boxPairs.clear();
+	polygonPairs.clear();
+	for (size_t i = 0; i < count; i++) {
+		DirectX::XMVECTOR maximum = DirectX::XMVectorReplicate(sweepMaximums[i]);
+		DirectX::XMVECTOR lower = DirectX::XMVectorReplicate(sweepLowers[i]);
+		DirectX::XMVECTOR upper = DirectX::XMVectorReplicate(sweepUppers[i]);
+		for (size_t j = i + 1;; j += 4) {
+			// ŏl̏ɕł̂ŁA͈͓̗vf͐擪瑱
+			DirectX::XMVECTOR minimums = DirectX::XMLoadFloat4(reinterpret_cast<const DirectX::XMFLOAT4*>(&sweepMinimums[j]));
+			int inRange = _mm_movemask_ps(DirectX::XMVectorLessOrEqual(minimums, maximum));
+			if (inRange == 0) {
+				break;
+			}
+			DirectX::XMVECTOR lowers = DirectX::XMLoadFloat4(reinterpret_cast<const DirectX::XMFLOAT4*>(&sweepLowers[j]));
+			DirectX::XMVECTOR uppers = DirectX::XMLoadFloat4(reinterpret_cast<const DirectX::XMFLOAT4*>(&sweepUppers[j]));
+			int hits = inRange & _mm_movemask_ps(DirectX::XMVectorAndInt(DirectX::XMVectorLessOrEqual(lowers, upper), DirectX::XMVectorGreaterOrEqual(uppers, lower)));
+			for (uint32_t lane = 0; hits != 0; lane++, hits >>= 1) {
+				if ((hits & 1) == 0) {
+					continue;
+				}
+
+				uint32_t a = order[i].body;
+				uint32_t b = order[j + lane].body;
+				Pair pair = a < b ? Pair{ a, b } : Pair{ b, a };
+				if (bodies[a].type == BodyType::CIRCLE && bodies[b].type == BodyType::CIRCLE) {
+					circlePairs.push_back(pair);
+				}
+				else if (aligned[a] && aligned[b]) {
+					boxPairs.push_back(pair);
+				}
+				else {
+					polygonPairs.push_back(pair);
+				}
+			}
+			if (inRange != 0xf) {
+				break;
+			}
+		}
+	}
+	statistics.candidates = (uint32_t)(circlePairs.size() + boxPairs.size() + polygonPairs.size());
+}
+
+void CollisionWorld::CollideCircles() {
+	for (size_t start = 0; start < circlePairs.size(); start += 4) {
+		// 4gɑȂ͍Ō̑gJԂĖ߂
+		DirectX::XMFLOAT4 ax, ay, ar, bx, by, br;
+		float* lanes[] = { &ax.x, &ay.x, &ar.x, &bx.x, &by.x, &br.x };
+		size_t count = circlePairs.size() - start < 4 ? circlePairs.size() - start : 4;
+		for (size_t lane = 0; lane < 4; lane++) {
+			const Pair& pair = circlePairs[start + (lane < count ? lane : count - 1)];
+			const DirectX::XMFLOAT3& a = circles[pair.a];
+			const DirectX::XMFLOAT3& b = circles[pair.b];
+			lanes[0][lane] = a.x;
+			lanes[1][lane] = a.y;
+			lanes[2][lane] = a.z;
+			lanes[3][lane] = b.x;
+			lanes[4][lane] = b.y;
+			lanes[5][lane] = b.z;
+		}
+
+		DirectX::XMVECTOR dx = DirectX::XMVectorSubtract(DirectX::XMLoadFloat4(&bx), DirectX::XMLoadFloat4(&ax));
+		DirectX::XMVECTOR dy = DirectX::XMVectorSubtract(DirectX::XMLoadFloat4(&by), DirectX::XMLoadFloat4(&ay));
+		DirectX::XMVECTOR radius = DirectX::XMVectorAdd(DirectX::XMLoadFloat4(&ar), DirectX::XMLoadFloat4(&br));
+		DirectX::XMVECTOR distance = DirectX::XMVectorSqrt(DirectX::XMVectorMultiplyAdd(dx, dx, DirectX::XMVectorMultiply(dy, dy)));
+		DirectX::XMVECTOR depth = DirectX::XMVectorSubtract(radius, distance);
+
+		// Sꍇ͌܂Ȃ̂X̌ɂ
+		DirectX::XMVECTOR zero = DirectX::XMVectorEqual(distance, DirectX::XMVectorZero());
+		DirectX::XMVECTOR inverse = DirectX::XMVectorReciprocal(DirectX::XMVectorSelect(distance, DirectX::g_XMOne, zero));
+		DirectX::XMVECTOR nx = DirectX::XMVectorSelect(DirectX::XMVectorMultiply(dx, inverse), DirectX::g_XMOne, zero);
+		DirectX::XMVECTOR ny = DirectX::XMVectorSelect(DirectX::XMVectorMultiply(dy, inverse), DirectX::XMVectorZero(), zero);
+
+		DirectX::XMFLOAT4 depths, normalXs, normalYs;
+		DirectX::XMStoreFloat4(&depths, depth);
+		DirectX::XMStoreFloat4(&normalXs, nx);
+		DirectX::XMStoreFloat4(&normalYs, ny);
+		const float* depthLanes = &depths.x;
+		const float* normalXLanes = &normalXs.x;
+		const float* normalYLanes = &normalYs.x;
+		for (size_t lane = 0; lane < count; lane++) {
+			if (depthLanes[lane] > 0.0f) {
+				const Pair& pair = circlePairs[start + lane];
+				contacts.push_back({ pair.a, pair.b, { normalXLanes[lane], normalYLanes[lane] }, depthLanes[lane] });
+			}
+		}
+	}
+}
+
+void CollisionWorld::CollideBoxes() {
+	for (size_t start = 0; start < boxPairs.size(); start += 4) {
+		DirectX::XMFLOAT4 aMinX, aMinY, aMaxX, aMaxY, bMinX, bMinY, bMaxX, bMaxY;
+		float* lanes[] = { &aMinX.x, &aMinY.x, &aMaxX.x, &aMaxY.x, &bMinX.x, &bMinY.x, &bMaxX.x, &bMaxY.x };
+		size_t count = boxPairs.size() - start < 4 ? boxPairs.size() - start : 4;
+		for (size_t lane = 0; lane < 4; lane++) {
+			const Pair& pair = boxPairs[start + (lane < count ? lane : count - 1)];
+			const DirectX::XMFLOAT4& a = boxes[pair.a];
+			const DirectX::XMFLOAT4& b = boxes[pair.b];
+			lanes[0][lane] = a.x;
+			lanes[1][lane] = a.y;
+			lanes[2][lane] = a.z;
+			lanes[3][lane] = a.w;
+			lanes[4][lane] = b.x;
+			lanes[5][lane] = b.y;
+			lanes[6][lane] = b.z;
+			lanes[7][lane] = b.w;
+		}
+
+		// eŁAb𐳂̌ɉoʂƕ̌ɉo
+		DirectX::XMVECTOR forwardX = DirectX::XMVectorSubtract(DirectX::XMLoadFloat4(&aMaxX), DirectX::XMLoadFloat4(&bMinX));
+		DirectX::XMVECTOR backwardX = DirectX::XMVectorSubtract(DirectX::XMLoadFloat4(&bMaxX), DirectX::XMLoadFloat4(&aMinX));
+		DirectX::XMVECTOR forwardY = DirectX::XMVectorSubtract(DirectX::XMLoadFloat4(&aMaxY), DirectX::XMLoadFloat4(&bMinY));
+		DirectX::XMVECTOR backwardY = DirectX::XMVectorSubtract(DirectX::XMLoadFloat4(&bMaxY), DirectX::XMLoadFloat4(&aMinY));
+		DirectX::XMVECTOR depthX = DirectX::XMVectorMin(forwardX, backwardX);
+		DirectX::XMVECTOR depthY = DirectX::XMVectorMin(forwardY, backwardY);
+
+		// oʂ̏EI
+		DirectX::XMVECTOR useX = DirectX::XMVectorLess(depthX, depthY);
+		DirectX::XMVECTOR depth = DirectX::XMVectorSelect(depthY, depthX, useX);
+		DirectX::XMVECTOR signX = DirectX::XMVectorSelect(DirectX::g_XMOne, DirectX::g_XMNegativeOne, DirectX::XMVectorLess(backwardX, forwardX));
+		DirectX::XMVECTOR signY = DirectX::XMVectorSelect(DirectX::g_XMOne, DirectX::g_XMNegativeOne, DirectX::XMVectorLess(backwardY, forwardY));
+		DirectX::XMVECTOR nx = DirectX::XMVectorSelect(DirectX::XMVectorZero(), signX, useX);
+		DirectX::XMVECTOR ny = DirectX::XMVectorSelect(signY, DirectX::XMVectorZero(), useX);
+
+		DirectX::XMFLOAT4 depths, normalXs, normalYs;
+		DirectX::XMStoreFloat4(&depths, depth);
+		DirectX::XMStoreFloat4(&normalXs, nx);
+		DirectX::XMStoreFloat4(&normalYs, ny);
+		const float* depthLanes = &depths.x;
+		const float* normalXLanes = &normalXs.x;
+		const float* normalYLanes = &normalYs.x;
+		for (size_t lane = 0; lane < count; lane++) {
+			if (depthLanes[lane] > 0.0f) {
+				const Pair& pair = boxPairs[start + lane];
+				contacts.push_back({ pair.a, pair.b, { normalXLanes[lane], normalYLanes[lane] }, depthLanes[lane] });
+			}
+		}
+	}
+}
+
+void CollisionWorld::Project(uint32_t id, float axisX, float axisY, float& minimum, float& maximum) {
+	const Body& body = bodies[id];
+	if (body.type == BodyType::CIRCLE) {
+		const DirectX::XMFLOAT3& circle = circles[id];
+		float center = circle.x * axisX + circle.y * axisY;
+		minimum = center - circle.z;
+		maximum = center + circle.z;
+		return;
+	}
+
+	// _4ɓe
+	DirectX::XMVECTOR ax = DirectX::XMVectorReplicate(axisX);
+	DirectX::XMVECTOR ay = DirectX::XMVectorReplicate(axisY);
+	DirectX::XMVECTOR low = DirectX::XMVectorReplicate(INFINITY);
+	DirectX::XMVECTOR high = DirectX::XMVectorReplicate(-INFINITY);
+	uint32_t end = body.firstVertex + ((body.vertexCount + 3) & ~3u);
+	for (uint32_t i = body.firstVertex; i < end; i += 4) {
+		DirectX::XMVECTOR x = DirectX::XMLoadFloat4(reinterpret_cast<const DirectX::XMFLOAT4*>(&worldXs[i]));
+		DirectX::XMVECTOR y = DirectX::XMLoadFloat4(reinterpret_cast<const DirectX::XMFLOAT4*>(&worldYs[i]));
+		DirectX::XMVECTOR projected = DirectX::XMVectorMultiplyAdd(x, ax, DirectX::XMVectorMultiply(y, ay));
+		low = DirectX::XMVectorMin(low, projected);
+		high = DirectX::XMVectorMax(high, projected);
+	}
+	low = DirectX::XMVectorMin(low, DirectX::XMVectorSwizzle<2, 3, 0, 1>(low));
+	high = DirectX::XMVectorMax(high, DirectX::XMVectorSwizzle<2, 3, 0, 1>(high));
+	low = DirectX::XMVectorMin(low, DirectX::XMVectorSwizzle<1, 0, 3, 2>(low));
+	high = DirectX::XMVectorMax(high, DirectX::XMVectorSwizzle<1, 0, 3, 2>(high));
+	minimum = DirectX::XMVectorGetX(low);
+	maximum = DirectX::XMVectorGetX(high);
+}
+
+bool CollisionWorld::CollidePolygon(uint32_t a, uint32_t b, Contact& contact) {
+	// Bp`̕ӂ̖@ƁA~ꍇ͉~̒Sԋ߂_ւ̌𒲂ׂ
+	float bestDepth = INFINITY;
+	float bestX = 1.0f;
+	float bestY = 0.0f;
+
+	auto testAxis = [&](float axisX, float axisY) {
+		float length = std::sqrt(axisX * axisX + axisY * axisY);
+		if (length == 0.0f) {
+			return true;
+		}
+		axisX /= length;
+		axisY /= length;
+
+		float minA, maxA, minB, maxB;
+		Project(a, axisX, axisY, minA, maxA);
+		Project(b, axisX, axisY, minB, maxB);
+		// b̐̌ƕ̌ɉoʂ̏
+		float forward = maxA - minB;
+		float backward = maxB - minA;
+		float depth = forward < backward ? forward : backward;
+		if (depth <= 0.0f) {
+			return false;
+		}
+		if (depth < bestDepth) {
+			bestDepth = depth;
+			bestX = forward < backward ? axisX : -axisX;
+			bestY = forward < backward ? axisY : -axisY;
+		}
+		return true;
+	};
+
+	const uint32_t pair[] = { a, b };
+	for (int side = 0; side < 2; side++) {
+		const Body& body = bodies[pair[side]];
+		const Body& other = bodies[pair[1 - side]];
+		if (body.type == BodyType::POLYGON) {
+			for (uint32_t i = 0; i < body.vertexCount; i++) {
+				uint32_t current = body.firstVertex + i;
+				uint32_t next = body.firstVertex + (i + 1 < body.vertexCount ? i + 1 : 0);
+				if (!testAxis(worldYs[next] - worldYs[current], worldXs[current] - worldXs[next])) {
+					return false;
+				}
+			}
+		}
+		else if (other.type == BodyType::POLYGON) {
+			const DirectX::XMFLOAT3& circle = circles[pair[side]];
+			float nearest = INFINITY;
+			float nearestX = 0.0f;
+			float nearestY = 0.0f;
+			for (uint32_t i = 0; i < other.vertexCount; i++) {
+				float dx = worldXs[other.firstVertex + i] - circle.x;
+				float dy = worldYs[other.firstVertex + i] - circle.y;
+				if (dx * dx + dy * dy < nearest) {
+					nearest = dx * dx + dy * dy;
+					nearestX = dx;
+					nearestY = dy;
+				}
+			}
+			if (!testAxis(nearestX, nearestY)) {
+				return false;
+			}
+		}
+	}
+
+	contact = { a, b, { bestX, bestY }, bestDepth };
+	return true;
+}
+
+void CollisionWorld::CollidePolygons() {
+	for (auto& pair : polygonPairs) {
+		Contact contact;
+		if (CollidePolygon(pair.a, pair.b, contact)) {
+			contacts.push_back(contact);
+		}
+	}
+}
+
+void CollisionWorld::Update() {
+	auto startTime = std::chrono::steady_clock::now();
+
+	// Removêтۂ܂܋l߂
+	if (removed) {
+		size_t kept = 0;
+		uint32_t keptSorted = 0;
+		for (size_t i = 0; i < order.size(); i++) {
+			Body& body = bodies[order[i].body];
+			body.sorted = body.active;
+			if (body.active) {
+				keptSorted += i < sortedCount ? 1 : 0;
+				order[kept++] = order[i];
+			}
+		}
+		order.resize(kept);
+		sortedCount = keptSorted;
+		removed = false;
+	}
+
+	worldXs.resize(localXs.size());
+	worldYs.resize(localYs.size());
+	boxes.resize(bodies.size());
+	circles.resize(bodies.size());
+	aligned.resize(bodies.size());
+	// s͔ԍ̏ɕł̂ŁAԍ̏ɓǂ
+	for (uint32_t id = 0; id < (uint32_t)bodies.size(); id++) {
+		if (bodies[id].active) {
+			UpdateGeometry(id);
+		}
+	}
+	SortAndSweep();
+
+	auto sweepTime = std::chrono::steady_clock::now();
+
+	contacts.clear();
+	CollideCircles();
+	CollideBoxes();
+	CollidePolygons();
+
+	auto endTime = std::chrono::steady_clock::now();
+	statistics.bodies = (uint32_t)order.size();
+	statistics.contacts = (uint32_t)contacts.size();
+	statistics.broadphaseSeconds = std::chrono::duration<double>(sweepTime - startTime).count();
+	statistics.narrowphaseSeconds = std::chrono::duration<double>(endTime - sweepTime).count();
+}
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <DirectXMath.h>
+
+#include <cstdint>
+#include <vector>
+
+// BoxECircleETriangleȂǂ̏dȂ𒲂ׂifoCXsvj
+// eXY1̃XC[vv[BÕt[̕т}\[gŒ̂ŁAꍇ͂قڐ`
+// ׂ͉~mEs̋`m4g܂Ƃ߂SIMDŁAȊO͕i_̓e4jōs
+class CollisionWorld
+{
+public:
+	static const uint32_t INVALID_BODY = 0xffffffff;
+
+	typedef struct Contact {
+		uint32_t a;					// a < b
+		uint32_t b;
+		DirectX::XMFLOAT2 normal;	// ab֌PʃxNg
+		float depth;				// bnormaľɂꂾƗ
+	};
+
+	// OUpdate̒l
+	typedef struct Statistics {
+		uint32_t bodies;
+		uint32_t candidates;		// eʂg
+		uint32_t contacts;
+		uint64_t swaps;				// גœւ
+		uint32_t axis;				// 0ȂXA1ȂYŕׂĂ
+		double broadphaseSeconds;	// _̕ϊ܂
+		double narrowphaseSeconds;
+	};
+
+private:
+	enum class BodyType : uint8_t {
+		CIRCLE,
+		POLYGON
+	};
+
+	typedef struct Body {
+		class Shape* shape;			// ѕt}`BUpdateōsǂ
+		BodyType type;
+		bool active;
+		bool sorted;				// orderɓĂiRemovêUpdateł܂Ƃ߂Ď菜j
+		bool rectangle;				// s̋`i]ĂȂAABBm̔ōςށj
+		DirectX::XMFLOAT2 center;	// ~̒Si[JWj
+		float radius;
+		uint32_t firstVertex;		// ʕ̒_B4̔{̐mۂA]͍Ō̒_Ŗ߂
+		uint32_t vertexCount;
+		uint32_t vertexCapacity;
+	};
+
+	// ނ̔4g܂Ƃ߂邽߂̑g
+	typedef struct Pair {
+		uint32_t a;
+		uint32_t b;
+	};
+
+	// XC[vő̂̋`ɍςނ悤Aׂ鎲̋ԂƂ1̎̋Ԃ
+	typedef struct SortEntry {
+		float minimum;		// ׂ鎲ł̍ŏl
+		float maximum;
+		float lower;		// 1̎ł̍ŏl
+		float upper;
+		uint32_t body;
+	};
+
+	std::vector<Body> bodies;
+	std::vector<DirectX::XMMATRIX> worlds;
+	std::vector<uint32_t> freeBodies;
+	std::vector<float> localXs;
+	std::vector<float> localYs;
+
+	// ȉUpdateō蒼
+	std::vector<float> worldXs;
+	std::vector<float> worldYs;
+	std::vector<DirectX::XMFLOAT4> boxes;		// minX, minY, maxX, maxY
+	std::vector<DirectX::XMFLOAT3> circles;		// x, y, a
+	std::vector<uint8_t> aligned;				// ̃t[AABBƂĈ
+
+	std::vector<SortEntry> order;				// axis̍ŏl̏ɕׂ
+	uint32_t sortedCount;						// OUpdateŕׂBȍ~͐V
+	std::vector<float> sweepMinimums;			// order̋Ԃ4ׂ邽߂ɕĕׂ́i4߂j
+	std::vector<float> sweepMaximums;
+	std::vector<float> sweepLowers;
+	std::vector<float> sweepUppers;
+	uint32_t axis;
+	bool removed;								// orderɎ菜̂cĂ
+	std::vector<Pair> circlePairs;
+	std::vector<Pair> boxPairs;
+	std::vector<Pair> polygonPairs;
+	std::vector<Contact> contacts;
+
+	Statistics statistics;
+
+public:
+	CollisionWorld();
+
+	CollisionWorld(const CollisionWorld&) = delete;
+	CollisionWorld& operator=(const CollisionWorld&) = delete;
+
+private:
+	uint32_t NewBody(BodyType type, uint32_t vertexCount);
+	void SetVertices(uint32_t body, const DirectX::XMFLOAT2* points, uint32_t count);
+	void UpdateGeometry(uint32_t body);
+	void SortAndSweep();
+	void CollideCircles();
+	void CollideBoxes();
+	void CollidePolygons();
+	bool CollidePolygon(uint32_t a, uint32_t b, Contact& contact);
+	void Project(uint32_t body, float axisX, float axisY, float& minimum, float& maximum);
+
+public:
+	/// <summary>
+	/// }`̒_̂BCircle͉~AȊO͒_̓ʕƂĈ
+	/// }`폜ORemove邱
+	/// </summary>
+	uint32_t Add(class Shape* shape);
+	/// <summary>
+	/// }`ɌѕtȂ~BʒuSetTransformŗ^
+	/// </summary>
+	uint32_t AddCircle(float radius, DirectX::XMFLOAT2 center = DirectX::XMFLOAT2(0.0f, 0.0f));
+	/// <summary>
+	/// }`ɌѕtȂʑp`ipoints̓ʕjBʒuSetTransformŗ^
+	/// </summary>
+	uint32_t AddPolygon(const DirectX::XMFLOAT2* points, uint32_t count);
+	void Remove(uint32_t body);
+
+	void SetTransform(uint32_t body, DirectX::FXMMATRIX world) { worlds[body] = world; }
+	class Shape* GetShape(uint32_t body) { return bodies[body].shape; }
+
+	/// <summary>
+	/// S̑̂̈ʒuXVďdȂ𒲂ג
+	/// </summary>
+	void Update();
+
+	/// <summary>
+	/// OUpdateŌdȂig1񂾂j
+	/// </summary>
+	const std::vector<Contact>& GetContacts() { return contacts; }
+
+	Statistics GetStatistics() { return statistics; }
+};
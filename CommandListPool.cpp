@@ -0,0 +1,41 @@
+#include "CommandListPool.h"
+#include "Debugger.h"
+
+CommandListPool::CommandListPool(ID3D12Device* device, unsigned int frameCount) {
+	this->device = device;
+	frames.resize(frameCount);
+	usedCounts.resize(frameCount, 0);
+	frameIndex = 0;
+}
+
+void CommandListPool::BeginFrame(unsigned int index) {
+	frameIndex = index;
+	usedCounts[index] = 0;
+}
+
+ID3D12GraphicsCommandList* CommandListPool::Acquire() {
+	auto& entries = frames[frameIndex];
+	size_t& used = usedCounts[frameIndex];
+
+	if (used < entries.size()) {
+		Entry& entry = entries[used++];
+		Debugger::ErrorCheck(entry.allocator->Reset());
+		Debugger::ErrorCheck(entry.list->Reset(entry.allocator.Get(), nullptr));
+		return entry.list.Get();
+	}
+
+	Entry entry;
+	Debugger::ErrorCheck(device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(entry.allocator.ReleaseAndGetAddressOf())));
+	Debugger::ErrorCheck(device->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_DIRECT, entry.allocator.Get(), nullptr, IID_PPV_ARGS(entry.list.ReleaseAndGetAddressOf())));
+	entries.push_back(entry);
+	used++;
+	return entry.list.Get();
+}
+
+size_t CommandListPool::GetListCount() {
+	size_t count = 0;
+	for (auto& entries : frames) {
+		count += entries.size();
+	}
+	return count;
+}
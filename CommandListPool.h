@@ -0,0 +1,38 @@
+#pragma once
+
+#include <wrl.h>
+#include <d3d12.h>
+
+#include <vector>
+
+// t[ƂɃR}hXgƃAP[^[̑g݂o
+// 1̃Xg1̃AP[^[蓖Ă̂ŁAʁX̃XbhœɋL^ł
+class CommandListPool
+{
+private:
+	typedef struct Entry {
+		Microsoft::WRL::ComPtr<ID3D12CommandAllocator> allocator;
+		Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList> list;
+	};
+
+	ID3D12Device* device;
+	std::vector<std::vector<Entry>> frames;
+	std::vector<size_t> usedCounts;
+	unsigned int frameIndex;
+
+public:
+	CommandListPool(ID3D12Device* device, unsigned int frameCount);
+
+public:
+	/// <summary>
+	/// t[̏IĂĂсÃt[ő݂Xgėpł悤ɂ
+	/// </summary>
+	void BeginFrame(unsigned int index);
+
+	/// <summary>
+	/// L^łԂ̃XgԂiCXbhĂԂƁj
+	/// </summary>
+	ID3D12GraphicsCommandList* Acquire();
+
+	size_t GetListCount();
+};
@@ -0,0 +1,306 @@
+#include "CommandStream.h"
+#include "SoftwareRasterizer.h"
+
+#include <chrono>
+#include <cstring>
+#include <fstream>
+
+CommandStreamWriter::CommandStreamWriter() {
+	Clear();
+}
+
+void CommandStreamWriter::Write(const void* value, size_t size) {
+	auto bytes = static_cast<const uint8_t*>(value);
+	data.insert(data.end(), bytes, bytes + size);
+}
+
+void CommandStreamWriter::Align() {
+	while (data.size() % 4 != 0) {
+		data.push_back(0);
+	}
+}
+
+void CommandStreamWriter::Clear() {
+	data.clear();
+	WriteU32(MAGIC);
+	WriteU32(VERSION);
+}
+
+void CommandStreamWriter::BeginDraw() {
+	WriteU32((uint32_t)StreamCommand::BEGIN_DRAW);
+}
+
+void CommandStreamWriter::EndDraw() {
+	WriteU32((uint32_t)StreamCommand::END_DRAW);
+}
+
+void CommandStreamWriter::SetPipeline(uint32_t pipeline) {
+	WriteU32((uint32_t)StreamCommand::SET_PIPELINE);
+	WriteU32(pipeline);
+}
+
+void CommandStreamWriter::SetDescriptorHeap(uint32_t heap) {
+	WriteU32((uint32_t)StreamCommand::SET_DESCRIPTOR_HEAP);
+	WriteU32(heap);
+}
+
+void CommandStreamWriter::DefineMesh(uint32_t mesh, StreamTopology topology, const float* vertices, uint32_t vertexCount, const uint16_t* indices, uint32_t indexCount) {
+	WriteU32((uint32_t)StreamCommand::DEFINE_MESH);
+	WriteU32(mesh);
+	WriteU32((uint32_t)topology);
+	WriteU32(vertexCount);
+	WriteU32(indexCount);
+	Write(vertices, sizeof(float) * VERTEX_FLOATS * vertexCount);
+	Write(indices, sizeof(uint16_t) * indexCount);
+	Align();
+}
+
+void CommandStreamWriter::DefineTexture(uint32_t texture, int width, int height, int rowPitch, const uint8_t* pixels) {
+	WriteU32((uint32_t)StreamCommand::DEFINE_TEXTURE);
+	WriteU32(texture);
+	WriteU32((uint32_t)width);
+	WriteU32((uint32_t)height);
+	for (int y = 0; y < height; y++) {
+		Write(pixels + (size_t)y * rowPitch, (size_t)width * 4);
+	}
+}
+
+void CommandStreamWriter::BindTexture(uint32_t texture) {
+	WriteU32((uint32_t)StreamCommand::BIND_TEXTURE);
+	WriteU32(texture);
+}
+
+void CommandStreamWriter::DrawMesh(uint32_t mesh, const float* world) {
+	WriteU32((uint32_t)StreamCommand::DRAW_MESH);
+	WriteU32(mesh);
+	Write(world, sizeof(float) * 16);
+}
+
+void CommandStreamWriter::DrawString(uint32_t font, const wchar_t* str, size_t length, const float* pos, const float* color) {
+	WriteU32((uint32_t)StreamCommand::DRAW_STRING);
+	WriteU32(font);
+	Write(pos, sizeof(float) * 2);
+	Write(color, sizeof(float) * 4);
+	WriteU32((uint32_t)length);
+	// wchar_t̑傫͊ňقȂ̂UTF-16ŕۑ
+	for (size_t i = 0; i < length; i++) {
+		uint16_t code = (uint16_t)str[i];
+		Write(&code, sizeof(code));
+	}
+	Align();
+}
+
+bool CommandStreamWriter::Save(const std::string& fileName) {
+	std::ofstream file(fileName, std::ios::binary);
+	if (!file) {
+		return false;
+	}
+	file.write(reinterpret_cast<const char*>(data.data()), data.size());
+	return (bool)file;
+}
+
+bool CommandStreamPlayer::Load(const std::string& fileName, std::vector<uint8_t>& data) {
+	std::ifstream file(fileName, std::ios::binary | std::ios::ate);
+	if (!file) {
+		return false;
+	}
+	data.resize((size_t)file.tellg());
+	file.seekg(0);
+	file.read(reinterpret_cast<char*>(data.data()), data.size());
+	return (bool)file;
+}
+
+bool CommandStreamPlayer::Replay(const std::vector<uint8_t>& data, CommandStreamTarget* target, CommandStreamStatistics* statistics) {
+	auto startTime = std::chrono::steady_clock::now();
+
+	CommandStreamStatistics result = {};
+	result.bytes = data.size();
+
+	const uint8_t* cursor = data.data();
+	const uint8_t* end = cursor + data.size();
+
+	// ϔ4oCgE܂ŋl߂Ă̂ŁAlߕ܂Ŋ܂߂Ċm߂
+	auto remain = [&](size_t size) { return (size_t)(end - cursor) >= ((size + 3) & ~(size_t)3); };
+	auto readU32 = [&]() { uint32_t value; std::memcpy(&value, cursor, sizeof(value)); cursor += sizeof(value); return value; };
+	auto skip = [&](size_t size) { const uint8_t* begin = cursor; cursor += (size + 3) & ~(size_t)3; return begin; };
+
+	if (!remain(8) || readU32() != CommandStreamWriter::MAGIC || readU32() != CommandStreamWriter::VERSION) {
+		return false;
+	}
+
+	// Ԃ̕ω𐔂邽߂̌ݒli0xffffffff͖ݒj
+	uint32_t currentPipeline = 0xffffffff;
+	uint32_t currentHeap = 0xffffffff;
+
+	while (cursor < end) {
+		if (!remain(4)) {
+			return false;
+		}
+
+		switch ((StreamCommand)readU32()) {
+		case StreamCommand::BEGIN_DRAW:
+			currentPipeline = 0xffffffff;
+			currentHeap = 0xffffffff;
+			if (target != nullptr) target->BeginDraw();
+			break;
+
+		case StreamCommand::END_DRAW:
+			result.frames++;
+			if (target != nullptr) target->EndDraw();
+			break;
+
+		case StreamCommand::SET_PIPELINE: {
+			if (!remain(4)) return false;
+			uint32_t pipeline = readU32();
+			result.pipelineSets++;
+			if (pipeline != currentPipeline) {
+				result.pipelineChanges++;
+				currentPipeline = pipeline;
+			}
+			if (target != nullptr) target->SetPipeline(pipeline);
+			break;
+		}
+
+		case StreamCommand::SET_DESCRIPTOR_HEAP: {
+			if (!remain(4)) return false;
+			uint32_t heap = readU32();
+			result.descriptorHeapSets++;
+			if (heap != currentHeap) {
+				result.descriptorHeapChanges++;
+				currentHeap = heap;
+			}
+			if (target != nullptr) target->SetDescriptorHeap(heap);
+			break;
+		}
+
+		case StreamCommand::DEFINE_MESH: {
+			if (!remain(16)) return false;
+			uint32_t mesh = readU32();
+			StreamTopology topology = (StreamTopology)readU32();
+			uint32_t vertexCount = readU32();
+			uint32_t indexCount = readU32();
+			size_t vertexBytes = sizeof(float) * CommandStreamWriter::VERTEX_FLOATS * vertexCount;
+			size_t indexBytes = sizeof(uint16_t) * indexCount;
+			if (!remain(vertexBytes + indexBytes)) return false;
+			auto vertices = reinterpret_cast<const float*>(cursor);
+			auto indices = reinterpret_cast<const uint16_t*>(cursor + vertexBytes);
+			skip(vertexBytes + indexBytes);
+			result.meshDefinitions++;
+			if (target != nullptr) target->DefineMesh(mesh, topology, vertices, vertexCount, indices, indexCount);
+			break;
+		}
+
+		case StreamCommand::DEFINE_TEXTURE: {
+			if (!remain(12)) return false;
+			uint32_t texture = readU32();
+			uint32_t width = readU32();
+			uint32_t height = readU32();
+			// ꂽt@C̋Ȓlint傫̌vZȂ悤Aɔ͈͂m߂
+			if (width == 0 || height == 0 || width > CommandStreamWriter::MAX_TEXTURE_SIZE || height > CommandStreamWriter::MAX_TEXTURE_SIZE) return false;
+			uint64_t bytes = (uint64_t)width * height * 4;
+			if (bytes > (uint64_t)(size_t)-1) return false;
+			size_t size = (size_t)bytes;
+			if (!remain(size)) return false;
+			auto pixels = skip(size);
+			result.textureDefinitions++;
+			if (target != nullptr) target->DefineTexture(texture, (int)width, (int)height, pixels);
+			break;
+		}
+
+		case StreamCommand::BIND_TEXTURE: {
+			if (!remain(4)) return false;
+			uint32_t texture = readU32();
+			result.textureBinds++;
+			if (target != nullptr) target->BindTexture(texture);
+			break;
+		}
+
+		case StreamCommand::DRAW_MESH: {
+			if (!remain(4 + sizeof(float) * 16)) return false;
+			uint32_t mesh = readU32();
+			auto world = reinterpret_cast<const float*>(skip(sizeof(float) * 16));
+			result.draws++;
+			if (target != nullptr) target->DrawMesh(mesh, world);
+			break;
+		}
+
+		case StreamCommand::DRAW_STRING: {
+			if (!remain(4 + sizeof(float) * 6 + 4)) return false;
+			uint32_t font = readU32();
+			auto pos = reinterpret_cast<const float*>(skip(sizeof(float) * 2));
+			auto color = reinterpret_cast<const float*>(skip(sizeof(float) * 4));
+			uint32_t length = readU32();
+			if (!remain(sizeof(uint16_t) * length)) return false;
+			auto chars = reinterpret_cast<const uint16_t*>(skip(sizeof(uint16_t) * length));
+			result.strings++;
+			if (target != nullptr) target->DrawString(font, chars, length, pos, color);
+			break;
+		}
+
+		default:
+			return false;
+		}
+	}
+
+	result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+	if (statistics != nullptr) {
+		*statistics = result;
+	}
+
+	return true;
+}
+
+RasterizerReplayTarget::RasterizerReplayTarget(SoftwareRasterizer* rasterizer) {
+	this->rasterizer = rasterizer;
+}
+
+void RasterizerReplayTarget::BeginDraw() {
+	rasterizer->Clear(0.0f, 0.0f, 0.0f, 1.0f);
+	rasterizer->SetPipeline(RasterPipeline::NORMAL);
+}
+
+void RasterizerReplayTarget::EndDraw() {
+	rasterizer->Flush();
+}
+
+void RasterizerReplayTarget::SetPipeline(uint32_t pipeline) {
+	rasterizer->SetPipeline(pipeline == (uint32_t)RasterPipeline::TEXTURE ? RasterPipeline::TEXTURE : RasterPipeline::NORMAL);
+}
+
+void RasterizerReplayTarget::DefineMesh(uint32_t mesh, StreamTopology topology, const float* vertices, uint32_t vertexCount, const uint16_t* indices, uint32_t indexCount) {
+	meshes[mesh] = { topology, vertices, vertexCount, indices, indexCount };
+}
+
+void RasterizerReplayTarget::DefineTexture(uint32_t texture, int width, int height, const uint8_t* pixels) {
+	textures[texture] = { width, height, pixels };
+}
+
+void RasterizerReplayTarget::BindTexture(uint32_t texture) {
+	auto found = textures.find(texture);
+	if (found == textures.end()) {
+		return;
+	}
+
+	RasterTexture raster;
+	raster.pixels = found->second.pixels;
+	raster.width = found->second.width;
+	raster.height = found->second.height;
+	raster.rowPitch = found->second.width * 4;
+	rasterizer->SetTexture(raster);
+}
+
+void RasterizerReplayTarget::DrawMesh(uint32_t mesh, const float* world) {
+	auto found = meshes.find(mesh);
+	if (found == meshes.end()) {
+		return;
+	}
+
+	const Mesh& data = found->second;
+	auto vertices = reinterpret_cast<const RasterVertex*>(data.vertices);
+	if (data.topology == StreamTopology::LINE_LIST) {
+		rasterizer->DrawLines(vertices, data.vertexCount, world);
+	}
+	else {
+		rasterizer->DrawIndexed(vertices, data.vertexCount, data.indices, data.indexCount, world);
+	}
+}
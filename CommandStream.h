@@ -0,0 +1,136 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// `R}h̃oCi`
+// [wb_[] [(uint32) + ]... ̕тŁAׂ͂4oCgEɑ
+enum class StreamCommand : uint32_t {
+	BEGIN_DRAW = 1,
+	END_DRAW,
+	SET_PIPELINE,
+	SET_DESCRIPTOR_HEAP,
+	DEFINE_MESH,
+	DEFINE_TEXTURE,
+	BIND_TEXTURE,
+	DRAW_MESH,
+	DRAW_STRING,
+};
+
+enum class StreamTopology : uint32_t {
+	TRIANGLE_LIST,
+	LINE_LIST,
+};
+
+typedef struct CommandStreamStatistics {
+	uint64_t frames;
+	uint64_t draws;
+	uint64_t strings;
+	uint64_t pipelineSets;
+	uint64_t pipelineChanges;
+	uint64_t descriptorHeapSets;
+	uint64_t descriptorHeapChanges;
+	uint64_t textureBinds;
+	uint64_t meshDefinitions;
+	uint64_t textureDefinitions;
+	uint64_t bytes;
+	double seconds;
+};
+
+// Đ
+class CommandStreamTarget
+{
+public:
+	virtual ~CommandStreamTarget() {}
+
+	virtual void BeginDraw() {}
+	virtual void EndDraw() {}
+	virtual void SetPipeline(uint32_t /*pipeline*/) {}
+	virtual void SetDescriptorHeap(uint32_t /*heap*/) {}
+	virtual void DefineMesh(uint32_t /*mesh*/, StreamTopology /*topology*/, const float* /*vertices*/, uint32_t /*vertexCount*/, const uint16_t* /*indices*/, uint32_t /*indexCount*/) {}
+	virtual void DefineTexture(uint32_t /*texture*/, int /*width*/, int /*height*/, const uint8_t* /*pixels*/) {}
+	virtual void BindTexture(uint32_t /*texture*/) {}
+	virtual void DrawMesh(uint32_t /*mesh*/, const float* /*world*/) {}
+	virtual void DrawString(uint32_t /*font*/, const uint16_t* /*chars*/, uint32_t /*length*/, const float* /*pos*/, const float* /*color*/) {}
+};
+
+class CommandStreamWriter
+{
+public:
+	static const uint32_t MAGIC = 0x434c474d;	// "MGLC"
+	static const uint32_t VERSION = 1;
+	static const uint32_t VERTEX_FLOATS = 8;	// position(3) + color(3) + uv(2)
+	static const uint32_t MAX_TEXTURE_SIZE = 16384;	// D3D122DeNX`̍ő̕ƍ
+
+private:
+	std::vector<uint8_t> data;
+
+public:
+	CommandStreamWriter();
+
+private:
+	void Write(const void* value, size_t size);
+	void WriteU32(uint32_t value) { Write(&value, sizeof(value)); }
+	void Align();
+
+public:
+	void BeginDraw();
+	void EndDraw();
+	void SetPipeline(uint32_t pipeline);
+	void SetDescriptorHeap(uint32_t heap);
+	void DefineMesh(uint32_t mesh, StreamTopology topology, const float* vertices, uint32_t vertexCount, const uint16_t* indices, uint32_t indexCount);
+	void DefineTexture(uint32_t texture, int width, int height, int rowPitch, const uint8_t* pixels);
+	void BindTexture(uint32_t texture);
+	void DrawMesh(uint32_t mesh, const float* world);
+	void DrawString(uint32_t font, const wchar_t* str, size_t length, const float* pos, const float* color);
+
+	void Clear();
+	bool Save(const std::string& fileName);
+
+	const std::vector<uint8_t>& GetData() { return data; }
+};
+
+class CommandStreamPlayer
+{
+public:
+	static bool Load(const std::string& fileName, std::vector<uint8_t>& data);
+
+	// targetnullptȑꍇ͉͂Ɠvs
+	static bool Replay(const std::vector<uint8_t>& data, CommandStreamTarget* target, CommandStreamStatistics* statistics = nullptr);
+};
+
+// SoftwareRasterizer֍Đ
+class RasterizerReplayTarget : public CommandStreamTarget
+{
+private:
+	typedef struct Mesh {
+		StreamTopology topology;
+		const float* vertices;
+		uint32_t vertexCount;
+		const uint16_t* indices;
+		uint32_t indexCount;
+	};
+
+	typedef struct Image {
+		int width;
+		int height;
+		const uint8_t* pixels;
+	};
+
+	class SoftwareRasterizer* rasterizer;
+	std::unordered_map<uint32_t, Mesh> meshes;
+	std::unordered_map<uint32_t, Image> textures;
+
+public:
+	RasterizerReplayTarget(class SoftwareRasterizer* rasterizer);
+
+	void BeginDraw() override;
+	void EndDraw() override;
+	void SetPipeline(uint32_t pipeline) override;
+	void DefineMesh(uint32_t mesh, StreamTopology topology, const float* vertices, uint32_t vertexCount, const uint16_t* indices, uint32_t indexCount) override;
+	void DefineTexture(uint32_t texture, int width, int height, const uint8_t* pixels) override;
+	void BindTexture(uint32_t texture) override;
+	void DrawMesh(uint32_t mesh, const float* world) override;
+};
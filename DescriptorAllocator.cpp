@@ -0,0 +1,54 @@
+#include "DescriptorAllocator.h"
+#include "FrameRing.h"
+#include "Debugger.h"
+
+std::unique_ptr<DirectX::DescriptorHeap> DescriptorAllocator::heap;
+
+std::unique_ptr<DescriptorIndexAllocator> DescriptorAllocator::allocator;
+
+FrameRing* DescriptorAllocator::frameRing;
+
+void DescriptorAllocator::Initialize(ID3D12Device* device, FrameRing* frameRing, UINT persistentCount, UINT transientCountPerFrame) {
+	DescriptorAllocator::frameRing = frameRing;
+
+	UINT frameCount = frameRing->GetFrameCount();
+	allocator = std::make_unique<DescriptorIndexAllocator>(persistentCount, transientCountPerFrame, frameCount);
+	heap = std::make_unique<DirectX::DescriptorHeap>(device, allocator->GetCapacity());
+}
+
+void DescriptorAllocator::Finalize() {
+	heap.reset();
+	allocator.reset();
+	frameRing = nullptr;
+}
+
+UINT DescriptorAllocator::Allocate(UINT count) {
+	UINT index = allocator->Allocate(count);
+	if (index == DescriptorIndexAllocator::INVALID_INDEX) {
+		Debugger::ErrorCheck(E_OUTOFMEMORY);
+	}
+	return index;
+}
+
+void DescriptorAllocator::Free(UINT index, UINT count) {
+	// RendererɔjĂꍇ▢mۂ̏ꍇ͉Ȃ
+	if (!IsInitialized() || index == DescriptorIndexAllocator::INVALID_INDEX) {
+		return;
+	}
+
+	// ݋L^̃t[I܂ł͍ėpȂ
+	allocator->Free(index, count, frameRing->GetLastSignaledValue() + 1);
+}
+
+UINT DescriptorAllocator::AllocateTransient(UINT count) {
+	UINT index = allocator->AllocateTransient(count);
+	if (index == DescriptorIndexAllocator::INVALID_INDEX) {
+		Debugger::ErrorCheck(E_OUTOFMEMORY);
+	}
+	return index;
+}
+
+void DescriptorAllocator::BeginFrame(UINT frameIndex) {
+	allocator->Reclaim(frameRing->GetCompletedValue());
+	allocator->BeginFrame(frameIndex);
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "DescriptorHeap.h"
+#include "DescriptorIndexAllocator.h"
+
+#include <memory>
+
+// SIuWFNgŋLVF[_[猩CBV/SRV/UAVq[v
+// q[v̓t[̍ŏɈxݒ肵A`ł͔ԍŃfBXNv^QƂ
+class DescriptorAllocator
+{
+private:
+	static std::unique_ptr<DirectX::DescriptorHeap> heap;
+	static std::unique_ptr<DescriptorIndexAllocator> allocator;
+	static class FrameRing* frameRing;
+
+public:
+	/// <summary>
+	/// 
+	/// </summary>
+	/// <param name="device">foCX</param>
+	/// <param name="frameRing">fBXNv^ėpł邩̔Ɏg</param>
+	/// <param name="persistentCount">󂫃XgŊǗ鐔</param>
+	/// <param name="transientCountPerFrame">t[Ƃ̎ĝė̈̐</param>
+	static void Initialize(ID3D12Device* device, class FrameRing* frameRing, UINT persistentCount = 4096, UINT transientCountPerFrame = 1024);
+	static void Finalize();
+	static bool IsInitialized() { return heap != nullptr; }
+
+	static UINT Allocate(UINT count = 1);
+	static void Free(UINT index, UINT count = 1);
+	static UINT AllocateTransient(UINT count = 1);
+
+	/// <summary>
+	/// t[JnɌĂсAGPUgIԍ
+	/// </summary>
+	static void BeginFrame(UINT frameIndex);
+
+	static D3D12_CPU_DESCRIPTOR_HANDLE GetCpuHandle(UINT index) { return heap->GetCpuHandle(index); }
+	static D3D12_GPU_DESCRIPTOR_HANDLE GetGpuHandle(UINT index) { return heap->GetGpuHandle(index); }
+	static ID3D12DescriptorHeap* GetHeap() { return heap->Heap(); }
+
+	static DescriptorIndexAllocator::Statistics GetStatistics() { return allocator->GetStatistics(); }
+};
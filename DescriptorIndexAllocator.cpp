@@ -0,0 +1,139 @@
+#include "DescriptorIndexAllocator.h"
+
+#include <algorithm>
+
+DescriptorIndexAllocator::DescriptorIndexAllocator(uint32_t persistentCount, uint32_t transientCountPerFrame, uint32_t frameCount) {
+	this->persistentCount = persistentCount;
+	this->transientCount = transientCountPerFrame;
+	this->frameCount = frameCount > 0 ? frameCount : 1;
+
+	if (persistentCount > 0) {
+		freeRanges.push_back({ 0, persistentCount });
+	}
+	allocated = 0;
+
+	frameIndex = 0;
+	transientOffset = 0;
+
+	statistics = {};
+}
+
+uint32_t DescriptorIndexAllocator::Allocate(uint32_t count) {
+	// ŏɌ\ȑ傫̋󂫔͈͂؂o
+	for (size_t i = 0; i < freeRanges.size(); i++) {
+		Range& range = freeRanges[i];
+		if (range.count < count) {
+			continue;
+		}
+
+		uint32_t index = range.start;
+		range.start += count;
+		range.count -= count;
+		if (range.count == 0) {
+			freeRanges.erase(freeRanges.begin() + i);
+		}
+
+		allocated += count;
+		statistics.allocations++;
+		return index;
+	}
+
+	statistics.failures++;
+	return INVALID_INDEX;
+}
+
+void DescriptorIndexAllocator::Free(uint32_t index, uint32_t count, uint64_t fenceValue) {
+	if (index == INVALID_INDEX || count == 0) {
+		return;
+	}
+
+	// GPUgI܂ł͍ėpȂ
+	pendingFrees.push_back({ { index, count }, fenceValue });
+}
+
+void DescriptorIndexAllocator::Reclaim(uint64_t completedFenceValue) {
+	size_t kept = 0;
+	for (size_t i = 0; i < pendingFrees.size(); i++) {
+		if (pendingFrees[i].fenceValue <= completedFenceValue) {
+			Release(pendingFrees[i].range);
+			statistics.recycled++;
+		}
+		else {
+			pendingFrees[kept++] = pendingFrees[i];
+		}
+	}
+	pendingFrees.resize(kept);
+}
+
+void DescriptorIndexAllocator::Release(Range range) {
+	allocated -= range.count;
+
+	auto next = std::lower_bound(freeRanges.begin(), freeRanges.end(), range.start,
+		[](const Range& r, uint32_t start) { return r.start < start; });
+
+	// Ő󂫔͈͂ƗאڂĂΌ
+	bool mergePrev = next != freeRanges.begin() && (next - 1)->start + (next - 1)->count == range.start;
+	bool mergeNext = next != freeRanges.end() && range.start + range.count == next->start;
+
+	if (mergePrev && mergeNext) {
+		(next - 1)->count += range.count + next->count;
+		freeRanges.erase(next);
+	}
+	else if (mergePrev) {
+		(next - 1)->count += range.count;
+	}
+	else if (mergeNext) {
+		next->start = range.start;
+		next->count += range.count;
+	}
+	else {
+		freeRanges.insert(next, range);
+	}
+}
+
+void DescriptorIndexAllocator::BeginFrame(uint32_t frameIndex) {
+	this->frameIndex = frameIndex % frameCount;
+	transientOffset = 0;
+}
+
+uint32_t DescriptorIndexAllocator::AllocateTransient(uint32_t count) {
+	// transientOffset + count͑傫countň̂ŁAcƔׂ
+	if (count > transientCount - transientOffset) {
+		statistics.failures++;
+		return INVALID_INDEX;
+	}
+
+	uint32_t index = persistentCount + frameIndex * transientCount + transientOffset;
+	transientOffset += count;
+	statistics.transientPeak = std::max(statistics.transientPeak, transientOffset);
+	return index;
+}
+
+DescriptorIndexAllocator::Statistics DescriptorIndexAllocator::GetStatistics() {
+	Statistics result = statistics;
+	result.capacity = GetCapacity();
+	result.allocated = allocated;
+	result.free = 0;
+	result.largestFreeRange = 0;
+	for (auto& range : freeRanges) {
+		result.free += range.count;
+		result.largestFreeRange = std::max(result.largestFreeRange, range.count);
+	}
+	result.freeRangeCount = (uint32_t)freeRanges.size();
+	result.pending = 0;
+	for (auto& pending : pendingFrees) {
+		result.pending += pending.range.count;
+	}
+	result.transientUsed = transientOffset;
+	return result;
+}
+
+float DescriptorIndexAllocator::GetFragmentation() {
+	uint32_t free = 0;
+	uint32_t largest = 0;
+	for (auto& range : freeRanges) {
+		free += range.count;
+		largest = std::max(largest, range.count);
+	}
+	return free == 0 ? 0.0f : 1.0f - (float)largest / (float)free;
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// fBXNv^q[v̔ԍǗifoCXsvj
+// [0, persistentCount) ͋󂫃XgŊmہEA
+// ̌̓t[Ƃɋ؂ĝĂ̐`mۗ̈ɂ
+class DescriptorIndexAllocator
+{
+public:
+	static const uint32_t INVALID_INDEX = 0xffffffff;
+
+	typedef struct Statistics {
+		uint32_t capacity;
+		uint32_t allocated;
+		uint32_t free;
+		uint32_t pending;
+		uint32_t largestFreeRange;
+		uint32_t freeRangeCount;
+		uint32_t transientUsed;
+		uint32_t transientPeak;
+		uint64_t allocations;
+		uint64_t recycled;
+		uint64_t failures;
+	};
+
+private:
+	typedef struct Range {
+		uint32_t start;
+		uint32_t count;
+	};
+
+	typedef struct PendingFree {
+		Range range;
+		uint64_t fenceValue;
+	};
+
+	uint32_t persistentCount;
+	uint32_t transientCount;
+	uint32_t frameCount;
+
+	// Jnʒuɕׂ󂫔͈
+	std::vector<Range> freeRanges;
+	std::vector<PendingFree> pendingFrees;
+	uint32_t allocated;
+
+	uint32_t frameIndex;
+	uint32_t transientOffset;
+
+	Statistics statistics;
+
+public:
+	DescriptorIndexAllocator(uint32_t persistentCount, uint32_t transientCountPerFrame = 0, uint32_t frameCount = 1);
+
+private:
+	void Release(Range range);
+
+public:
+	uint32_t Allocate(uint32_t count = 1);
+	void Free(uint32_t index, uint32_t count, uint64_t fenceValue);
+	void Reclaim(uint64_t completedFenceValue);
+
+	void BeginFrame(uint32_t frameIndex);
+	uint32_t AllocateTransient(uint32_t count = 1);
+
+	uint32_t GetCapacity() { return persistentCount + transientCount * frameCount; }
+	Statistics GetStatistics();
+
+	// 󂫗eʂ̂ő̘ÄɓȂi0ȂfЉȂj
+	float GetFragmentation();
+};
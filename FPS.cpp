@@ -1,8 +1,6 @@
 #include "FPS.h"
 #include <iostream>
 
-bool FPS::updateFlag;
-
 double FPS::frameRate;
 
 double FPS::deltaTime;
@@ -13,6 +11,26 @@ LARGE_INTEGER FPS::freq;
 
 LARGE_INTEGER FPS::updateTime;
 
+std::unique_ptr<FrameLimiter> FPS::limiter;
+
+LARGE_INTEGER FPS::tickTime;
+
+uint32_t FPS::tickRate;
+
+uint32_t FPS::maxTicks;
+
+int64_t FPS::accumulator;
+
+double FPS::alpha;
+
+uint64_t FPS::updateCount;
+
+uint64_t FPS::frameCount;
+
+uint32_t FPS::frameTicks;
+
+uint64_t FPS::droppedTicks;
+
 void FPS::Initialize(const double _frameRate) {
 	// g̎擾
 	QueryPerformanceFrequency(&freq);
@@ -20,55 +38,129 @@ void FPS::Initialize(const double _frameRate) {
 	// ptH[}XJE^̎擾
 	QueryPerformanceCounter(&updateTime);
 
-	// XVtOTrueɐݒ
-	updateFlag = true;
-
 	// Œ肵t[[g̎wiftHgF60fpsj
 	frameRate = _frameRate;
-}
 
-bool FPS::Run(const std::function<bool()> func) {
-	LARGE_INTEGER nowTime;
+	// t[̊Ԋuۂ^C}[̍쐬
+	limiter = std::make_unique<FrameLimiter>(frameRate);
 
-	// ʍXV
-	if (updateFlag) {
-		// ʍXV^C~ÕptH[}XJE^̎擾
-		QueryPerformanceCounter(&updateTime);
+	// ŒXebv̓t[[gƓ񐔂Ŏn߂
+	SetFixedTimestep((uint32_t)(_frameRate + 0.5));
 
-		// w肵֐̌Ăяo
-		bool runFlag = func();
+	// 񐔂̃Zbg
+	updateCount = 0;
+	frameCount = 0;
+	frameTicks = 0;
+	droppedTicks = 0;
+}
 
-		// stOFalse
-		if (!runFlag) {
-			return false;
-		}
+void FPS::SetFixedTimestep(const uint32_t _tickRate, const uint32_t _maxTicks) {
+	tickRate = _tickRate > 0 ? _tickRate : 1;
+	maxTicks = _maxTicks > 0 ? _maxTicks : 1;
 
-		// ʍXV~߂
-		updateFlag = false;
-	}
+	// ܂Ԃ͒Pʂς̂Ŏ̂Ă
+	accumulator = 0;
+	alpha = 0.0;
+	QueryPerformanceCounter(&tickTime);
+}
+
+bool FPS::Run(const std::function<bool()> func) {
+	LARGE_INTEGER nowTime;
+
+	// ỎʍXV1/frameRatebo܂Ŗđ҂
+	limiter->Wait();
 
 	// ݂̃ptH[}XJE^̎擾
 	QueryPerformanceCounter(&nowTime);
 
-	// ʍXVĂ̎Ԃz
-	if ((((double)nowTime.QuadPart - (double)updateTime.QuadPart) / (double)freq.QuadPart) >= 1.0 / frameRate) {
-		// ʍXVtOTrueɐݒ
-		updateFlag = true;
+	// oߎԂ̌v
+	deltaTime = ((double)nowTime.QuadPart - (double)updateTime.QuadPart) / (double)freq.QuadPart;
+
+	// ۂFPŠv
+	actualFPS = 1.0 / deltaTime;
+
+	// ʍXV^C~ÕptH[}XJE^
+	updateTime = nowTime;
 
-		// oߎԂ̌v
-		deltaTime = ((double)nowTime.QuadPart - (double)updateTime.QuadPart) / (double)freq.QuadPart;
+	// w肵֐̌Ăяo
+	bool runFlag = func();
+	frameCount++;
 
-		// ۂFPŠv
-		actualFPS = 1.0 / deltaTime;
+	// stOFalse
+	if (!runFlag) {
+		return false;
 	}
 
 	return true;
 }
 
+bool FPS::Run(const std::function<bool()> update, const std::function<bool()> render) {
+	return Run([&] {
+		// O̕`悩̌oߎԂ𗭂߂
+		// ̂܂ܗ߂̂ŁAt[ĂXV̉񐔂Ԃ炸Ȃ
+		LARGE_INTEGER nowTime;
+		QueryPerformanceCounter(&nowTime);
+		accumulator += (nowTime.QuadPart - tickTime.QuadPart) * (int64_t)tickRate;
+		tickTime = nowTime;
+
+		// 1񕪗܂邲ƂɍXV
+		uint32_t ticks = 0;
+		while (accumulator >= freq.QuadPart) {
+			// ɒBĉ͎Ăi[͎̕`Ɏzj
+			if (ticks >= maxTicks) {
+				droppedTicks += accumulator / freq.QuadPart;
+				accumulator %= freq.QuadPart;
+				break;
+			}
+
+			if (!update()) {
+				return false;
+			}
+			accumulator -= freq.QuadPart;
+			ticks++;
+			updateCount++;
+		}
+		frameTicks = ticks;
+
+		// ̍XV܂ł̊
+		alpha = (double)accumulator / (double)freq.QuadPart;
+
+		return render();
+	});
+}
+
 double FPS::GetFPS() {
 	return actualFPS;
 }
 
 double FPS::GetDeltaTime() {
 	return deltaTime;
+}
+
+double FPS::GetFixedDeltaTime() {
+	return 1.0 / (double)tickRate;
+}
+
+double FPS::GetAlpha() {
+	return alpha;
+}
+
+uint64_t FPS::GetUpdateCount() {
+	return updateCount;
+}
+
+uint64_t FPS::GetFrameCount() {
+	return frameCount;
+}
+
+uint32_t FPS::GetFrameTicks() {
+	return frameTicks;
+}
+
+uint64_t FPS::GetDroppedTicks() {
+	return droppedTicks;
+}
+
+FrameLimiter::Statistics FPS::GetLimiterStatistics() {
+	return limiter->GetStatistics();
 }
\ No newline at end of file
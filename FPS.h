@@ -1,13 +1,14 @@
 #pragma once
+#include "FrameLimiter.h"
+
+#include <cstdint>
 #include <functional>
+#include <memory>
 #include <windows.h>
 
 class FPS
 {
 private:
-	// ʍXVp̃tO
-	static bool updateFlag;
-
 	// t[[g
 	static double frameRate;
 
@@ -23,6 +24,34 @@ private:
 	// ptH[}XJE^
 	static LARGE_INTEGER updateTime;
 
+	// t[̊Ԋuۂi҂Ԃ͖j
+	static std::unique_ptr<FrameLimiter> limiter;
+
+	// ŒXebvōŌɎԂ𗭂߂ptH[}XJE^
+	static LARGE_INTEGER tickTime;
+
+	// ŒXebv1b̍XV
+	static uint32_t tickRate;
+
+	// 1̕`ōsXV̏
+	static uint32_t maxTicks;
+
+	// ܂ԁiptH[}XJE^̒l~tickRateBg̕1XVj
+	static int64_t accumulator;
+
+	// `̕ԌW
+	static double alpha;
+
+	// ŒXebv̍XV񐔂ƕ`
+	static uint64_t updateCount;
+	static uint64_t frameCount;
+
+	// O̕`܂łɍsXV̉
+	static uint32_t frameTicks;
+
+	// 𒴂Ď̂ĂXV̉
+	static uint64_t droppedTicks;
+
 public:
 	/// <summary>
 	/// 
@@ -32,15 +61,28 @@ public:
 
 	/// <summary>
 	/// FPSŒ
+	/// Õt[1/frameRatebo܂ő҂Ă֐Ă
 	/// </summary>
 	/// <param name="func">s֐</param>
-	
+	/// <returns>siFalse: I@True: sj</returns>
+	static bool Run(const std::function<bool()> func);
+
 	/// <summary>
-	/// FPSŒ
+	/// ŒXebv̍XVƕ`
+	/// `̂тɌoߎԂ𗭂߁A1/tickRatebƂupdateĂłrenderĂ
+	/// updatẻ񐔂ɒB͎̂Ăix߂ƂčXɒx̂hj
 	/// </summary>
-	/// <param name="func">s֐</param>
+	/// <param name="update">XV֐iGetFixedDeltaTimei߂j</param>
+	/// <param name="render">`悷֐iGetAlphaőȌԂƕԂj</param>
 	/// <returns>siFalse: I@True: sj</returns>
-	static bool Run(const std::function<bool()> func);
+	static bool Run(const std::function<bool()> update, const std::function<bool()> render);
+
+	/// <summary>
+	/// ŒXebv̐ݒ
+	/// </summary>
+	/// <param name="_tickRate">1b̍XV񐔁iftHgFt[[gj</param>
+	/// <param name="_maxTicks">1̕`ōsXV̏iftHgF5AŒ1j</param>
+	static void SetFixedTimestep(const uint32_t _tickRate, const uint32_t _maxTicks = 5);
 
 	/// <summary>
 	/// FPS̎擾
@@ -53,4 +95,46 @@ public:
 	/// </summary>
 	/// <returns></returns>
 	static double GetDeltaTime();
+
+	/// <summary>
+	/// ŒXebv1̍XVŐi߂鎞
+	/// </summary>
+	/// <returns></returns>
+	static double GetFixedDeltaTime();
+
+	/// <summary>
+	/// `̕ԌWi0`1jBO̍XV玟̍XV܂ł̂ǂ`
+	/// </summary>
+	/// <returns></returns>
+	static double GetAlpha();
+
+	/// <summary>
+	/// ŒXebv̍XV񐔂擾
+	/// </summary>
+	/// <returns></returns>
+	static uint64_t GetUpdateCount();
+
+	/// <summary>
+	/// `񐔂擾
+	/// </summary>
+	/// <returns></returns>
+	static uint64_t GetFrameCount();
+
+	/// <summary>
+	/// O̕`܂łɍsXV̉񐔂擾
+	/// </summary>
+	/// <returns></returns>
+	static uint32_t GetFrameTicks();
+
+	/// <summary>
+	/// 𒴂Ď̂ĂXV̉񐔂擾
+	/// </summary>
+	/// <returns></returns>
+	static uint64_t GetDroppedTicks();
+
+	/// <summary>
+	/// t[̊Ԋu̗hAĐߖ񂵂CPUԂ擾
+	/// </summary>
+	/// <returns></returns>
+	static FrameLimiter::Statistics GetLimiterStatistics();
 };
\ No newline at end of file
@@ -0,0 +1,197 @@
+#include "FrameLimiter.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#include <mmsystem.h>
+#pragma comment(lib, "winmm.lib")
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+#else
+#include <cerrno>
+#include <ctime>
+#endif
+
+FrameLimiter::FrameLimiter(double frameRate, double spinSeconds) {
+	minimumMargin = (int64_t)(spinSeconds * 1e9);
+	spinMargin = minimumMargin;
+	deadline = 0;
+	lastWake = 0;
+	timer = nullptr;
+	frequency = 0;
+	timerPeriod = 0;
+	maximumMargin = 1000000;
+
+#ifdef _WIN32
+	LARGE_INTEGER freq;
+	QueryPerformanceFrequency(&freq);
+	frequency = freq.QuadPart;
+
+	// x̃^C}[Windows 10 1803ȍ~BȂΕʂ̃^C}[ɂ
+	timer = CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+	if (timer == nullptr) {
+		timer = CreateWaitableTimerExW(nullptr, nullptr, 0, TIMER_ALL_ACCESS);
+
+		// ʂ̃^C}[Sleep͊Ŗ15.6~b݂Ȃ̂ŁAł邾ׂ
+		TIMECAPS caps;
+		if (timeGetDevCaps(&caps, sizeof(caps)) == MMSYSERR_NOERROR && timeBeginPeriod(caps.wPeriodMin) == TIMERR_NOERROR) {
+			timerPeriod = caps.wPeriodMin;
+		}
+
+		// N鎞͍1`2xꂤ̂ŁA͎̕v񂵂đ҂Ă悤ɂ
+		maximumMargin = timerPeriod != 0 ? (int64_t)timerPeriod * 2 * 1000000 : 16000000;
+	}
+#endif
+	if (maximumMargin < minimumMargin) {
+		maximumMargin = minimumMargin;
+	}
+
+	SetFrameRate(frameRate);
+	ResetStatistics();
+}
+
+FrameLimiter::~FrameLimiter() {
+#ifdef _WIN32
+	if (timer != nullptr) {
+		CloseHandle(timer);
+	}
+	if (timerPeriod != 0) {
+		timeEndPeriod(timerPeriod);
+	}
+#endif
+}
+
+int64_t FrameLimiter::Now() {
+#ifdef _WIN32
+	LARGE_INTEGER counter;
+	QueryPerformanceCounter(&counter);
+	// ̂܂10^9{ƈ̂ŕbƒ[ɕ
+	return counter.QuadPart / frequency * 1000000000 + counter.QuadPart % frequency * 1000000000 / frequency;
+#else
+	timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (int64_t)now.tv_sec * 1000000000 + now.tv_nsec;
+#endif
+}
+
+void FrameLimiter::SleepUntil(int64_t time) {
+#ifdef _WIN32
+	int64_t remaining = time - Now();
+	if (remaining <= 0) {
+		return;
+	}
+	if (timer == nullptr) {
+		Sleep((DWORD)(remaining / 1000000));
+		return;
+	}
+	// ̒l͍̑Ύԁi100imbPʁj
+	LARGE_INTEGER due;
+	due.QuadPart = -(remaining / 100);
+	if (SetWaitableTimer(timer, &due, 0, nullptr, nullptr, FALSE)) {
+		WaitForSingleObject(timer, INFINITE);
+	}
+#else
+	timespec target;
+	target.tv_sec = (time_t)(time / 1000000000);
+	target.tv_nsec = (long)(time % 1000000000);
+	// Ύő҂̂ŁAVOiŋNĂ̂܂ܑ҂
+	while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &target, nullptr) == EINTR) {
+	}
+#endif
+}
+
+int64_t FrameLimiter::ThreadCpuTime() {
+#ifdef _WIN32
+	FILETIME creation, exit, kernel, user;
+	if (!GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user)) {
+		return 0;
+	}
+	uint64_t kernelTime = ((uint64_t)kernel.dwHighDateTime << 32) | kernel.dwLowDateTime;
+	uint64_t userTime = ((uint64_t)user.dwHighDateTime << 32) | user.dwLowDateTime;
+	return (int64_t)(kernelTime + userTime) * 100;
+#else
+	timespec now;
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+	return (int64_t)now.tv_sec * 1000000000 + now.tv_nsec;
+#endif
+}
+
+void FrameLimiter::SetFrameRate(double frameRate) {
+	period = (int64_t)(1e9 / frameRate);
+	statistics.targetSeconds = period * 1e-9;
+	deadline = 0;
+}
+
+void FrameLimiter::ResetStatistics() {
+	statistics = {};
+	statistics.targetSeconds = period * 1e-9;
+	statistics.spinMarginSeconds = spinMargin * 1e-9;
+	jitterSum = 0.0;
+}
+
+void FrameLimiter::Wait() {
+	int64_t start = Now();
+	if (deadline == 0) {
+		deadline = start + period;
+		lastWake = start;
+		return;
+	}
+
+	bool late = start >= deadline;
+	if (late) {
+		// ԂɍȂ玟̎琔iZt[ŒǂtƂȂj
+		deadline = start;
+		statistics.lateFrames++;
+	}
+	else {
+		int64_t cpuStart = ThreadCpuTime();
+
+		// ]TcĖ
+		int64_t wakeTarget = deadline - spinMargin;
+		if (start < wakeTarget) {
+			SleepUntil(wakeTarget);
+
+			// Q߂]T𔼕L΂AłȂΏk߂
+			// 1񂾂̑傫ȐQ߂Œ񂵑Ȃ悤AL΂͖̂̐xŌ߂܂
+			int64_t overslept = Now() - wakeTarget;
+			if (overslept > spinMargin) {
+				spinMargin += (overslept - spinMargin) / 2;
+			}
+			else {
+				spinMargin -= (spinMargin - minimumMargin) / 16;
+			}
+			if (spinMargin > maximumMargin) {
+				spinMargin = maximumMargin;
+			}
+		}
+
+		// c͎v񂵂đ҂
+		int64_t spinStart = Now();
+		int64_t now = spinStart;
+		while (now < deadline) {
+			now = Now();
+		}
+
+		statistics.spinSeconds += (now - spinStart > 0 ? now - spinStart : 0) * 1e-9;
+		statistics.waitSeconds += (now - start) * 1e-9;
+		statistics.waitCpuSeconds += (ThreadCpuTime() - cpuStart) * 1e-9;
+		statistics.savedCpuSeconds = statistics.waitSeconds - statistics.waitCpuSeconds;
+	}
+
+	int64_t wake = Now();
+	int64_t interval = wake - lastWake;
+	lastWake = wake;
+	deadline += period;
+
+	statistics.frames++;
+	statistics.lastIntervalSeconds = interval * 1e-9;
+	statistics.spinMarginSeconds = spinMargin * 1e-9;
+	if (!late) {
+		double jitter = (interval > period ? interval - period : period - interval) * 1e-9;
+		jitterSum += jitter;
+		statistics.averageJitterSeconds = jitterSum / (double)(statistics.frames - statistics.lateFrames);
+		if (jitter > statistics.maxJitterSeconds) {
+			statistics.maxJitterSeconds = jitter;
+		}
+	}
+}
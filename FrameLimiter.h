@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+
+// t[̊ԊuɕۂifoCXsvj
+// ̃t[̏O܂ōx^C}[ŖAc1~bv񂵂đ҂
+// vƖWindowsłQueryPerformanceCounterƍx̑ҋ@\^C}[AȊOłclock_gettimeclock_nanosleep
+// x̃^C}[WindowsłtimeBeginPeriodŃ^C}[̐xグA񂵂đ҂Ԃ̏̐xɍ킹
+class FrameLimiter
+{
+public:
+	typedef struct Statistics {
+		uint64_t frames;
+		uint64_t lateFrames;			// ҂ɊԂɍȂt[
+		double targetSeconds;			// ڕW̃t[Ԋu
+		double lastIntervalSeconds;		// Õt[Ԋu
+		double averageJitterSeconds;	// t[ԊuƖڕW̍̕ρiԂɍȂt[j
+		double maxJitterSeconds;
+		double waitSeconds;				// Waitő҂Ԃ̍v
+		double spinSeconds;				// ̂v񂵂đ҂
+		double waitCpuSeconds;			// WaitŎgCPUԁi񂵑ĂwaitSecondsƓɂȂj
+		double savedCpuSeconds;			// waitSeconds - waitCpuSeconds
+		double spinMarginSeconds;		// ̖肩N]T
+	};
+
+private:
+	int64_t period;				// ȉ̎Ԃ̓imb
+	int64_t deadline;			// ̃t[̎B0Ȃ玟WaitŌ߂
+	int64_t lastWake;
+	int64_t minimumMargin;
+	int64_t spinMargin;			// Q߂ɍ킹ĐLяk݂imaximumMargin܂Łj
+	int64_t maximumMargin;		// ̐xŌ܂
+	double jitterSum;
+
+	void* timer;				// Windows̑ҋ@\^C}[
+	int64_t frequency;			// QueryPerformanceFrequency
+	unsigned int timerPeriod;	// timeBeginPeriodŐݒ肵~bB0Ȃݒ肵ĂȂ
+
+	Statistics statistics;
+
+public:
+	/// <summary>
+	/// spinSeconds͍ŌɎv񂵂đ҂ŒZ̎ԁBQ߂悤Ȃ玩ŐL΂
+	/// </summary>
+	FrameLimiter(double frameRate = 60.0, double spinSeconds = 0.0005);
+	~FrameLimiter();
+
+	FrameLimiter(const FrameLimiter&) = delete;
+	FrameLimiter& operator=(const FrameLimiter&) = delete;
+
+private:
+	int64_t Now();
+	void SleepUntil(int64_t time);
+	int64_t ThreadCpuTime();
+
+public:
+	void SetFrameRate(double frameRate);
+
+	/// <summary>
+	/// Õt[1/frameRatebo܂ő҂
+	/// ԂɍȂꍇ͑҂ɖ߂Ãt[̎琔i܂Ƃ߂ĒǂtƂȂj
+	/// </summary>
+	void Wait();
+
+	Statistics GetStatistics() { return statistics; }
+	void ResetStatistics();
+};
@@ -0,0 +1,37 @@
+#include "FrameRing.h"
+
+FrameRing::FrameRing(FrameFence* fence, unsigned int frameCount) {
+	this->fence = fence;
+	fenceValues.resize(frameCount, 0);
+	lastSignaledValue = 0;
+	frameIndex = 0;
+	waitCount = 0;
+}
+
+void FrameRing::BeginFrame(unsigned int index) {
+	frameIndex = index;
+
+	// ̃t[Og̏IĂȂΑ҂
+	if (fence->GetCompletedValue() < fenceValues[index]) {
+		fence->Wait(fenceValues[index]);
+		waitCount++;
+	}
+}
+
+uint64_t FrameRing::EndFrame() {
+	fence->Signal(++lastSignaledValue);
+	fenceValues[frameIndex] = lastSignaledValue;
+
+	return lastSignaledValue;
+}
+
+uint64_t FrameRing::Flush() {
+	fence->Signal(++lastSignaledValue);
+	fence->Wait(lastSignaledValue);
+
+	for (auto& value : fenceValues) {
+		value = lastSignaledValue;
+	}
+
+	return lastSignaledValue;
+}
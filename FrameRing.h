@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// t[ɎgtFX̒ۉ
+// D3D12łQueueFenceAeXgx`}[Nł͋ŨtFX
+class FrameFence
+{
+public:
+	virtual ~FrameFence() {}
+
+	virtual void Signal(uint64_t value) = 0;
+	virtual uint64_t GetCompletedValue() = 0;
+	virtual void Wait(uint64_t value) = 0;
+};
+
+// obNobt@Ƃ̃tFXlǗAėpt[҂
+class FrameRing
+{
+private:
+	FrameFence* fence;
+	std::vector<uint64_t> fenceValues;
+	uint64_t lastSignaledValue;
+	unsigned int frameIndex;
+
+	unsigned int waitCount;
+
+public:
+	FrameRing(FrameFence* fence, unsigned int frameCount);
+
+public:
+	void BeginFrame(unsigned int index);
+	uint64_t EndFrame();
+	uint64_t Flush();
+
+	unsigned int GetFrameCount() { return (unsigned int)fenceValues.size(); }
+	unsigned int GetFrameIndex() { return frameIndex; }
+	uint64_t GetFenceValue(unsigned int index) { return fenceValues[index]; }
+	uint64_t GetLastSignaledValue() { return lastSignaledValue; }
+	uint64_t GetCompletedValue() { return fence->GetCompletedValue(); }
+	bool IsFrameComplete(unsigned int index) { return fence->GetCompletedValue() >= fenceValues[index]; }
+
+	unsigned int GetWaitCount() { return waitCount; }
+};
+
+// GPUgI܂ŎȂ̂AgItFXlƈꏏɗa
+// al͑Ȃ̂ŁA擪珇Ɏ
+template <typename T>
+class FrameRetireList
+{
+private:
+	typedef struct Entry {
+		T object;
+		uint64_t fenceValue;
+	};
+
+	std::vector<Entry> entries;
+
+public:
+	/// <summary>
+	/// fenceValue܂GPȔI܂ŗaiL^̃t[ȂGetLastSignaledValue() + 1j
+	/// </summary>
+	void Retire(T object, uint64_t fenceValue) {
+		entries.push_back({ std::move(object), fenceValue });
+	}
+
+	/// <summary>
+	/// ÎA̐Ԃ
+	/// </summary>
+	size_t Release(uint64_t completedValue) {
+		size_t count = 0;
+		while (count < entries.size() && entries[count].fenceValue <= completedValue) {
+			count++;
+		}
+		entries.erase(entries.begin(), entries.begin() + count);
+		return count;
+	}
+
+	void Clear() { entries.clear(); }
+	size_t GetCount() { return entries.size(); }
+};
@@ -0,0 +1,250 @@
+#include "HashedGrid.h"
+
+#include <cmath>
+
+HashedGrid::HashedGrid(float cellSize) {
+	this->cellSize = cellSize;
+	inverseCellSize = 1.0f / cellSize;
+	stamp = 0;
+
+	minCellX = 0;
+	minCellY = 0;
+	maxCellX = -1;
+	maxCellY = -1;
+
+	// 0Ԃ̓Z傫̂̈ꗗ
+	cells.push_back({ 0, 0, 0, {} });
+	statistics.cells = 1;
+}
+
+bool HashedGrid::IsLarge(const Box& box) {
+	// ͈͂̊OiNaNȂǁjASZ̈ʒuŕ\Ȃقǉ̂傫̂ƂĈ
+	float centerX = (box.minX + box.maxX) * 0.5f * inverseCellSize;
+	float centerY = (box.minY + box.maxY) * 0.5f * inverseCellSize;
+	return !(box.maxX - box.minX <= cellSize && box.maxY - box.minY <= cellSize &&
+		std::fabs(centerX) < (float)MAX_CELL && std::fabs(centerY) < (float)MAX_CELL);
+}
+
+int32_t HashedGrid::ToCell(float position) {
+	// ͈͂̊OiNaN܂ށjint32_tɕϊƖ`Ȃ̂ŁAɔ͈͂֎߂
+	float scaled = position * inverseCellSize;
+	if (!(scaled > (float)-MAX_CELL)) {
+		return -MAX_CELL;
+	}
+	if (!(scaled < (float)MAX_CELL)) {
+		return MAX_CELL;
+	}
+
+	// std::floor͊֐ĂяoɂȂ邱Ƃ̂ŁA؂̂ĂĂ畉̕ɒ
+	int32_t cell = (int32_t)scaled;
+	return (float)cell > scaled ? cell - 1 : cell;
+}
+
+void HashedGrid::GetCell(const Box& box, int32_t& x, int32_t& y) {
+	x = ToCell((box.minX + box.maxX) * 0.5f);
+	y = ToCell((box.minY + box.maxY) * 0.5f);
+}
+
+uint32_t HashedGrid::FindCell(int32_t x, int32_t y) {
+	auto found = cellIndices.find(MakeKey(x, y));
+	if (found != cellIndices.end()) {
+		return found->second;
+	}
+
+	uint32_t index = (uint32_t)cells.size();
+	cells.push_back({ x, y, stamp, {} });
+	cellIndices.emplace(MakeKey(x, y), index);
+	statistics.cells++;
+
+	if (maxCellX < minCellX) {
+		minCellX = maxCellX = x;
+		minCellY = maxCellY = y;
+	}
+	minCellX = x < minCellX ? x : minCellX;
+	minCellY = y < minCellY ? y : minCellY;
+	maxCellX = x > maxCellX ? x : maxCellX;
+	maxCellY = y > maxCellY ? y : maxCellY;
+	return index;
+}
+
+void HashedGrid::Link(uint32_t id) {
+	Object& object = objects[id];
+	uint32_t cell = LARGE_CELL;
+	object.cellKey = 0;
+	if (!IsLarge(object.box)) {
+		int32_t x, y;
+		GetCell(object.box, x, y);
+		cell = FindCell(x, y);
+		object.cellKey = MakeKey(x, y);
+	}
+
+	object.cell = cell;
+	object.slot = (uint32_t)cells[cell].objects.size();
+	cells[cell].objects.push_back(id);
+}
+
+void HashedGrid::Unlink(uint32_t id) {
+	// Ō̗vf󂢂ʒuɈڂ
+	Cell& cell = cells[objects[id].cell];
+	uint32_t slot = objects[id].slot;
+	uint32_t last = cell.objects.back();
+	cell.objects[slot] = last;
+	objects[last].slot = slot;
+	cell.objects.pop_back();
+}
+
+void HashedGrid::Relink(uint32_t id) {
+	// Ẑ܂܂Ȃ甠̏ōς
+	const Object& object = objects[id];
+	bool large = IsLarge(object.box);
+	uint64_t key = 0;
+	if (!large) {
+		int32_t x, y;
+		GetCell(object.box, x, y);
+		key = MakeKey(x, y);
+	}
+	if (large == (object.cell == LARGE_CELL) && key == object.cellKey) {
+		return;
+	}
+
+	Unlink(id);
+	Link(id);
+	statistics.relinks++;
+}
+
+void HashedGrid::GatherCell(const Cell& cell, const Box& box, std::vector<uint32_t>& result) {
+	for (auto id : cell.objects) {
+		if (Overlaps(objects[id].box, box)) {
+			result.push_back(id);
+		}
+	}
+	statistics.tested += cell.objects.size();
+}
+
+void HashedGrid::Gather(const Box& box, std::vector<uint32_t>& result) {
+	GatherCell(cells[LARGE_CELL], box, result);
+
+	// Zɒû͒SZ̔܂ł͂ݏoȂ
+	float margin = cellSize * 0.5f;
+	int32_t x0 = ToCell(box.minX - margin);
+	int32_t y0 = ToCell(box.minY - margin);
+	int32_t x1 = ToCell(box.maxX + margin);
+	int32_t y1 = ToCell(box.maxY + margin);
+	x0 = x0 > minCellX ? x0 : minCellX;
+	y0 = y0 > minCellY ? y0 : minCellY;
+	x1 = x1 < maxCellX ? x1 : maxCellX;
+	y1 = y1 < maxCellY ? y1 : maxCellY;
+	if (x0 > x1 || y0 > y1) {
+		return;
+	}
+
+	// ͈͂̃Z̐gĂZ葽΁AS̃Z𒲂ׂ
+	if ((uint64_t)(x1 - x0 + 1) * (uint64_t)(y1 - y0 + 1) >= cells.size()) {
+		for (uint32_t i = 1; i < cells.size(); i++) {
+			const Cell& cell = cells[i];
+			if (cell.x >= x0 && cell.x <= x1 && cell.y >= y0 && cell.y <= y1) {
+				GatherCell(cell, box, result);
+			}
+		}
+		return;
+	}
+
+	for (int32_t y = y0; y <= y1; y++) {
+		for (int32_t x = x0; x <= x1; x++) {
+			auto found = cellIndices.find(MakeKey(x, y));
+			if (found != cellIndices.end()) {
+				GatherCell(cells[found->second], box, result);
+			}
+		}
+	}
+}
+
+void HashedGrid::GatherCellRay(Cell& cell, const Ray2D& ray, std::vector<RayHit>& result) {
+	if (cell.stamp == stamp) {
+		return;
+	}
+	cell.stamp = stamp;
+
+	for (auto id : cell.objects) {
+		float distance;
+		if (IntersectRay(ray, objects[id].box, distance)) {
+			result.push_back({ id, distance });
+		}
+	}
+	statistics.tested += cell.objects.size();
+}
+
+void HashedGrid::GatherRay(const Ray2D& ray, std::vector<RayHit>& result) {
+	stamp++;
+	GatherCellRay(cells[LARGE_CELL], ray, result);
+	if (maxCellX < minCellX) {
+		return;
+	}
+
+	// gƂ̂Zi͂ݏoƂĎ1ZLj͈̔͂ɓĂԂH
+	Box used = {
+		(float)(minCellX - 1) * cellSize, (float)(minCellY - 1) * cellSize,
+		(float)(maxCellX + 2) * cellSize, (float)(maxCellY + 2) * cellSize
+	};
+	float enter;
+	if (!IntersectRay(ray, used, enter)) {
+		return;
+	}
+	float exit = ray.maxDistance;
+	if (ray.directionX != 0.0f) {
+		float distance = ((ray.directionX > 0.0f ? used.maxX : used.minX) - ray.originX) / ray.directionX;
+		exit = distance < exit ? distance : exit;
+	}
+	if (ray.directionY != 0.0f) {
+		float distance = ((ray.directionY > 0.0f ? used.maxY : used.minY) - ray.originY) / ray.directionY;
+		exit = distance < exit ? distance : exit;
+	}
+
+	// HZ̐gĂZ葽΁AS̃Z𒲂ׂ
+	// iɗꂽ̂ƁÃZXƒH邱ƂɂȂj
+	float steps = (exit - enter) * (std::fabs(ray.directionX) + std::fabs(ray.directionY)) * inverseCellSize;
+	if (!(steps < (float)cells.size())) {
+		for (uint32_t i = 1; i < cells.size(); i++) {
+			GatherCellRay(cells[i], ray, result);
+		}
+		return;
+	}
+
+	// ZɒHDDABׂ̂͗̃Zɂ͂ݏoĂ̂ŁA3x3̃Zׂ
+	float startX = ray.originX + ray.directionX * enter;
+	float startY = ray.originY + ray.directionY * enter;
+	int32_t x = ToCell(startX);
+	int32_t y = ToCell(startY);
+	int32_t stepX = ray.directionX > 0.0f ? 1 : -1;
+	int32_t stepY = ray.directionY > 0.0f ? 1 : -1;
+	float deltaX = ray.directionX != 0.0f ? std::fabs(cellSize / ray.directionX) : INFINITY;
+	float deltaY = ray.directionY != 0.0f ? std::fabs(cellSize / ray.directionY) : INFINITY;
+	float nextX = ray.directionX != 0.0f ? enter + ((float)(x + (stepX > 0 ? 1 : 0)) * cellSize - startX) / ray.directionX : INFINITY;
+	float nextY = ray.directionY != 0.0f ? enter + ((float)(y + (stepY > 0 ? 1 : 0)) * cellSize - startY) / ray.directionY : INFINITY;
+
+	// H񐔂͋Ԃ؂Z̐܂łȂ̂ŁA덷Ői܂ȂȂĂ~܂
+	uint32_t remaining = (uint32_t)steps + 4;
+	while (remaining-- > 0) {
+		for (int32_t dy = -1; dy <= 1; dy++) {
+			for (int32_t dx = -1; dx <= 1; dx++) {
+				auto found = cellIndices.find(MakeKey(x + dx, y + dy));
+				if (found != cellIndices.end()) {
+					GatherCellRay(cells[found->second], ray, result);
+				}
+			}
+		}
+
+		float next = nextX < nextY ? nextX : nextY;
+		if (next > exit) {
+			break;
+		}
+		if (nextX < nextY) {
+			x += stepX;
+			nextX += deltaX;
+		}
+		else {
+			y += stepY;
+			nextY += deltaY;
+		}
+	}
+}
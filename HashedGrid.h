@@ -0,0 +1,57 @@
+#pragma once
+
+#include "SpatialIndex.h"
+
+#include <unordered_map>
+
+// ̑傫̃ZɕAgĂZnbVŎObh
+// ̂͒ŜZɒuA͈̔͂Z̔Lėׂ̃Zɂ͂ݏoE
+// Z傫̂ƁASZ̈ʒu͈̔͂̊Oɂ镨͕̂ʂ̈ꗗɒuÂтɂׂĒׂ
+class HashedGrid : public SpatialIndex
+{
+private:
+	static const uint32_t LARGE_CELL = 0;
+	// Z̈ʒu͈̔́Bׂ̃Z1̈ʒuvZĂȂ悤Aint32_t̔ɗ߂
+	static const int32_t MAX_CELL = 1 << 30;
+
+	typedef struct Cell {
+		int32_t x;
+		int32_t y;
+		uint32_t stamp;			// ČœZxׂȂ߂̈
+		std::vector<uint32_t> objects;
+	};
+
+	float cellSize;
+	float inverseCellSize;
+	std::vector<Cell> cells;
+	std::unordered_map<uint64_t, uint32_t> cellIndices;
+	uint32_t stamp;
+
+	// gƂ̂Z͈̔́iCł؂̂Ɏgj
+	int32_t minCellX;
+	int32_t minCellY;
+	int32_t maxCellX;
+	int32_t maxCellY;
+
+public:
+	/// <summary>
+	/// cellSize͑̂̑̕傫菭傫炢ɂ
+	/// </summary>
+	HashedGrid(float cellSize = 128.0f);
+
+private:
+	static uint64_t MakeKey(int32_t x, int32_t y) { return ((uint64_t)(uint32_t)x << 32) | (uint32_t)y; }
+	bool IsLarge(const Box& box);
+	int32_t ToCell(float position);
+	void GetCell(const Box& box, int32_t& x, int32_t& y);
+	uint32_t FindCell(int32_t x, int32_t y);
+	void GatherCell(const Cell& cell, const Box& box, std::vector<uint32_t>& result);
+	void GatherCellRay(Cell& cell, const Ray2D& ray, std::vector<RayHit>& result);
+
+protected:
+	void Link(uint32_t id) override;
+	void Unlink(uint32_t id) override;
+	void Relink(uint32_t id) override;
+	void Gather(const Box& box, std::vector<uint32_t>& result) override;
+	void GatherRay(const Ray2D& ray, std::vector<RayHit>& result) override;
+};
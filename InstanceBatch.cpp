@@ -0,0 +1,77 @@
+#include "InstanceBatch.h"
+#include "Box.h"
+#include "Circle.h"
+#include "Triangle.h"
+
+#include "GraphicsMemory.h"
+
+#include <cstring>
+
+InstanceBatch::InstanceBatch(ID3D12Device* device) {
+	// 傫1̐}`baseSizeŊg傷ƌ̐}`Ɠ`ɂȂ
+	meshes[(int)ShapeType::BOX] = std::make_unique<Box>(0, 0, 1, 1, device);
+	meshes[(int)ShapeType::CIRCLE] = std::make_unique<Circle>(0, 0, 1, device);
+	meshes[(int)ShapeType::TRIANGLE] = std::make_unique<Triangle>(0, 0, 1, device);
+
+	statistics = {};
+}
+
+InstanceBatch::~InstanceBatch() {
+
+}
+
+void InstanceBatch::Add(ShapeType type, DirectX::FXMMATRIX world, DirectX::XMFLOAT4 color, DirectX::XMFLOAT4 uvRect) {
+	InstanceData data;
+	DirectX::XMStoreFloat4x4(&data.world, world);
+	data.color = color;
+	data.uvRect = uvRect;
+
+	instances[(int)type].push_back(data);
+}
+
+bool InstanceBatch::Add(Shape* shape) {
+	if (shape->GetShapeType() == ShapeType::CUSTOM) {
+		return false;
+	}
+
+	auto color = shape->GetColor();
+	Add(shape->GetShapeType(), shape->GetInstanceMatrix(), DirectX::XMFLOAT4(color.x, color.y, color.z, 1.0f));
+	return true;
+}
+
+void InstanceBatch::Flush(ID3D12GraphicsCommandList* cmdList) {
+	for (int i = 0; i < TYPE_COUNT; i++) {
+		if (instances[i].empty() || meshes[i] == nullptr) {
+			continue;
+		}
+
+		// CX^Xobt@GraphicsMemorỹt[Ƃ̗̈g
+		auto size = sizeof(InstanceData) * instances[i].size();
+		auto buffer = DirectX::GraphicsMemory::Get().Allocate(size);
+		std::memcpy(buffer.Memory(), instances[i].data(), size);
+
+		D3D12_VERTEX_BUFFER_VIEW view = {};
+		view.BufferLocation = buffer.GpuAddress();
+		view.SizeInBytes = (UINT)size;
+		view.StrideInBytes = sizeof(InstanceData);
+
+		meshes[i]->DrawInstanced(cmdList, view, (UINT)instances[i].size());
+
+		statistics.instances += instances[i].size();
+		statistics.drawCalls++;
+
+		instances[i].clear();
+	}
+}
+
+bool InstanceBatch::IsEmpty() {
+	return GetCount() == 0;
+}
+
+size_t InstanceBatch::GetCount() {
+	size_t count = 0;
+	for (int i = 0; i < TYPE_COUNT; i++) {
+		count += instances[i].size();
+	}
+	return count;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "Shape.h"
+
+#include <d3d12.h>
+#include <DirectXMath.h>
+
+#include <memory>
+#include <vector>
+
+// BoxECircleETriangleނƂ1DrawIndexedInstancedł܂Ƃ߂ĕ`悷
+// PʃbV͎ނƂ1AsEFEUV͈̔͂̓t[Ƃ̃CX^Xobt@ɏ
+class InstanceBatch
+{
+public:
+	static const int TYPE_COUNT = 4;	// ShapeType̐
+
+	// InstancedVertexShader.hlsl̓͂ƓCAEg
+	typedef struct InstanceData {
+		DirectX::XMFLOAT4X4 world;
+		DirectX::XMFLOAT4 color;
+		DirectX::XMFLOAT4 uvRect;	// xy: Jnʒu  zw: 傫
+	};
+
+	typedef struct Statistics {
+		uint64_t instances;
+		uint64_t drawCalls;
+	};
+
+private:
+	std::unique_ptr<Shape> meshes[TYPE_COUNT];
+	std::vector<InstanceData> instances[TYPE_COUNT];
+
+	Statistics statistics;
+
+public:
+	InstanceBatch(ID3D12Device* device);
+	~InstanceBatch();
+
+	void Add(ShapeType type, DirectX::FXMMATRIX world, DirectX::XMFLOAT4 color = DirectX::XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f), DirectX::XMFLOAT4 uvRect = DirectX::XMFLOAT4(0.0f, 0.0f, 1.0f, 1.0f));
+
+	/// <summary>
+	/// }`̍sƐFŃCX^Xǉ
+	/// </summary>
+	/// <returns>CUSTOM̐}`͂܂Ƃ߂Ȃ̂false</returns>
+	bool Add(Shape* shape);
+
+	/// <summary>
+	/// ߂CX^XނƂɕ`悷
+	/// pCvC͌ĂяoŃCX^X`p̂̂ݒ肵Ă
+	/// </summary>
+	void Flush(ID3D12GraphicsCommandList* cmdList);
+
+	bool IsEmpty();
+	size_t GetCount();
+
+	Statistics GetStatistics() { return statistics; }
+	void ResetStatistics() { statistics = {}; }
+};
@@ -0,0 +1,13 @@
+#include "BasicShaderHeader.hlsli"
+
+Output InstancedVS(float4 pos : POSITION, float3 color : COLOR, float2 uv : TEXCOORD,
+    float4 world0 : WORLD0, float4 world1 : WORLD1, float4 world2 : WORLD2, float4 world3 : WORLD3,
+    float4 tint : TINT, float4 uvRect : UVRECT)
+{
+    Output output;
+    matrix instanceWorld = matrix(world0, world1, world2, world3);
+    output.pos = mul(view, mul(pos, instanceWorld));
+    output.color = color * tint.rgb;
+    output.uv = uvRect.xy + uv * uvRect.zw;
+	return output;
+}
\ No newline at end of file
@@ -1,6 +1,8 @@
 #include "Line.h"
-#include "d3dx12.h"
-#include "Debugger.h"
+#include "GraphicsMemory.h"
+#include "RenderBackend.h"
+
+#include <algorithm>
 
 Line::Line(float x1, float y1, float x2, float y2, ID3D12Device* device) {
 	vertices.emplace_back();
@@ -14,60 +16,45 @@ Line::Line(float x1, float y1, float x2, float y2, ID3D12Device* device) {
 	vertices[1].color = vertices[0].color;
 	vertices[1].uv = DirectX::XMFLOAT2(1, 0);
 
+	position = DirectX::XMMatrixTranslation(x1, y1, 0);
+	rotate = DirectX::XMMatrixIdentity();
+	scale = DirectX::XMMatrixIdentity();
+
+	vertexBuffer = {};
+	if (device == nullptr) {
+		verticesMap = nullptr;
+		return;
+	}
+
 	CreateVertexBufferView(device);
-	CreateTransform(device);
-	*world = DirectX::XMMatrixTranslation(x1, y1, 0);
 }
 
 Line::~Line() {
-
+	ResourceAllocator::FreeBuffer(vertexBuffer);
 }
 
 void Line::CreateVertexBufferView(ID3D12Device* device) {
 	auto size = sizeof(VertexData) * vertices.size();
 
-	D3D12_HEAP_PROPERTIES heapprop = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD);
-	D3D12_RESOURCE_DESC resdesc = CD3DX12_RESOURCE_DESC::Buffer(size);
-	Debugger::ErrorCheck(device->CreateCommittedResource(&heapprop, D3D12_HEAP_FLAG_NONE, &resdesc, D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(vertexBuffer.ReleaseAndGetAddressOf())));
+	vertexBuffer = ResourceAllocator::AllocateBuffer(size);
 
-	verticesMap = nullptr;
-	Debugger::ErrorCheck(vertexBuffer->Map(0, nullptr, (void**)&verticesMap));
+	verticesMap = reinterpret_cast<VertexData*>(vertexBuffer.cpuAddress);
 	std::copy(std::begin(vertices), std::end(vertices), verticesMap);
 
-	vertexBufferView.BufferLocation = vertexBuffer->GetGPUVirtualAddress();
+	vertexBufferView.BufferLocation = vertexBuffer.gpuAddress;
 	vertexBufferView.SizeInBytes = size;
 	vertexBufferView.StrideInBytes = sizeof(VertexData);
 }
 
-void Line::CreateTransform(ID3D12Device* device) {
-	D3D12_HEAP_PROPERTIES heapprop = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD);
-	D3D12_RESOURCE_DESC resourceDesc = CD3DX12_RESOURCE_DESC::Buffer((sizeof(DirectX::XMMATRIX) + 0xff) & ~0xff);
-
-	Debugger::ErrorCheck(device->CreateCommittedResource(&heapprop, D3D12_HEAP_FLAG_NONE, &resourceDesc, D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(constBuffer.ReleaseAndGetAddressOf())));
-
-	Debugger::ErrorCheck(constBuffer->Map(0, nullptr, (void**)&world));
-	*world = DirectX::XMMatrixIdentity();
-
-	D3D12_DESCRIPTOR_HEAP_DESC descriptorHeapDesc = {};
-	descriptorHeapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
-	descriptorHeapDesc.NodeMask = 0;
-	descriptorHeapDesc.NumDescriptors = 1;
-	descriptorHeapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
-
-	Debugger::ErrorCheck(device->CreateDescriptorHeap(&descriptorHeapDesc, IID_PPV_ARGS(worldDescriptorHeap.ReleaseAndGetAddressOf())));
-
-	D3D12_CONSTANT_BUFFER_VIEW_DESC constantBufferViewDesc = {};
-	constantBufferViewDesc.BufferLocation = constBuffer->GetGPUVirtualAddress();
-	constantBufferViewDesc.SizeInBytes = constBuffer->GetDesc().Width;
-
-	device->CreateConstantBufferView(&constantBufferViewDesc, worldDescriptorHeap->GetCPUDescriptorHandleForHeapStart());
-}
-
 void Line::Draw(ID3D12GraphicsCommandList* cmdList) {
-	cmdList->SetDescriptorHeaps(1, worldDescriptorHeap.GetAddressOf());
-	cmdList->SetGraphicsRootDescriptorTable(1, worldDescriptorHeap->GetGPUDescriptorHandleForHeapStart());
+	auto world = DirectX::GraphicsMemory::Get().AllocateConstant(GetWorldMatrix());
+	cmdList->SetGraphicsRootConstantBufferView(1, world.GpuAddress());
 
 	cmdList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_LINELIST);
 	cmdList->IASetVertexBuffers(0, 1, &vertexBufferView);
 	cmdList->DrawInstanced(2, 1, 0, 0);
+}
+
+void Line::Draw(RenderBackend* backend) {
+	backend->DrawLine(this);
 }
\ No newline at end of file
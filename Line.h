@@ -1,5 +1,7 @@
 #pragma once
 
+#include "ResourceAllocator.h"
+
 #include <d3d12.h>
 #include <DirectXMath.h>
 #include <vector>
@@ -16,13 +18,9 @@ public:
 
 private:
 	std::vector<VertexData> vertices;
-	Microsoft::WRL::ComPtr<ID3D12Resource> vertexBuffer = nullptr;
+	ResourceAllocator::BufferRange vertexBuffer;
 	D3D12_VERTEX_BUFFER_VIEW vertexBufferView;
 
-	Microsoft::WRL::ComPtr<ID3D12Resource> constBuffer;
-	Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> worldDescriptorHeap;
-	DirectX::XMMATRIX* world;
-
 	VertexData* verticesMap;
 
 	DirectX::XMMATRIX position;
@@ -33,10 +31,16 @@ public:
 	Line(float x1, float y1, float x2, float y2, ID3D12Device* device);
 	~Line();
 
+	Line(const Line&) = delete;
+	Line& operator=(const Line&) = delete;
+
 private:
 	void CreateVertexBufferView(ID3D12Device* device);
-	void CreateTransform(ID3D12Device* device);
 
 public:
 	void Draw(ID3D12GraphicsCommandList* cmdList);
+	void Draw(class RenderBackend* backend);
+
+	DirectX::XMMATRIX GetWorldMatrix() { return scale * rotate * position; }
+	const std::vector<VertexData>& GetVertices() { return vertices; }
 };
\ No newline at end of file
@@ -0,0 +1,179 @@
+#include "LooseQuadtree.h"
+
+#include <cstring>
+
+LooseQuadtree::LooseQuadtree(const Box& world, uint32_t maxDepth) {
+	this->world = world;
+	this->maxDepth = maxDepth < 15 ? maxDepth : 15;
+
+	// `Ƃĕ
+	float width = world.maxX - world.minX;
+	float height = world.maxY - world.minY;
+	worldSize = width > height ? width : height;
+
+	Node root = {};
+	for (auto& child : root.children) {
+		child = INVALID_ID;
+	}
+	root.parent = INVALID_ID;
+	nodes.push_back(root);
+	statistics.cells = 1;
+}
+
+void LooseQuadtree::Locate(const Box& box, uint32_t& level, int32_t& x, int32_t& y) {
+	float centerX = (box.minX + box.maxX) * 0.5f;
+	float centerY = (box.minY + box.maxY) * 0.5f;
+	float size = box.maxX - box.minX > box.maxY - box.minY ? box.maxX - box.minX : box.maxY - box.minY;
+
+	// ͈͂̊OA͈͂傫͍̂ɒu
+	level = 0;
+	x = 0;
+	y = 0;
+	if (!(centerX >= world.minX && centerX < world.minX + worldSize && centerY >= world.minY && centerY < world.minY + worldSize) || !(size <= worldSize)) {
+		return;
+	}
+
+	// Z̑傫sizeȏɂȂԐ[xi邢͈͂͒SZ̑傫܂ōL̂Ŏ܂j
+	if (size <= 0.0f) {
+		level = maxDepth;
+	}
+	else {
+		// floor(log2(worldSize / size))float̎wi1ȏȂ̂ŐKj
+		float ratio = worldSize / size;
+		uint32_t bits;
+		std::memcpy(&bits, &ratio, sizeof(bits));
+		int exponent = (int)((bits >> 23) & 0xff) - 127;
+		level = exponent < 0 ? 0 : ((uint32_t)exponent < maxDepth ? (uint32_t)exponent : maxDepth);
+	}
+
+	int32_t cells = 1 << level;
+	float scale = (float)cells / worldSize;
+	x = (int32_t)((centerX - world.minX) * scale);
+	y = (int32_t)((centerY - world.minY) * scale);
+	x = x < 0 ? 0 : (x >= cells ? cells - 1 : x);
+	y = y < 0 ? 0 : (y >= cells ? cells - 1 : y);
+}
+
+uint32_t LooseQuadtree::FindNode(uint32_t level, int32_t x, int32_t y) {
+	// Z̈ʒũrbgォHAm[h͍
+	uint32_t node = 0;
+	for (uint32_t depth = 1; depth <= level; depth++) {
+		uint32_t shift = level - depth;
+		uint32_t child = ((x >> shift) & 1) | (((y >> shift) & 1) << 1);
+		if (nodes[node].children[child] == INVALID_ID) {
+			Node created = {};
+			for (auto& grandChild : created.children) {
+				grandChild = INVALID_ID;
+			}
+			created.parent = node;
+			created.level = depth;
+			created.x = x >> shift;
+			created.y = y >> shift;
+			nodes[node].children[child] = (uint32_t)nodes.size();
+			nodes.push_back(std::move(created));
+			statistics.cells++;
+		}
+		node = nodes[node].children[child];
+	}
+	return node;
+}
+
+void LooseQuadtree::AddCount(uint32_t node, int32_t delta) {
+	for (; node != INVALID_ID; node = nodes[node].parent) {
+		nodes[node].count += delta;
+	}
+}
+
+SpatialIndex::Box LooseQuadtree::GetLooseBox(const Node& node) {
+	float cellSize = worldSize / (float)(1 << node.level);
+	float minX = world.minX + (float)node.x * cellSize;
+	float minY = world.minY + (float)node.y * cellSize;
+	float margin = cellSize * 0.5f;
+	return { minX - margin, minY - margin, minX + cellSize + margin, minY + cellSize + margin };
+}
+
+void LooseQuadtree::Link(uint32_t id) {
+	uint32_t level;
+	int32_t x, y;
+	Locate(objects[id].box, level, x, y);
+
+	uint32_t node = FindNode(level, x, y);
+	objects[id].cellKey = MakeKey(level, x, y);
+	objects[id].cell = node;
+	objects[id].slot = (uint32_t)nodes[node].objects.size();
+	nodes[node].objects.push_back(id);
+	AddCount(node, 1);
+}
+
+void LooseQuadtree::Unlink(uint32_t id) {
+	// Ō̗vf󂢂ʒuɈڂ
+	Node& node = nodes[objects[id].cell];
+	uint32_t slot = objects[id].slot;
+	uint32_t last = node.objects.back();
+	node.objects[slot] = last;
+	objects[last].slot = slot;
+	node.objects.pop_back();
+	AddCount(objects[id].cell, -1);
+}
+
+void LooseQuadtree::Relink(uint32_t id) {
+	uint32_t level;
+	int32_t x, y;
+	Locate(objects[id].box, level, x, y);
+
+	// m[ĥ܂܂Ȃ甠̏ōς
+	if (objects[id].cellKey == MakeKey(level, x, y)) {
+		return;
+	}
+
+	Unlink(id);
+	Link(id);
+	statistics.relinks++;
+}
+
+void LooseQuadtree::Gather(const Box& box, std::vector<uint32_t>& result) {
+	// ͔͈͂̊Ô̕̂ŏɒׂ
+	stack.clear();
+	stack.push_back(0);
+	while (!stack.empty()) {
+		const Node& node = nodes[stack.back()];
+		stack.pop_back();
+
+		for (auto id : node.objects) {
+			if (Overlaps(objects[id].box, box)) {
+				result.push_back(id);
+			}
+		}
+		statistics.tested += node.objects.size();
+
+		for (auto child : node.children) {
+			if (child != INVALID_ID && nodes[child].count > 0 && Overlaps(GetLooseBox(nodes[child]), box)) {
+				stack.push_back(child);
+			}
+		}
+	}
+}
+
+void LooseQuadtree::GatherRay(const Ray2D& ray, std::vector<RayHit>& result) {
+	stack.clear();
+	stack.push_back(0);
+	while (!stack.empty()) {
+		const Node& node = nodes[stack.back()];
+		stack.pop_back();
+
+		for (auto id : node.objects) {
+			float distance;
+			if (IntersectRay(ray, objects[id].box, distance)) {
+				result.push_back({ id, distance });
+			}
+		}
+		statistics.tested += node.objects.size();
+
+		for (auto child : node.children) {
+			float distance;
+			if (child != INVALID_ID && nodes[child].count > 0 && IntersectRay(ray, GetLooseBox(nodes[child]), distance)) {
+				stack.push_back(child);
+			}
+		}
+	}
+}
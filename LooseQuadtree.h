@@ -0,0 +1,45 @@
+#pragma once
+
+#include "SpatialIndex.h"
+
+// 邢l؁Bm[h͈̔͂㉺EɃZ̔LĂ̂ŁÂ͑傫[ASʒu܂AE܂ł̃m[hɈڂȂ
+// Ȃ瓯m[hɗ܂̂ŁAړ͔̑邾ōς
+class LooseQuadtree : public SpatialIndex
+{
+private:
+	typedef struct Node {
+		uint32_t children[4];	// INVALID_ID
+		uint32_t parent;
+		uint32_t level;
+		int32_t x;				// ̃xł̃Z̈ʒu
+		int32_t y;
+		uint32_t count;			// ؂ɒuꂽ̂̐i0Ȃ猟Ŕ΂j
+		std::vector<uint32_t> objects;
+	};
+
+	Box world;
+	float worldSize;
+	uint32_t maxDepth;
+	std::vector<Node> nodes;
+	std::vector<uint32_t> stack;
+
+public:
+	/// <summary>
+	/// world͈̔͂maxDepthi܂ŕB͈͂̊OɒS镨͍̂ɒu
+	/// </summary>
+	LooseQuadtree(const Box& world, uint32_t maxDepth = 8);
+
+private:
+	static uint64_t MakeKey(uint32_t level, int32_t x, int32_t y) { return ((uint64_t)level << 48) | ((uint64_t)(uint32_t)x << 24) | (uint32_t)y; }
+	void Locate(const Box& box, uint32_t& level, int32_t& x, int32_t& y);
+	uint32_t FindNode(uint32_t level, int32_t x, int32_t y);
+	void AddCount(uint32_t node, int32_t delta);
+	Box GetLooseBox(const Node& node);
+
+protected:
+	void Link(uint32_t id) override;
+	void Unlink(uint32_t id) override;
+	void Relink(uint32_t id) override;
+	void Gather(const Box& box, std::vector<uint32_t>& result) override;
+	void GatherRay(const Ray2D& ray, std::vector<RayHit>& result) override;
+};
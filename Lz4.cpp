@@ -0,0 +1,220 @@
+#include "Lz4.h"
+
+#include <cstring>
+#include <vector>
+
+namespace {
+	const size_t MIN_MATCH = 4;
+	const size_t LAST_LITERALS = 5;		// Ō5oCg͕Ke
+	const size_t MATCH_LIMIT = 12;		// Ō̈v͏I12oCgOn܂
+	const size_t MAX_OFFSET = 65535;
+	const int HASH_BITS = 16;
+
+	uint32_t Read32(const uint8_t* p) {
+		uint32_t value;
+		std::memcpy(&value, p, sizeof(value));
+		return value;
+	}
+
+	uint32_t Hash(uint32_t value) {
+		return (value * 2654435761u) >> (32 - HASH_BITS);
+	}
+
+	// 15ȏ̒255ǉ̃oCgŕ\
+	uint8_t* WriteLength(uint8_t* dst, size_t length) {
+		while (length >= 255) {
+			*dst++ = 255;
+			length -= 255;
+		}
+		*dst++ = (uint8_t)length;
+		return dst;
+	}
+}
+
+size_t Lz4::GetMaxCompressedSize(size_t size) {
+	return size + size / 255 + 16;
+}
+
+size_t Lz4::Compress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstCapacity) {
+	if (dstCapacity < GetMaxCompressedSize(srcSize)) {
+		return 0;
+	}
+
+	std::vector<uint32_t> table((size_t)1 << HASH_BITS, 0);
+
+	const uint8_t* end = src + srcSize;
+	const uint8_t* matchLimit = srcSize > MATCH_LIMIT ? end - MATCH_LIMIT : src;
+	const uint8_t* literal = src;
+	const uint8_t* cursor = src;
+	uint8_t* out = dst;
+
+	// ʒu0\̂0ĝŁAe[uɂ͈ʒu+1
+	while (cursor < matchLimit) {
+		uint32_t sequence = Read32(cursor);
+		uint32_t hash = Hash(sequence);
+		size_t candidate = table[hash];
+		table[hash] = (uint32_t)(cursor - src) + 1;
+
+		if (candidate == 0) {
+			cursor++;
+			continue;
+		}
+		const uint8_t* match = src + candidate - 1;
+		if ((size_t)(cursor - match) > MAX_OFFSET || Read32(match) != sequence) {
+			cursor++;
+			continue;
+		}
+
+		// OɐL΂邾L΂
+		while (cursor > literal && match > src && cursor[-1] == match[-1]) {
+			cursor--;
+			match--;
+		}
+
+		const uint8_t* matchEnd = cursor + MIN_MATCH;
+		const uint8_t* ref = match + MIN_MATCH;
+		while (matchEnd < end - LAST_LITERALS && *matchEnd == *ref) {
+			matchEnd++;
+			ref++;
+		}
+
+		size_t literalLength = (size_t)(cursor - literal);
+		size_t matchLength = (size_t)(matchEnd - cursor) - MIN_MATCH;
+
+		uint8_t* token = out++;
+		*token = (uint8_t)((literalLength < 15 ? literalLength : 15) << 4);
+		if (literalLength >= 15) {
+			out = WriteLength(out, literalLength - 15);
+		}
+		std::memcpy(out, literal, literalLength);
+		out += literalLength;
+
+		size_t offset = (size_t)(cursor - match);
+		*out++ = (uint8_t)(offset & 0xff);
+		*out++ = (uint8_t)(offset >> 8);
+
+		*token |= (uint8_t)(matchLength < 15 ? matchLength : 15);
+		if (matchLength >= 15) {
+			out = WriteLength(out, matchLength - 15);
+		}
+
+		cursor = matchEnd;
+		literal = cursor;
+
+		// v̓r̈ʒuo^ĂƁÄv₷
+		if (cursor - 2 > src && cursor < matchLimit) {
+			table[Hash(Read32(cursor - 2))] = (uint32_t)(cursor - 2 - src) + 1;
+		}
+	}
+
+	// cׂ͂ăe
+	size_t literalLength = (size_t)(end - literal);
+	uint8_t* token = out++;
+	*token = (uint8_t)((literalLength < 15 ? literalLength : 15) << 4);
+	if (literalLength >= 15) {
+		out = WriteLength(out, literalLength - 15);
+	}
+	if (literalLength > 0) {
+		std::memcpy(out, literal, literalLength);
+		out += literalLength;
+	}
+
+	return (size_t)(out - dst);
+}
+
+bool Lz4::Decompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize) {
+	const uint8_t* in = src;
+	const uint8_t* inEnd = src + srcSize;
+	uint8_t* out = dst;
+	uint8_t* outEnd = dst + dstSize;
+
+	auto readLength = [&](size_t& length) {
+		uint8_t value;
+		do {
+			if (in >= inEnd) {
+				return false;
+			}
+			value = *in++;
+			length += value;
+		} while (value == 255);
+		return true;
+	};
+
+	while (in < inEnd) {
+		uint8_t token = *in++;
+
+		size_t literalLength = token >> 4;
+		if (literalLength == 15 && !readLength(literalLength)) {
+			return false;
+		}
+		if ((size_t)(inEnd - in) < literalLength || (size_t)(outEnd - out) < literalLength) {
+			return false;
+		}
+		// Ze͒ɂ炸32oCgʂi]Ɏʂ͌ŏ㏑j
+		if (literalLength <= 32 && inEnd - in >= 32 && outEnd - out >= 32) {
+			std::memcpy(out, in, 32);
+			in += literalLength;
+			out += literalLength;
+		}
+		else if (literalLength > 0) {
+			std::memcpy(out, in, literalLength);
+			in += literalLength;
+			out += literalLength;
+		}
+
+		// Ō̃V[PX͈vȂ
+		if (in == inEnd) {
+			break;
+		}
+
+		if (inEnd - in < 2) {
+			return false;
+		}
+		size_t offset = (size_t)in[0] | ((size_t)in[1] << 8);
+		in += 2;
+		if (offset == 0 || offset > (size_t)(out - dst)) {
+			return false;
+		}
+
+		size_t matchLength = token & 15;
+		if (matchLength == 15 && !readLength(matchLength)) {
+			return false;
+		}
+		matchLength += MIN_MATCH;
+		if ((size_t)(outEnd - out) < matchLength) {
+			return false;
+		}
+
+		// v͎gƏdȂ邱ƂBʂPʂ藣Ă΁AǂޑOɏIĂ
+		// o͂ɗ]Tꍇ͒[܂Ƃ߂Ďʂi͂ݏo͌̃V[PXŏ㏑j
+		const uint8_t* match = out - offset;
+		uint8_t* copyEnd = out + matchLength;
+		if (offset >= 16 && (size_t)(outEnd - copyEnd) >= 16) {
+			do {
+				std::memcpy(out, match, 16);
+				out += 16;
+				match += 16;
+			} while (out < copyEnd);
+			out = copyEnd;
+		}
+		else if (offset >= 8 && (size_t)(outEnd - copyEnd) >= 8) {
+			do {
+				std::memcpy(out, match, 8);
+				out += 8;
+				match += 8;
+			} while (out < copyEnd);
+			out = copyEnd;
+		}
+		else if (offset >= matchLength) {
+			std::memcpy(out, match, matchLength);
+			out = copyEnd;
+		}
+		else {
+			while (out < copyEnd) {
+				*out++ = *match++;
+			}
+		}
+	}
+
+	return out == outEnd;
+}
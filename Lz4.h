@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// LZ4̃ubN`̈kEWJit[`̃wb_[͎Ȃj
+// WĴŁAAZbgpbN̒gɎg
+class Lz4
+{
+public:
+	/// <summary>
+	/// k̍ő̑傫ikłȂf[^ł𒴂Ȃj
+	/// </summary>
+	static size_t GetMaxCompressedSize(size_t size);
+
+	/// <summary>
+	/// kď񂾑傫ԂBeʂȂꍇ0
+	/// </summary>
+	static size_t Compress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstCapacity);
+
+	/// <summary>
+	/// WJBWJ̑傫dstSizeƈvȂEĂꍇfalse
+	/// </summary>
+	static bool Decompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize);
+};
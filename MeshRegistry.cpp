@@ -0,0 +1,181 @@
+#include "MeshRegistry.h"
+
+#include <cstring>
+
+std::unordered_map<uint64_t, std::vector<std::weak_ptr<Mesh>>> MeshRegistry::meshes;
+
+std::mutex MeshRegistry::mutex;
+
+uint64_t MeshRegistry::hits = 0;
+
+uint64_t MeshRegistry::misses = 0;
+
+Mesh::Mesh(const std::vector<Shape::VertexData>& vertices, const std::vector<unsigned short>& indices, uint64_t hash) {
+	this->vertices = vertices;
+	this->indices = indices;
+	this->hash = hash;
+
+	buffer = {};
+	vertexBufferView = {};
+	indexBufferView = {};
+}
+
+Mesh::~Mesh() {
+	ResourceAllocator::FreeBuffer(buffer);
+}
+
+void Mesh::CreateBuffers(ID3D12Device* device) {
+	std::call_once(bufferFlag, [&]() {
+		auto vertexSize = sizeof(Shape::VertexData) * vertices.size();
+		auto indexSize = sizeof(unsigned short) * indices.size();
+		buffer = ResourceAllocator::AllocateBuffer(vertexSize + indexSize);
+
+		std::memcpy(buffer.cpuAddress, vertices.data(), vertexSize);
+		std::memcpy(buffer.cpuAddress + vertexSize, indices.data(), indexSize);
+
+		vertexBufferView.BufferLocation = buffer.gpuAddress;
+		vertexBufferView.SizeInBytes = (UINT)vertexSize;
+		vertexBufferView.StrideInBytes = sizeof(Shape::VertexData);
+
+		indexBufferView.BufferLocation = buffer.gpuAddress + vertexSize;
+		indexBufferView.Format = DXGI_FORMAT_R16_UINT;
+		indexBufferView.SizeInBytes = (UINT)indexSize;
+	});
+}
+
+bool Mesh::Equals(const std::vector<Shape::VertexData>& vertices, const std::vector<unsigned short>& indices) {
+	return this->vertices.size() == vertices.size() &&
+		this->indices.size() == indices.size() &&
+		std::memcmp(this->vertices.data(), vertices.data(), sizeof(Shape::VertexData) * vertices.size()) == 0 &&
+		std::memcmp(this->indices.data(), indices.data(), sizeof(unsigned short) * indices.size()) == 0;
+}
+
+uint64_t MeshRegistry::Hash(const std::vector<Shape::VertexData>& vertices, const std::vector<unsigned short>& indices) {
+	// FNV-1a
+	uint64_t hash = 0xcbf29ce484222325ull;
+	auto append = [&](const void* data, size_t size) {
+		auto bytes = static_cast<const uint8_t*>(data);
+		for (size_t i = 0; i < size; i++) {
+			hash ^= bytes[i];
+			hash *= 0x100000001b3ull;
+		}
+	};
+
+	append(vertices.data(), sizeof(Shape::VertexData) * vertices.size());
+	append(indices.data(), sizeof(unsigned short) * indices.size());
+	return hash;
+}
+
+std::shared_ptr<Mesh> MeshRegistry::Acquire(const std::vector<Shape::VertexData>& vertices, const std::vector<unsigned short>& indices) {
+	uint64_t hash = Hash(vertices, indices);
+
+	std::lock_guard<std::mutex> lock(mutex);
+
+	auto& bucket = meshes[hash];
+	for (size_t i = 0; i < bucket.size();) {
+		auto mesh = bucket[i].lock();
+		if (mesh == nullptr) {
+			bucket[i] = bucket.back();
+			bucket.pop_back();
+			continue;
+		}
+		// nbVՓ˂ĂeႦΕʂ̃bVɂ
+		if (mesh->Equals(vertices, indices)) {
+			hits++;
+			return mesh;
+		}
+		i++;
+	}
+
+	// make_sharedweak_ptrcĂԃbV̗̈Ȃ̂ŕĊmۂ
+	std::shared_ptr<Mesh> mesh(new Mesh(vertices, indices, hash));
+	bucket.push_back(mesh);
+	misses++;
+	return mesh;
+}
+
+void MeshRegistry::Purge() {
+	std::lock_guard<std::mutex> lock(mutex);
+
+	for (auto it = meshes.begin(); it != meshes.end();) {
+		auto& bucket = it->second;
+		for (size_t i = 0; i < bucket.size();) {
+			if (bucket[i].expired()) {
+				bucket[i] = bucket.back();
+				bucket.pop_back();
+			}
+			else {
+				i++;
+			}
+		}
+
+		if (bucket.empty()) {
+			it = meshes.erase(it);
+		}
+		else {
+			++it;
+		}
+	}
+}
+
+void MeshRegistry::Release(std::shared_ptr<Mesh>& mesh) {
+	if (mesh == nullptr) {
+		return;
+	}
+
+	// obt@̉̓bN̊Oōs
+	std::shared_ptr<Mesh> released;
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+
+		// Acquire̓bN̒łQƂ𑝂₳Ȃ̂ŁA1Ȃ瑼ɎgĂ}`͖
+		if (mesh.use_count() == 1) {
+			auto it = meshes.find(mesh->GetHash());
+			if (it != meshes.end()) {
+				auto& bucket = it->second;
+				for (size_t i = 0; i < bucket.size();) {
+					// oPc̉ς݂̓o^ꏏɏ
+					auto other = bucket[i].lock();
+					if (other == nullptr || other == mesh) {
+						bucket[i] = bucket.back();
+						bucket.pop_back();
+					}
+					else {
+						i++;
+					}
+				}
+				if (bucket.empty()) {
+					meshes.erase(it);
+				}
+			}
+		}
+		released.swap(mesh);
+	}
+}
+
+MeshRegistry::Statistics MeshRegistry::GetStatistics() {
+	Purge();
+
+	std::lock_guard<std::mutex> lock(mutex);
+
+	Statistics result = {};
+	result.hits = hits;
+	result.misses = misses;
+	for (auto& pair : meshes) {
+		for (auto& weak : pair.second) {
+			auto mesh = weak.lock();
+			if (mesh != nullptr) {
+				result.liveMeshes++;
+				result.liveBytes += mesh->GetByteSize();
+			}
+		}
+	}
+	return result;
+}
+
+void MeshRegistry::ResetStatistics() {
+	std::lock_guard<std::mutex> lock(mutex);
+	hits = 0;
+	misses = 0;
+}
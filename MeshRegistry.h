@@ -0,0 +1,90 @@
+#pragma once
+
+#include "ResourceAllocator.h"
+#include "Shape.h"
+
+#include <d3d12.h>
+#include <wrl.h>
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+// _ECfbNXGPŨobt@܂Ƃ߂AShapeŋL郁bV
+// 쐬͓eύXȂiύXꍇ͐VeMeshRegistry蒼j
+class Mesh
+{
+private:
+	std::vector<Shape::VertexData> vertices;
+	std::vector<unsigned short> indices;
+	uint64_t hash;
+
+	// _̌ɃCfbNX𑱂1͈̔͂ɓ
+	ResourceAllocator::BufferRange buffer;
+	D3D12_VERTEX_BUFFER_VIEW vertexBufferView;
+	D3D12_INDEX_BUFFER_VIEW indexBufferView;
+	std::once_flag bufferFlag;
+
+public:
+	Mesh(const std::vector<Shape::VertexData>& vertices, const std::vector<unsigned short>& indices, uint64_t hash);
+	~Mesh();
+
+	/// <summary>
+	/// GPŨobt@i2ڈȍ~͉Ȃj
+	/// </summary>
+	void CreateBuffers(ID3D12Device* device);
+
+	bool Equals(const std::vector<Shape::VertexData>& vertices, const std::vector<unsigned short>& indices);
+
+	const std::vector<Shape::VertexData>& GetVertices() { return vertices; }
+	const std::vector<unsigned short>& GetIndices() { return indices; }
+	uint64_t GetHash() { return hash; }
+
+	bool HasBuffers() { return buffer.resource != nullptr; }
+	const D3D12_VERTEX_BUFFER_VIEW& GetVertexBufferView() { return vertexBufferView; }
+	const D3D12_INDEX_BUFFER_VIEW& GetIndexBufferView() { return indexBufferView; }
+	size_t GetByteSize() { return sizeof(Shape::VertexData) * vertices.size() + sizeof(unsigned short) * indices.size(); }
+};
+
+// ẽnbVŃbVA`̐}`mŋL
+// gȂȂbV͍ŌShapeƈꏏɉ
+class MeshRegistry
+{
+public:
+	typedef struct Statistics {
+		uint64_t hits;
+		uint64_t misses;
+		uint64_t liveMeshes;
+		uint64_t liveBytes;
+	};
+
+private:
+	static std::unordered_map<uint64_t, std::vector<std::weak_ptr<Mesh>>> meshes;
+	static std::mutex mutex;
+	static uint64_t hits;
+	static uint64_t misses;
+
+public:
+	static uint64_t Hash(const std::vector<Shape::VertexData>& vertices, const std::vector<unsigned short>& indices);
+
+	/// <summary>
+	/// ẽbV΂AΐVĕԂ
+	/// </summary>
+	static std::shared_ptr<Mesh> Acquire(const std::vector<Shape::VertexData>& vertices, const std::vector<unsigned short>& indices);
+
+	/// <summary>
+	/// ς݂̃bV̓o^
+	/// </summary>
+	static void Purge();
+
+	/// <summary>
+	/// gȂȂbVBŌ̎QƂȂo^
+	/// GPŨobt@͈̔͂ResourceAllocatorL^̃t[I܂ōėpȂ
+	/// </summary>
+	static void Release(std::shared_ptr<Mesh>& mesh);
+
+	static Statistics GetStatistics();
+	static void ResetStatistics();
+};
@@ -0,0 +1,198 @@
+#include "PipelineCacheFile.h"
+
+#include <cstring>
+#include <fstream>
+
+PipelineCacheFile::PipelineCacheFile() {
+	dirty = false;
+}
+
+void PipelineCacheFile::Serialize(std::vector<uint8_t>& data) {
+	data.clear();
+
+	auto write = [&](const void* value, size_t size) {
+		auto bytes = static_cast<const uint8_t*>(value);
+		data.insert(data.end(), bytes, bytes + size);
+	};
+	auto writeU32 = [&](uint32_t value) { write(&value, sizeof(value)); };
+
+	writeU32(MAGIC);
+	writeU32(VERSION);
+	writeU32((uint32_t)entries.size());
+
+	for (auto& entry : entries) {
+		write(&entry.hash, sizeof(entry.hash));
+		uint8_t key[] = {
+			(uint8_t)entry.key.vertexShader,
+			(uint8_t)entry.key.pixelShader,
+			(uint8_t)entry.key.layout,
+			(uint8_t)entry.key.blend,
+			(uint8_t)entry.key.topology,
+		};
+		write(key, sizeof(key));
+		writeU32((uint32_t)entry.blob.size());
+		write(entry.blob.data(), entry.blob.size());
+		while (data.size() % 4 != 0) {
+			data.push_back(0);
+		}
+	}
+
+	uint64_t checksum = HashBytes(data.data(), data.size());
+	write(&checksum, sizeof(checksum));
+}
+
+bool PipelineCacheFile::Deserialize(const std::vector<uint8_t>& data) {
+	Clear();
+
+	if (data.size() < 12 + sizeof(uint64_t)) {
+		return false;
+	}
+
+	// rŐ؂ꂽt@Cǂ܂Ȃ悤ɐɃ`FbNTm߂
+	size_t bodySize = data.size() - sizeof(uint64_t);
+	uint64_t checksum;
+	std::memcpy(&checksum, data.data() + bodySize, sizeof(checksum));
+	if (checksum != HashBytes(data.data(), bodySize)) {
+		return false;
+	}
+	// {̂4oCgEŏÎŁAłȂΉĂicursor{̂zȂƂ͂ŕۏ؂j
+	if (bodySize % 4 != 0) {
+		return false;
+	}
+
+	size_t cursor = 0;
+	auto read = [&](void* value, size_t size) {
+		if (size > bodySize - cursor) {
+			return false;
+		}
+		std::memcpy(value, data.data() + cursor, size);
+		cursor += size;
+		return true;
+	};
+
+	uint32_t magic, version, count;
+	if (!read(&magic, 4) || !read(&version, 4) || !read(&count, 4) || magic != MAGIC || version != VERSION) {
+		return false;
+	}
+
+	for (uint32_t i = 0; i < count; i++) {
+		uint64_t hash;
+		uint8_t key[5];
+		uint32_t size;
+		if (!read(&hash, sizeof(hash)) || !read(key, sizeof(key)) || !read(&size, sizeof(size))) {
+			Clear();
+			return false;
+		}
+
+		PipelineKey pipelineKey;
+		pipelineKey.vertexShader = (PipelineShader)key[0];
+		pipelineKey.pixelShader = (PipelineShader)key[1];
+		pipelineKey.layout = (PipelineLayout)key[2];
+		pipelineKey.blend = (BlendMode)key[3];
+		pipelineKey.topology = (PipelineTopology)key[4];
+
+		if (!pipelineKey.IsValid() || size > bodySize - cursor) {
+			Clear();
+			return false;
+		}
+
+		Store(hash, pipelineKey, data.data() + cursor, size);
+		cursor += size;
+		cursor = (cursor + 3) & ~(size_t)3;
+		if (cursor > bodySize) {
+			Clear();
+			return false;
+		}
+	}
+
+	// ̌ɗ]ȃf[^̂Ă
+	if (cursor != bodySize) {
+		Clear();
+		return false;
+	}
+
+	dirty = false;
+	return true;
+}
+
+bool PipelineCacheFile::Load(const std::string& fileName) {
+	std::ifstream file(fileName, std::ios::binary | std::ios::ate);
+	if (!file) {
+		Clear();
+		return false;
+	}
+
+	std::vector<uint8_t> data((size_t)file.tellg());
+	file.seekg(0);
+	file.read(reinterpret_cast<char*>(data.data()), data.size());
+	if (!file) {
+		Clear();
+		return false;
+	}
+
+	return Deserialize(data);
+}
+
+bool PipelineCacheFile::Save(const std::string& fileName) {
+	std::vector<uint8_t> data;
+	Serialize(data);
+
+	std::ofstream file(fileName, std::ios::binary);
+	if (!file) {
+		return false;
+	}
+	file.write(reinterpret_cast<const char*>(data.data()), data.size());
+	if (!file) {
+		return false;
+	}
+
+	dirty = false;
+	return true;
+}
+
+const PipelineCacheFile::Entry* PipelineCacheFile::Find(uint64_t hash) {
+	auto found = indices.find(hash);
+	if (found == indices.end()) {
+		return nullptr;
+	}
+	return &entries[found->second];
+}
+
+void PipelineCacheFile::Store(uint64_t hash, const PipelineKey& key, const void* blob, size_t size) {
+	auto bytes = static_cast<const uint8_t*>(blob);
+
+	auto found = indices.find(hash);
+	if (found != indices.end()) {
+		Entry& entry = entries[found->second];
+		entry.key = key;
+		entry.blob.assign(bytes, bytes + size);
+	}
+	else {
+		indices[hash] = entries.size();
+		entries.push_back({ hash, key, std::vector<uint8_t>(bytes, bytes + size) });
+	}
+	dirty = true;
+}
+
+void PipelineCacheFile::Remove(uint64_t hash) {
+	auto found = indices.find(hash);
+	if (found == indices.end()) {
+		return;
+	}
+
+	// Ō̗vfƓւď
+	size_t index = found->second;
+	indices.erase(found);
+	if (index != entries.size() - 1) {
+		entries[index] = std::move(entries.back());
+		indices[entries[index].hash] = index;
+	}
+	entries.pop_back();
+	dirty = true;
+}
+
+void PipelineCacheFile::Clear() {
+	entries.clear();
+	indices.clear();
+	dirty = false;
+}
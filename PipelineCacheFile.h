@@ -0,0 +1,48 @@
+#pragma once
+
+#include "PipelineKey.h"
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// 쐬ς݃pCvC̃LbViID3D12PipelineState::GetCachedBlobjۑt@CifoCXsvj
+// [wb_[] [nbV(u64) L[(5) TCY(u32) f[^ 4oCgE]... [`FbNT(u64)]
+class PipelineCacheFile
+{
+public:
+	static const uint32_t MAGIC = 0x504c474d;	// "MGLP"
+	static const uint32_t VERSION = 1;
+
+	typedef struct Entry {
+		uint64_t hash;
+		PipelineKey key;
+		std::vector<uint8_t> blob;
+	};
+
+private:
+	std::vector<Entry> entries;
+	std::unordered_map<uint64_t, size_t> indices;
+	bool dirty;
+
+public:
+	PipelineCacheFile();
+
+	/// <summary>
+	/// ǂݍށB`ႤEĂꍇ͋ɂfalseԂ
+	/// </summary>
+	bool Deserialize(const std::vector<uint8_t>& data);
+	void Serialize(std::vector<uint8_t>& data);
+
+	bool Load(const std::string& fileName);
+	bool Save(const std::string& fileName);
+
+	const Entry* Find(uint64_t hash);
+	void Store(uint64_t hash, const PipelineKey& key, const void* blob, size_t size);
+	void Remove(uint64_t hash);
+	void Clear();
+
+	const std::vector<Entry>& GetEntries() { return entries; }
+	bool IsDirty() { return dirty; }
+};
@@ -0,0 +1,38 @@
+#include "PipelineKey.h"
+
+bool PipelineKey::operator==(const PipelineKey& other) const {
+	return vertexShader == other.vertexShader &&
+		pixelShader == other.pixelShader &&
+		layout == other.layout &&
+		blend == other.blend &&
+		topology == other.topology;
+}
+
+bool PipelineKey::IsValid() const {
+	return vertexShader < PipelineShader::COUNT &&
+		pixelShader < PipelineShader::COUNT &&
+		layout < PipelineLayout::COUNT &&
+		blend < BlendMode::COUNT &&
+		topology < PipelineTopology::COUNT;
+}
+
+uint64_t PipelineKey::Hash() const {
+	// \̗̂]܂߂Ȃ悤1ǉ
+	uint8_t values[] = {
+		(uint8_t)vertexShader,
+		(uint8_t)pixelShader,
+		(uint8_t)layout,
+		(uint8_t)blend,
+		(uint8_t)topology,
+	};
+	return HashBytes(values, sizeof(values));
+}
+
+uint64_t HashBytes(const void* data, size_t size, uint64_t hash) {
+	auto bytes = static_cast<const uint8_t*>(data);
+	for (size_t i = 0; i < size; i++) {
+		hash ^= bytes[i];
+		hash *= 0x100000001b3ull;
+	}
+	return hash;
+}
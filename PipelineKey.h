@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// pCvC̑gݍ킹\lifoCXsvj
+// D3D12_GRAPHICS_PIPELINE_STATE_DESĈÃCuŕς镔
+
+enum class PipelineShader : uint8_t {
+	BASIC_VS,		// BasicVertexShader.hlsl
+	INSTANCED_VS,	// InstancedVertexShader.hlsl
+	BASIC_PS,		// BasicPixelShader.hlsl
+	TEXTURE_PS,		// TexPixelShader.hlsl
+	SPRITE_PS,		// SpritePixelShader.hlsl
+	COUNT
+};
+
+enum class PipelineLayout : uint8_t {
+	STANDARD,		// Shape::VertexData
+	INSTANCED,		// Shape::VertexData + InstanceBatch::InstanceData
+	COUNT
+};
+
+enum class BlendMode : uint8_t {
+	DISABLED,
+	ALPHA,
+	ADDITIVE,
+	COUNT
+};
+
+enum class PipelineTopology : uint8_t {
+	TRIANGLE,
+	LINE,
+	COUNT
+};
+
+typedef struct PipelineKey {
+	PipelineShader vertexShader = PipelineShader::BASIC_VS;
+	PipelineShader pixelShader = PipelineShader::BASIC_PS;
+	PipelineLayout layout = PipelineLayout::STANDARD;
+	BlendMode blend = BlendMode::DISABLED;
+	PipelineTopology topology = PipelineTopology::TRIANGLE;
+
+	bool operator==(const PipelineKey& other) const;
+	bool operator!=(const PipelineKey& other) const { return !(*this == other); }
+
+	/// <summary>
+	/// el͈͓iꂽLbVt@C̓ǂݍݑ΍j
+	/// </summary>
+	bool IsValid() const;
+
+	uint64_t Hash() const;
+};
+
+// FNV-1aŃnbVlɃf[^ǉ
+uint64_t HashBytes(const void* data, size_t size, uint64_t hash = 0xcbf29ce484222325ull);
@@ -0,0 +1,183 @@
+#include "PipelineRegistry.h"
+#include "Debugger.h"
+
+#include <chrono>
+
+using Microsoft::WRL::ComPtr;
+
+namespace {
+	const D3D12_INPUT_ELEMENT_DESC standardLayout[] = {
+		{"POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+		{"COLOR", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+		{"TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+	};
+
+	// Xbg0ɒPʃbVAXbg1ɃCX^XƂ̃f[^
+	const D3D12_INPUT_ELEMENT_DESC instancedLayout[] = {
+		{"POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+		{"COLOR", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+		{"TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+		{"WORLD", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA, 1},
+		{"WORLD", 1, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA, 1},
+		{"WORLD", 2, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA, 1},
+		{"WORLD", 3, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA, 1},
+		{"TINT", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA, 1},
+		{"UVRECT", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA, 1},
+	};
+}
+
+PipelineRegistry::PipelineRegistry(ID3D12Device* device, ID3D12RootSignature* rootSignature, const std::string& cacheFileName) {
+	this->device = device;
+	this->rootSignature = rootSignature;
+	this->cacheFileName = cacheFileName;
+
+	for (int i = 0; i < (int)PipelineShader::COUNT; i++) {
+		shaders[i] = {};
+		shaderHashes[i] = 0;
+	}
+
+	// EĂꍇ͋̃LbVn߂
+	if (!cacheFileName.empty()) {
+		cacheFile.Load(cacheFileName);
+	}
+}
+
+PipelineRegistry::~PipelineRegistry() {
+	if (cacheFile.IsDirty()) {
+		Save();
+	}
+}
+
+void PipelineRegistry::RegisterShader(PipelineShader shader, const void* code, size_t size) {
+	shaders[(int)shader] = { code, size };
+	shaderHashes[(int)shader] = HashBytes(code, size);
+}
+
+uint64_t PipelineRegistry::Hash(const PipelineKey& key) {
+	uint64_t hash = key.Hash();
+	hash = HashBytes(&shaderHashes[(int)key.vertexShader], sizeof(uint64_t), hash);
+	hash = HashBytes(&shaderHashes[(int)key.pixelShader], sizeof(uint64_t), hash);
+	return hash;
+}
+
+ID3D12PipelineState* PipelineRegistry::Get(const PipelineKey& key) {
+	uint64_t hash = Hash(key);
+
+	std::lock_guard<std::mutex> lock(mutex);
+	auto found = pipelines.find(hash);
+	if (found != pipelines.end()) {
+		return found->second.pipeline.Get();
+	}
+
+	return Create(key, hash).pipeline.Get();
+}
+
+PipelineRegistry::Entry& PipelineRegistry::Create(const PipelineKey& key, uint64_t hash) {
+	auto startTime = std::chrono::steady_clock::now();
+
+	D3D12_RENDER_TARGET_BLEND_DESC blend = {};
+	blend.BlendEnable = key.blend != BlendMode::DISABLED;
+	blend.LogicOpEnable = false;
+	blend.SrcBlend = D3D12_BLEND_SRC_ALPHA;
+	blend.DestBlend = key.blend == BlendMode::ADDITIVE ? D3D12_BLEND_ONE : D3D12_BLEND_INV_SRC_ALPHA;
+	blend.BlendOp = D3D12_BLEND_OP_ADD;
+	blend.SrcBlendAlpha = D3D12_BLEND_ONE;
+	blend.DestBlendAlpha = D3D12_BLEND_INV_SRC_ALPHA;
+	blend.BlendOpAlpha = D3D12_BLEND_OP_ADD;
+	blend.LogicOp = D3D12_LOGIC_OP_NOOP;
+	blend.RenderTargetWriteMask = D3D12_COLOR_WRITE_ENABLE_ALL;
+
+	D3D12_GRAPHICS_PIPELINE_STATE_DESC desc = {};
+	desc.pRootSignature = rootSignature;
+	desc.VS = shaders[(int)key.vertexShader];
+	desc.PS = shaders[(int)key.pixelShader];
+
+	desc.SampleMask = D3D12_DEFAULT_SAMPLE_MASK;
+
+	desc.RasterizerState.MultisampleEnable = false;
+	desc.RasterizerState.CullMode = D3D12_CULL_MODE_NONE;
+	desc.RasterizerState.FillMode = D3D12_FILL_MODE_SOLID;
+	desc.RasterizerState.DepthClipEnable = true;
+
+	desc.BlendState.AlphaToCoverageEnable = false;
+	desc.BlendState.IndependentBlendEnable = false;
+	desc.BlendState.RenderTarget[0] = blend;
+
+	if (key.layout == PipelineLayout::INSTANCED) {
+		desc.InputLayout.pInputElementDescs = instancedLayout;
+		desc.InputLayout.NumElements = _countof(instancedLayout);
+	}
+	else {
+		desc.InputLayout.pInputElementDescs = standardLayout;
+		desc.InputLayout.NumElements = _countof(standardLayout);
+	}
+
+	desc.IBStripCutValue = D3D12_INDEX_BUFFER_STRIP_CUT_VALUE_DISABLED;
+	desc.PrimitiveTopologyType = key.topology == PipelineTopology::LINE ? D3D12_PRIMITIVE_TOPOLOGY_TYPE_LINE : D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE;
+	desc.NumRenderTargets = 1;
+	desc.RTVFormats[0] = DXGI_FORMAT_R8G8B8A8_UNORM;
+
+	desc.SampleDesc.Count = 1;
+	desc.SampleDesc.Quality = 0;
+
+	Entry entry = {};
+	entry.permutation.key = key;
+	entry.permutation.hash = hash;
+
+	// hCo[ςƃLbV͎gȂ̂ŁAsLbVō蒼
+	auto cached = cacheFile.Find(hash);
+	if (cached != nullptr && cached->key == key) {
+		desc.CachedPSO = { cached->blob.data(), cached->blob.size() };
+		entry.permutation.fromCache = SUCCEEDED(device->CreateGraphicsPipelineState(&desc, IID_PPV_ARGS(entry.pipeline.ReleaseAndGetAddressOf())));
+		desc.CachedPSO = {};
+	}
+
+	if (!entry.permutation.fromCache) {
+		Debugger::ErrorCheck(device->CreateGraphicsPipelineState(&desc, IID_PPV_ARGS(entry.pipeline.ReleaseAndGetAddressOf())));
+
+		ComPtr<ID3DBlob> blob;
+		if (SUCCEEDED(entry.pipeline->GetCachedBlob(blob.ReleaseAndGetAddressOf()))) {
+			cacheFile.Store(hash, key, blob->GetBufferPointer(), blob->GetBufferSize());
+		}
+	}
+
+	entry.permutation.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+	order.push_back(hash);
+	return pipelines.emplace(hash, entry).first->second;
+}
+
+void PipelineRegistry::Warm() {
+	// Create̒ŃLbV邱Ƃ̂ŐɃL[W߂
+	std::vector<std::pair<uint64_t, PipelineKey>> keys;
+	for (auto& entry : cacheFile.GetEntries()) {
+		keys.push_back({ entry.hash, entry.key });
+	}
+
+	for (auto& key : keys) {
+		// VF[_[ςÂgݍ킹͎̂Ă
+		if (Hash(key.second) != key.first) {
+			cacheFile.Remove(key.first);
+			continue;
+		}
+		Get(key.second);
+	}
+}
+
+bool PipelineRegistry::Save() {
+	if (cacheFileName.empty()) {
+		return false;
+	}
+
+	std::lock_guard<std::mutex> lock(mutex);
+	return cacheFile.Save(cacheFileName);
+}
+
+std::vector<PipelineRegistry::Permutation> PipelineRegistry::GetPermutations() {
+	std::lock_guard<std::mutex> lock(mutex);
+	std::vector<Permutation> result;
+	for (auto hash : order) {
+		result.push_back(pipelines[hash].permutation);
+	}
+	return result;
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <wrl.h>
+#include <d3d12.h>
+#include "PipelineCacheFile.h"
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// pCvC̑gݍ킹ƂPSOĕێ
+// ߂Ďgɍ쐬A쐬PSÕLbVt@CɕۑĎ̋N𑬂
+// Get͕̃XbhĂł悢
+class PipelineRegistry
+{
+public:
+	typedef struct Permutation {
+		PipelineKey key;
+		uint64_t hash;
+		double seconds;		// 쐬ɂ
+		bool fromCache;		// LbV쐬ł
+	};
+
+private:
+	typedef struct Entry {
+		Microsoft::WRL::ComPtr<ID3D12PipelineState> pipeline;
+		Permutation permutation;
+	};
+
+	ID3D12Device* device;
+	ID3D12RootSignature* rootSignature;
+
+	D3D12_SHADER_BYTECODE shaders[(int)PipelineShader::COUNT];
+	uint64_t shaderHashes[(int)PipelineShader::COUNT];
+
+	std::unordered_map<uint64_t, Entry> pipelines;
+	std::vector<uint64_t> order;
+	std::mutex mutex;
+
+	std::string cacheFileName;
+	PipelineCacheFile cacheFile;
+
+public:
+	/// <param name="cacheFileName">̏ꍇ̓t@CɕۑȂ</param>
+	PipelineRegistry(ID3D12Device* device, ID3D12RootSignature* rootSignature, const std::string& cacheFileName);
+	~PipelineRegistry();
+
+private:
+	Entry& Create(const PipelineKey& key, uint64_t hash);
+
+public:
+	/// <summary>
+	/// VF[_[o^icode͓o^܂܂̊Ԃ͉ȂƁj
+	/// </summary>
+	void RegisterShader(PipelineShader shader, const void* code, size_t size);
+
+	/// <summary>
+	/// VF[_[̒g܂߂nbVliVF[_[ςƌÂLbV͎gȂj
+	/// </summary>
+	uint64_t Hash(const PipelineKey& key);
+
+	ID3D12PipelineState* Get(const PipelineKey& key);
+
+	/// <summary>
+	/// LbVt@Cɂgݍ킹ɍĂi`n߂OɌĂԂƁj
+	/// </summary>
+	void Warm();
+	bool Save();
+
+	std::vector<Permutation> GetPermutations();
+};
@@ -0,0 +1,29 @@
+#include "QueueFence.h"
+#include "Debugger.h"
+
+QueueFence::QueueFence(ID3D12Device* device, ID3D12CommandQueue* cmdQueue, uint64_t initialValue) {
+	this->cmdQueue = cmdQueue;
+
+	Debugger::ErrorCheck(device->CreateFence(initialValue, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(fence.ReleaseAndGetAddressOf())));
+
+	event = CreateEvent(nullptr, false, false, nullptr);
+}
+
+QueueFence::~QueueFence() {
+	CloseHandle(event);
+}
+
+void QueueFence::Signal(uint64_t value) {
+	Debugger::ErrorCheck(cmdQueue->Signal(fence.Get(), value));
+}
+
+uint64_t QueueFence::GetCompletedValue() {
+	return fence->GetCompletedValue();
+}
+
+void QueueFence::Wait(uint64_t value) {
+	while (fence->GetCompletedValue() < value) {
+		Debugger::ErrorCheck(fence->SetEventOnCompletion(value, event));
+		WaitForSingleObject(event, INFINITE);
+	}
+}
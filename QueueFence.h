@@ -0,0 +1,25 @@
+#pragma once
+
+#include "FrameRing.h"
+
+#include <d3d12.h>
+#include <wrl.h>
+
+class QueueFence : public FrameFence
+{
+private:
+	Microsoft::WRL::ComPtr<ID3D12Fence> fence;
+	ID3D12CommandQueue* cmdQueue;
+	HANDLE event;
+
+public:
+	QueueFence(ID3D12Device* device, ID3D12CommandQueue* cmdQueue, uint64_t initialValue = 0);
+	~QueueFence();
+
+public:
+	void Signal(uint64_t value) override;
+	uint64_t GetCompletedValue() override;
+	void Wait(uint64_t value) override;
+
+	ID3D12Fence* GetFence() { return fence.Get(); }
+};
@@ -0,0 +1,194 @@
+#include "RecordingRenderer.h"
+#include "SoftwareRasterizer.h"
+#include "Shape.h"
+#include "Line.h"
+#include "Texture.h"
+#include "Text.h"
+
+#include <cstring>
+
+namespace {
+	uint64_t HashBytes(uint64_t hash, const void* data, size_t size) {
+		auto bytes = static_cast<const uint8_t*>(data);
+		for (size_t i = 0; i < size; i++) {
+			hash ^= bytes[i];
+			hash *= 0x100000001b3ull;
+		}
+		return hash;
+	}
+
+	// eNX`͑傫̂ŁA8oCgi߂
+	uint64_t HashPixels(uint64_t hash, const uint8_t* data, size_t size) {
+		size_t words = size / sizeof(uint64_t);
+		for (size_t i = 0; i < words; i++) {
+			uint64_t word;
+			std::memcpy(&word, data + i * sizeof(uint64_t), sizeof(word));
+			hash ^= word;
+			hash *= 0x100000001b3ull;
+		}
+		return HashBytes(hash, data + words * sizeof(uint64_t), size - words * sizeof(uint64_t));
+	}
+}
+
+RecordingRenderer::RecordingRenderer(RenderBackend* forward) {
+	this->forward = forward;
+	nextId = SHARED_HEAP_ID + 1;
+}
+
+void RecordingRenderer::Clear() {
+	writer.Clear();
+	meshes.clear();
+	textures.clear();
+	objectIds.clear();
+	nextId = SHARED_HEAP_ID + 1;
+}
+
+uint32_t RecordingRenderer::GetObjectId(const void* object) {
+	auto found = objectIds.find(object);
+	if (found != objectIds.end()) {
+		return found->second;
+	}
+
+	uint32_t id = nextId++;
+	objectIds[object] = id;
+	return id;
+}
+
+uint32_t RecordingRenderer::RecordMesh(const void* owner, StreamTopology topology, const void* vertices, size_t vertexCount, const unsigned short* indices, size_t indexCount) {
+	uint64_t hash = HashBytes(0xcbf29ce484222325ull, vertices, sizeof(RasterVertex) * vertexCount);
+	hash = HashBytes(hash, indices, sizeof(unsigned short) * indexCount);
+
+	// ߂ČA܂UVȂǂꂽbV`
+	auto found = meshes.find(owner);
+	if (found == meshes.end() || found->second.hash != hash) {
+		uint32_t id = GetObjectId(owner);
+		writer.DefineMesh(id, topology, static_cast<const float*>(vertices), (uint32_t)vertexCount, indices, (uint32_t)indexCount);
+		meshes[owner] = { id, hash };
+		return id;
+	}
+
+	return found->second.id;
+}
+
+void RecordingRenderer::RecordShape(Shape* shape) {
+	auto& vertices = shape->GetVertices();
+	auto& indices = shape->GetIndices();
+	uint32_t mesh = RecordMesh(shape, StreamTopology::TRIANGLE_LIST, vertices.data(), vertices.size(), indices.data(), indices.size());
+
+	DirectX::XMFLOAT4X4 world;
+	DirectX::XMStoreFloat4x4(&world, shape->GetWorldMatrix());
+
+	writer.DrawMesh(mesh, &world.m[0][0]);
+}
+
+void RecordingRenderer::BeginDraw() {
+	writer.BeginDraw();
+	writer.SetPipeline((uint32_t)RasterPipeline::NORMAL);
+	writer.SetDescriptorHeap(SHARED_HEAP_ID);
+
+	if (forward != nullptr) {
+		forward->BeginDraw();
+	}
+}
+
+void RecordingRenderer::EndDraw() {
+	writer.EndDraw();
+
+	if (forward != nullptr) {
+		forward->EndDraw();
+	}
+}
+
+void RecordingRenderer::SetNormalPipeline() {
+	writer.SetPipeline((uint32_t)RasterPipeline::NORMAL);
+
+	if (forward != nullptr) {
+		forward->SetNormalPipeline();
+	}
+}
+
+void RecordingRenderer::SetTexturePipeline() {
+	writer.SetPipeline((uint32_t)RasterPipeline::TEXTURE);
+
+	if (forward != nullptr) {
+		forward->SetTexturePipeline();
+	}
+}
+
+void RecordingRenderer::DrawShape(Shape* shape) {
+	RecordShape(shape);
+
+	if (forward != nullptr) {
+		forward->DrawShape(shape);
+	}
+}
+
+void RecordingRenderer::DrawLine(Line* line) {
+	auto& vertices = line->GetVertices();
+	uint32_t mesh = RecordMesh(line, StreamTopology::LINE_LIST, vertices.data(), vertices.size(), nullptr, 0);
+
+	DirectX::XMFLOAT4X4 world;
+	DirectX::XMStoreFloat4x4(&world, line->GetWorldMatrix());
+
+	writer.DrawMesh(mesh, &world.m[0][0]);
+
+	if (forward != nullptr) {
+		forward->DrawLine(line);
+	}
+}
+
+void RecordingRenderer::DrawTexture(Texture* texture) {
+	// ǂݍݒ̃eNX`͉摜̂ŁAǂݍ݂I܂ł͋L^Ȃ
+	if (texture->GetImage() == nullptr) {
+		if (forward != nullptr) {
+			forward->DrawTexture(texture);
+		}
+		return;
+	}
+
+	// ǂݍ݂Iĉ摜ւꍇAAhXɕʂ̃eNX`ꂽꍇ`
+	// 摜OƓȂ璆gȂ̂ŁAnbV͂Ȃ
+	const DirectX::Image* image = texture->GetImage();
+	uint32_t id = GetObjectId(texture);
+	auto found = textures.find(texture);
+	if (found == textures.end() || found->second.pixels != image->pixels) {
+		uint64_t hash = HashBytes(0xcbf29ce484222325ull, &image->format, sizeof(image->format));
+		hash = HashBytes(hash, &image->width, sizeof(image->width));
+		hash = HashBytes(hash, &image->height, sizeof(image->height));
+		hash = HashPixels(hash, image->pixels, image->slicePitch);
+
+		if (found == textures.end() || found->second.hash != hash) {
+			const void* pixels = image->pixels;
+			DirectX::ScratchImage converted;
+			if (image->format != DXGI_FORMAT_R8G8B8A8_UNORM &&
+				SUCCEEDED(DirectX::Convert(*image, DXGI_FORMAT_R8G8B8A8_UNORM, DirectX::TEX_FILTER_DEFAULT, DirectX::TEX_THRESHOLD_DEFAULT, converted))) {
+				image = converted.GetImage(0, 0, 0);
+			}
+			writer.DefineTexture(id, (int)image->width, (int)image->height, (int)image->rowPitch, image->pixels);
+			textures[texture] = { id, hash, pixels };
+		}
+		else {
+			found->second.pixels = image->pixels;
+		}
+	}
+
+	writer.BindTexture(id);
+	RecordShape(texture->GetShape());
+
+	if (forward != nullptr) {
+		forward->DrawTexture(texture);
+	}
+}
+
+void RecordingRenderer::DrawString(Text* text, const std::wstring& str, DirectX::XMFLOAT2 pos, DirectX::FXMVECTOR color) {
+	uint32_t id = GetObjectId(text);
+
+	DirectX::XMFLOAT4 rgba;
+	DirectX::XMStoreFloat4(&rgba, color);
+
+	writer.DrawString(id, str.c_str(), str.size(), &pos.x, &rgba.x);
+
+	if (forward != nullptr) {
+		forward->DrawString(text, str, pos, color);
+	}
+}
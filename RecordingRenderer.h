@@ -0,0 +1,66 @@
+#pragma once
+
+#include "RenderBackend.h"
+#include "CommandStream.h"
+
+#include <unordered_map>
+
+// `ĂяoCommandStreamɋL^obNGh
+// forwardw肷ƁAL^Ȃۂ̕`ɂ̂܂ܗ
+class RecordingRenderer : public RenderBackend
+{
+public:
+	// BeginDrawňxݒ肳鋤LfBXNv^q[v̔ԍ
+	static const uint32_t SHARED_HEAP_ID = 0;
+
+private:
+	// `ς݂̃bVeNX`Bg̃nbVς`
+	typedef struct DefinitionRecord {
+		uint32_t id;
+		uint64_t hash;
+	};
+
+	// ǂݍ񂾉摜͏ꂸւ邾Ȃ̂ŁAf̈ʒuςnbV
+	typedef struct TextureRecord {
+		uint32_t id;
+		uint64_t hash;
+		const void* pixels;
+	};
+
+	CommandStreamWriter writer;
+	RenderBackend* forward;
+
+	// ԍ͋L^ƂɐU蒼iꂽIuWFNg̓o^cȂj
+	std::unordered_map<const void*, DefinitionRecord> meshes;
+	std::unordered_map<const void*, TextureRecord> textures;
+	std::unordered_map<const void*, uint32_t> objectIds;
+	uint32_t nextId;
+
+public:
+	RecordingRenderer(RenderBackend* forward = nullptr);
+
+private:
+	uint32_t GetObjectId(const void* object);
+	uint32_t RecordMesh(const void* owner, StreamTopology topology, const void* vertices, size_t vertexCount, const unsigned short* indices, size_t indexCount);
+	void RecordShape(class Shape* shape);
+
+public:
+	void BeginDraw() override;
+	void EndDraw() override;
+
+	void SetNormalPipeline() override;
+	void SetTexturePipeline() override;
+
+	void DrawShape(class Shape* shape) override;
+	void DrawLine(class Line* line) override;
+	void DrawTexture(class Texture* texture) override;
+	void DrawString(class Text* text, const std::wstring& str, DirectX::XMFLOAT2 pos, DirectX::FXMVECTOR color) override;
+
+	bool Save(const std::string& fileName) { return writer.Save(fileName); }
+	/// <summary>
+	/// L^̂ĂĐVL^n߂
+	/// </summary>
+	void Clear();
+
+	CommandStreamWriter* GetWriter() { return &writer; }
+};
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <DirectXMath.h>
+
+#include <string>
+
+enum class PipelineType {
+	NORMAL,
+	TEXTURE,
+	LINE
+};
+
+// `̒ۉ
+// RendereriD3D12jSoftwareRendererȂǂAShapeELineETextureEText͂ʂĕ`ł
+class RenderBackend
+{
+public:
+	virtual ~RenderBackend() {}
+
+	virtual void BeginDraw() = 0;
+	virtual void EndDraw() = 0;
+
+	virtual void SetNormalPipeline() = 0;
+	virtual void SetTexturePipeline() = 0;
+
+	virtual void DrawShape(class Shape* shape) = 0;
+	virtual void DrawLine(class Line* line) = 0;
+	virtual void DrawTexture(class Texture* texture) = 0;
+	virtual void DrawString(class Text* text, const std::wstring& str, DirectX::XMFLOAT2 pos, DirectX::FXMVECTOR color) = 0;
+};
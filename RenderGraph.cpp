@@ -0,0 +1,292 @@
+#include "RenderGraph.h"
+
+#include <algorithm>
+
+RenderGraph::RenderGraph() {
+	heapSize = 0;
+	compiled = false;
+	statistics = {};
+}
+
+bool RenderGraph::IsWriteState(ResourceState state) {
+	return state == ResourceState::RENDER_TARGET || state == ResourceState::COPY_DEST;
+}
+
+bool RenderGraph::Fail(const std::string& message) {
+	error = message;
+	compiled = false;
+	return false;
+}
+
+uint32_t RenderGraph::Import(const std::string& name, ResourceState initialState, ResourceState finalState) {
+	Resource resource = {};
+	resource.name = name;
+	resource.transient = false;
+	resource.initialState = initialState;
+	resource.finalState = finalState;
+	resources.push_back(resource);
+	compiled = false;
+	return (uint32_t)resources.size() - 1;
+}
+
+uint32_t RenderGraph::CreateTransient(const std::string& name, const TransientDesc& desc) {
+	Resource resource = {};
+	resource.name = name;
+	resource.transient = true;
+	resource.desc = desc;
+	if (resource.desc.alignment == 0) {
+		resource.desc.alignment = 1;
+	}
+	resources.push_back(resource);
+	compiled = false;
+	return (uint32_t)resources.size() - 1;
+}
+
+uint32_t RenderGraph::AddPass(const std::string& name, std::function<void()> execute) {
+	Pass pass;
+	pass.name = name;
+	pass.execute = std::move(execute);
+	passes.push_back(pass);
+	compiled = false;
+	return (uint32_t)passes.size() - 1;
+}
+
+void RenderGraph::Read(uint32_t pass, uint32_t resource, ResourceState state) {
+	passes[pass].accesses.push_back({ resource, state, false });
+	compiled = false;
+}
+
+void RenderGraph::Write(uint32_t pass, uint32_t resource, ResourceState state) {
+	passes[pass].accesses.push_back({ resource, state, true });
+	compiled = false;
+}
+
+bool RenderGraph::Compile() {
+	error.clear();
+	finalBarriers.clear();
+	heapSize = 0;
+
+	// pX̒̓\[Xւ̃ANZX1ɂ܂Ƃ߂
+	// G[͂̕ǂ̕R[hŃRpCĂȂ悤ASCIIɂ
+	for (auto& pass : passes) {
+		std::vector<Access> merged;
+		for (auto& access : pass.accesses) {
+			if (access.resource >= resources.size()) {
+				return Fail(pass.name + ": unknown resource");
+			}
+			if (access.write != IsWriteState(access.state)) {
+				return Fail(pass.name + ": " + resources[access.resource].name + ": state does not match read/write");
+			}
+
+			auto found = std::find_if(merged.begin(), merged.end(), [&](const Access& a) { return a.resource == access.resource; });
+			if (found == merged.end()) {
+				merged.push_back(access);
+			}
+			else if (found->write || access.write) {
+				if (found->state != access.state || found->write != access.write) {
+					return Fail(pass.name + ": " + resources[access.resource].name + ": used in different states in one pass");
+				}
+			}
+			else {
+				found->state = found->state | access.state;
+			}
+		}
+		pass.accesses = merged;
+		pass.barriers.clear();
+	}
+
+	// e\[Xg
+	for (auto& resource : resources) {
+		resource.firstPass = -1;
+		resource.lastPass = -1;
+		resource.offset = 0;
+	}
+	for (int i = 0; i < (int)passes.size(); i++) {
+		for (auto& access : passes[i].accesses) {
+			Resource& resource = resources[access.resource];
+			if (resource.firstPass < 0) {
+				resource.firstPass = i;
+				if (resource.transient) {
+					if (!access.write) {
+						return Fail(passes[i].name + ": " + resource.name + ": read before first write");
+					}
+					resource.initialState = access.state;
+				}
+			}
+			resource.lastPass = i;
+		}
+	}
+
+	PlaceTransients();
+
+	std::vector<ResourceState> current(resources.size());
+	for (size_t i = 0; i < resources.size(); i++) {
+		current[i] = resources[i].initialState;
+	}
+
+	for (int i = 0; i < (int)passes.size(); i++) {
+		Pass& pass = passes[i];
+
+		// 𒼑O܂ŎgĂꎞ\[X̐؂ւ
+		for (uint32_t r = 0; r < resources.size(); r++) {
+			Resource& resource = resources[r];
+			if (!resource.transient || resource.firstPass != i) {
+				continue;
+			}
+
+			uint32_t before = INVALID_ID;
+			int beforeLast = -1;
+			for (uint32_t o = 0; o < resources.size(); o++) {
+				Resource& other = resources[o];
+				if (o == r || !other.transient || other.firstPass < 0 || other.lastPass >= i) {
+					continue;
+				}
+				bool overlap = other.offset < resource.offset + resource.desc.size && resource.offset < other.offset + other.desc.size;
+				if (overlap && other.lastPass > beforeLast) {
+					before = o;
+					beforeLast = other.lastPass;
+				}
+			}
+
+			if (before != INVALID_ID) {
+				pass.barriers.push_back({ GraphBarrierType::ALIASING, r, before, ResourceState::COMMON, ResourceState::COMMON });
+				statistics.aliasingBarriers++;
+			}
+		}
+
+		for (auto& access : pass.accesses) {
+			ResourceState required = access.state;
+
+			if (!access.write) {
+				// ɏ܂܂ł̓ǂݍ݂̏Ԃ܂Ƃ߁Aǂނтɐ؂ւȂ悤ɂ
+				for (int j = i + 1; j < (int)passes.size(); j++) {
+					auto next = std::find_if(passes[j].accesses.begin(), passes[j].accesses.end(), [&](const Access& a) { return a.resource == access.resource; });
+					if (next == passes[j].accesses.end()) {
+						continue;
+					}
+					if (next->write) {
+						break;
+					}
+					required = required | next->state;
+				}
+
+				// ̏ԂɕKvȓǂݍׂ݂Ċ܂܂Ăΐ؂ւȂ
+				ResourceState state = current[access.resource];
+				if (required != ResourceState::COMMON && !IsWriteState(state) && ((uint32_t)state & (uint32_t)required) == (uint32_t)required) {
+					continue;
+				}
+			}
+
+			if (current[access.resource] != required) {
+				pass.barriers.push_back({ GraphBarrierType::TRANSITION, access.resource, INVALID_ID, current[access.resource], required });
+				current[access.resource] = required;
+				statistics.transitions++;
+			}
+		}
+
+		if (!pass.barriers.empty()) {
+			statistics.batches++;
+		}
+	}
+
+	// Õ\[X͌߂ꂽԂɁAꎞ\[X͎ɓ̂ĝ߂ɍ쐬̏Ԃɖ߂
+	for (uint32_t r = 0; r < resources.size(); r++) {
+		Resource& resource = resources[r];
+		if (resource.transient && resource.firstPass < 0) {
+			continue;
+		}
+		ResourceState finalState = resource.transient ? resource.initialState : resource.finalState;
+		if (current[r] != finalState) {
+			finalBarriers.push_back({ GraphBarrierType::TRANSITION, r, INVALID_ID, current[r], finalState });
+			statistics.transitions++;
+		}
+	}
+	if (!finalBarriers.empty()) {
+		statistics.batches++;
+	}
+
+	statistics.passes += passes.size();
+	statistics.heapSize = heapSize;
+
+	compiled = true;
+	return true;
+}
+
+void RenderGraph::PlaceTransients() {
+	std::vector<uint32_t> order;
+	uint64_t totalBytes = 0;
+	for (uint32_t r = 0; r < resources.size(); r++) {
+		if (resources[r].transient && resources[r].firstPass >= 0) {
+			order.push_back(r);
+			totalBytes += resources[r].desc.size;
+		}
+	}
+
+	// 傫̂珇ɁAgԂdȂ̂ƔȂԒႢʒuɒu
+	std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return resources[a].desc.size > resources[b].desc.size; });
+
+	std::vector<uint32_t> placed;
+	for (auto r : order) {
+		Resource& resource = resources[r];
+
+		std::vector<std::pair<uint64_t, uint64_t>> used;
+		for (auto p : placed) {
+			Resource& other = resources[p];
+			if (other.firstPass <= resource.lastPass && resource.firstPass <= other.lastPass) {
+				used.push_back({ other.offset, other.offset + other.desc.size });
+			}
+		}
+		std::sort(used.begin(), used.end());
+
+		uint64_t alignment = resource.desc.alignment;
+		uint64_t offset = 0;
+		for (auto& range : used) {
+			if (offset + resource.desc.size <= range.first) {
+				break;
+			}
+			if (range.second > offset) {
+				offset = (range.second + alignment - 1) / alignment * alignment;
+			}
+		}
+
+		resource.offset = offset;
+		if (offset + resource.desc.size > heapSize) {
+			heapSize = offset + resource.desc.size;
+		}
+		placed.push_back(r);
+	}
+
+	statistics.transientBytes = totalBytes;
+}
+
+void RenderGraph::Execute(const std::function<void(const GraphBarrier* barriers, size_t count)>& issue) {
+	for (uint32_t i = 0; i < passes.size(); i++) {
+		ExecutePass(i, issue);
+	}
+	ExecuteFinal(issue);
+}
+
+void RenderGraph::ExecutePass(uint32_t pass, const std::function<void(const GraphBarrier* barriers, size_t count)>& issue) {
+	auto& barriers = passes[pass].barriers;
+	if (!barriers.empty()) {
+		issue(barriers.data(), barriers.size());
+	}
+	if (passes[pass].execute) {
+		passes[pass].execute();
+	}
+}
+
+void RenderGraph::ExecuteFinal(const std::function<void(const GraphBarrier* barriers, size_t count)>& issue) {
+	if (!finalBarriers.empty()) {
+		issue(finalBarriers.data(), finalBarriers.size());
+	}
+}
+
+void RenderGraph::Clear() {
+	resources.clear();
+	passes.clear();
+	finalBarriers.clear();
+	heapSize = 0;
+	compiled = false;
+	error.clear();
+}
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+// \[X̏ԁiD3D12_RESOURCE_STATESւ̕ϊRenderGraphExecutorōsj
+// ǂݍ݂̏Ԃ͂܂Ƃ߂1̏Ԃɂł
+enum class ResourceState : uint32_t {
+	COMMON = 0,
+	PRESENT = 1 << 0,
+	RENDER_TARGET = 1 << 1,
+	COPY_DEST = 1 << 2,
+	PIXEL_SHADER_RESOURCE = 1 << 3,
+	COPY_SOURCE = 1 << 4,
+	VERTEX_AND_CONSTANT_BUFFER = 1 << 5,
+	INDEX_BUFFER = 1 << 6,
+};
+
+inline ResourceState operator|(ResourceState a, ResourceState b) { return (ResourceState)((uint32_t)a | (uint32_t)b); }
+
+enum class GraphBarrierType {
+	TRANSITION,
+	ALIASING
+};
+
+typedef struct GraphBarrier {
+	GraphBarrierType type;
+	uint32_t resource;
+	uint32_t resourceBefore;	// ALIASING̎A𒼑O܂ŎgĂ\[X
+	ResourceState before;
+	ResourceState after;
+};
+
+// pXǂݏ郊\[X錾ƁApX̑OɕKvȃoAvZĂ܂Ƃ߂Ĕs
+// ꎞ\[X͎gԂdȂȂ̓mœg񂷁ifoCXsvj
+class RenderGraph
+{
+public:
+	static const uint32_t INVALID_ID = 0xffffffff;
+
+	typedef struct TransientDesc {
+		uint64_t size;
+		uint64_t alignment;
+	};
+
+	typedef struct Statistics {
+		uint64_t passes;
+		uint64_t transitions;
+		uint64_t aliasingBarriers;
+		uint64_t batches;			// ResourceBarrierĂԉ
+		uint64_t transientBytes;	// g񂳂Ȃꍇ̍v
+		uint64_t heapSize;
+	};
+
+private:
+	typedef struct Resource {
+		std::string name;
+		bool transient;
+		TransientDesc desc;
+		ResourceState initialState;
+		ResourceState finalState;	// Õ\[XOt̍Ōɖ߂
+
+		int firstPass;
+		int lastPass;
+		uint64_t offset;
+	};
+
+	typedef struct Access {
+		uint32_t resource;
+		ResourceState state;
+		bool write;
+	};
+
+	typedef struct Pass {
+		std::string name;
+		std::vector<Access> accesses;
+		std::function<void()> execute;
+		std::vector<GraphBarrier> barriers;
+	};
+
+	std::vector<Resource> resources;
+	std::vector<Pass> passes;
+	std::vector<GraphBarrier> finalBarriers;
+	uint64_t heapSize;
+	bool compiled;
+	std::string error;
+
+	Statistics statistics;
+
+public:
+	RenderGraph();
+
+private:
+	static bool IsWriteState(ResourceState state);
+	bool Fail(const std::string& message);
+	void PlaceTransients();
+
+public:
+	/// <summary>
+	/// Ot̊Oōꂽ\[XiobNobt@Ȃǁjo^
+	/// </summary>
+	uint32_t Import(const std::string& name, ResourceState initialState, ResourceState finalState);
+	/// <summary>
+	/// ̃Ot̒Ŏg\[Xo^B쐬̏Ԃ͍ŏɎg̏Ԃɂ邱
+	/// </summary>
+	uint32_t CreateTransient(const std::string& name, const TransientDesc& desc);
+
+	uint32_t AddPass(const std::string& name, std::function<void()> execute = nullptr);
+	void Read(uint32_t pass, uint32_t resource, ResourceState state);
+	void Write(uint32_t pass, uint32_t resource, ResourceState state);
+
+	/// <summary>
+	/// oAƈꎞ\[X̔zuvZB錾Ɍ肪falseԂGetErrorɗR
+	/// </summary>
+	bool Compile();
+
+	/// <summary>
+	/// pXɎsAepX̑OƍŌɃoA܂Ƃ߂issue֓n
+	/// </summary>
+	void Execute(const std::function<void(const GraphBarrier* barriers, size_t count)>& issue);
+	void ExecutePass(uint32_t pass, const std::function<void(const GraphBarrier* barriers, size_t count)>& issue);
+	void ExecuteFinal(const std::function<void(const GraphBarrier* barriers, size_t count)>& issue);
+
+	void Clear();
+
+	const std::vector<GraphBarrier>& GetBarriers(uint32_t pass) { return passes[pass].barriers; }
+	const std::vector<GraphBarrier>& GetFinalBarriers() { return finalBarriers; }
+	uint64_t GetTransientOffset(uint32_t resource) { return resources[resource].offset; }
+	uint64_t GetTransientHeapSize() { return heapSize; }
+	bool IsTransient(uint32_t resource) { return resources[resource].transient; }
+	ResourceState GetInitialState(uint32_t resource) { return resources[resource].initialState; }
+	size_t GetResourceCount() { return resources.size(); }
+	size_t GetPassCount() { return passes.size(); }
+	bool IsCompiled() { return compiled; }
+	const std::string& GetError() { return error; }
+
+	Statistics GetStatistics() { return statistics; }
+	void ResetStatistics() { statistics = {}; }
+};
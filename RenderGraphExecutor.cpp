@@ -0,0 +1,129 @@
+#include "RenderGraphExecutor.h"
+#include "Debugger.h"
+
+#include <cstring>
+
+using Microsoft::WRL::ComPtr;
+
+RenderGraphExecutor::RenderGraphExecutor(ID3D12Device* device, FrameRing* frameRing) {
+	this->device = device;
+	this->frameRing = frameRing;
+	heapCapacity = 0;
+}
+
+void RenderGraphExecutor::Retire(ID3D12Pageable* object) {
+	retired.Retire(object, frameRing->GetLastSignaledValue() + 1);
+}
+
+void RenderGraphExecutor::BeginFrame() {
+	retired.Release(frameRing->GetCompletedValue());
+}
+
+D3D12_RESOURCE_STATES RenderGraphExecutor::ToD3D12(ResourceState state) {
+	uint32_t bits = (uint32_t)state;
+	D3D12_RESOURCE_STATES result = D3D12_RESOURCE_STATE_COMMON;
+	if (bits & (uint32_t)ResourceState::RENDER_TARGET) result |= D3D12_RESOURCE_STATE_RENDER_TARGET;
+	if (bits & (uint32_t)ResourceState::COPY_DEST) result |= D3D12_RESOURCE_STATE_COPY_DEST;
+	if (bits & (uint32_t)ResourceState::PIXEL_SHADER_RESOURCE) result |= D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
+	if (bits & (uint32_t)ResourceState::COPY_SOURCE) result |= D3D12_RESOURCE_STATE_COPY_SOURCE;
+	if (bits & (uint32_t)ResourceState::VERTEX_AND_CONSTANT_BUFFER) result |= D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER;
+	if (bits & (uint32_t)ResourceState::INDEX_BUFFER) result |= D3D12_RESOURCE_STATE_INDEX_BUFFER;
+	// PRESENTCOMMONƓl
+	return result;
+}
+
+RenderGraph::TransientDesc RenderGraphExecutor::GetTransientDesc(const D3D12_RESOURCE_DESC& desc) {
+	auto info = device->GetResourceAllocationInfo(0, 1, &desc);
+	return { info.SizeInBytes, info.Alignment };
+}
+
+void RenderGraphExecutor::SetResource(uint32_t id, ID3D12Resource* resource) {
+	if (id >= resources.size()) {
+		resources.resize(id + 1, nullptr);
+	}
+	resources[id] = resource;
+}
+
+void RenderGraphExecutor::PlaceTransient(RenderGraph& graph, uint32_t id, const D3D12_RESOURCE_DESC& desc, const D3D12_CLEAR_VALUE* clearValue) {
+	if (graph.GetTransientHeapSize() > heapCapacity) {
+		if (heap != nullptr) {
+			Retire(heap.Get());
+		}
+		for (auto& entry : placed) {
+			if (entry.resource != nullptr) {
+				Retire(entry.resource.Get());
+			}
+			entry.resource = nullptr;
+		}
+
+		D3D12_HEAP_DESC heapDesc = {};
+		heapDesc.SizeInBytes = graph.GetTransientHeapSize();
+		heapDesc.Properties.Type = D3D12_HEAP_TYPE_DEFAULT;
+		heapDesc.Alignment = D3D12_DEFAULT_MSAA_RESOURCE_PLACEMENT_ALIGNMENT;
+		heapDesc.Flags = D3D12_HEAP_FLAG_ALLOW_ONLY_RT_DS_TEXTURES;
+		Debugger::ErrorCheck(device->CreateHeap(&heapDesc, IID_PPV_ARGS(heap.ReleaseAndGetAddressOf())));
+		heapCapacity = heapDesc.SizeInBytes;
+	}
+
+	if (id >= placed.size()) {
+		placed.resize(id + 1);
+	}
+
+	Placed& entry = placed[id];
+	uint64_t offset = graph.GetTransientOffset(id);
+	if (entry.resource == nullptr || entry.offset != offset || std::memcmp(&entry.desc, &desc, sizeof(desc)) != 0) {
+		if (entry.resource != nullptr) {
+			Retire(entry.resource.Get());
+		}
+		entry.offset = offset;
+		entry.desc = desc;
+		Debugger::ErrorCheck(device->CreatePlacedResource(heap.Get(), offset, &desc, ToD3D12(graph.GetInitialState(id)), clearValue, IID_PPV_ARGS(entry.resource.ReleaseAndGetAddressOf())));
+	}
+
+	SetResource(id, entry.resource.Get());
+}
+
+void RenderGraphExecutor::Execute(RenderGraph& graph, ID3D12GraphicsCommandList* cmdList) {
+	graph.Execute([&](const GraphBarrier* graphBarriers, size_t count) { Issue(graphBarriers, count, cmdList); });
+}
+
+void RenderGraphExecutor::ExecutePass(RenderGraph& graph, uint32_t pass, ID3D12GraphicsCommandList* cmdList) {
+	graph.ExecutePass(pass, [&](const GraphBarrier* graphBarriers, size_t count) { Issue(graphBarriers, count, cmdList); });
+}
+
+void RenderGraphExecutor::ExecuteFinal(RenderGraph& graph, ID3D12GraphicsCommandList* cmdList) {
+	graph.ExecuteFinal([&](const GraphBarrier* graphBarriers, size_t count) { Issue(graphBarriers, count, cmdList); });
+}
+
+void RenderGraphExecutor::Issue(const GraphBarrier* graphBarriers, size_t count, ID3D12GraphicsCommandList* cmdList) {
+	barriers.clear();
+	for (size_t i = 0; i < count; i++) {
+		const GraphBarrier& graphBarrier = graphBarriers[i];
+
+		D3D12_RESOURCE_BARRIER barrier = {};
+		if (graphBarrier.type == GraphBarrierType::ALIASING) {
+			barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_ALIASING;
+			barrier.Aliasing.pResourceBefore = GetResource(graphBarrier.resourceBefore);
+			barrier.Aliasing.pResourceAfter = GetResource(graphBarrier.resource);
+		}
+		else {
+			D3D12_RESOURCE_STATES before = ToD3D12(graphBarrier.before);
+			D3D12_RESOURCE_STATES after = ToD3D12(graphBarrier.after);
+			// PRESENTCOMMON̊Ԃ̐؂ւȂD3D12ł͓ԂɂȂ̂͏Ȃ
+			if (before == after) {
+				continue;
+			}
+			barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+			barrier.Transition.pResource = GetResource(graphBarrier.resource);
+			barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+			barrier.Transition.StateBefore = before;
+			barrier.Transition.StateAfter = after;
+		}
+		barriers.push_back(barrier);
+	}
+
+	// 1̃pX̑ÕoA1̌Ăяoł܂Ƃ߂Ĕs
+	if (!barriers.empty()) {
+		cmdList->ResourceBarrier((UINT)barriers.size(), barriers.data());
+	}
+}
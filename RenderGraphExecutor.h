@@ -0,0 +1,68 @@
+#pragma once
+
+#include <wrl.h>
+#include <d3d12.h>
+#include "RenderGraph.h"
+#include "FrameRing.h"
+
+#include <vector>
+
+// RenderGraph̃oAD3D12̃R}hXgɔsAꎞ\[X1̃q[vɔzu
+class RenderGraphExecutor
+{
+private:
+	typedef struct Placed {
+		Microsoft::WRL::ComPtr<ID3D12Resource> resource;
+		uint64_t offset;
+		D3D12_RESOURCE_DESC desc;
+	};
+
+	ID3D12Device* device;
+	FrameRing* frameRing;
+	Microsoft::WRL::ComPtr<ID3D12Heap> heap;
+	uint64_t heapCapacity;
+	// 蒼Õq[vƃ\[X́AL^̃t[GPUgI܂Ŏc
+	FrameRetireList<Microsoft::WRL::ComPtr<ID3D12Pageable>> retired;
+
+	std::vector<ID3D12Resource*> resources;
+	std::vector<Placed> placed;
+	std::vector<D3D12_RESOURCE_BARRIER> barriers;
+
+public:
+	RenderGraphExecutor(ID3D12Device* device, FrameRing* frameRing);
+
+private:
+	void Retire(ID3D12Pageable* object);
+
+public:
+	static D3D12_RESOURCE_STATES ToD3D12(ResourceState state);
+	/// <summary>
+	/// CreateTransientɓn傫iꎞ\[X̓_[^[Qbg̃eNX`Ɍj
+	/// </summary>
+	RenderGraph::TransientDesc GetTransientDesc(const D3D12_RESOURCE_DESC& desc);
+
+	/// <summary>
+	/// Import\[X̎̂ݒ肷
+	/// </summary>
+	void SetResource(uint32_t id, ID3D12Resource* resource);
+
+	/// <summary>
+	/// CompileɈꎞ\[Xq[vɍiʒuƓeOƓȂ蒼Ȃj
+	/// </summary>
+	void PlaceTransient(RenderGraph& graph, uint32_t id, const D3D12_RESOURCE_DESC& desc, const D3D12_CLEAR_VALUE* clearValue = nullptr);
+
+	ID3D12Resource* GetResource(uint32_t id) { return id < resources.size() ? resources[id] : nullptr; }
+
+	/// <summary>
+	/// t[JnɌĂсAGPUgIÂq[vƃ\[X
+	/// </summary>
+	void BeginFrame();
+
+	void Execute(RenderGraph& graph, ID3D12GraphicsCommandList* cmdList);
+	void ExecutePass(RenderGraph& graph, uint32_t pass, ID3D12GraphicsCommandList* cmdList);
+	void ExecuteFinal(RenderGraph& graph, ID3D12GraphicsCommandList* cmdList);
+	void Issue(const GraphBarrier* graphBarriers, size_t count, ID3D12GraphicsCommandList* cmdList);
+
+	uint64_t GetHeapCapacity() { return heapCapacity; }
+	size_t GetRetiredCount() { return retired.GetCount(); }
+};
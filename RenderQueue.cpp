@@ -0,0 +1,91 @@
+#include "RenderQueue.h"
+
+#include <cstring>
+
+RenderQueue::RenderQueue() {
+	for (auto& flag : painterOrder) {
+		flag = false;
+	}
+	sequence = 0;
+	statistics = {};
+}
+
+void RenderQueue::SetPainterOrder(int layer, bool enable) {
+	painterOrder[layer & (MAX_LAYERS - 1)] = enable;
+}
+
+uint32_t RenderQueue::DepthToBits(float depth) {
+	// _̃rbg𕄍ȂƂđ召rł`ɂ
+	uint32_t bits;
+	std::memcpy(&bits, &depth, sizeof(bits));
+	return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+}
+
+void RenderQueue::Push(int layer, uint32_t pipeline, uint32_t texture, float depth, uint32_t payload) {
+	uint64_t layerBits = (uint64_t)(layer & (MAX_LAYERS - 1)) << 56;
+
+	Item item;
+	item.payload = payload;
+	item.pipeline = pipeline;
+	item.texture = texture;
+
+	if (painterOrder[layer & (MAX_LAYERS - 1)]) {
+		item.key = layerBits | (sequence & 0x00ffffffffffffffull);
+	}
+	else {
+		item.key = layerBits |
+			((uint64_t)(pipeline & (MAX_PIPELINES - 1)) << 52) |
+			((uint64_t)(texture & (MAX_TEXTURES - 1)) << 32) |
+			(uint64_t)DepthToBits(depth);
+	}
+	sequence++;
+
+	items.push_back(item);
+}
+
+void RenderQueue::CountChanges(const std::vector<Item>& items, uint64_t& pipelineChanges, uint64_t& textureChanges) {
+	for (size_t i = 0; i < items.size(); i++) {
+		if (i == 0 || items[i].pipeline != items[i - 1].pipeline) {
+			pipelineChanges++;
+		}
+		if (i == 0 || items[i].texture != items[i - 1].texture) {
+			textureChanges++;
+		}
+	}
+}
+
+void RenderQueue::Sort() {
+	statistics.items += items.size();
+	CountChanges(items, statistics.pipelineChangesBefore, statistics.textureChangesBefore);
+
+	// 8bitLSD\[giȂ̂œL[͓o^̂܂܁j
+	scratch.resize(items.size());
+	for (int shift = 0; shift < 64; shift += 8) {
+		size_t counts[257] = {};
+		bool sorted = true;
+		for (size_t i = 0; i < items.size(); i++) {
+			counts[((items[i].key >> shift) & 0xff) + 1]++;
+			if (i > 0 && ((items[i].key >> shift) & 0xff) != ((items[0].key >> shift) & 0xff)) {
+				sorted = false;
+			}
+		}
+		// Svfł̌ȂבւKv
+		if (sorted) {
+			continue;
+		}
+		for (int i = 0; i < 256; i++) {
+			counts[i + 1] += counts[i];
+		}
+		for (size_t i = 0; i < items.size(); i++) {
+			scratch[counts[(items[i].key >> shift) & 0xff]++] = items[i];
+		}
+		items.swap(scratch);
+	}
+
+	CountChanges(items, statistics.pipelineChangesAfter, statistics.textureChangesAfter);
+}
+
+void RenderQueue::Clear() {
+	items.clear();
+	sequence = 0;
+}
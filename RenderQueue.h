@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// 64bit̃\[gL[ŕ`揇בւL[
+// [63..56] C[  [55..52] pCvC  [51..32] eNX`  [31..0] [x
+// `揇ŒiyC^[jɂC[ [55..0] ɓo^
+class RenderQueue
+{
+public:
+	static const int MAX_LAYERS = 256;
+	static const uint32_t MAX_PIPELINES = 16;
+	static const uint32_t MAX_TEXTURES = 1 << 20;
+
+	typedef struct Item {
+		uint64_t key;
+		uint32_t payload;
+		uint32_t pipeline;
+		uint32_t texture;
+	};
+
+	typedef struct Statistics {
+		uint64_t items;
+		uint64_t pipelineChangesBefore;
+		uint64_t pipelineChangesAfter;
+		uint64_t textureChangesBefore;
+		uint64_t textureChangesAfter;
+	};
+
+private:
+	std::vector<Item> items;
+	std::vector<Item> scratch;
+	bool painterOrder[MAX_LAYERS];
+	uint64_t sequence;
+
+	Statistics statistics;
+
+public:
+	RenderQueue();
+
+private:
+	static uint32_t DepthToBits(float depth);
+	static void CountChanges(const std::vector<Item>& items, uint64_t& pipelineChanges, uint64_t& textureChanges);
+
+public:
+	void SetPainterOrder(int layer, bool enable);
+	bool IsPainterOrder(int layer) { return painterOrder[layer & (MAX_LAYERS - 1)]; }
+
+	void Push(int layer, uint32_t pipeline, uint32_t texture, float depth, uint32_t payload);
+	void Sort();
+	void Clear();
+
+	const std::vector<Item>& GetItems() { return items; }
+	size_t GetCount() { return items.size(); }
+
+	Statistics GetStatistics() { return statistics; }
+	void ResetStatistics() { statistics = {}; }
+};
@@ -1,13 +1,46 @@
 #include "Renderer.h"
+#include "CommandListPool.h"
 #include "Debugger.h"
+#include "DescriptorAllocator.h"
+#include "FrameRing.h"
+#include "InstanceBatch.h"
+#include "QueueFence.h"
+#include "RenderGraphExecutor.h"
+#include "Shape.h"
+#include "Line.h"
+#include "Texture.h"
+#include "Text.h"
+#include "TextureStreamer.h"
+#include "ThreadPool.h"
 
 #include "d3dx12.h"
 
+// FxCompilẽwb_[ói$(IntDir)ɏo͂j
+#include "InstancedVertexShader.h"
+#include "SpritePixelShader.h"
+
+#include <chrono>
 #include <string>
 
 using Microsoft::WRL::ComPtr;
 
-Renderer::Renderer(int width, int height, HWND hwnd) {
+namespace {
+	// 쐬pCvC̃LbVist@CƓꏊɕۑj
+	const char* PIPELINE_CACHE_FILE = "PipelineCache.bin";
+}
+
+Renderer::Renderer(int width, int height, HWND hwnd, int frameCount) {
+	// obNobt@̐t[𓯎ɏitbvf͍Œ2j
+	if (frameCount < 2) {
+		frameCount = 2;
+	}
+	if (frameCount > DXGI_MAX_SWAP_CHAIN_BUFFERS) {
+		frameCount = DXGI_MAX_SWAP_CHAIN_BUFFERS;
+	}
+	this->frameCount = frameCount;
+	frameIndex = 0;
+	blendMode = BlendMode::DISABLED;
+
 	Debugger::ErrorCheck(CoInitializeEx(nullptr, COINIT_APARTMENTTHREADED | COINIT_DISABLE_OLE1DDE));
 	
 #ifdef _DEBUG
@@ -27,8 +60,14 @@ Renderer::Renderer(int width, int height, HWND hwnd) {
 	CreateGraphicsPipeline();
 	CreateRenderTarget();
 
-	fenceVal = 0;
-	Debugger::ErrorCheck(device->CreateFence(fenceVal, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(fence.ReleaseAndGetAddressOf())));
+	fence = std::make_unique<QueueFence>(device.Get(), cmdQueue.Get());
+	frameRing = std::make_unique<FrameRing>(fence.get(), this->frameCount);
+
+	graphExecutor = std::make_unique<RenderGraphExecutor>(device.Get(), frameRing.get());
+	ResetFrameGraph();
+
+	frameIndex = swapchain->GetCurrentBackBufferIndex();
+	frameRing->BeginFrame(frameIndex);
 
 	viewPort.Width = width;
 	viewPort.Height = height;
@@ -42,43 +81,50 @@ Renderer::Renderer(int width, int height, HWND hwnd) {
 	scissorRect.right = width;
 	scissorRect.bottom = height;
 
-	{
-		D3D12_DESCRIPTOR_HEAP_DESC descHeapDesc = {};
-		descHeapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;	// VF[_[猩悤ɂ
-		descHeapDesc.NodeMask = 0;										// }XN0
-		descHeapDesc.NumDescriptors = 1;
-		descHeapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;		// VF[_[\[Xr[p
-		Debugger::ErrorCheck(device->CreateDescriptorHeap(&descHeapDesc, IID_PPV_ARGS(&basicDescHeap)));
+	viewCuller.SetViewRect(viewPort.TopLeftX, viewPort.TopLeftY, viewPort.TopLeftX + viewPort.Width, viewPort.TopLeftY + viewPort.Height);
+	culling = true;
 
+	DescriptorAllocator::Initialize(device.Get(), frameRing.get());
+	DescriptorAllocator::BeginFrame(frameIndex);
+	ResourceAllocator::Initialize(device.Get(), frameRing.get());
+
+	{
 		DirectX::XMMATRIX matrix = DirectX::XMMatrixIdentity();
 		matrix.r[0].m128_f32[0] = 2.0f / (float)width;
 		matrix.r[1].m128_f32[1] = -2.0f / (float)height;
 		matrix.r[3].m128_f32[0] = -1.0f;
 		matrix.r[3].m128_f32[1] = 1.0f;
 
-		D3D12_HEAP_PROPERTIES heapprop = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD);
-		D3D12_RESOURCE_DESC resourceDesc = CD3DX12_RESOURCE_DESC::Buffer((sizeof(matrix) + 0xff) & ~0xff);
-
-		Debugger::ErrorCheck(device->CreateCommittedResource(&heapprop, D3D12_HEAP_FLAG_NONE, &resourceDesc, D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(constBuffer.ReleaseAndGetAddressOf())));
-
-		DirectX::XMMATRIX* mapMatrix;
-		Debugger::ErrorCheck(constBuffer->Map(0, nullptr, (void**)&mapMatrix));
-		*mapMatrix = matrix;
-		constBuffer->Unmap(0, nullptr);
+		constBuffer = ResourceAllocator::AllocateBuffer((sizeof(matrix) + 0xff) & ~0xff);
+		*reinterpret_cast<DirectX::XMMATRIX*>(constBuffer.cpuAddress) = matrix;
 
 		D3D12_CONSTANT_BUFFER_VIEW_DESC cbvDesc = {};
-		cbvDesc.BufferLocation = constBuffer->GetGPUVirtualAddress();
-		cbvDesc.SizeInBytes = constBuffer->GetDesc().Width;
+		cbvDesc.BufferLocation = constBuffer.gpuAddress;
+		cbvDesc.SizeInBytes = (UINT)constBuffer.size;
 
-		device->CreateConstantBufferView(&cbvDesc, basicDescHeap->GetCPUDescriptorHandleForHeapStart());
+		viewDescriptor = DescriptorAllocator::Allocate();
+		device->CreateConstantBufferView(&cbvDesc, DescriptorAllocator::GetCpuHandle(viewDescriptor));
 	}
 
 	graphicsMemory = std::make_unique<DirectX::GraphicsMemory>(device.Get());
+
+	instanceBatch = std::make_unique<InstanceBatch>(device.Get());
+
+	commandLists = std::make_unique<CommandListPool>(device.Get(), this->frameCount);
+	commandLists->BeginFrame(frameIndex);
+	recordThreads = std::make_unique<ThreadPool>();
+	recordStatistics = {};
+
+	textureStreamer = std::make_unique<TextureStreamer>(device.Get());
 }
 
 Renderer::~Renderer() {
 	RunCommand();
 
+	textureStreamer.reset();
+	DescriptorAllocator::Finalize();
+	ResourceAllocator::Finalize();
+
 	CoUninitialize();
 }
 
@@ -123,9 +169,13 @@ void Renderer::CreateDevice() {
 }
 
 void Renderer::CreateCommand() {
-	Debugger::ErrorCheck(device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(cmdAllocator.ReleaseAndGetAddressOf())));
+	cmdAllocators.resize(frameCount);
+	for (auto& allocator : cmdAllocators) {
+		Debugger::ErrorCheck(device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(allocator.ReleaseAndGetAddressOf())));
+	}
 
-	Debugger::ErrorCheck(device->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_DIRECT, cmdAllocator.Get(), nullptr, IID_PPV_ARGS(cmdList.ReleaseAndGetAddressOf())));
+	Debugger::ErrorCheck(device->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_DIRECT, cmdAllocators[0].Get(), nullptr, IID_PPV_ARGS(mainCmdList.ReleaseAndGetAddressOf())));
+	cmdList = mainCmdList;
 
 	D3D12_COMMAND_QUEUE_DESC desc = {};
 	desc.Flags = D3D12_COMMAND_QUEUE_FLAG_NONE;
@@ -146,7 +196,7 @@ void Renderer::CreateSwapChain(int width, int height, HWND hwnd) {
 	desc.SampleDesc.Quality = 0;
 
 	desc.BufferUsage = DXGI_USAGE_BACK_BUFFER;
-	desc.BufferCount = 2;
+	desc.BufferCount = frameCount;
 
 	desc.Scaling = DXGI_SCALING_STRETCH;
 	desc.SwapEffect = DXGI_SWAP_EFFECT_FLIP_DISCARD;
@@ -157,10 +207,9 @@ void Renderer::CreateSwapChain(int width, int height, HWND hwnd) {
 }
 
 void Renderer::CreateRootSignature() {
-	D3D12_DESCRIPTOR_RANGE range[3];
+	D3D12_DESCRIPTOR_RANGE range[2];
 	range[0] = CD3DX12_DESCRIPTOR_RANGE(D3D12_DESCRIPTOR_RANGE_TYPE_CBV, 1, 0);	// Wϊs
-	range[1] = CD3DX12_DESCRIPTOR_RANGE(D3D12_DESCRIPTOR_RANGE_TYPE_CBV, 1, 1);	// Ws
-	range[2] = CD3DX12_DESCRIPTOR_RANGE(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 0);	// eNX`
+	range[1] = CD3DX12_DESCRIPTOR_RANGE(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 0);	// eNX`
 
 	D3D12_ROOT_PARAMETER rootParam[3] = {};
 	rootParam[0].ParameterType = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
@@ -168,14 +217,15 @@ void Renderer::CreateRootSignature() {
 	rootParam[0].DescriptorTable.pDescriptorRanges = &range[0];
 	rootParam[0].DescriptorTable.NumDescriptorRanges = 1;
 
-	rootParam[1].ParameterType = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
+	// Ws̓t[ƂGraphicsMemory֏݁AGPUAhXŒړn
+	rootParam[1].ParameterType = D3D12_ROOT_PARAMETER_TYPE_CBV;
 	rootParam[1].ShaderVisibility = D3D12_SHADER_VISIBILITY_ALL;
-	rootParam[1].DescriptorTable.pDescriptorRanges = &range[1];
-	rootParam[1].DescriptorTable.NumDescriptorRanges = 1;
+	rootParam[1].Descriptor.ShaderRegister = 1;
+	rootParam[1].Descriptor.RegisterSpace = 0;
 
 	rootParam[2].ParameterType = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
 	rootParam[2].ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL;
-	rootParam[2].DescriptorTable.pDescriptorRanges = &range[2];
+	rootParam[2].DescriptorTable.pDescriptorRanges = &range[1];
 	rootParam[2].DescriptorTable.NumDescriptorRanges = 1;
 
 	D3D12_STATIC_SAMPLER_DESC samplerDesc = {};
@@ -183,7 +233,7 @@ void Renderer::CreateRootSignature() {
 	samplerDesc.AddressV = D3D12_TEXTURE_ADDRESS_MODE_WRAP;
 	samplerDesc.AddressW = D3D12_TEXTURE_ADDRESS_MODE_WRAP;
 	samplerDesc.BorderColor = D3D12_STATIC_BORDER_COLOR_TRANSPARENT_BLACK;
-	samplerDesc.Filter = D3D12_FILTER_COMPARISON_MIN_MAG_MIP_LINEAR;
+	samplerDesc.Filter = D3D12_FILTER_MIN_MAG_MIP_LINEAR;	// rp̃tB^[Sampleł͎gȂ
 	samplerDesc.MaxLOD = D3D12_FLOAT32_MAX;
 	samplerDesc.MinLOD = 0;
 	samplerDesc.ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL;
@@ -205,13 +255,8 @@ void Renderer::CreateRootSignature() {
 }
 
 void Renderer::CreateGraphicsPipeline() {
-	D3D12_INPUT_ELEMENT_DESC inputLayout[] = {
-		{"POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
-		{"COLOR", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
-		{"TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
-	};
-
-    std::vector<BYTE> g_BasicVS = {
+	// pCvCWXgŌ܂ŎQƂ̂staticɂĂ
+    static const std::vector<BYTE> g_BasicVS = {
          68,  88,  66,  67, 255, 154,
          88, 156, 143, 108,  39, 166,
         159, 238, 217,  76, 228,  21,
@@ -513,7 +558,7 @@ void Renderer::CreateGraphicsPipeline() {
           0,   0,   0,   0,   0,   0,
           0,   0,   0,   0,   0,   0
     };
-    std::vector<BYTE> g_BasicPS = {
+    static const std::vector<BYTE> g_BasicPS = {
          68,  88,  66,  67,  36,  58,
          14, 220, 252, 208,  40, 172,
         150,  46,  66,  26, 178,  86,
@@ -611,7 +656,7 @@ void Renderer::CreateGraphicsPipeline() {
           0,   0,   0,   0,   0,   0,
           0,   0
     };
-    std::vector<BYTE> g_TexturePS = {
+    static const std::vector<BYTE> g_TexturePS = {
          68,  88,  66,  67, 204,  43,
         143, 105, 248,  28, 182, 110,
          41, 239, 156,  30, 171, 233,
@@ -727,49 +772,25 @@ void Renderer::CreateGraphicsPipeline() {
           0,   0,   0,   0
     };
 
-	D3D12_RENDER_TARGET_BLEND_DESC blend = {};
-	blend.BlendEnable = false;
-	blend.LogicOpEnable = false;
-	blend.RenderTargetWriteMask = D3D12_COLOR_WRITE_ENABLE_ALL;
-
-	D3D12_GRAPHICS_PIPELINE_STATE_DESC desc = {};
-	desc.pRootSignature = rootSignature.Get();
-    desc.VS = { g_BasicVS.data(), g_BasicVS.size() };
-	desc.PS = { g_TexturePS.data(), g_TexturePS.size() };
-
-	desc.SampleMask = D3D12_DEFAULT_SAMPLE_MASK;
-
-	desc.RasterizerState.MultisampleEnable = false;
-	desc.RasterizerState.CullMode = D3D12_CULL_MODE_NONE;
-	desc.RasterizerState.FillMode = D3D12_FILL_MODE_SOLID;
-	desc.RasterizerState.DepthClipEnable = true;
-
-	desc.BlendState.AlphaToCoverageEnable = false;
-	desc.BlendState.IndependentBlendEnable = false;
-	desc.BlendState.RenderTarget[0] = blend;
-
-	desc.InputLayout.pInputElementDescs = inputLayout;
-	desc.InputLayout.NumElements = _countof(inputLayout);
-
-	desc.IBStripCutValue = D3D12_INDEX_BUFFER_STRIP_CUT_VALUE_DISABLED;
-	desc.PrimitiveTopologyType = D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE;
-	desc.NumRenderTargets = 1;
-	desc.RTVFormats[0] = DXGI_FORMAT_R8G8B8A8_UNORM;
-
-	desc.SampleDesc.Count = 1;
-	desc.SampleDesc.Quality = 0;
-
-	Debugger::ErrorCheck(device->CreateGraphicsPipelineState(&desc, IID_PPV_ARGS(texturePipeline.ReleaseAndGetAddressOf())));
-
-	desc.PS = { g_BasicPS.data(), g_BasicPS.size() };
-	Debugger::ErrorCheck(device->CreateGraphicsPipelineState(&desc, IID_PPV_ARGS(pipeline.ReleaseAndGetAddressOf())));
+	pipelines = std::make_unique<PipelineRegistry>(device.Get(), rootSignature.Get(), PIPELINE_CACHE_FILE);
+	pipelines->RegisterShader(PipelineShader::BASIC_VS, g_BasicVS.data(), g_BasicVS.size());
+	pipelines->RegisterShader(PipelineShader::INSTANCED_VS, g_InstancedVS, sizeof(g_InstancedVS));
+	pipelines->RegisterShader(PipelineShader::BASIC_PS, g_BasicPS.data(), g_BasicPS.size());
+	pipelines->RegisterShader(PipelineShader::TEXTURE_PS, g_TexturePS.data(), g_TexturePS.size());
+	pipelines->RegisterShader(PipelineShader::SPRITE_PS, g_SpritePS, sizeof(g_SpritePS));
+
+	// Oggݍ킹ƁAKggݍ킹͕`悪n܂OɍĂ
+	pipelines->Warm();
+	pipelines->Get(MakeKey(PipelineShader::BASIC_VS, PipelineShader::BASIC_PS));
+	pipelines->Get(MakeKey(PipelineShader::BASIC_VS, PipelineShader::TEXTURE_PS));
+	pipelines->Get(MakeKey(PipelineShader::INSTANCED_VS, PipelineShader::BASIC_PS));
 }
 
 void Renderer::CreateRenderTarget() {
 	D3D12_DESCRIPTOR_HEAP_DESC heapDesc = {};
 	heapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_RTV;
 	heapDesc.NodeMask = 0;
-	heapDesc.NumDescriptors = 2;
+	heapDesc.NumDescriptors = frameCount;
 	heapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
 
 	Debugger::ErrorCheck(device->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(rtvHeaps.ReleaseAndGetAddressOf())));
@@ -791,65 +812,448 @@ void Renderer::CreateRenderTarget() {
 }
 
 void Renderer::BeginDraw() {
+	// ]IeNX`̃t[g
+	textureStreamer->Update();
+
+	viewCuller.ResetStatistics();
+
 	auto index = swapchain->GetCurrentBackBufferIndex();
 
-	auto barrier = CD3DX12_RESOURCE_BARRIER::Transition(backBuffer[index].Get(), D3D12_RESOURCE_STATE_PRESENT, D3D12_RESOURCE_STATE_RENDER_TARGET);
-	cmdList->ResourceBarrier(1, &barrier);
+	// BeginDraw܂łɒǉꂽpX̌ɁAobNobt@֕`V[̃pXu
+	graphExecutor->SetResource(backBufferResource, backBuffer[index].Get());
+	scenePass = frameGraph.AddPass("Scene");
+	frameGraph.Write(scenePass, backBufferResource, ResourceState::RENDER_TARGET);
+	for (auto& read : sceneReads) {
+		frameGraph.Read(scenePass, read.first, read.second);
+	}
+	if (!frameGraph.Compile()) {
+		OutputDebugStringA(frameGraph.GetError().c_str());
+		Debugger::ErrorCheck(E_INVALIDARG);
+	}
+	for (auto& target : frameTargets) {
+		graphExecutor->PlaceTransient(frameGraph, target.resource, target.desc, target.hasClearValue ? &target.clearValue : nullptr);
+	}
+
+	currentRtv = rtvHeaps->GetCPUDescriptorHandleForHeapStart();
+	currentRtv.ptr += index * device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_RTV);
 
-	auto rtvH = rtvHeaps->GetCPUDescriptorHandleForHeapStart();
-	rtvH.ptr += index * device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_RTV);
+	SetupCommandList(cmdList.Get());
+	for (uint32_t pass = 0; pass < scenePass; pass++) {
+		graphExecutor->ExecutePass(frameGraph, pass, cmdList.Get());
+	}
+	graphExecutor->ExecutePass(frameGraph, scenePass, cmdList.Get());
 
-	cmdList->OMSetRenderTargets(1, &rtvH, false, nullptr);
+	// ÕpX_[^[QbgȂǂςĂĂǂ悤ɐݒ肵
+	SetupCommandList(cmdList.Get());
 
 	float clearColor[] = { 0.0f, 0.0f, 0.0f, 1.0f };
-	cmdList->ClearRenderTargetView(rtvH, clearColor, 0, nullptr);
+	cmdList->ClearRenderTargetView(currentRtv, clearColor, 0, nullptr);
 
-	cmdList->RSSetViewports(1, &viewPort);
-	cmdList->RSSetScissorRects(1, &scissorRect);
+	SetPipeline(MakeKey(PipelineShader::BASIC_VS, PipelineShader::BASIC_PS));
+}
 
-	cmdList->SetPipelineState(pipeline.Get());
+void Renderer::ResetFrameGraph() {
+	frameGraph.Clear();
+	frameTargets.clear();
+	sceneReads.clear();
+	backBufferResource = frameGraph.Import("BackBuffer", ResourceState::PRESENT, ResourceState::PRESENT);
+	scenePass = RenderGraph::INVALID_ID;
+}
 
-	cmdList->SetGraphicsRootSignature(rootSignature.Get());
+uint32_t Renderer::AddFramePass(const std::string& name, std::function<void(ID3D12GraphicsCommandList* list)> execute) {
+	return frameGraph.AddPass(name, [this, execute] { execute(cmdList.Get()); });
+}
 
-	cmdList->SetDescriptorHeaps(1, basicDescHeap.GetAddressOf());
+uint32_t Renderer::CreateFrameTarget(const std::string& name, const D3D12_RESOURCE_DESC& desc, const D3D12_CLEAR_VALUE* clearValue) {
+	FrameTarget target = {};
+	target.resource = frameGraph.CreateTransient(name, graphExecutor->GetTransientDesc(desc));
+	target.desc = desc;
+	target.hasClearValue = clearValue != nullptr;
+	if (clearValue != nullptr) {
+		target.clearValue = *clearValue;
+	}
+	frameTargets.push_back(target);
+	return target.resource;
+}
 
-	cmdList->SetGraphicsRootDescriptorTable(0, basicDescHeap->GetGPUDescriptorHandleForHeapStart());
+ID3D12Resource* Renderer::GetFrameResource(uint32_t resource) {
+	return graphExecutor->GetResource(resource);
+}
+
+void Renderer::SetupCommandList(ID3D12GraphicsCommandList* list) {
+	list->OMSetRenderTargets(1, &currentRtv, false, nullptr);
+
+	list->RSSetViewports(1, &viewPort);
+	list->RSSetScissorRects(1, &scissorRect);
+
+	list->SetGraphicsRootSignature(rootSignature.Get());
+
+	// fBXNv^q[v͑SIuWFNgŋLĂ̂ŃXg̍ŏɈxݒ肷
+	ID3D12DescriptorHeap* descHeaps[] = { DescriptorAllocator::GetHeap() };
+	list->SetDescriptorHeaps(1, descHeaps);
+
+	list->SetGraphicsRootDescriptorTable(0, DescriptorAllocator::GetGpuHandle(viewDescriptor));
 }
 
 void Renderer::EndDraw() {
+	FlushQueue();
+	FlushSprites();
 
-	auto index = swapchain->GetCurrentBackBufferIndex();
+	// obNobt@PRESENTɖ߂
+	graphExecutor->ExecuteFinal(frameGraph, cmdList.Get());
+	ResetFrameGraph();
 
-	auto barrier = CD3DX12_RESOURCE_BARRIER::Transition(backBuffer[index].Get(), D3D12_RESOURCE_STATE_RENDER_TARGET, D3D12_RESOURCE_STATE_PRESENT);
-	cmdList->ResourceBarrier(1, &barrier);
+	cmdList->Close();
 
-	RunCommand();
+	// RecordParallelŕXgL^1Ŏs
+	submitLists.push_back(cmdList.Get());
+	cmdQueue->ExecuteCommandLists((UINT)submitLists.size(), submitLists.data());
+	submitLists.clear();
 
 	swapchain->Present(1, 0);
 
 	graphicsMemory->Commit(cmdQueue.Get());
+
+	frameRing->EndFrame();
+
+	// ɎgobNobt@̑O񕪂҂AGPȔƏd˂Ď̃t[L^
+	frameIndex = swapchain->GetCurrentBackBufferIndex();
+	frameRing->BeginFrame(frameIndex);
+	DescriptorAllocator::BeginFrame(frameIndex);
+	ResourceAllocator::BeginFrame();
+	commandLists->BeginFrame(frameIndex);
+	graphExecutor->BeginFrame();
+
+	cmdList = mainCmdList;
+	cmdAllocators[frameIndex]->Reset();
+	cmdList->Reset(cmdAllocators[frameIndex].Get(), nullptr);
 }
 
 void Renderer::RunCommand() {
 	cmdList->Close();
 
-	ID3D12CommandList* cmdLists[] = { cmdList.Get() };
-	cmdQueue->ExecuteCommandLists(1, cmdLists);
-	cmdQueue->Signal(fence.Get(), ++fenceVal);
-	while (fence->GetCompletedValue() != fenceVal) {
-		auto event = CreateEvent(nullptr, false, false, nullptr);
-		fence->SetEventOnCompletion(fenceVal, event);
-		WaitForSingleObject(event, INFINITE);
-		CloseHandle(event);
-	}
-	cmdAllocator->Reset();
-	cmdList->Reset(cmdAllocator.Get(), nullptr);
+	submitLists.push_back(cmdList.Get());
+	cmdQueue->ExecuteCommandLists((UINT)submitLists.size(), submitLists.data());
+	submitLists.clear();
+
+	// GPȔׂďI܂ő҂
+	frameRing->Flush();
+
+	cmdList = mainCmdList;
+	cmdAllocators[frameIndex]->Reset();
+	cmdList->Reset(cmdAllocators[frameIndex].Get(), nullptr);
+}
+
+UINT64 Renderer::GetFrameFenceValue(UINT index) {
+	return frameRing->GetFenceValue(index);
+}
+
+UINT64 Renderer::GetCompletedFenceValue() {
+	return frameRing->GetCompletedValue();
+}
+
+PipelineKey Renderer::MakeKey(PipelineShader vertexShader, PipelineShader pixelShader, PipelineTopology topology) {
+	PipelineKey key;
+	key.vertexShader = vertexShader;
+	key.pixelShader = pixelShader;
+	key.layout = vertexShader == PipelineShader::INSTANCED_VS ? PipelineLayout::INSTANCED : PipelineLayout::STANDARD;
+	key.blend = blendMode;
+	key.topology = topology;
+	return key;
+}
+
+void Renderer::SetPipeline(const PipelineKey& key) {
+	cmdList->SetPipelineState(pipelines->Get(key));
+	currentKey = key;
 }
 
 void Renderer::SetNormalPipeline() {
-	cmdList->SetPipelineState(pipeline.Get());
+	SetPipeline(MakeKey(PipelineShader::BASIC_VS, PipelineShader::BASIC_PS));
 }
 
 void Renderer::SetTexturePipeline() {
-	cmdList->SetPipelineState(texturePipeline.Get());
+	SetPipeline(MakeKey(PipelineShader::BASIC_VS, PipelineShader::TEXTURE_PS));
+}
+
+ID3D12PipelineState* Renderer::GetPipeline(PipelineType type) {
+	return GetPipeline(type, blendMode);
+}
+
+ID3D12PipelineState* Renderer::GetPipeline(PipelineType type, BlendMode blend) {
+	PipelineKey key;
+	switch (type) {
+	case PipelineType::TEXTURE:
+		key = MakeKey(PipelineShader::BASIC_VS, PipelineShader::TEXTURE_PS);
+		break;
+	case PipelineType::LINE:
+		key = MakeKey(PipelineShader::BASIC_VS, PipelineShader::BASIC_PS, PipelineTopology::LINE);
+		break;
+	default:
+		key = MakeKey(PipelineShader::BASIC_VS, PipelineShader::BASIC_PS);
+		break;
+	}
+	key.blend = blend;
+	return pipelines->Get(key);
+}
+
+uint32_t Renderer::QueuePipeline(PipelineType type, BlendMode blend) {
+	// L[̃pCvC4bitɎށi2bitjƃuhi2bitj
+	return (uint32_t)type | ((uint32_t)blend << 2);
+}
+
+std::vector<PipelineRegistry::Permutation> Renderer::GetPipelinePermutations() {
+	return pipelines->GetPermutations();
+}
+
+void Renderer::DrawShape(Shape* shape) {
+	if (culling && !viewCuller.IsVisible(shape->GetLocalBounds(), shape->GetWorldMatrix())) {
+		return;
+	}
+
+	shape->Draw(cmdList.Get());
+}
+
+void Renderer::DrawLine(Line* line) {
+	// ͐̃g|W[ōpCvCŕ`AI猳ɖ߂
+	PipelineKey previous = currentKey;
+	PipelineKey key = currentKey;
+	key.topology = PipelineTopology::LINE;
+	SetPipeline(key);
+
+	line->Draw(cmdList.Get());
+
+	SetPipeline(previous);
+}
+
+void Renderer::DrawTexture(Texture* texture) {
+	Shape* shape = texture->GetShape();
+	if (culling && shape != nullptr && !viewCuller.IsVisible(shape->GetLocalBounds(), shape->GetWorldMatrix())) {
+		return;
+	}
+
+	texture->Draw(cmdList.Get());
+}
+
+void Renderer::DrawString(Text* text, const std::wstring& str, DirectX::XMFLOAT2 pos, DirectX::FXMVECTOR color) {
+	text->Draw(cmdList.Get(), str, pos, color);
+}
+
+void Renderer::Submit(Shape* shape, int layer, float depth) {
+	// eNX`̈ʒuɐ}`̎ނAނ̐}`ŃCX^X`ł܂Ƃ܂悤ɂ
+	renderQueue.Push(layer, QueuePipeline(PipelineType::NORMAL, blendMode), (uint32_t)shape->GetShapeType(), depth, (uint32_t)queuedDraws.size());
+	queuedDraws.push_back({ QueuedType::SHAPE, shape, 0xffffffff });
+}
+
+void Renderer::Submit(Line* line, int layer, float depth) {
+	renderQueue.Push(layer, QueuePipeline(PipelineType::LINE, blendMode), 0, depth, (uint32_t)queuedDraws.size());
+	queuedDraws.push_back({ QueuedType::LINE, line, 0xffffffff });
+}
+
+void Renderer::Submit(Texture* texture, int layer, float depth) {
+	// fBXNv^iAgX̃y[W܂ށj𑱂ĕ`悤AfBXNv^̔ԍŕׂ
+	// VF[_[猩q[v100܂łȂ̂ŁA0eNX`Ɏg1𑫂ĂL[20bitɎ܂
+	uint32_t descriptor = texture->GetDescriptor() + 1;
+
+	renderQueue.Push(layer, QueuePipeline(PipelineType::TEXTURE, blendMode), descriptor, depth, (uint32_t)queuedDraws.size());
+	queuedDraws.push_back({ QueuedType::TEXTURE, texture, 0xffffffff });
+}
+
+void Renderer::FlushQueue() {
+	if (queuedDraws.empty()) {
+		return;
+	}
+
+	// DrawStringȂǂʂ̃[gVOl`pCvCݒ肵Ă邩Ȃ̂Őݒ肵
+	SetupCommandList(cmdList.Get());
+
+	renderQueue.Sort();
+	CullQueue();
+
+	// \[g̏ɁApCvCςݒ肵
+	uint32_t currentPipeline = 0xffffffff;
+	ShapeType batchType = ShapeType::CUSTOM;
+	BlendMode batchBlend = BlendMode::DISABLED;
+	for (auto& item : renderQueue.GetItems()) {
+		auto& draw = queuedDraws[item.payload];
+		if (draw.cullIndex != 0xffffffff && !cullVisible[draw.cullIndex]) {
+			continue;
+		}
+
+		PipelineType type = (PipelineType)(item.pipeline & 3);
+		BlendMode blend = (BlendMode)(item.pipeline >> 2);
+
+		// ށEuh̊{}`Ԃ̓CX^XƂė߁Aς`悷
+		if (draw.type == QueuedType::SHAPE) {
+			auto shape = static_cast<Shape*>(draw.object);
+			if (shape->GetShapeType() != ShapeType::CUSTOM) {
+				if (shape->GetShapeType() != batchType || blend != batchBlend) {
+					FlushInstances(currentPipeline, batchBlend);
+					batchType = shape->GetShapeType();
+					batchBlend = blend;
+				}
+				instanceBatch->Add(shape);
+				continue;
+			}
+		}
+		FlushInstances(currentPipeline, batchBlend);
+		batchType = ShapeType::CUSTOM;
+
+		if (item.pipeline != currentPipeline) {
+			cmdList->SetPipelineState(GetPipeline(type, blend));
+			currentPipeline = item.pipeline;
+		}
+
+		switch (draw.type) {
+		case QueuedType::SHAPE:
+			static_cast<Shape*>(draw.object)->Draw(cmdList.Get());
+			break;
+		case QueuedType::LINE:
+			static_cast<Line*>(draw.object)->Draw(cmdList.Get());
+			break;
+		case QueuedType::TEXTURE:
+			static_cast<Texture*>(draw.object)->Draw(cmdList.Get());
+			break;
+		}
+	}
+
+	FlushInstances(currentPipeline, batchBlend);
+
+	renderQueue.Clear();
+	queuedDraws.clear();
+}
+
+void Renderer::CullQueue() {
+	if (!culling) {
+		return;
+	}
+
+	// }`̋E{bNXƍsׁA܂Ƃ߂Ĕ肷
+	cullBounds.clear();
+	cullWorlds.clear();
+	for (auto& draw : queuedDraws) {
+		Shape* shape = nullptr;
+		if (draw.type == QueuedType::SHAPE) {
+			shape = static_cast<Shape*>(draw.object);
+		}
+		else if (draw.type == QueuedType::TEXTURE) {
+			shape = static_cast<Texture*>(draw.object)->GetShape();
+		}
+		if (shape == nullptr) {
+			continue;
+		}
+
+		draw.cullIndex = (uint32_t)cullBounds.size();
+		cullBounds.push_back(shape->GetLocalBounds());
+		cullWorlds.push_back(shape->GetWorldMatrix());
+	}
+
+	cullVisible.resize(cullBounds.size());
+	viewCuller.Cull(cullBounds.data(), cullWorlds.data(), cullBounds.size(), cullVisible.data());
+}
+
+void Renderer::FlushInstances(uint32_t& currentPipeline, BlendMode blend) {
+	if (instanceBatch->IsEmpty()) {
+		return;
+	}
+
+	PipelineKey key = MakeKey(PipelineShader::INSTANCED_VS, PipelineShader::BASIC_PS);
+	key.blend = blend;
+	SetPipeline(key);
+	instanceBatch->Flush(cmdList.Get());
+
+	// ̕`Œʏ̃pCvCݒ肵
+	currentPipeline = 0xffffffff;
+}
+
+void Renderer::DrawInstances(Texture* texture) {
+	if (instanceBatch->IsEmpty()) {
+		return;
+	}
+
+	if (texture != nullptr) {
+		SetPipeline(MakeKey(PipelineShader::INSTANCED_VS, PipelineShader::TEXTURE_PS));
+		texture->Bind(cmdList.Get());
+	}
+	else {
+		SetPipeline(MakeKey(PipelineShader::INSTANCED_VS, PipelineShader::BASIC_PS));
+	}
+
+	instanceBatch->Flush(cmdList.Get());
+}
+
+void Renderer::DrawSprite(Texture* texture, const SpriteBatchBuilder::Sprite& sprite) {
+	spriteBatcher.Draw(texture, sprite);
+}
+
+void Renderer::FlushSprites() {
+	if (spriteBatcher.IsEmpty()) {
+		return;
+	}
+
+	SetupCommandList(cmdList.Get());
+
+	// XvCg͓𔲂ߏɃAt@uhŕ`
+	PipelineKey key = MakeKey(PipelineShader::BASIC_VS, PipelineShader::SPRITE_PS);
+	key.blend = BlendMode::ALPHA;
+	SetPipeline(key);
+	spriteBatcher.Flush(cmdList.Get());
+}
+
+void Renderer::RecordParallel(int partCount, const std::function<void(int part, ID3D12GraphicsCommandList* list)>& record) {
+	if (partCount <= 0) {
+		return;
+	}
+
+	auto startTime = std::chrono::steady_clock::now();
+
+	// ܂ł̋L^ĐɕׁǍɕƂ̃Xgԍɕׂ
+	cmdList->Close();
+	submitLists.push_back(cmdList.Get());
+
+	// Xg݂̑oƋʂ̐ݒ̓CXbhōs
+	ID3D12PipelineState* pipeline = pipelines->Get(currentKey);
+	std::vector<ID3D12GraphicsCommandList*> parts(partCount);
+	for (int i = 0; i < partCount; i++) {
+		parts[i] = commandLists->Acquire();
+		SetupCommandList(parts[i]);
+		parts[i]->SetPipelineState(pipeline);
+	}
+
+	auto body = [&](int i) {
+		record(i, parts[i]);
+		parts[i]->Close();
+	};
+	if (recordThreads != nullptr) {
+		recordThreads->ParallelFor(partCount, body);
+	}
+	else {
+		for (int i = 0; i < partCount; i++) {
+			body(i);
+		}
+	}
+
+	submitLists.insert(submitLists.end(), parts.begin(), parts.end());
+
+	// ͐VXgɋL^
+	cmdList = commandLists->Acquire();
+	SetupCommandList(cmdList.Get());
+	SetPipeline(currentKey);
+
+	recordStatistics.calls++;
+	recordStatistics.parts += partCount;
+	recordStatistics.seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+void Renderer::SetRecordThreadCount(int count) {
+	// ĂяõXbhL^ɎQ̂ŁA[J[1ȂĂ悢
+	if (count == 1) {
+		recordThreads.reset();
+	}
+	else {
+		recordThreads = std::make_unique<ThreadPool>(count <= 0 ? 0 : count - 1);
+	}
+}
+
+int Renderer::GetRecordThreadCount() {
+	return recordThreads != nullptr ? recordThreads->GetThreadCount() + 1 : 1;
 }
\ No newline at end of file
@@ -6,37 +6,103 @@
 #include <d3dcompiler.h>
 #include <DirectXMath.h>
 #include "GraphicsMemory.h"
+#include "PipelineRegistry.h"
+#include "RenderBackend.h"
+#include "RenderGraph.h"
+#include "RenderQueue.h"
+#include "ResourceAllocator.h"
+#include "SpriteBatcher.h"
+#include "ViewCuller.h"
 
+#include <functional>
 #include <vector>
+#include <memory>
 
-class Renderer
+class Renderer : public RenderBackend
 {
 private:
+	enum class QueuedType {
+		SHAPE,
+		LINE,
+		TEXTURE
+	};
+
+	typedef struct QueuedDraw {
+		QueuedType type;
+		void* object;
+		uint32_t cullIndex;		// 肵Ȃ̂0xffffffff
+	};
+
+	typedef struct FrameTarget {
+		uint32_t resource;
+		D3D12_RESOURCE_DESC desc;
+		D3D12_CLEAR_VALUE clearValue;
+		bool hasClearValue;
+	};
+
+public:
+	typedef struct RecordStatistics {
+		uint64_t calls;
+		uint64_t parts;
+		double seconds;		// Xg̏EL^E܂ł̍v
+	};
+
+private:
+
 	Microsoft::WRL::ComPtr<ID3D12Device> device = nullptr;
 	Microsoft::WRL::ComPtr<IDXGIFactory7> factory = nullptr;
 	Microsoft::WRL::ComPtr<IDXGISwapChain4> swapchain = nullptr;
 
-	Microsoft::WRL::ComPtr<ID3D12CommandAllocator> cmdAllocator = nullptr;
-	Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList> cmdList = nullptr;
+	std::vector<Microsoft::WRL::ComPtr<ID3D12CommandAllocator>> cmdAllocators;
+	Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList> cmdList = nullptr;		// L^Ă郊Xg
+	Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList> mainCmdList = nullptr;
+	std::unique_ptr<class CommandListPool> commandLists;
+	std::vector<ID3D12CommandList*> submitLists;
+	std::unique_ptr<class ThreadPool> recordThreads;
+	RecordStatistics recordStatistics;
 	Microsoft::WRL::ComPtr<ID3D12CommandQueue> cmdQueue = nullptr;
 
 	Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> rtvHeaps;
 	std::vector<Microsoft::WRL::ComPtr<ID3D12Resource>> backBuffer;
-	UINT64 fenceVal;
-	Microsoft::WRL::ComPtr<ID3D12Fence> fence;
+	UINT frameCount;
+	UINT frameIndex;
+	D3D12_CPU_DESCRIPTOR_HANDLE currentRtv;
+	std::unique_ptr<class QueueFence> fence;
+	std::unique_ptr<class FrameRing> frameRing;
 	Microsoft::WRL::ComPtr<ID3D12RootSignature> rootSignature;
-	Microsoft::WRL::ComPtr<ID3D12PipelineState> pipeline;
-	Microsoft::WRL::ComPtr<ID3D12PipelineState> texturePipeline;
+	std::unique_ptr<class PipelineRegistry> pipelines;
+	PipelineKey currentKey;
+	BlendMode blendMode;
 	D3D12_VIEWPORT viewPort;
 	D3D12_RECT scissorRect;
 
-	Microsoft::WRL::ComPtr<ID3D12Resource> constBuffer = nullptr;
-	Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> basicDescHeap = nullptr;
+	ResourceAllocator::BufferRange constBuffer;
+	UINT viewDescriptor;
 
 	std::unique_ptr<DirectX::GraphicsMemory> graphicsMemory = nullptr;
 
+	std::unique_ptr<class InstanceBatch> instanceBatch;
+	std::unique_ptr<class TextureStreamer> textureStreamer;
+	SpriteBatcher spriteBatcher;
+
+	RenderQueue renderQueue;
+	std::vector<QueuedDraw> queuedDraws;
+
+	ViewCuller viewCuller;
+	bool culling;
+	std::vector<ViewCuller::Bounds> cullBounds;
+	std::vector<DirectX::XMMATRIX> cullWorlds;
+	std::vector<uint8_t> cullVisible;
+
+	RenderGraph frameGraph;
+	std::unique_ptr<class RenderGraphExecutor> graphExecutor;
+	uint32_t backBufferResource;
+	uint32_t scenePass;
+	std::vector<FrameTarget> frameTargets;
+	std::vector<std::pair<uint32_t, ResourceState>> sceneReads;
+
 public:
-	Renderer(int width, int height, HWND hwnd);
+	Renderer(int width, int height, HWND hwnd, int frameCount = 2);
 	~Renderer();
 
 private:
@@ -46,19 +112,126 @@ private:
 	void CreateRootSignature();
 	void CreateGraphicsPipeline();
 	void CreateRenderTarget();
+	void SetupCommandList(ID3D12GraphicsCommandList* list);
+	void ResetFrameGraph();
+	void FlushQueue();
+	void CullQueue();
+	void FlushInstances(uint32_t& currentPipeline, BlendMode blend);
+	static uint32_t QueuePipeline(PipelineType type, BlendMode blend);
+	PipelineKey MakeKey(PipelineShader vertexShader, PipelineShader pixelShader, PipelineTopology topology = PipelineTopology::TRIANGLE);
+	void SetPipeline(const PipelineKey& key);
 
 public:
-	void BeginDraw();
-	void EndDraw();
+	void BeginDraw() override;
+	void EndDraw() override;
 	void RunCommand();
 
-	void SetNormalPipeline();
-	void SetTexturePipeline();
+	void SetNormalPipeline() override;
+	void SetTexturePipeline() override;
+	/// <summary>
+	/// ȍ~ɐݒ肷pCvC̃uhςiXvCg͏ɃAt@uhj
+	/// </summary>
+	void SetBlendMode(BlendMode mode) { blendMode = mode; }
+	/// <summary>
+	/// ނƂ̃pCvCiRecordParallel̒Ăł悢j
+	/// </summary>
+	ID3D12PipelineState* GetPipeline(PipelineType type);
+	ID3D12PipelineState* GetPipeline(PipelineType type, BlendMode blend);
+	std::vector<PipelineRegistry::Permutation> GetPipelinePermutations();
+
+	void DrawShape(class Shape* shape) override;
+	void DrawLine(class Line* line) override;
+	void DrawTexture(class Texture* texture) override;
+	void DrawString(class Text* text, const std::wstring& str, DirectX::XMFLOAT2 pos, DirectX::FXMVECTOR color) override;
+
+	/// <summary>
+	/// `EndDraw܂ŗ߁AC[EpCvCEeNX`E[x̏ɕבւĂ`悷
+	/// }`͕ێAWsUViSetImageArrayjEndDraw̎_̒lŕ`悳
+	/// uhSubmit_SetBlendMode̒lg
+	/// EndDraw܂ł͔jAt[̒ŕʂ̈ʒuɕ`߂ɏȂ
+	/// </summary>
+	void Submit(class Shape* shape, int layer = 0, float depth = 0.0f);
+	void Submit(class Line* line, int layer = 0, float depth = 0.0f);
+	void Submit(class Texture* texture, int layer = 0, float depth = 0.0f);
+	void SetPainterOrder(int layer, bool enable) { renderQueue.SetPainterOrder(layer, enable); }
+	RenderQueue::Statistics GetQueueStatistics() { return renderQueue.GetStatistics(); }
+
+	/// <summary>
+	/// DrawShapeEDrawTextureESubmitŁAʂ̊Oɂ}`L^ȂiŗLj
+	/// RecordParallel̒ȂǂShape::Draw𒼐ڌĂ񂾂͔̂肵Ȃ
+	/// </summary>
+	void SetCulling(bool enable) { culling = enable; }
+	/// <summary>
+	/// ̃t[iOBeginDrawȍ~jŔ肵}`̐
+	/// </summary>
+	ViewCuller::Statistics GetCullStatistics() { return viewCuller.GetStatistics(); }
+
+	/// <summary>
+	/// GetInstanceBatchɒǉCX^Xɕ`悷
+	/// `SetNormalPipelineESetTexturePipelineŃpCvCݒ肵
+	/// </summary>
+	/// <param name="texture">w肷ƃeNX`\ĕ`悷</param>
+	void DrawInstances(class Texture* texture = nullptr);
+	class InstanceBatch* GetInstanceBatch() { return instanceBatch.get(); }
+
+	/// <summary>
+	/// XvCg𗭂߁AFlushSpritesEndDrawŃeNX`ς邲Ƃ1񂸂`悷
+	/// </summary>
+	void DrawSprite(class Texture* texture, const SpriteBatchBuilder::Sprite& sprite);
+	/// <summary>
+	/// `SetNormalPipelineESetTexturePipelineŃpCvCݒ肵
+	/// </summary>
+	void FlushSprites();
+	void SetSpriteSortByTexture(bool enable) { spriteBatcher.SetSortByTexture(enable); }
+	SpriteBatcher::Statistics GetSpriteStatistics() { return spriteBatcher.GetStatistics(); }
+
+	/// <summary>
+	/// t[̈ꕔpartCountɕAꂼʂ̃R}hXgɃ[J[XbhŋL^
+	/// EndDrawł͌ĂяoŐL^Epart 0珇̊eEĂяőL^̏Ɏs
+	/// record̒łShape::DrawETexture::DrawȂǂɓnꂽXggASubmitEDrawSprite͌Ă΂Ȃ
+	/// </summary>
+	void RecordParallel(int partCount, const std::function<void(int part, ID3D12GraphicsCommandList* list)>& record);
+	/// <summary>
+	/// L^ɎgXbhiĂяo܂ށjB0CPŨRAɍ킹
+	/// </summary>
+	void SetRecordThreadCount(int count);
+	int GetRecordThreadCount();
+	RecordStatistics GetRecordStatistics() { return recordStatistics; }
+	void ResetRecordStatistics() { recordStatistics = {}; }
+
+	/// <summary>
+	/// BeginDrawŃV[OɎspXǉiǂݏGetFrameGraphŐ錾j
+	/// pXEndDrawƂɏ̂Ŗt[ǉ邱
+	/// </summary>
+	uint32_t AddFramePass(const std::string& name, std::function<void(ID3D12GraphicsCommandList* list)> execute);
+	/// <summary>
+	/// ̃t[g_[^[QbgBgԂdȂȂ̓mŃL
+	/// e͑Õt[⑼̃^[Qbgɏ㏑Ă̂ŁAŏɏރpXŃNA邱
+	/// </summary>
+	uint32_t CreateFrameTarget(const std::string& name, const D3D12_RESOURCE_DESC& desc, const D3D12_CLEAR_VALUE* clearValue = nullptr);
+	/// <summary>
+	/// V[iBeginDraw`EndDraw̕`jœǂރ\[X錾
+	/// </summary>
+	void ReadInScene(uint32_t resource, ResourceState state = ResourceState::PIXEL_SHADER_RESOURCE) { sceneReads.push_back({ resource, state }); }
+	/// <summary>
+	/// pX̒ƃV[̕`撆Ɏg
+	/// </summary>
+	ID3D12Resource* GetFrameResource(uint32_t resource);
+	RenderGraph& GetFrameGraph() { return frameGraph; }
+	uint32_t GetBackBufferResource() { return backBufferResource; }
+	RenderGraph::Statistics GetGraphStatistics() { return frameGraph.GetStatistics(); }
 
 public:
 	ID3D12Device* GetDevice() { return device.Get(); }
 	ID3D12GraphicsCommandList* GetCommandList() { return cmdList.Get(); }
 	ID3D12CommandQueue* GetCommandQueue() { return cmdQueue.Get(); }
 	D3D12_VIEWPORT GetViewPort() { return viewPort; }
+
+	UINT GetFrameCount() { return frameCount; }
+	UINT GetFrameIndex() { return frameIndex; }
+	UINT64 GetFrameFenceValue(UINT index);
+	UINT64 GetCompletedFenceValue();
+	class FrameRing* GetFrameRing() { return frameRing.get(); }
+	class TextureStreamer* GetTextureStreamer() { return textureStreamer.get(); }
 };
 
@@ -0,0 +1,278 @@
+#include "ResourceAllocator.h"
+#include "FrameRing.h"
+#include "Debugger.h"
+
+#include "d3dx12.h"
+
+#include <chrono>
+
+ID3D12Device* ResourceAllocator::device = nullptr;
+
+FrameRing* ResourceAllocator::frameRing = nullptr;
+
+std::vector<std::unique_ptr<ResourceAllocator::Page>> ResourceAllocator::pages[POOL_COUNT];
+
+uint64_t ResourceAllocator::pageSizes[POOL_COUNT];
+
+std::vector<ResourceAllocator::PlacedTexture> ResourceAllocator::textures;
+
+std::vector<ResourceAllocator::PlacedTexture> ResourceAllocator::retiredTextures;
+
+uint32_t ResourceAllocator::bufferRanges = 0;
+
+std::mutex ResourceAllocator::mutex;
+
+ResourceAllocator::Statistics ResourceAllocator::statistics;
+
+void ResourceAllocator::Initialize(ID3D12Device* device, FrameRing* frameRing, uint64_t bufferPageSize, uint64_t texturePageSize) {
+	ResourceAllocator::device = device;
+	ResourceAllocator::frameRing = frameRing;
+
+	// q[v̑傫64KB̔{ɂ
+	const uint64_t heapAlignment = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+	pageSizes[POOL_BUFFER] = (bufferPageSize + heapAlignment - 1) & ~(heapAlignment - 1);
+	pageSizes[POOL_TEXTURE] = (texturePageSize + heapAlignment - 1) & ~(heapAlignment - 1);
+
+	bufferRanges = 0;
+	statistics = {};
+}
+
+void ResourceAllocator::Finalize() {
+	std::lock_guard<std::mutex> lock(mutex);
+	textures.clear();
+	retiredTextures.clear();
+	for (auto& pool : pages) {
+		pool.clear();
+	}
+	device = nullptr;
+	frameRing = nullptr;
+}
+
+uint32_t ResourceAllocator::CreatePage(Pool pool, uint64_t size, bool dedicated) {
+	auto page = std::make_unique<Page>();
+	page->cpuAddress = nullptr;
+	page->dedicated = dedicated;
+
+	// \[Xq[vTier1łg悤ɁAobt@ƃeNX`Ńq[v𕪂
+	D3D12_HEAP_DESC heapDesc = {};
+	heapDesc.SizeInBytes = size;
+	heapDesc.Alignment = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+	if (pool == POOL_BUFFER) {
+		heapDesc.Properties = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD);
+		heapDesc.Flags = D3D12_HEAP_FLAG_ALLOW_ONLY_BUFFERS;
+	}
+	else {
+		heapDesc.Properties = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT);
+		heapDesc.Flags = D3D12_HEAP_FLAG_ALLOW_ONLY_NON_RT_DS_TEXTURES;
+	}
+	Debugger::ErrorCheck(device->CreateHeap(&heapDesc, IID_PPV_ARGS(page->heap.ReleaseAndGetAddressOf())));
+
+	if (pool == POOL_BUFFER) {
+		// y[WŜ1̃obt@ɂĔ͈͂œn̂ŁAobt@Ƃ̃\[X͍Ȃ
+		auto bufferDesc = CD3DX12_RESOURCE_DESC::Buffer(size);
+		Debugger::ErrorCheck(device->CreatePlacedResource(page->heap.Get(), 0, &bufferDesc, D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(page->buffer.ReleaseAndGetAddressOf())));
+		Debugger::ErrorCheck(page->buffer->Map(0, nullptr, reinterpret_cast<void**>(&page->cpuAddress)));
+		page->allocator = std::make_unique<TlsfAllocator>(size, D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT);
+	}
+	else {
+		page->allocator = std::make_unique<TlsfAllocator>(size, D3D12_SMALL_RESOURCE_PLACEMENT_ALIGNMENT);
+	}
+
+	// py[W̔ԍg
+	auto& list = pages[pool];
+	for (uint32_t i = 0; i < list.size(); i++) {
+		if (list[i] == nullptr) {
+			list[i] = std::move(page);
+			return i;
+		}
+	}
+	list.push_back(std::move(page));
+	return (uint32_t)list.size() - 1;
+}
+
+uint32_t ResourceAllocator::Allocate(Pool pool, uint64_t size, uint64_t alignment, TlsfAllocator::Allocation& allocation) {
+	auto& list = pages[pool];
+	if (size > pageSizes[pool]) {
+		uint64_t dedicatedSize = (size + D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT - 1) & ~(uint64_t)(D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT - 1);
+		uint32_t index = CreatePage(pool, dedicatedSize, true);
+		allocation = list[index]->allocator->Allocate(size, alignment);
+		return index;
+	}
+
+	for (uint32_t i = 0; i < list.size(); i++) {
+		if (list[i] == nullptr || list[i]->dedicated) {
+			continue;
+		}
+		allocation = list[i]->allocator->Allocate(size, alignment);
+		if (allocation.offset != TlsfAllocator::INVALID_OFFSET) {
+			return i;
+		}
+	}
+
+	uint32_t index = CreatePage(pool, pageSizes[pool], false);
+	allocation = list[index]->allocator->Allocate(size, alignment);
+	return index;
+}
+
+void ResourceAllocator::RecordLatency(double seconds) {
+	statistics.allocations++;
+	statistics.allocateSeconds += seconds;
+	if (seconds > statistics.maxAllocateSeconds) {
+		statistics.maxAllocateSeconds = seconds;
+	}
+}
+
+ResourceAllocator::BufferRange ResourceAllocator::AllocateBuffer(uint64_t size, uint64_t alignment) {
+	auto startTime = std::chrono::steady_clock::now();
+	std::lock_guard<std::mutex> lock(mutex);
+
+	BufferRange range = {};
+	range.page = Allocate(POOL_BUFFER, size, alignment, range.allocation);
+	if (range.allocation.offset == TlsfAllocator::INVALID_OFFSET) {
+		Debugger::ErrorCheck(E_OUTOFMEMORY);
+	}
+
+	Page* page = pages[POOL_BUFFER][range.page].get();
+	range.resource = page->buffer.Get();
+	range.offset = range.allocation.offset;
+	range.size = size;
+	range.cpuAddress = page->cpuAddress + range.offset;
+	range.gpuAddress = page->buffer->GetGPUVirtualAddress() + range.offset;
+	bufferRanges++;
+
+	RecordLatency(std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count());
+	return range;
+}
+
+void ResourceAllocator::FreeBuffer(BufferRange& range) {
+	// RendererɔjĂꍇ▢mۂ̏ꍇ͉Ȃ
+	if (!IsInitialized() || range.resource == nullptr) {
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(mutex);
+	pages[POOL_BUFFER][range.page]->allocator->Free(range.allocation, frameRing->GetLastSignaledValue() + 1);
+	bufferRanges--;
+	range = {};
+}
+
+Microsoft::WRL::ComPtr<ID3D12Resource> ResourceAllocator::CreateTexture(const D3D12_RESOURCE_DESC& desc, D3D12_RESOURCE_STATES state) {
+	auto startTime = std::chrono::steady_clock::now();
+	std::lock_guard<std::mutex> lock(mutex);
+
+	// eNX`4KBEɒuBuȂꍇAlignmentႤlŕԂ̂64KBɂ
+	D3D12_RESOURCE_DESC placedDesc = desc;
+	placedDesc.Alignment = D3D12_SMALL_RESOURCE_PLACEMENT_ALIGNMENT;
+	D3D12_RESOURCE_ALLOCATION_INFO info = device->GetResourceAllocationInfo(0, 1, &placedDesc);
+	if (info.Alignment != D3D12_SMALL_RESOURCE_PLACEMENT_ALIGNMENT) {
+		placedDesc.Alignment = 0;
+		info = device->GetResourceAllocationInfo(0, 1, &placedDesc);
+	}
+
+	Microsoft::WRL::ComPtr<ID3D12Resource> resource;
+	if (info.SizeInBytes > pageSizes[POOL_TEXTURE]) {
+		auto defaultHeap = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT);
+		Debugger::ErrorCheck(device->CreateCommittedResource(&defaultHeap, D3D12_HEAP_FLAG_NONE, &desc, state, nullptr, IID_PPV_ARGS(resource.ReleaseAndGetAddressOf())));
+		statistics.committedFallbacks++;
+		RecordLatency(std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count());
+		return resource;
+	}
+
+	PlacedTexture texture = {};
+	texture.page = Allocate(POOL_TEXTURE, info.SizeInBytes, info.Alignment, texture.allocation);
+	if (texture.allocation.offset == TlsfAllocator::INVALID_OFFSET) {
+		Debugger::ErrorCheck(E_OUTOFMEMORY);
+	}
+	Page* page = pages[POOL_TEXTURE][texture.page].get();
+	Debugger::ErrorCheck(device->CreatePlacedResource(page->heap.Get(), texture.allocation.offset, &placedDesc, state, nullptr, IID_PPV_ARGS(resource.ReleaseAndGetAddressOf())));
+
+	// QƂ1ĂABeginFrameőɎQƂȂ̂
+	texture.resource = resource;
+	textures.push_back(texture);
+
+	RecordLatency(std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count());
+	return resource;
+}
+
+void ResourceAllocator::BeginFrame() {
+	std::lock_guard<std::mutex> lock(mutex);
+	uint64_t completed = frameRing->GetCompletedValue();
+	uint64_t recording = frameRing->GetLastSignaledValue() + 1;
+
+	// QƂĂȂeNX`́AL^̃t[I܂ő҂Ă
+	// fBXNv^̓\[X̎QƂȂ̂ŁAQƐŔł
+	size_t kept = 0;
+	for (size_t i = 0; i < textures.size(); i++) {
+		textures[i].resource->AddRef();
+		if (textures[i].resource->Release() == 1) {
+			textures[i].fenceValue = recording;
+			retiredTextures.push_back(textures[i]);
+		}
+		else {
+			textures[kept++] = textures[i];
+		}
+	}
+	textures.resize(kept);
+
+	kept = 0;
+	for (size_t i = 0; i < retiredTextures.size(); i++) {
+		auto& texture = retiredTextures[i];
+		if (texture.fenceValue <= completed) {
+			texture.resource.Reset();
+			pages[POOL_TEXTURE][texture.page]->allocator->Free(texture.allocation);
+		}
+		else {
+			retiredTextures[kept++] = texture;
+		}
+	}
+	retiredTextures.resize(kept);
+
+	for (auto& pool : pages) {
+		for (auto& page : pool) {
+			if (page == nullptr) {
+				continue;
+			}
+			page->allocator->Reclaim(completed);
+			if (page->dedicated && page->allocator->IsEmpty()) {
+				page.reset();
+			}
+		}
+	}
+}
+
+ResourceAllocator::Statistics ResourceAllocator::GetStatistics() {
+	std::lock_guard<std::mutex> lock(mutex);
+	Statistics result = statistics;
+	result.heaps = 0;
+	result.heapBytes = 0;
+	result.liveBytes = 0;
+	result.pendingBytes = 0;
+	result.largestFreeBlock = 0;
+
+	for (auto& pool : pages) {
+		for (auto& page : pool) {
+			if (page == nullptr) {
+				continue;
+			}
+			auto pageStatistics = page->allocator->GetStatistics();
+			result.heaps++;
+			result.heapBytes += pageStatistics.capacity;
+			result.liveBytes += pageStatistics.allocated;
+			result.pendingBytes += pageStatistics.pending;
+			if (pageStatistics.largestFreeBlock > result.largestFreeBlock) {
+				result.largestFreeBlock = pageStatistics.largestFreeBlock;
+			}
+		}
+	}
+
+	// ҂̃eNX`͂܂͈͂Ă
+	for (auto& texture : retiredTextures) {
+		result.pendingBytes += texture.allocation.size;
+	}
+
+	uint64_t free = result.heapBytes - result.liveBytes;
+	result.fragmentation = free == 0 ? 0.0f : 1.0f - (float)result.largestFreeBlock / (float)free;
+	result.bufferRanges = bufferRanges;
+	result.placedTextures = (uint32_t)(textures.size() + retiredTextures.size());
+	return result;
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "TlsfAllocator.h"
+
+#include <d3d12.h>
+#include <wrl.h>
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// ̑傫ȃq[vAobt@͈̔͂ƃeNX`̔zu\[X؂o
+// \[XƂCreateCommittedResourceŊmۂiJ[lł̊mۂ64KBPʂ̐؂グĵ
+// q[v̋󂫂̓y[WƂTlsfAllocatorŊǗ
+class ResourceAllocator
+{
+public:
+	// Abv[hq[ṽobt@̈ꕔBy[WƏɃ}bvĂ
+	typedef struct BufferRange {
+		ID3D12Resource* resource;		// y[WŜ𕢂obt@BmۂȂnullptr
+		uint64_t offset;				// resource̐擪̈ʒu
+		uint64_t size;
+		UINT8* cpuAddress;
+		D3D12_GPU_VIRTUAL_ADDRESS gpuAddress;
+		uint32_t page;
+		TlsfAllocator::Allocation allocation;
+	};
+
+	typedef struct Statistics {
+		uint32_t heaps;
+		uint64_t heapBytes;
+		uint64_t liveBytes;				// ҂܂
+		uint64_t pendingBytes;
+		uint64_t largestFreeBlock;
+		float fragmentation;			// 󂫗eʂ̂ő̘ÄɓȂ
+		uint32_t bufferRanges;
+		uint32_t placedTextures;
+		uint64_t committedFallbacks;	// y[Wɓ炸ʂɊmۂeNX`
+		uint64_t allocations;
+		double allocateSeconds;			// q[vƃ\[X̍쐬܂ލv
+		double maxAllocateSeconds;
+	};
+
+private:
+	enum Pool {
+		POOL_BUFFER,
+		POOL_TEXTURE,
+		POOL_COUNT
+	};
+
+	typedef struct Page {
+		Microsoft::WRL::ComPtr<ID3D12Heap> heap;
+		Microsoft::WRL::ComPtr<ID3D12Resource> buffer;	// obt@p̃y[Ŵ
+		UINT8* cpuAddress;
+		std::unique_ptr<TlsfAllocator> allocator;
+		bool dedicated;		// y[W傫̂1B󂢂
+	};
+
+	typedef struct PlacedTexture {
+		Microsoft::WRL::ComPtr<ID3D12Resource> resource;
+		uint32_t page;
+		TlsfAllocator::Allocation allocation;
+		uint64_t fenceValue;	// ꂽAGPUgItFXl
+	};
+
+	static ID3D12Device* device;
+	static class FrameRing* frameRing;
+	static std::vector<std::unique_ptr<Page>> pages[POOL_COUNT];
+	static uint64_t pageSizes[POOL_COUNT];
+	static std::vector<PlacedTexture> textures;
+	static std::vector<PlacedTexture> retiredTextures;
+	static uint32_t bufferRanges;
+	static std::mutex mutex;
+	static Statistics statistics;
+
+public:
+	/// <summary>
+	/// 
+	/// </summary>
+	/// <param name="device">foCX</param>
+	/// <param name="frameRing">͈͂ėpł邩̔Ɏg</param>
+	/// <param name="bufferPageSize">obt@p̃q[v1̑傫</param>
+	/// <param name="texturePageSize">eNX`p̃q[v1̑傫</param>
+	static void Initialize(ID3D12Device* device, class FrameRing* frameRing, uint64_t bufferPageSize = 32ull * 1024 * 1024, uint64_t texturePageSize = 64ull * 1024 * 1024);
+	static void Finalize();
+	static bool IsInitialized() { return device != nullptr; }
+
+private:
+	static uint32_t CreatePage(Pool pool, uint64_t size, bool dedicated);
+	static uint32_t Allocate(Pool pool, uint64_t size, uint64_t alignment, TlsfAllocator::Allocation& allocation);
+	static void RecordLatency(double seconds);
+
+public:
+	/// <summary>
+	/// obt@͈̔͂mۂBy[W傫ꍇ͐p̃y[W
+	/// </summary>
+	static BufferRange AllocateBuffer(uint64_t size, uint64_t alignment = D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT);
+	/// <summary>
+	/// ݋L^̃t[I܂ł͍ėpȂ
+	/// </summary>
+	static void FreeBuffer(BufferRange& range);
+
+	/// <summary>
+	/// eNX`q[vɔzučB64KBȉ̂̂4KBEɋl߂
+	/// Ō̎QƂƁAGPUgIBeginFrameŔ͈͂
+	/// </summary>
+	static Microsoft::WRL::ComPtr<ID3D12Resource> CreateTexture(const D3D12_RESOURCE_DESC& desc, D3D12_RESOURCE_STATES state);
+
+	/// <summary>
+	/// t[JnɌĂсAGPUgI͈͂
+	/// </summary>
+	static void BeginFrame();
+
+	static Statistics GetStatistics();
+};
@@ -3,114 +3,144 @@
 #include "d3dx12.h"
 
 #include "Debugger.h"
+#include "MeshRegistry.h"
+#include "RenderBackend.h"
+
+#include <cstring>
 
 Shape::Shape() {
-	
+	device = nullptr;
+	type = ShapeType::CUSTOM;
+	baseSize = { 1.0f, 1.0f };
+
+	position = { 0.0f, 0.0f, 0.0f };
+	rotation = { 0.0f, 0.0f, 0.0f };
+	scale = { 1.0f, 1.0f, 1.0f };
+	worldDirty = true;
+
+	worldConstant = {};
+	constantDirty = true;
+
+	localBounds = {};
 }
 
 Shape::~Shape() {
-	if (vertexBuffer != nullptr) {
-		vertexBuffer->Unmap(0, nullptr);
-	}
-
-	if (constBuffer != nullptr) {
-		constBuffer->Unmap(0, nullptr);
-	}
+	ResourceAllocator::FreeBuffer(worldConstant);
+	MeshRegistry::Release(mesh);
 }
 
 void Shape::CreateShape(std::vector<VertexData> vertex, std::vector<unsigned short> index, ID3D12Device* device) {
-	vertices = vertex;
-	indices = index;
+	// ẽbVΒ_ECfbNXGPŨobt@L
+	mesh = MeshRegistry::Acquire(vertex, index);
+	if (!vertex.empty()) {
+		localBounds = ViewCuller::ComputeBounds(&vertex[0].position, vertex.size(), sizeof(VertexData));
+	}
 
-	CreateVertexBufferView(device);
-	CreateIndexBufferView(device);
-	CreateTransform(device);
+	// GPŨobt@͌ʂɕ`悳鎞ɏ߂č
+	// CX^X`悾Ŏg}`AfoCXꍇiSoftwareRendererpjCPŨf[^
+	this->device = device;
 }
 
-void Shape::CreateVertexBufferView(ID3D12Device* device) {
-	auto size = sizeof(VertexData) * vertices.size();
-
-	D3D12_HEAP_PROPERTIES heapprop = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD);
-	D3D12_RESOURCE_DESC resdesc = CD3DX12_RESOURCE_DESC::Buffer(size);
-	Debugger::ErrorCheck(device->CreateCommittedResource(&heapprop, D3D12_HEAP_FLAG_NONE, &resdesc, D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(vertexBuffer.ReleaseAndGetAddressOf())));
+void Shape::SetShapeType(ShapeType type, DirectX::XMFLOAT2 baseSize) {
+	this->type = type;
+	this->baseSize = baseSize;
+	worldDirty = true;
+}
 
-	verticesMap = nullptr;
-	Debugger::ErrorCheck(vertexBuffer->Map(0, nullptr, (void**)&verticesMap));
-	std::copy(std::begin(vertices), std::end(vertices), verticesMap);
+void Shape::UpdateWorldMatrix() {
+	if (!worldDirty) {
+		return;
+	}
 
-	vertexBufferView.BufferLocation = vertexBuffer->GetGPUVirtualAddress();
-	vertexBufferView.SizeInBytes = size;
-	vertexBufferView.StrideInBytes = sizeof(VertexData);
+	world = DirectX::XMMatrixScaling(scale.x, scale.y, scale.z) *
+		DirectX::XMMatrixRotationX(rotation.x) * DirectX::XMMatrixRotationY(rotation.y) * DirectX::XMMatrixRotationZ(rotation.z) *
+		DirectX::XMMatrixTranslation(position.x, position.y, position.z);
+	instanceMatrix = DirectX::XMMatrixScaling(baseSize.x, baseSize.y, 1.0f) * world;
+	worldDirty = false;
+	constantDirty = true;
 }
 
-void Shape::CreateIndexBufferView(ID3D12Device* device) {
-	auto size = sizeof(unsigned short) * indices.size();
-
-	D3D12_HEAP_PROPERTIES heapprop = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD);
-	D3D12_RESOURCE_DESC resdesc = CD3DX12_RESOURCE_DESC::Buffer(size);
+void Shape::Draw(ID3D12GraphicsCommandList* cmdList) {
+	// Ȃ}`͑O񏑂񂾒萔̂܂܎g
+	// L^ς݂̃t[Â萔QƂĂ̂ŁAς͏ɐV͈͂ɏ
+	// Â͈͂GPUgIĂėp
+	UpdateWorldMatrix();
+	if (constantDirty) {
+		ResourceAllocator::FreeBuffer(worldConstant);
+		worldConstant = ResourceAllocator::AllocateBuffer(sizeof(DirectX::XMMATRIX));
+		std::memcpy(worldConstant.cpuAddress, &world, sizeof(DirectX::XMMATRIX));
+		constantDirty = false;
+	}
+	cmdList->SetGraphicsRootConstantBufferView(1, worldConstant.gpuAddress);
 
-	Debugger::ErrorCheck(device->CreateCommittedResource(&heapprop, D3D12_HEAP_FLAG_NONE, &resdesc, D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(indexBuffer.ReleaseAndGetAddressOf())));
+	mesh->CreateBuffers(device);
 
-	unsigned short* indicesMap = nullptr;
-	Debugger::ErrorCheck(indexBuffer->Map(0, nullptr, (void**)&indicesMap));
-	std::copy(std::begin(indices), std::end(indices), indicesMap);
-	indexBuffer->Unmap(0, nullptr);
+	cmdList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+	cmdList->IASetVertexBuffers(0, 1, &mesh->GetVertexBufferView());
+	cmdList->IASetIndexBuffer(&mesh->GetIndexBufferView());
+	cmdList->DrawIndexedInstanced(mesh->GetIndices().size(), 1, 0, 0, 0);
+}
 
-	indexBufferView.BufferLocation = indexBuffer->GetGPUVirtualAddress();
-	indexBufferView.Format = DXGI_FORMAT_R16_UINT;
-	indexBufferView.SizeInBytes = size;
+void Shape::Draw(RenderBackend* backend) {
+	backend->DrawShape(this);
 }
 
-void Shape::CreateTransform(ID3D12Device* device) {
-	D3D12_HEAP_PROPERTIES heapprop = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD);
-	D3D12_RESOURCE_DESC resourceDesc = CD3DX12_RESOURCE_DESC::Buffer((sizeof(DirectX::XMMATRIX) + 0xff) & ~0xff);
+void Shape::DrawInstanced(ID3D12GraphicsCommandList* cmdList, const D3D12_VERTEX_BUFFER_VIEW& instanceView, UINT instanceCount) {
+	mesh->CreateBuffers(device);
 
-	Debugger::ErrorCheck(device->CreateCommittedResource(&heapprop, D3D12_HEAP_FLAG_NONE, &resourceDesc, D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(constBuffer.ReleaseAndGetAddressOf())));
+	D3D12_VERTEX_BUFFER_VIEW views[] = { mesh->GetVertexBufferView(), instanceView };
 
-	Debugger::ErrorCheck(constBuffer->Map(0, nullptr, (void**)&world));
-	*world = DirectX::XMMatrixIdentity();
+	cmdList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+	cmdList->IASetVertexBuffers(0, 2, views);
+	cmdList->IASetIndexBuffer(&mesh->GetIndexBufferView());
+	cmdList->DrawIndexedInstanced(mesh->GetIndices().size(), instanceCount, 0, 0, 0);
+}
 
-	D3D12_DESCRIPTOR_HEAP_DESC descriptorHeapDesc = {};
-	descriptorHeapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
-	descriptorHeapDesc.NodeMask = 0;
-	descriptorHeapDesc.NumDescriptors = 1;
-	descriptorHeapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
+void Shape::SetTransform(DirectX::XMMATRIX position, DirectX::XMMATRIX rotation, DirectX::XMMATRIX scale) {
+	// ͂ňxsA擾鎞͕ێĂlԂ
+	this->position = GetPosition(position);
+	this->rotation = GetRotation(rotation);
+	this->scale = GetScale(scale);
+	worldDirty = true;
+}
 
-	Debugger::ErrorCheck(device->CreateDescriptorHeap(&descriptorHeapDesc, IID_PPV_ARGS(worldDescriptorHeap.ReleaseAndGetAddressOf())));
+void Shape::SetWorldMatrix(DirectX::FXMMATRIX world) {
+	this->world = world;
+	instanceMatrix = DirectX::XMMatrixScaling(baseSize.x, baseSize.y, 1.0f) * world;
+	worldDirty = false;
+	constantDirty = true;
+}
 
-	D3D12_CONSTANT_BUFFER_VIEW_DESC constantBufferViewDesc = {};
-	constantBufferViewDesc.BufferLocation = constBuffer->GetGPUVirtualAddress();
-	constantBufferViewDesc.SizeInBytes = constBuffer->GetDesc().Width;
+void Shape::SetUV(std::vector<DirectX::XMFLOAT2> uv) {
+	// bV͑̐}`ƋLĂ̂ŏAVẽbVɎւ
+	std::vector<VertexData> vertices = mesh->GetVertices();
+	for (int i = 0; i < vertices.size(); i++) {
+		vertices[i].uv = uv[i];
+	}
 
-	device->CreateConstantBufferView(&constantBufferViewDesc, worldDescriptorHeap->GetCPUDescriptorHandleForHeapStart());
+	auto next = MeshRegistry::Acquire(vertices, mesh->GetIndices());
+	MeshRegistry::Release(mesh);
+	mesh = next;
 }
 
-void Shape::Draw(ID3D12GraphicsCommandList* cmdList) {
-	*world = scale * rotate * position;
-
-	cmdList->SetDescriptorHeaps(1, worldDescriptorHeap.GetAddressOf());
-	cmdList->SetGraphicsRootDescriptorTable(1, worldDescriptorHeap->GetGPUDescriptorHandleForHeapStart());
+DirectX::XMFLOAT3 Shape::GetColor() {
+	if (mesh == nullptr || mesh->GetVertices().empty()) {
+		return DirectX::XMFLOAT3(1.0f, 1.0f, 1.0f);
+	}
 
-	cmdList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-	cmdList->IASetVertexBuffers(0, 1, &vertexBufferView);
-	cmdList->IASetIndexBuffer(&indexBufferView);
-	cmdList->DrawIndexedInstanced(indices.size(), 1, 0, 0, 0);
+	return mesh->GetVertices()[0].color;
 }
 
-void Shape::SetTransform(DirectX::XMMATRIX position, DirectX::XMMATRIX rotation, DirectX::XMMATRIX scale) {
-	this->position = position;
-	rotate = rotation;
-	this->scale = scale;
+const std::vector<Shape::VertexData>& Shape::GetVertices() {
+	return mesh->GetVertices();
 }
 
-void Shape::SetUV(std::vector<DirectX::XMFLOAT2> uv) {
-	for (int i = 0; i < vertices.size(); i++) {
-		verticesMap[i].uv.x = uv[i].x;
-		verticesMap[i].uv.y = uv[i].y;
-	}
+const std::vector<unsigned short>& Shape::GetIndices() {
+	return mesh->GetIndices();
 }
 
 std::vector<DirectX::XMFLOAT2> Shape::GetUV() {
+	auto& vertices = mesh->GetVertices();
 	std::vector<DirectX::XMFLOAT2> result(vertices.size());
 
 	for (int i = 0; i < vertices.size(); i++) {
@@ -121,17 +151,18 @@ std::vector<DirectX::XMFLOAT2> Shape::GetUV() {
 }
 
 void Shape::SetPosition(DirectX::XMFLOAT3 pos) {
-	position = DirectX::XMMatrixTranslation(pos.x, pos.y, pos.z);
+	position = pos;
+	worldDirty = true;
 }
 
 void Shape::SetRotation(DirectX::XMFLOAT3 rot) {
-	rotate = DirectX::XMMatrixRotationX(rot.x);
-	rotate = DirectX::XMMatrixRotationY(rot.y);
-	rotate = DirectX::XMMatrixRotationZ(rot.z);
+	rotation = rot;
+	worldDirty = true;
 }
 
 void Shape::SetScale(DirectX::XMFLOAT3 sca) {
-	scale = DirectX::XMMatrixScaling(sca.x, sca.y, sca.z);
+	scale = sca;
+	worldDirty = true;
 }
 
 DirectX::XMFLOAT3 Shape::GetPosition(DirectX::XMMATRIX transform) {
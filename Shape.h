@@ -3,10 +3,20 @@
 #include <d3d12.h>
 #include <DirectXMath.h>
 #include <wrl.h>
+#include "ResourceAllocator.h"
+#include "ViewCuller.h"
 
 #include <vector>
 #include <memory>
 
+// CX^X`ŋL̒PʃbVg}`̎
+enum class ShapeType {
+	CUSTOM,
+	BOX,
+	CIRCLE,
+	TRIANGLE
+};
+
 class Shape
 {
 public:
@@ -17,49 +27,92 @@ public:
 	};
 
 private:
-	std::vector<VertexData> vertices;
-	Microsoft::WRL::ComPtr<ID3D12Resource> vertexBuffer = nullptr;
-	D3D12_VERTEX_BUFFER_VIEW vertexBufferView;
+	// `̐}`mŋLiMeshRegistryj
+	std::shared_ptr<class Mesh> mesh;
+
+	DirectX::XMFLOAT3 position;
+	DirectX::XMFLOAT3 rotation;
+	DirectX::XMFLOAT3 scale;
+
+	// WE]Eg傪ς蒼
+	DirectX::XMMATRIX world;
+	DirectX::XMMATRIX instanceMatrix;
+	bool worldDirty;
 
-	std::vector<unsigned short> indices;
-	Microsoft::WRL::ComPtr<ID3D12Resource> indexBuffer = nullptr;
-	D3D12_INDEX_BUFFER_VIEW indexBufferView;
+	// Ws̒萔obt@BWs񂪕ς̍ŏ̕`ł
+	ResourceAllocator::BufferRange worldConstant;
+	bool constantDirty;
 
-	Microsoft::WRL::ComPtr<ID3D12Resource> constBuffer;
-	Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> worldDescriptorHeap;
-	DirectX::XMMATRIX* world;
+	// _x߂iʊO̔Ɏgj
+	ViewCuller::Bounds localBounds;
 
-	VertexData* verticesMap;
+	ID3D12Device* device;
 
-	DirectX::XMMATRIX position;
-	DirectX::XMMATRIX rotate;
-	DirectX::XMMATRIX scale;
+	ShapeType type;
+	DirectX::XMFLOAT2 baseSize;
 
 public:
 	Shape();
 	~Shape();
 
+	Shape(const Shape&) = delete;
+	Shape& operator=(const Shape&) = delete;
+
+protected:
+	/// <summary>
+	/// PʃbVbaseSizeŊg債̂Ɠ`ł邱Ƃݒ肷
+	/// </summary>
+	void SetShapeType(ShapeType type, DirectX::XMFLOAT2 baseSize);
+
 private:
-	void CreateVertexBufferView(ID3D12Device* device);
-	void CreateIndexBufferView(ID3D12Device* device);
-	void CreateTransform(ID3D12Device* device);
+	void UpdateWorldMatrix();
 
 public:
 	void CreateShape(std::vector<VertexData> vertex, std::vector<unsigned short> index, ID3D12Device* device);
 	void Draw(ID3D12GraphicsCommandList* cmdList);
-
+	void Draw(class RenderBackend* backend);
+	void DrawInstanced(ID3D12GraphicsCommandList* cmdList, const D3D12_VERTEX_BUFFER_VIEW& instanceView, UINT instanceCount);
+
+	/// <summary>
+	/// }`g̍WE]Eg
+	/// SetWorldMatrixōs^iTransformHierarchyɌѕtĂԁj́AGetŕԂ͍̂Ōɐݒ肵l̂܂܂ŁA`悳ʒuł͂Ȃ
+	/// `悳ʒuGetPosition(GetWorldMatrix())ŋ߂
+	/// ѕt܂SetƁAɃm[h̍s񂪕ς܂ł͂̒lŕ`Bʒu̓m[h̕ŕς邱
+	/// </summary>
 	void SetPosition(DirectX::XMFLOAT3 position);
 	void SetRotation(DirectX::XMFLOAT3 rotate);
 	void SetScale(DirectX::XMFLOAT3 scale);
 
+	DirectX::XMFLOAT3 GetPosition() { return position; }
+	DirectX::XMFLOAT3 GetRotation() { return rotation; }
+	DirectX::XMFLOAT3 GetScale() { return scale; }
+
+	/// <summary>
+	/// s񂩂番ivẐŁA}`g̒l͈Ȃ̕gj
+	/// </summary>
 	DirectX::XMFLOAT3 GetPosition(DirectX::XMMATRIX transform);
 	DirectX::XMFLOAT3 GetRotation(DirectX::XMMATRIX transform);
 	DirectX::XMFLOAT3 GetScale(DirectX::XMMATRIX transform);
 
 	void SetTransform(DirectX::XMMATRIX position, DirectX::XMMATRIX rotation, DirectX::XMMATRIX scale);
+	/// <summary>
+	/// eq֌WiTransformHierarchyjȂǂŋ߂[hŝ܂܎g
+	/// SetPositionESetRotationESetScaleESetTransformĂԂ܂ŗLŁAGetPositionɂ͔fȂiȂGet͌ÂlԂj
+	/// </summary>
+	void SetWorldMatrix(DirectX::FXMMATRIX world);
 	void SetUV(std::vector<DirectX::XMFLOAT2> uv);
 
-	DirectX::XMMATRIX GetTransform() { return *world; }
+	DirectX::XMMATRIX GetTransform() { return GetWorldMatrix(); }
+	DirectX::XMMATRIX GetWorldMatrix() { UpdateWorldMatrix(); return world; }
+	DirectX::XMMATRIX GetInstanceMatrix() { UpdateWorldMatrix(); return instanceMatrix; }
+
+	ShapeType GetShapeType() { return type; }
+	const ViewCuller::Bounds& GetLocalBounds() { return localBounds; }
+	DirectX::XMFLOAT3 GetColor();
 
 	std::vector<DirectX::XMFLOAT2> GetUV();
+
+	const std::vector<VertexData>& GetVertices();
+	const std::vector<unsigned short>& GetIndices();
+	std::shared_ptr<class Mesh> GetMesh() { return mesh; }
 };
\ No newline at end of file
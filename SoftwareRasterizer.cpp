@@ -0,0 +1,597 @@
+#include "SoftwareRasterizer.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#else
+#include <emmintrin.h>
+#endif
+
+namespace {
+	// SIMD̕AVX2/SSEŐ؂ւ
+#if defined(__AVX2__)
+	typedef __m256 vfloat;
+	const int LANES = 8;
+	inline vfloat VSet(float value) { return _mm256_set1_ps(value); }
+	inline vfloat VAdd(vfloat a, vfloat b) { return _mm256_add_ps(a, b); }
+	inline vfloat VMul(vfloat a, vfloat b) { return _mm256_mul_ps(a, b); }
+	inline vfloat VAnd(vfloat a, vfloat b) { return _mm256_and_ps(a, b); }
+	inline vfloat VOr(vfloat a, vfloat b) { return _mm256_or_ps(a, b); }
+	inline vfloat VGreater(vfloat a, vfloat b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+	inline vfloat VEqual(vfloat a, vfloat b) { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+	inline int VMask(vfloat a) { return _mm256_movemask_ps(a); }
+	inline vfloat VStep() { return _mm256_setr_ps(0, 1, 2, 3, 4, 5, 6, 7); }
+	inline void VStore(float* out, vfloat a) { _mm256_storeu_ps(out, a); }
+#else
+	typedef __m128 vfloat;
+	const int LANES = 4;
+	inline vfloat VSet(float value) { return _mm_set1_ps(value); }
+	inline vfloat VAdd(vfloat a, vfloat b) { return _mm_add_ps(a, b); }
+	inline vfloat VMul(vfloat a, vfloat b) { return _mm_mul_ps(a, b); }
+	inline vfloat VAnd(vfloat a, vfloat b) { return _mm_and_ps(a, b); }
+	inline vfloat VOr(vfloat a, vfloat b) { return _mm_or_ps(a, b); }
+	inline vfloat VGreater(vfloat a, vfloat b) { return _mm_cmpgt_ps(a, b); }
+	inline vfloat VEqual(vfloat a, vfloat b) { return _mm_cmpeq_ps(a, b); }
+	inline int VMask(vfloat a) { return _mm_movemask_ps(a); }
+	inline vfloat VStep() { return _mm_setr_ps(0, 1, 2, 3); }
+	inline void VStore(float* out, vfloat a) { _mm_storeu_ps(out, a); }
+#endif
+
+	inline uint8_t ToUNorm(float value) {
+		if (!(value > 0.0f)) {
+			return 0;
+		}
+		if (value >= 1.0f) {
+			return 255;
+		}
+		return (uint8_t)(value * 255.0f + 0.5f);
+	}
+
+	inline uint32_t PackColor(float r, float g, float b, float a) {
+		return (uint32_t)ToUNorm(r) | ((uint32_t)ToUNorm(g) << 8) | ((uint32_t)ToUNorm(b) << 16) | ((uint32_t)ToUNorm(a) << 24);
+	}
+
+	inline int Wrap(int value, int size) {
+		value %= size;
+		return value < 0 ? value + size : value;
+	}
+
+	// TexPixelShader.hlsl̃Tv[ƓbvEoCjAœǂ
+	uint32_t SampleTexture(const RasterTexture& texture, float u, float v) {
+		if (texture.pixels == nullptr || texture.width <= 0 || texture.height <= 0) {
+			return 0xff000000;
+		}
+
+		float fx = u * (float)texture.width - 0.5f;
+		float fy = v * (float)texture.height - 0.5f;
+		float floorX = std::floor(fx);
+		float floorY = std::floor(fy);
+		float tx = fx - floorX;
+		float ty = fy - floorY;
+
+		int x0 = Wrap((int)floorX, texture.width);
+		int y0 = Wrap((int)floorY, texture.height);
+		int x1 = Wrap(x0 + 1, texture.width);
+		int y1 = Wrap(y0 + 1, texture.height);
+
+		const uint8_t* row0 = texture.pixels + (size_t)y0 * texture.rowPitch;
+		const uint8_t* row1 = texture.pixels + (size_t)y1 * texture.rowPitch;
+		const uint8_t* p00 = row0 + x0 * 4;
+		const uint8_t* p10 = row0 + x1 * 4;
+		const uint8_t* p01 = row1 + x0 * 4;
+		const uint8_t* p11 = row1 + x1 * 4;
+
+		uint32_t result = 0;
+		for (int c = 0; c < 4; c++) {
+			float top = (float)p00[c] + ((float)p10[c] - (float)p00[c]) * tx;
+			float bottom = (float)p01[c] + ((float)p11[c] - (float)p01[c]) * tx;
+			float value = top + (bottom - top) * ty;
+			result |= (uint32_t)(value + 0.5f) << (c * 8);
+		}
+		return result;
+	}
+
+	inline int OutCode(double x, double y, double maxX, double maxY) {
+		return (x < 0.0 ? 1 : 0) | (x > maxX ? 2 : 0) | (y < 0.0 ? 4 : 0) | (y > maxY ? 8 : 0);
+	}
+
+	// `[0, maxX] x [0, maxY]Ő؂iCohen-Sutherlandj
+	// [_ӂ̏֍WœBtŕ\Ɖʂ肸ƒł͉ʂ̕덷ɖ
+	bool ClipLine(double& ax, double& ay, double& bx, double& by, double maxX, double maxY) {
+		int codeA = OutCode(ax, ay, maxX, maxY);
+		int codeB = OutCode(bx, by, maxX, maxY);
+		// 덷ŕӂ̂킸ɊOɏoĂAŎ܂
+		for (int iteration = 0; iteration < 8; iteration++) {
+			if ((codeA | codeB) == 0) {
+				return true;
+			}
+			if ((codeA & codeB) != 0) {
+				return false;
+			}
+
+			int code = codeA != 0 ? codeA : codeB;
+			double x, y;
+			if (code & 4) {
+				x = ax + (bx - ax) * ((0.0 - ay) / (by - ay));
+				y = 0.0;
+			}
+			else if (code & 8) {
+				x = ax + (bx - ax) * ((maxY - ay) / (by - ay));
+				y = maxY;
+			}
+			else if (code & 1) {
+				x = 0.0;
+				y = ay + (by - ay) * ((0.0 - ax) / (bx - ax));
+			}
+			else {
+				x = maxX;
+				y = ay + (by - ay) * ((maxX - ax) / (bx - ax));
+			}
+
+			if (code == codeA) {
+				ax = x;
+				ay = y;
+				codeA = OutCode(ax, ay, maxX, maxY);
+			}
+			else {
+				bx = x;
+				by = y;
+				codeB = OutCode(bx, by, maxX, maxY);
+			}
+		}
+		return (codeA & codeB) == 0;
+	}
+
+	// Ɋۂ߂銄Zidenominator͐j
+	inline int64_t FloorDivide(int64_t numerator, int64_t denominator) {
+		return numerator >= 0 ? numerator / denominator : -((-numerator + denominator - 1) / denominator);
+	}
+
+	void MultiplyMatrix(const float* a, const float* b, float* out) {
+		for (int row = 0; row < 4; row++) {
+			for (int column = 0; column < 4; column++) {
+				out[row * 4 + column] =
+					a[row * 4 + 0] * b[0 * 4 + column] +
+					a[row * 4 + 1] * b[1 * 4 + column] +
+					a[row * 4 + 2] * b[2 * 4 + column] +
+					a[row * 4 + 3] * b[3 * 4 + column];
+			}
+		}
+	}
+}
+
+SoftwareRasterizer::SoftwareRasterizer(int width, int height, int threadCount) {
+	this->width = width;
+	this->height = height;
+	tileCountX = (width + TILE_SIZE - 1) / TILE_SIZE;
+	tileCountY = (height + TILE_SIZE - 1) / TILE_SIZE;
+
+	frameBuffer.resize((size_t)width * height, 0xff000000);
+	tileBins.resize((size_t)tileCountX * tileCountY);
+	tilePixels.resize(tileBins.size(), 0);
+
+	// Renderer̃RXgN^Ɠˉẽr[s
+	std::memset(view, 0, sizeof(view));
+	view[0] = 2.0f / (float)width;
+	view[5] = -2.0f / (float)height;
+	view[10] = 1.0f;
+	view[12] = -1.0f;
+	view[13] = 1.0f;
+	view[15] = 1.0f;
+
+	currentPipeline = RasterPipeline::NORMAL;
+	currentTexture = {};
+	stateDirty = true;
+
+	clearPending = false;
+	clearColor = 0xff000000;
+
+	threadPool = std::make_unique<ThreadPool>(threadCount);
+
+	statistics = {};
+}
+
+SoftwareRasterizer::~SoftwareRasterizer() {
+
+}
+
+void SoftwareRasterizer::SetViewMatrix(const float* matrix) {
+	std::memcpy(view, matrix, sizeof(view));
+}
+
+void SoftwareRasterizer::SetPipeline(RasterPipeline pipeline) {
+	currentPipeline = pipeline;
+	stateDirty = true;
+}
+
+void SoftwareRasterizer::SetTexture(const RasterTexture& texture) {
+	currentTexture = texture;
+	stateDirty = true;
+}
+
+void SoftwareRasterizer::Clear(float r, float g, float b, float a) {
+	// ܂Ă`͎̂āA^C̍ŏɓhԂ
+	primitives.clear();
+	states.clear();
+	stateDirty = true;
+	for (auto& bin : tileBins) {
+		bin.clear();
+	}
+
+	clearColor = PackColor(r, g, b, a);
+	clearPending = true;
+}
+
+int SoftwareRasterizer::CurrentState() {
+	if (stateDirty || states.empty()) {
+		states.push_back({ currentPipeline, currentTexture });
+		stateDirty = false;
+	}
+	return (int)states.size() - 1;
+}
+
+void SoftwareRasterizer::TransformVertex(const RasterVertex& vertex, const float* matrix, float& x, float& y) {
+	// BasicVertexShader.hlslƓ pos * world * view vZAr[|[gϊ
+	const float* p = vertex.position;
+	float clipX = p[0] * matrix[0] + p[1] * matrix[4] + p[2] * matrix[8] + matrix[12];
+	float clipY = p[0] * matrix[1] + p[1] * matrix[5] + p[2] * matrix[9] + matrix[13];
+	float clipW = p[0] * matrix[3] + p[1] * matrix[7] + p[2] * matrix[11] + matrix[15];
+	if (clipW == 0.0f) {
+		clipW = 1.0f;
+	}
+
+	x = (clipX / clipW + 1.0f) * 0.5f * (float)width;
+	y = (1.0f - clipY / clipW) * 0.5f * (float)height;
+}
+
+void SoftwareRasterizer::BinPrimitive(int index) {
+	Primitive& primitive = primitives[index];
+
+	float minX = primitive.x[0], maxX = primitive.x[0];
+	float minY = primitive.y[0], maxY = primitive.y[0];
+	for (int i = 1; i < primitive.vertexCount; i++) {
+		minX = std::min(minX, primitive.x[i]);
+		maxX = std::max(maxX, primitive.x[i]);
+		minY = std::min(minY, primitive.y[i]);
+		maxY = std::max(maxY, primitive.y[i]);
+	}
+
+	// ʊȎ傫ȒlintɂłȂ̂ŁAʂ̏O܂łɎ߂ĂϊiNaN͕`Ȃj
+	if (std::isnan(minX) || std::isnan(maxX) || std::isnan(minY) || std::isnan(maxY)) {
+		return;
+	}
+	minX = std::min(std::max(minX, -1.0f), (float)width);
+	maxX = std::min(std::max(maxX, -1.0f), (float)width);
+	minY = std::min(std::max(minY, -1.0f), (float)height);
+	maxY = std::min(std::max(maxY, -1.0f), (float)height);
+
+	primitive.minX = std::max(0, (int)std::floor(minX));
+	primitive.minY = std::max(0, (int)std::floor(minY));
+	primitive.maxX = std::min(width - 1, (int)std::ceil(maxX));
+	primitive.maxY = std::min(height - 1, (int)std::ceil(maxY));
+	if (primitive.minX > primitive.maxX || primitive.minY > primitive.maxY) {
+		return;
+	}
+
+	for (int ty = primitive.minY / TILE_SIZE; ty <= primitive.maxY / TILE_SIZE; ty++) {
+		for (int tx = primitive.minX / TILE_SIZE; tx <= primitive.maxX / TILE_SIZE; tx++) {
+			tileBins[ty * tileCountX + tx].push_back((uint32_t)index);
+			statistics.binnedPrimitives++;
+		}
+	}
+}
+
+void SoftwareRasterizer::DrawIndexed(const RasterVertex* vertices, size_t vertexCount, const uint16_t* indices, size_t indexCount, const float* world) {
+	float matrix[16];
+	MultiplyMatrix(world, view, matrix);
+
+	std::vector<float> screen(vertexCount * 2);
+	for (size_t i = 0; i < vertexCount; i++) {
+		TransformVertex(vertices[i], matrix, screen[i * 2], screen[i * 2 + 1]);
+	}
+
+	int state = CurrentState();
+	for (size_t i = 0; i + 2 < indexCount; i += 3) {
+		Primitive primitive;
+		primitive.vertexCount = 3;
+		primitive.state = state;
+		for (int v = 0; v < 3; v++) {
+			uint16_t index = indices[i + v];
+			if (index >= vertexCount) {
+				return;
+			}
+			primitive.x[v] = screen[index * 2];
+			primitive.y[v] = screen[index * 2 + 1];
+			std::memcpy(primitive.color[v], vertices[index].color, sizeof(float) * 3);
+			std::memcpy(primitive.uv[v], vertices[index].uv, sizeof(float) * 2);
+		}
+
+		primitives.push_back(primitive);
+		BinPrimitive((int)primitives.size() - 1);
+		statistics.triangles++;
+	}
+}
+
+void SoftwareRasterizer::DrawLines(const RasterVertex* vertices, size_t vertexCount, const float* world) {
+	float matrix[16];
+	MultiplyMatrix(world, view, matrix);
+
+	int state = CurrentState();
+	for (size_t i = 0; i + 1 < vertexCount; i += 2) {
+		statistics.lines++;
+
+		float x[2], y[2];
+		for (int v = 0; v < 2; v++) {
+			TransformVertex(vertices[i + v], matrix, x[v], y[v]);
+		}
+		if (!std::isfinite(x[0]) || !std::isfinite(y[0]) || !std::isfinite(x[1]) || !std::isfinite(y[1])) {
+			continue;
+		}
+
+		// ɉʂ͈̔͂doubleŐ؂A[_f̈ʒuŕ\傫ɂĂ
+		// ifloat̂܂tŐiނƁAʂ̉{ł͉fj
+		double clipped[2][2] = { { x[0], y[0] }, { x[1], y[1] } };
+		if (!ClipLine(clipped[0][0], clipped[0][1], clipped[1][0], clipped[1][1], (double)width, (double)height)) {
+			continue;
+		}
+
+		Primitive primitive;
+		primitive.vertexCount = 2;
+		primitive.state = state;
+		double dx = (double)x[1] - (double)x[0];
+		double dy = (double)y[1] - (double)y[0];
+		for (int v = 0; v < 2; v++) {
+			// ɒ[ɒ͐؂ʒǔ덷傫̂ŁA͈͂̒ɖ߂
+			primitive.x[v] = (float)std::min(std::max(clipped[v][0], 0.0), (double)width);
+			primitive.y[v] = (float)std::min(std::max(clipped[v][1], 0.0), (double)height);
+
+			// FUV͐؂ʒu܂ŕԂĂ
+			double t = 0.0;
+			if (std::fabs(dx) >= std::fabs(dy) && dx != 0.0) {
+				t = (clipped[v][0] - (double)x[0]) / dx;
+			}
+			else if (dy != 0.0) {
+				t = (clipped[v][1] - (double)y[0]) / dy;
+			}
+			for (int c = 0; c < 3; c++) {
+				const float* from = vertices[i].color;
+				const float* to = vertices[i + 1].color;
+				primitive.color[v][c] = (float)((double)from[c] + ((double)to[c] - (double)from[c]) * t);
+			}
+			for (int c = 0; c < 2; c++) {
+				const float* from = vertices[i].uv;
+				const float* to = vertices[i + 1].uv;
+				primitive.uv[v][c] = (float)((double)from[c] + ((double)to[c] - (double)from[c]) * t);
+			}
+		}
+
+		primitives.push_back(primitive);
+		BinPrimitive((int)primitives.size() - 1);
+	}
+}
+
+void SoftwareRasterizer::Flush() {
+	std::fill(tilePixels.begin(), tilePixels.end(), 0);
+	threadPool->ParallelFor(tileCountX * tileCountY, [this](int tile) { RasterizeTile(tile); });
+	for (auto pixels : tilePixels) {
+		statistics.pixels += pixels;
+	}
+
+	primitives.clear();
+	states.clear();
+	stateDirty = true;
+	for (auto& bin : tileBins) {
+		bin.clear();
+	}
+	clearPending = false;
+}
+
+void SoftwareRasterizer::RasterizeTile(int tile) {
+	int x0 = (tile % tileCountX) * TILE_SIZE;
+	int y0 = (tile / tileCountX) * TILE_SIZE;
+	int x1 = std::min(x0 + TILE_SIZE, width) - 1;
+	int y1 = std::min(y0 + TILE_SIZE, height) - 1;
+
+	if (clearPending) {
+		for (int y = y0; y <= y1; y++) {
+			std::fill(frameBuffer.begin() + (size_t)y * width + x0, frameBuffer.begin() + (size_t)y * width + x1 + 1, clearColor);
+		}
+	}
+
+	// o^ɏ̂ŁAuhGPUƓ㏑ɂȂ
+	for (auto index : tileBins[tile]) {
+		const Primitive& primitive = primitives[index];
+		const State& state = states[primitive.state];
+
+		int minX = std::max(x0, primitive.minX);
+		int minY = std::max(y0, primitive.minY);
+		int maxX = std::min(x1, primitive.maxX);
+		int maxY = std::min(y1, primitive.maxY);
+
+		if (primitive.vertexCount == 3) {
+			tilePixels[tile] += RasterizeTriangle(primitive, state, minX, minY, maxX, maxY);
+		}
+		else {
+			tilePixels[tile] += RasterizeLine(primitive, state, minX, minY, maxX, maxY);
+		}
+	}
+}
+
+uint64_t SoftwareRasterizer::RasterizeTriangle(const Primitive& primitive, const State& state, int x0, int y0, int x1, int y1) {
+	int i0 = 0, i1 = 1, i2 = 2;
+
+	float area = (primitive.x[i1] - primitive.x[i0]) * (primitive.y[i2] - primitive.y[i0]) - (primitive.y[i1] - primitive.y[i0]) * (primitive.x[i2] - primitive.x[i0]);
+	if (area == 0.0f) {
+		return 0;
+	}
+	// JOȂ̂ŁA͒_ւĕ\ƂĈ
+	if (area < 0.0f) {
+		std::swap(i1, i2);
+		area = -area;
+	}
+
+	const int order[3] = { i0, i1, i2 };
+	float edgeA[3], edgeB[3], edgeC[3];
+	vfloat topLeft[3];
+	for (int e = 0; e < 3; e++) {
+		// e͒_order[e]̌
+		int a = order[(e + 1) % 3];
+		int b = order[(e + 2) % 3];
+		float ax = primitive.x[a], ay = primitive.y[a];
+		float bx = primitive.x[b], by = primitive.y[b];
+
+		edgeA[e] = ay - by;
+		edgeB[e] = bx - ax;
+		edgeC[e] = ax * by - ay * bx;
+
+		// ӁEӂ̃gbvtg[
+		bool isTopLeft = (edgeA[e] > 0.0f) || (edgeA[e] == 0.0f && edgeB[e] < 0.0f);
+		topLeft[e] = VGreater(VSet(isTopLeft ? 1.0f : 0.0f), VSet(0.0f));
+	}
+
+	float invArea = 1.0f / area;
+	const vfloat zero = VSet(0.0f);
+	const vfloat step = VStep();
+	float w1Lanes[LANES], w2Lanes[LANES];
+	uint64_t pixels = 0;
+
+	for (int y = y0; y <= y1; y++) {
+		float py = (float)y + 0.5f;
+		uint32_t* row = frameBuffer.data() + (size_t)y * width;
+
+		for (int x = x0; x <= x1; x += LANES) {
+			vfloat px = VAdd(VSet((float)x + 0.5f), step);
+			vfloat w[3];
+			vfloat inside = VGreater(VSet(1.0f), zero);
+			for (int e = 0; e < 3; e++) {
+				w[e] = VAdd(VAdd(VMul(VSet(edgeA[e]), px), VSet(edgeB[e] * py)), VSet(edgeC[e]));
+				vfloat covered = VOr(VGreater(w[e], zero), VAnd(VEqual(w[e], zero), topLeft[e]));
+				inside = VAnd(inside, covered);
+			}
+
+			int mask = VMask(inside);
+			if (mask == 0) {
+				continue;
+			}
+
+			VStore(w1Lanes, VMul(w[1], VSet(invArea)));
+			VStore(w2Lanes, VMul(w[2], VSet(invArea)));
+
+			for (int lane = 0; lane < LANES; lane++) {
+				if ((mask & (1 << lane)) == 0 || x + lane > x1) {
+					continue;
+				}
+
+				float l1 = w1Lanes[lane];
+				float l2 = w2Lanes[lane];
+				float l0 = 1.0f - l1 - l2;
+
+				uint32_t color;
+				if (state.pipeline == RasterPipeline::TEXTURE) {
+					float u = primitive.uv[i0][0] * l0 + primitive.uv[i1][0] * l1 + primitive.uv[i2][0] * l2;
+					float v = primitive.uv[i0][1] * l0 + primitive.uv[i1][1] * l1 + primitive.uv[i2][1] * l2;
+					color = SampleTexture(state.texture, u, v);
+				}
+				else {
+					float r = primitive.color[i0][0] * l0 + primitive.color[i1][0] * l1 + primitive.color[i2][0] * l2;
+					float g = primitive.color[i0][1] * l0 + primitive.color[i1][1] * l1 + primitive.color[i2][1] * l2;
+					float b = primitive.color[i0][2] * l0 + primitive.color[i1][2] * l1 + primitive.color[i2][2] * l2;
+					color = PackColor(r, g, b, 1.0f);
+				}
+
+				row[x + lane] = color;
+				pixels++;
+			}
+		}
+	}
+
+	return pixels;
+}
+
+uint64_t SoftwareRasterizer::RasterizeLine(const Primitive& primitive, const State& state, int x0, int y0, int x1, int y1) {
+	// DrawLinesŉʂɐ؂Ă̂ŁA[_[0, width] x [0, height]ɂA؂̂Ăintɂł
+	int startX = (int)primitive.x[0];
+	int startY = (int)primitive.y[0];
+	int endX = (int)primitive.x[1];
+	int endY = (int)primitive.y[1];
+
+	// ω̑傫i厲j1fi߁A̎̈ʒu͐ŋ߂i[̉f܂ށj
+	bool xMajor = std::abs(endX - startX) >= std::abs(endY - startY);
+	int majorStart = xMajor ? startX : startY;
+	int majorDelta = xMajor ? endX - startX : endY - startY;
+	int minorStart = xMajor ? startY : startX;
+	int minorDelta = xMajor ? endY - startY : endX - startX;
+	int majorMin = xMajor ? x0 : y0;
+	int majorMax = xMajor ? x1 : y1;
+	int minorMin = xMajor ? y0 : x0;
+	int minorMax = xMajor ? y1 : x1;
+	int steps = std::abs(majorDelta);
+	int majorStep = majorDelta < 0 ? -1 : 1;
+
+	// 厲^CɊ|͈͂i
+	int first, last;
+	if (majorStep > 0) {
+		first = std::max(0, majorMin - majorStart);
+		last = std::min(steps, majorMax - majorStart);
+	}
+	else {
+		first = std::max(0, majorStart - majorMax);
+		last = std::min(steps, majorStart - majorMin);
+	}
+	if (first > last) {
+		return 0;
+	}
+
+	// ̈ʒuminorStart + round(i * minorDelta / steps)BŜ̎狁߂̂ŁA^ČpڂȂ
+	// numerator / denominatoȑƗ]A1ƂɑĐi߂
+	int64_t denominator = 2 * (int64_t)std::max(steps, 1);
+	int64_t increment = 2 * (int64_t)minorDelta;
+	int64_t numerator = (int64_t)first * increment + std::max(steps, 1);
+	int64_t quotient = FloorDivide(numerator, denominator);
+	int64_t remainder = numerator - quotient * denominator;
+
+	uint64_t pixels = 0;
+	for (int i = first; i <= last; i++) {
+		int minor = minorStart + (int)quotient;
+		remainder += increment;
+		if (remainder >= denominator) {
+			remainder -= denominator;
+			quotient++;
+		}
+		else if (remainder < 0) {
+			remainder += denominator;
+			quotient--;
+		}
+		if (minor < minorMin || minor > minorMax) {
+			continue;
+		}
+
+		int major = majorStart + i * majorStep;
+		int x = xMajor ? major : minor;
+		int y = xMajor ? minor : major;
+		float t = steps > 0 ? (float)i / (float)steps : 0.0f;
+
+		uint32_t color;
+		if (state.pipeline == RasterPipeline::TEXTURE) {
+			float u = primitive.uv[0][0] + (primitive.uv[1][0] - primitive.uv[0][0]) * t;
+			float v = primitive.uv[0][1] + (primitive.uv[1][1] - primitive.uv[0][1]) * t;
+			color = SampleTexture(state.texture, u, v);
+		}
+		else {
+			float r = primitive.color[0][0] + (primitive.color[1][0] - primitive.color[0][0]) * t;
+			float g = primitive.color[0][1] + (primitive.color[1][1] - primitive.color[0][1]) * t;
+			float b = primitive.color[0][2] + (primitive.color[1][2] - primitive.color[0][2]) * t;
+			color = PackColor(r, g, b, 1.0f);
+		}
+
+		frameBuffer[(size_t)y * width + x] = color;
+		pixels++;
+	}
+
+	return pixels;
+}
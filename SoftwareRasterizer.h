@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Shape::VertexDataƓCAEg
+typedef struct RasterVertex {
+	float position[3];
+	float color[3];
+	float uv[2];
+};
+
+// R8G8B8A8̃eNX`
+typedef struct RasterTexture {
+	const uint8_t* pixels;
+	int width;
+	int height;
+	int rowPitch;
+};
+
+enum class RasterPipeline {
+	NORMAL,		// BasicPixelShader.hlsl
+	TEXTURE		// TexPixelShader.hlsl
+};
+
+typedef struct RasterStatistics {
+	uint64_t triangles;
+	uint64_t lines;
+	uint64_t binnedPrimitives;
+	uint64_t pixels;
+};
+
+// ^CE}`XbhESIMDŕ`悷CPUX^CU
+// `施߂Flush܂ŗ߂ĂA^CƂɕɏ
+class SoftwareRasterizer
+{
+public:
+	static const int TILE_SIZE = 64;
+
+private:
+	typedef struct Primitive {
+		float x[3];
+		float y[3];
+		float color[3][3];
+		float uv[3][2];
+		int vertexCount;
+		int state;
+		int minX, minY, maxX, maxY;
+	};
+
+	typedef struct State {
+		RasterPipeline pipeline;
+		RasterTexture texture;
+	};
+
+	int width;
+	int height;
+	int tileCountX;
+	int tileCountY;
+
+	std::vector<uint32_t> frameBuffer;
+	float view[16];
+
+	std::vector<Primitive> primitives;
+	std::vector<State> states;
+	std::vector<std::vector<uint32_t>> tileBins;
+	std::vector<uint64_t> tilePixels;
+
+	RasterPipeline currentPipeline;
+	RasterTexture currentTexture;
+	bool stateDirty;
+
+	bool clearPending;
+	uint32_t clearColor;
+
+	std::unique_ptr<class ThreadPool> threadPool;
+
+	RasterStatistics statistics;
+
+public:
+	SoftwareRasterizer(int width, int height, int threadCount = 0);
+	~SoftwareRasterizer();
+
+private:
+	int CurrentState();
+	void TransformVertex(const RasterVertex& vertex, const float* matrix, float& x, float& y);
+	void BinPrimitive(int index);
+	void RasterizeTile(int tile);
+	uint64_t RasterizeTriangle(const Primitive& primitive, const State& state, int x0, int y0, int x1, int y1);
+	uint64_t RasterizeLine(const Primitive& primitive, const State& state, int x0, int y0, int x1, int y1);
+
+public:
+	void SetViewMatrix(const float* matrix);
+	void SetPipeline(RasterPipeline pipeline);
+	void SetTexture(const RasterTexture& texture);
+	void Clear(float r, float g, float b, float a);
+
+	void DrawIndexed(const RasterVertex* vertices, size_t vertexCount, const uint16_t* indices, size_t indexCount, const float* world);
+	void DrawLines(const RasterVertex* vertices, size_t vertexCount, const float* world);
+
+	void Flush();
+
+	const uint32_t* GetPixels() { return frameBuffer.data(); }
+	int GetWidth() { return width; }
+	int GetHeight() { return height; }
+
+	RasterStatistics GetStatistics() { return statistics; }
+	void ResetStatistics() { statistics = {}; }
+};
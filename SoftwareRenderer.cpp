@@ -0,0 +1,122 @@
+#include "SoftwareRenderer.h"
+
+#include <cstring>
+
+#ifdef _WIN32
+#include "Shape.h"
+#include "Line.h"
+#include "Texture.h"
+#include "Text.h"
+#include "DirectXTex.h"
+
+static_assert(sizeof(RasterVertex) == sizeof(Shape::VertexData), "RasterVertex must match Shape::VertexData");
+static_assert(sizeof(RasterVertex) == sizeof(Line::VertexData), "RasterVertex must match Line::VertexData");
+#endif
+
+SoftwareRenderer::SoftwareRenderer(int width, int height, int threadCount) {
+	rasterizer = std::make_unique<SoftwareRasterizer>(width, height, threadCount);
+	skippedStrings = 0;
+}
+
+SoftwareRenderer::~SoftwareRenderer() {
+
+}
+
+void SoftwareRenderer::BeginDraw() {
+	rasterizer->Clear(0.0f, 0.0f, 0.0f, 1.0f);
+	rasterizer->SetPipeline(RasterPipeline::NORMAL);
+}
+
+void SoftwareRenderer::EndDraw() {
+	rasterizer->Flush();
+}
+
+void SoftwareRenderer::SetNormalPipeline() {
+	rasterizer->SetPipeline(RasterPipeline::NORMAL);
+}
+
+void SoftwareRenderer::SetTexturePipeline() {
+	rasterizer->SetPipeline(RasterPipeline::TEXTURE);
+}
+
+void SoftwareRenderer::DrawShape(Shape* shape) {
+#ifdef _WIN32
+	auto& vertices = shape->GetVertices();
+	auto& indices = shape->GetIndices();
+
+	DirectX::XMFLOAT4X4 world;
+	DirectX::XMStoreFloat4x4(&world, shape->GetWorldMatrix());
+
+	rasterizer->DrawIndexed(reinterpret_cast<const RasterVertex*>(vertices.data()), vertices.size(), indices.data(), indices.size(), &world.m[0][0]);
+#endif
+}
+
+void SoftwareRenderer::DrawLine(Line* line) {
+#ifdef _WIN32
+	auto& vertices = line->GetVertices();
+
+	DirectX::XMFLOAT4X4 world;
+	DirectX::XMStoreFloat4x4(&world, line->GetWorldMatrix());
+
+	rasterizer->DrawLines(reinterpret_cast<const RasterVertex*>(vertices.data()), vertices.size(), &world.m[0][0]);
+#endif
+}
+
+void SoftwareRenderer::DrawTexture(Texture* texture) {
+#ifdef _WIN32
+	rasterizer->SetTexture(GetRasterTexture(texture));
+	DrawShape(texture->GetShape());
+#endif
+}
+
+void SoftwareRenderer::DrawString(Text* text, const std::wstring& str, DirectX::XMFLOAT2 pos, DirectX::FXMVECTOR color) {
+	// SpriteFont̃OtGPUɂȂ̂ŕ`悵Ȃ
+	skippedStrings++;
+}
+
+void SoftwareRenderer::ReleaseTexture(Texture* texture) {
+	convertedImages.erase(texture);
+}
+
+RasterTexture SoftwareRenderer::GetRasterTexture(Texture* texture) {
+#ifdef _WIN32
+	const DirectX::Image* image = texture->GetImage();
+	if (image == nullptr) {
+		return {};
+	}
+
+	RasterTexture result;
+	if (image->format == DXGI_FORMAT_R8G8B8A8_UNORM) {
+		result.pixels = image->pixels;
+		result.width = (int)image->width;
+		result.height = (int)image->height;
+		result.rowPitch = (int)image->rowPitch;
+		return result;
+	}
+
+	// R8G8B8A8ȊO͈xϊĕێĂ
+	auto found = convertedImages.find(texture);
+	if (found == convertedImages.end()) {
+		DirectX::ScratchImage scratch;
+		if (FAILED(DirectX::Convert(*image, DXGI_FORMAT_R8G8B8A8_UNORM, DirectX::TEX_FILTER_DEFAULT, DirectX::TEX_THRESHOLD_DEFAULT, scratch))) {
+			return {};
+		}
+		const DirectX::Image* converted = scratch.GetImage(0, 0, 0);
+		ConvertedImage copy;
+		copy.pixels.resize(converted->slicePitch);
+		std::memcpy(copy.pixels.data(), converted->pixels, converted->slicePitch);
+		copy.width = (int)converted->width;
+		copy.height = (int)converted->height;
+		copy.rowPitch = (int)converted->rowPitch;
+		found = convertedImages.emplace(texture, std::move(copy)).first;
+	}
+
+	result.pixels = found->second.pixels.data();
+	result.width = found->second.width;
+	result.height = found->second.height;
+	result.rowPitch = found->second.rowPitch;
+	return result;
+#else
+	return {};
+#endif
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "RenderBackend.h"
+#include "SoftwareRasterizer.h"
+
+#include <map>
+#include <memory>
+#include <vector>
+
+// GPUg킸̃t[obt@ɕ`悷obNGh
+// D3D12DirectXTex̃wb_[܂܂Ȃ̂ŁAWindowsȊOłrhł
+// ShapeELineETextureD3D12Ɉˑ̂Windowsł`AȊOłGetRasterizer璼ڕ`
+class SoftwareRenderer : public RenderBackend
+{
+private:
+	// R8G8B8A8ȊÕeNX`ϊf
+	typedef struct ConvertedImage {
+		std::vector<uint8_t> pixels;
+		int width;
+		int height;
+		int rowPitch;
+	};
+
+	std::unique_ptr<SoftwareRasterizer> rasterizer;
+	std::map<class Texture*, ConvertedImage> convertedImages;
+
+	unsigned long long skippedStrings;
+
+public:
+	SoftwareRenderer(int width, int height, int threadCount = 0);
+	~SoftwareRenderer();
+
+private:
+	RasterTexture GetRasterTexture(class Texture* texture);
+
+public:
+	void BeginDraw() override;
+	void EndDraw() override;
+
+	void SetNormalPipeline() override;
+	void SetTexturePipeline() override;
+
+	void DrawShape(class Shape* shape) override;
+	void DrawLine(class Line* line) override;
+	void DrawTexture(class Texture* texture) override;
+	void DrawString(class Text* text, const std::wstring& str, DirectX::XMFLOAT2 pos, DirectX::FXMVECTOR color) override;
+
+	void ReleaseTexture(class Texture* texture);
+
+	SoftwareRasterizer* GetRasterizer() { return rasterizer.get(); }
+	const uint32_t* GetPixels() { return rasterizer->GetPixels(); }
+	unsigned long long GetSkippedStringCount() { return skippedStrings; }
+};
@@ -1,5 +1,7 @@
 #include "Sound.h"
 
+#include <cstring>
+
 Sound::Sound() {
 	DirectX::AUDIO_ENGINE_FLAGS eflags = DirectX::AudioEngine_Default;
 #ifdef _DEBUG
@@ -27,6 +29,58 @@ bool Sound::LoadWave(std::wstring fileName, std::string tag) {
 	return true;
 }
 
+bool Sound::LoadWave(const uint8_t* data, size_t size, std::string tag) {
+	if (soundEffectInstances.find(tag) != soundEffectInstances.end()) {
+		return false;
+	}
+
+	// RIFF̃`N"fmt ""data"T
+	if (size < 12 || std::memcmp(data, "RIFF", 4) != 0 || std::memcmp(data + 8, "WAVE", 4) != 0) {
+		return false;
+	}
+	const uint8_t* format = nullptr;
+	const uint8_t* audio = nullptr;
+	uint32_t formatSize = 0;
+	uint32_t audioSize = 0;
+	size_t offset = 12;
+	while (size - offset >= 8) {
+		uint32_t chunkSize;
+		std::memcpy(&chunkSize, data + offset + 4, sizeof(chunkSize));
+		if (size - offset - 8 < chunkSize) {
+			return false;
+		}
+		if (std::memcmp(data + offset, "fmt ", 4) == 0) {
+			format = data + offset + 8;
+			formatSize = chunkSize;
+		}
+		else if (std::memcmp(data + offset, "data", 4) == 0) {
+			audio = data + offset + 8;
+			audioSize = chunkSize;
+		}
+		offset += 8 + (size_t)chunkSize + (chunkSize & 1);
+		if (offset > size) {
+			break;
+		}
+	}
+	if (format == nullptr || audio == nullptr || formatSize < sizeof(PCMWAVEFORMAT)) {
+		return false;
+	}
+
+	// SoundEffectobt@Ɍ`Ɣg`܂Ƃ߂ĎʂBPCM"fmt "ɂcbSizê0Ŗ߂
+	size_t formatBytes = formatSize > sizeof(WAVEFORMATEX) ? formatSize : sizeof(WAVEFORMATEX);
+	size_t audioOffset = (formatBytes + 15) & ~(size_t)15;
+	std::unique_ptr<uint8_t[]> wavData(new uint8_t[audioOffset + audioSize]());
+	std::memcpy(wavData.get(), format, formatSize);
+	std::memcpy(wavData.get() + audioOffset, audio, audioSize);
+
+	auto wfx = reinterpret_cast<const WAVEFORMATEX*>(wavData.get());
+	const uint8_t* startAudio = wavData.get() + audioOffset;
+	soundEffects[tag] = std::make_unique<DirectX::SoundEffect>(audioEngine.get(), wavData, wfx, startAudio, (size_t)audioSize);
+	soundEffectInstances[tag] = soundEffects[tag]->CreateInstance();
+
+	return true;
+}
+
 DirectX::SoundEffectInstance* Sound::GetAudio(std::string tag) {
 	if (soundEffectInstances.find(tag) == soundEffectInstances.end()) {
 		return nullptr;
@@ -18,6 +18,10 @@ public:
 
 public:
 	bool LoadWave(std::wstring fileName, std::string tag);
+	/// <summary>
+	/// WAVt@CǂށiAZbgpbNȂǁjBg̓Rs[̂ŁAdata͓ǂ񂾌͕sv
+	/// </summary>
+	bool LoadWave(const uint8_t* data, size_t size, std::string tag);
 
 	DirectX::SoundEffectInstance* GetAudio(std::string tag);
 };
@@ -0,0 +1,138 @@
+#include "SpatialIndex.h"
+#include "Shape.h"
+
+#include <algorithm>
+
+SpatialIndex::SpatialIndex() {
+	statistics = {};
+}
+
+bool SpatialIndex::IntersectRay(const Ray2D& ray, const Box& box, float& distance) {
+	float enter = 0.0f;
+	float exit = ray.maxDistance;
+
+	// Ƃɔ̗ʂ̊Ԃɂ͈͂߂ďd˂iXu@j
+	const float origins[] = { ray.originX, ray.originY };
+	const float directions[] = { ray.directionX, ray.directionY };
+	const float minimums[] = { box.minX, box.minY };
+	const float maximums[] = { box.maxX, box.maxY };
+	for (int axis = 0; axis < 2; axis++) {
+		if (directions[axis] == 0.0f) {
+			if (origins[axis] < minimums[axis] || origins[axis] > maximums[axis]) {
+				return false;
+			}
+			continue;
+		}
+
+		float inverse = 1.0f / directions[axis];
+		float nearDistance = (minimums[axis] - origins[axis]) * inverse;
+		float farDistance = (maximums[axis] - origins[axis]) * inverse;
+		if (nearDistance > farDistance) {
+			std::swap(nearDistance, farDistance);
+		}
+		if (nearDistance > enter) {
+			enter = nearDistance;
+		}
+		if (farDistance < exit) {
+			exit = farDistance;
+		}
+		if (enter > exit) {
+			return false;
+		}
+	}
+
+	distance = enter;
+	return true;
+}
+
+uint32_t SpatialIndex::Insert(const Box& box, void* userData) {
+	uint32_t id;
+	if (!freeIds.empty()) {
+		id = freeIds.back();
+		freeIds.pop_back();
+	}
+	else {
+		id = (uint32_t)objects.size();
+		objects.push_back({});
+	}
+
+	objects[id].box = box;
+	objects[id].userData = userData;
+	Link(id);
+	statistics.inserts++;
+	return id;
+}
+
+uint32_t SpatialIndex::Insert(Shape* shape) {
+	return Insert(GetShapeBox(shape), shape);
+}
+
+void SpatialIndex::Move(uint32_t id, const Box& box) {
+	objects[id].box = box;
+	Relink(id);
+	statistics.moves++;
+}
+
+void SpatialIndex::Move(uint32_t id, Shape* shape) {
+	Move(id, GetShapeBox(shape));
+}
+
+void SpatialIndex::Remove(uint32_t id) {
+	if (id == INVALID_ID || objects[id].cell == INVALID_ID) {
+		return;
+	}
+
+	Unlink(id);
+	objects[id].cell = INVALID_ID;
+	objects[id].userData = nullptr;
+	freeIds.push_back(id);
+	statistics.removes++;
+}
+
+void SpatialIndex::QueryBox(const Box& box, std::vector<uint32_t>& result) {
+	statistics.queries++;
+	result.clear();
+	Gather(box, result);
+}
+
+void SpatialIndex::QueryPoint(float x, float y, std::vector<uint32_t>& result) {
+	statistics.queries++;
+	result.clear();
+	Gather({ x, y, x, y }, result);
+}
+
+void SpatialIndex::QueryRay(const DirectX::SimpleMath::Ray& ray, float maxDistance, std::vector<RayHit>& result) {
+	statistics.queries++;
+	result.clear();
+
+	Ray2D ray2D = { ray.position.x, ray.position.y, ray.direction.x, ray.direction.y, maxDistance };
+	if (ray2D.directionX == 0.0f && ray2D.directionY == 0.0f) {
+		// ʂ̉ɌĆAn_܂ޕ̂ɋ0œ
+		std::vector<uint32_t> ids;
+		Gather({ ray2D.originX, ray2D.originY, ray2D.originX, ray2D.originY }, ids);
+		for (auto id : ids) {
+			result.push_back({ id, 0.0f });
+		}
+	}
+	else {
+		GatherRay(ray2D, result);
+	}
+
+	std::sort(result.begin(), result.end(), [](const RayHit& a, const RayHit& b) {
+		return a.distance != b.distance ? a.distance < b.distance : a.id < b.id;
+	});
+}
+
+SpatialIndex::Box SpatialIndex::GetShapeBox(Shape* shape) {
+	ViewCuller::Bounds bounds = ViewCuller::TransformBounds(shape->GetLocalBounds(), shape->GetWorldMatrix());
+	return {
+		bounds.center.x - bounds.extents.x, bounds.center.y - bounds.extents.y,
+		bounds.center.x + bounds.extents.x, bounds.center.y + bounds.extents.y
+	};
+}
+
+void SpatialIndex::ResetStatistics() {
+	uint32_t cells = statistics.cells;
+	statistics = {};
+	statistics.cells = cells;
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+#include "SimpleMath.h"
+
+#include <cstdint>
+#include <vector>
+
+// }`Ȃǂ2D̋E{bNXo^Á͈E_ECŌԃCfbNX
+// LooseQuadtreeHashedGridAǂ̂1̃Zɒûňړ̍XV͒萔
+class SpatialIndex
+{
+public:
+	static const uint32_t INVALID_ID = 0xffffffff;
+
+	typedef struct Box {
+		float minX;
+		float minY;
+		float maxX;
+		float maxY;
+	};
+
+	typedef struct RayHit {
+		uint32_t id;
+		float distance;		// direction̒1ƂBn_̒Ȃ0
+	};
+
+	typedef struct Statistics {
+		uint32_t objects;
+		uint32_t cells;			// ؂̃m[hObh̃Z
+		uint64_t inserts;
+		uint64_t moves;
+		uint64_t relinks;		// ړŒuZς
+		uint64_t removes;
+		uint64_t queries;
+		uint64_t tested;		// Ŕׂ
+	};
+
+protected:
+	typedef struct Object {
+		Box box;
+		void* userData;
+		uint32_t cell;			// 폜ς݂INVALID_ID
+		uint32_t slot;			// Z̈ꗗ̒̈ʒu
+		uint64_t cellKey;		// Z̈ʒuBړŃZςZǂ܂ɔ肷
+	};
+
+	typedef struct Ray2D {
+		float originX;
+		float originY;
+		float directionX;
+		float directionY;
+		float maxDistance;
+	};
+
+	std::vector<Object> objects;
+	std::vector<uint32_t> freeIds;
+	Statistics statistics;
+
+public:
+	SpatialIndex();
+	virtual ~SpatialIndex() {}
+
+	SpatialIndex(const SpatialIndex&) = delete;
+	SpatialIndex& operator=(const SpatialIndex&) = delete;
+
+protected:
+	// objects[id]ZɒuEZOEς̂Œu
+	virtual void Link(uint32_t id) = 0;
+	virtual void Unlink(uint32_t id) = 0;
+	virtual void Relink(uint32_t id) = 0;
+	// dȂ镨̂W߂idȂȂ̂ĂĂ͂Ȃj
+	virtual void Gather(const Box& box, std::vector<uint32_t>& result) = 0;
+	// C镨̂W߂iԂ͖Ȃj
+	virtual void GatherRay(const Ray2D& ray, std::vector<RayHit>& result) = 0;
+
+	static bool Overlaps(const Box& a, const Box& b) {
+		return a.minX <= b.maxX && b.minX <= a.maxX && a.minY <= b.maxY && b.minY <= a.maxY;
+	}
+	/// <summary>
+	/// Cɓdistanceɓʒu
+	/// </summary>
+	static bool IntersectRay(const Ray2D& ray, const Box& box, float& distance);
+
+public:
+	/// <summary>
+	/// o^ĔԍԂBuserData͌ʂ߂̔Cӂ̃|C^
+	/// </summary>
+	uint32_t Insert(const Box& box, void* userData);
+	/// <summary>
+	/// }`̃[hWł̋E{bNXœo^
+	/// </summary>
+	uint32_t Insert(class Shape* shape);
+	void Move(uint32_t id, const Box& box);
+	/// <summary>
+	/// }`𓮂ɌĂсAE{bNXvZ
+	/// </summary>
+	void Move(uint32_t id, class Shape* shape);
+	void Remove(uint32_t id);
+
+	/// <summary>
+	/// ƏdȂ镨̂̔ԍresultɓi͂ǂresult̑O̓eĂj
+	/// </summary>
+	void QueryBox(const Box& box, std::vector<uint32_t>& result);
+	/// <summary>
+	/// _܂ޕ́iJ[\̉ɂ̂Ȃǁj̔ԍresultɓ
+	/// </summary>
+	void QueryPoint(float x, float y, std::vector<uint32_t>& result);
+	/// <summary>
+	/// XYʏŃC镨̂߂resultɓ
+	/// directionXY0iʂ̉ɌCjȂAn_܂ޕ̂0œ
+	/// </summary>
+	void QueryRay(const DirectX::SimpleMath::Ray& ray, float maxDistance, std::vector<RayHit>& result);
+
+	void* GetUserData(uint32_t id) { return objects[id].userData; }
+	Box GetBox(uint32_t id) { return objects[id].box; }
+	uint32_t GetCount() { return (uint32_t)(objects.size() - freeIds.size()); }
+
+	static Box GetShapeBox(class Shape* shape);
+
+	Statistics GetStatistics() { statistics.objects = GetCount(); return statistics; }
+	void ResetStatistics();
+};
@@ -0,0 +1,127 @@
+#include "SpriteBatchBuilder.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+SpriteBatchBuilder::SpriteBatchBuilder() {
+	sortByTexture = false;
+	statistics = {};
+}
+
+void SpriteBatchBuilder::Add(uint32_t texture, int textureWidth, int textureHeight, const Sprite& sprite) {
+	entries.push_back({ texture, textureWidth, textureHeight, sprite });
+}
+
+void SpriteBatchBuilder::BuildQuad(const Entry& entry, Vertex* quad) {
+	const Sprite& sprite = entry.sprite;
+
+	float srcX = sprite.sourceRect[0];
+	float srcY = sprite.sourceRect[1];
+	float srcW = sprite.sourceRect[2];
+	float srcH = sprite.sourceRect[3];
+	if (srcW == 0.0f || srcH == 0.0f) {
+		srcX = 0.0f;
+		srcY = 0.0f;
+		srcW = (float)entry.textureWidth;
+		srcH = (float)entry.textureHeight;
+	}
+
+	// 񂵂ĒuĂꍇA\傫͕ƍւ
+	float width = (sprite.sourceRotated ? srcH : srcW) * sprite.scaleX;
+	float height = (sprite.sourceRotated ? srcW : srcH) * sprite.scaleY;
+
+	float left = -sprite.origin[0] * width;
+	float top = -sprite.origin[1] * height;
+	float right = left + width;
+	float bottom = top + height;
+
+	float u0 = srcX / (float)entry.textureWidth;
+	float v0 = srcY / (float)entry.textureHeight;
+	float u1 = (srcX + srcW) / (float)entry.textureWidth;
+	float v1 = (srcY + srcH) / (float)entry.textureHeight;
+
+	float c = 1.0f;
+	float s = 0.0f;
+	if (sprite.rotation != 0.0f) {
+		c = std::cos(sprite.rotation);
+		s = std::sin(sprite.rotation);
+	}
+
+	// EEEEE
+	float corners[4][4] = {
+		{ left, top, u0, v0 },
+		{ right, top, u1, v0 },
+		{ left, bottom, u0, v1 },
+		{ right, bottom, u1, v1 },
+	};
+	if (sprite.sourceRotated) {
+		// ̉摜(u, v)͒uꂽ`(1 - v, u)ɂ
+		corners[0][2] = u1;
+		corners[0][3] = v0;
+		corners[1][2] = u1;
+		corners[1][3] = v1;
+		corners[2][2] = u0;
+		corners[2][3] = v0;
+		corners[3][2] = u0;
+		corners[3][3] = v1;
+	}
+
+	for (int i = 0; i < 4; i++) {
+		Vertex& vertex = quad[i];
+		vertex.position[0] = sprite.x + corners[i][0] * c - corners[i][1] * s;
+		vertex.position[1] = sprite.y + corners[i][0] * s + corners[i][1] * c;
+		vertex.position[2] = 0.0f;
+		vertex.color[0] = sprite.color[0];
+		vertex.color[1] = sprite.color[1];
+		vertex.color[2] = sprite.color[2];
+		vertex.uv[0] = corners[i][2];
+		vertex.uv[1] = corners[i][3];
+	}
+}
+
+void SpriteBatchBuilder::Build() {
+	auto startTime = std::chrono::steady_clock::now();
+
+	vertices.resize(entries.size() * 4);
+	indices.resize(entries.size() * 6);
+	runs.clear();
+
+	const std::vector<Entry>* source = &entries;
+	if (sortByTexture) {
+		scratch = entries;
+		std::stable_sort(scratch.begin(), scratch.end(), [](const Entry& a, const Entry& b) { return a.texture < b.texture; });
+		source = &scratch;
+	}
+
+	for (size_t i = 0; i < source->size(); i++) {
+		const Entry& entry = (*source)[i];
+		BuildQuad(entry, &vertices[i * 4]);
+
+		uint32_t base = (uint32_t)(i * 4);
+		uint32_t* index = &indices[i * 6];
+		index[0] = base;
+		index[1] = base + 1;
+		index[2] = base + 2;
+		index[3] = base + 1;
+		index[4] = base + 3;
+		index[5] = base + 2;
+
+		// eNX`ςŕ`͈͂؂
+		if (runs.empty() || runs.back().texture != entry.texture) {
+			runs.push_back({ entry.texture, (uint32_t)(i * 6), 0 });
+		}
+		runs.back().indexCount += 6;
+	}
+
+	statistics.sprites += entries.size();
+	statistics.runs += runs.size();
+	statistics.seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+void SpriteBatchBuilder::Clear() {
+	entries.clear();
+	vertices.clear();
+	indices.clear();
+	runs.clear();
+}
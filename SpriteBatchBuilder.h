@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// XvCglp`̒_ɓWJAeNX`ς邲Ƃɕ`͈͂؂ifoCXsvj
+// _̓XN[WisNZjō̂ŁA[hs͒Pʍsŕ`悷
+class SpriteBatchBuilder
+{
+public:
+	// Shape::VertexDataƓCAEg
+	typedef struct Vertex {
+		float position[3];
+		float color[3];
+		float uv[2];
+	};
+
+	typedef struct Sprite {
+		float x = 0.0f;
+		float y = 0.0f;
+		float rotation = 0.0f;						// WA
+		float scaleX = 1.0f;
+		float scaleY = 1.0f;
+		float color[3] = { 1.0f, 1.0f, 1.0f };
+		float sourceRect[4] = { 0.0f, 0.0f, 0.0f, 0.0f };	// sNZPʂx, y, , i0Ȃ摜Śj
+		float origin[2] = { 0.5f, 0.5f };				// ]Eg̒Si0`1j
+		bool sourceRotated = false;					// sourceRect̒gv90x񂵂ĒuĂiAgXpj
+	};
+
+	// eNX`őĕ`ł͈
+	typedef struct Run {
+		uint32_t texture;
+		uint32_t indexStart;
+		uint32_t indexCount;
+	};
+
+	typedef struct Statistics {
+		uint64_t sprites;
+		uint64_t runs;
+		double seconds;
+	};
+
+private:
+	typedef struct Entry {
+		uint32_t texture;
+		int textureWidth;
+		int textureHeight;
+		Sprite sprite;
+	};
+
+	std::vector<Entry> entries;
+	std::vector<Entry> scratch;
+	bool sortByTexture;
+
+	std::vector<Vertex> vertices;
+	std::vector<uint32_t> indices;
+	std::vector<Run> runs;
+
+	Statistics statistics;
+
+public:
+	SpriteBatchBuilder();
+
+private:
+	void BuildQuad(const Entry& entry, Vertex* quad);
+
+public:
+	/// <summary>
+	/// trueɂƃeNX`Ƃɂ܂Ƃ߂ĂWJieNX`m̏Ԃ͕ۂj
+	/// </summary>
+	void SetSortByTexture(bool enable) { sortByTexture = enable; }
+
+	void Add(uint32_t texture, int textureWidth, int textureHeight, const Sprite& sprite);
+
+	/// <summary>
+	/// ǉXvCg𒸓_ECfbNXE`͈͂ɓWJ
+	/// </summary>
+	void Build();
+	void Clear();
+
+	const std::vector<Vertex>& GetVertices() { return vertices; }
+	const std::vector<uint32_t>& GetIndices() { return indices; }
+	const std::vector<Run>& GetRuns() { return runs; }
+	size_t GetCount() { return entries.size(); }
+
+	Statistics GetStatistics() { return statistics; }
+	void ResetStatistics() { statistics = {}; }
+};
@@ -0,0 +1,90 @@
+#include "SpriteBatcher.h"
+#include "Texture.h"
+#include "TextureAtlas.h"
+
+#include "GraphicsMemory.h"
+
+#include <DirectXMath.h>
+
+#include <cstring>
+
+SpriteBatcher::SpriteBatcher() {
+	statistics = {};
+}
+
+void SpriteBatcher::Draw(Texture* texture, const SpriteBatchBuilder::Sprite& sprite) {
+	auto found = textureIds.find(texture->GetDescriptor());
+	if (found == textureIds.end()) {
+		found = textureIds.emplace(texture->GetDescriptor(), (uint32_t)textures.size()).first;
+		textures.push_back(texture);
+	}
+
+	auto atlas = texture->GetAtlas();
+	if (atlas == nullptr) {
+		builder.Add(found->second, texture->GetWidth(), texture->GetHeight(), sprite);
+		return;
+	}
+
+	// AgX̃y[Ẅʒuɒu
+	SpriteBatchBuilder::Sprite mapped = sprite;
+	float rect[4] = { sprite.sourceRect[0], sprite.sourceRect[1], sprite.sourceRect[2], sprite.sourceRect[3] };
+	if (rect[2] == 0.0f || rect[3] == 0.0f) {
+		rect[0] = 0.0f;
+		rect[1] = 0.0f;
+		rect[2] = (float)texture->GetWidth();
+		rect[3] = (float)texture->GetHeight();
+	}
+	atlas->ToAtlasSourceRect(texture->GetAtlasRegion(), rect, mapped.sourceRect);
+	mapped.sourceRotated = atlas->GetRegion(texture->GetAtlasRegion()).rotated;
+
+	builder.Add(found->second, atlas->GetPageWidth(), atlas->GetPageHeight(), mapped);
+}
+
+void SpriteBatcher::Flush(ID3D12GraphicsCommandList* cmdList) {
+	if (IsEmpty()) {
+		return;
+	}
+
+	builder.Build();
+
+	auto& vertices = builder.GetVertices();
+	auto& indices = builder.GetIndices();
+
+	auto vertexSize = sizeof(SpriteBatchBuilder::Vertex) * vertices.size();
+	auto vertexBuffer = DirectX::GraphicsMemory::Get().Allocate(vertexSize);
+	std::memcpy(vertexBuffer.Memory(), vertices.data(), vertexSize);
+
+	auto indexSize = sizeof(uint32_t) * indices.size();
+	auto indexBuffer = DirectX::GraphicsMemory::Get().Allocate(indexSize);
+	std::memcpy(indexBuffer.Memory(), indices.data(), indexSize);
+
+	D3D12_VERTEX_BUFFER_VIEW vertexBufferView = {};
+	vertexBufferView.BufferLocation = vertexBuffer.GpuAddress();
+	vertexBufferView.SizeInBytes = (UINT)vertexSize;
+	vertexBufferView.StrideInBytes = sizeof(SpriteBatchBuilder::Vertex);
+
+	D3D12_INDEX_BUFFER_VIEW indexBufferView = {};
+	indexBufferView.BufferLocation = indexBuffer.GpuAddress();
+	indexBufferView.SizeInBytes = (UINT)indexSize;
+	indexBufferView.Format = DXGI_FORMAT_R32_UINT;
+
+	// _̓XN[WōĂ̂Ń[hs͒Pʍs
+	auto world = DirectX::GraphicsMemory::Get().AllocateConstant(DirectX::XMMatrixIdentity());
+	cmdList->SetGraphicsRootConstantBufferView(1, world.GpuAddress());
+
+	cmdList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+	cmdList->IASetVertexBuffers(0, 1, &vertexBufferView);
+	cmdList->IASetIndexBuffer(&indexBufferView);
+
+	for (auto& run : builder.GetRuns()) {
+		textures[run.texture]->Bind(cmdList);
+		cmdList->DrawIndexedInstanced(run.indexCount, 1, run.indexStart, 0, 0);
+		statistics.drawCalls++;
+	}
+
+	statistics.sprites += builder.GetCount();
+
+	builder.Clear();
+	textures.clear();
+	textureIds.clear();
+}
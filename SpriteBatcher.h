@@ -0,0 +1,43 @@
+#pragma once
+
+#include "SpriteBatchBuilder.h"
+
+#include <d3d12.h>
+
+#include <unordered_map>
+#include <vector>
+
+// TextureXvCgƂĂ܂Ƃ߂ĕ`悷
+// _̓t[Ƃ̗̈ɏ݁AeNX`ς邲Ƃ1񂾂`悷
+class SpriteBatcher
+{
+public:
+	typedef struct Statistics {
+		uint64_t sprites;
+		uint64_t drawCalls;
+	};
+
+private:
+	SpriteBatchBuilder builder;
+	std::vector<class Texture*> textures;
+	std::unordered_map<UINT, uint32_t> textureIds;	// fBXNv^ƁiAgX̓y[W͂܂Ƃ܂j
+
+	Statistics statistics;
+
+public:
+	SpriteBatcher();
+
+	void Draw(class Texture* texture, const SpriteBatchBuilder::Sprite& sprite);
+
+	/// <summary>
+	/// ߂XvCg`悷
+	/// pCvC͌ĂяoŃXvCgp̂̂ݒ肵Ă
+	/// </summary>
+	void Flush(ID3D12GraphicsCommandList* cmdList);
+
+	void SetSortByTexture(bool enable) { builder.SetSortByTexture(enable); }
+	bool IsEmpty() { return builder.GetCount() == 0; }
+
+	Statistics GetStatistics() { return statistics; }
+	void ResetStatistics() { statistics = {}; }
+};
@@ -0,0 +1,6 @@
+#include "BasicShaderHeader.hlsli"
+
+float4 SpritePS(float4 pos : SV_POSITION, float3 color : COLOR, float2 uv : TEXCOORD) : SV_TARGET
+{
+    return tex.Sample(smp, uv) * float4(color, 1.0f);
+}
\ No newline at end of file
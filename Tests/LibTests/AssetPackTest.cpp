@@ -0,0 +1,146 @@
+#include "Test.h"
+#include "AssetPack.h"
+#include "AssetPackWriter.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+namespace {
+	const char* PACK_FILE = "AssetPackTest.pack";
+
+	std::vector<uint8_t> ReadFile(const char* fileName) {
+		std::ifstream file(fileName, std::ios::binary);
+		return std::vector<uint8_t>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+	}
+
+	void WriteFile(const char* fileName, const std::vector<uint8_t>& bytes) {
+		std::ofstream file(fileName, std::ios::binary | std::ios::trunc);
+		file.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+	}
+
+	// 悭kނ̂Ək܂Ȃ̂1ꂽpbN
+	std::vector<uint8_t> MakePack(std::vector<uint8_t>& text, std::vector<uint8_t>& noise) {
+		text.clear();
+		for (int i = 0; i < 4096; i++) {
+			text.push_back((uint8_t)("abcabcabd"[i % 9]));
+		}
+		Test::Random random(1);
+		noise.clear();
+		for (int i = 0; i < 1000; i++) {
+			noise.push_back((uint8_t)random.Next());
+		}
+
+		AssetPackWriter writer;
+		writer.Add("Data/Text.txt", text.data(), text.size(), true);
+		writer.Add("Data/Noise.bin", noise.data(), noise.size(), false);
+		writer.Save(PACK_FILE);
+		return ReadFile(PACK_FILE);
+	}
+
+	// ڎ̒LZ4̃GgT
+	size_t FindCompressedEntry(const std::vector<uint8_t>& bytes) {
+		AssetPack::Header header;
+		std::memcpy(&header, bytes.data(), sizeof(header));
+		for (uint32_t i = 0; i < header.entryCount; i++) {
+			size_t at = (size_t)header.tocOffset + i * sizeof(AssetPack::Entry);
+			AssetPack::Entry entry;
+			std::memcpy(&entry, &bytes[at], sizeof(entry));
+			if ((entry.flags & AssetPack::ENTRY_LZ4) != 0) {
+				return at;
+			}
+		}
+		return 0;
+	}
+
+	bool OpenWithSize(std::vector<uint8_t> bytes, size_t entryAt, uint64_t size) {
+		AssetPack::Entry entry;
+		std::memcpy(&entry, &bytes[entryAt], sizeof(entry));
+		entry.size = size;
+		std::memcpy(&bytes[entryAt], &entry, sizeof(entry));
+		WriteFile(PACK_FILE, bytes);
+
+		AssetPack pack;
+		if (!pack.Open(PACK_FILE)) {
+			return false;
+		}
+		// JꍇAWJłȂ΋ԂŗȂ
+		std::vector<uint8_t> storage;
+		pack.Get("data/text.txt", storage);
+		return true;
+	}
+}
+
+TEST(AssetPackRoundTrip) {
+	std::vector<uint8_t> text, noise;
+	MakePack(text, noise);
+
+	AssetPack pack;
+	CHECK(pack.Open(PACK_FILE));
+
+	std::vector<uint8_t> storage;
+	AssetSpan span = pack.Get("DATA\\TEXT.TXT", storage);
+	CHECK(span.data != nullptr && span.size == text.size() && std::memcmp(span.data, text.data(), text.size()) == 0);
+	CHECK((pack.Find("data/text.txt")->flags & AssetPack::ENTRY_LZ4) != 0);
+
+	span = pack.Get("data/noise.bin", storage);
+	CHECK(span.data != nullptr && span.size == noise.size() && std::memcmp(span.data, noise.data(), noise.size()) == 0);
+	CHECK(pack.Find("data/missing.bin") == nullptr);
+
+	pack.Close();
+	std::remove(PACK_FILE);
+}
+
+TEST(AssetPackRejectsImpossibleLz4Size) {
+	std::vector<uint8_t> text, noise;
+	std::vector<uint8_t> bytes = MakePack(text, noise);
+	size_t entryAt = FindCompressedEntry(bytes);
+	CHECK(entryAt != 0);
+
+	AssetPack::Entry entry;
+	std::memcpy(&entry, &bytes[entryAt], sizeof(entry));
+
+	// LZ4ōő̑傫܂ł͎󂯕tA𒴂Jɒe
+	CHECK(OpenWithSize(bytes, entryAt, entry.storedSize * 255 + 16));
+	CHECK(!OpenWithSize(bytes, entryAt, entry.storedSize * 255 + 17));
+	CHECK(!OpenWithSize(bytes, entryAt, 1ull << 62));
+	CHECK(!OpenWithSize(bytes, entryAt, ~0ull));
+
+	std::remove(PACK_FILE);
+}
+
+TEST(AssetPackSurvivesCorruptHeaders) {
+	// wb_[EڎEO󂵂t@CJēǂłA͈͊Oǂ񂾂苐Ȋmۂ肵Ȃ
+	std::vector<uint8_t> text, noise;
+	std::vector<uint8_t> bytes = MakePack(text, noise);
+
+	AssetPack::Header header;
+	std::memcpy(&header, bytes.data(), sizeof(header));
+	size_t metadataEnd = (size_t)header.nameTableOffset + header.nameTableSize;
+
+	Test::Random random(7);
+	int opened = 0;
+	for (int i = 0; i < 500; i++) {
+		std::vector<uint8_t> corrupt = bytes;
+		int flips = 1 + (int)random.Next(4);
+		for (int f = 0; f < flips; f++) {
+			corrupt[random.Next((uint32_t)metadataEnd)] ^= (uint8_t)(1 + random.Next(255));
+		}
+		WriteFile(PACK_FILE, corrupt);
+
+		AssetPack pack;
+		if (!pack.Open(PACK_FILE)) {
+			continue;
+		}
+		opened++;
+		std::vector<uint8_t> storage;
+		AssetSpan span = pack.Get("data/text.txt", storage);
+		CHECK(span.data == nullptr || span.size <= (size_t)pack.Find("data/text.txt")->storedSize * 255 + 16);
+		pack.Get("data/noise.bin", storage);
+	}
+	std::printf("  %d of 500 corrupt packs opened\n", opened);
+
+	std::remove(PACK_FILE);
+}
@@ -0,0 +1,160 @@
+#include "Test.h"
+#include "AtlasPacker.h"
+
+#include <vector>
+
+namespace {
+	// ]܂߂ďdȂ炸Ay[W̒[]ȏ㗣Ă邩
+	bool IsValidLayout(AtlasPacker& packer, int padding, const std::vector<AtlasPacker::Rect>& sizes) {
+		std::vector<std::vector<AtlasPacker::Placement>> pages(packer.GetPageCount());
+		for (int id = 0; id < (int)sizes.size(); id++) {
+			const AtlasPacker::Placement& placement = packer.GetPlacement(id);
+			if (placement.page < 0 || placement.page >= packer.GetPageCount()) {
+				return false;
+			}
+			int width = placement.rotated ? sizes[id].height : sizes[id].width;
+			int height = placement.rotated ? sizes[id].width : sizes[id].height;
+			if (placement.width != width || placement.height != height) {
+				return false;
+			}
+			if (placement.x < padding || placement.y < padding ||
+				placement.x + placement.width + padding > packer.GetPageWidth() ||
+				placement.y + placement.height + padding > packer.GetPageHeight()) {
+				return false;
+			}
+			pages[placement.page].push_back(placement);
+		}
+
+		for (auto& placements : pages) {
+			for (size_t i = 0; i < placements.size(); i++) {
+				for (size_t j = i + 1; j < placements.size(); j++) {
+					const AtlasPacker::Placement& a = placements[i];
+					const AtlasPacker::Placement& b = placements[j];
+					if (a.x < b.x + b.width + padding && b.x < a.x + a.width + padding &&
+						a.y < b.y + b.height + padding && b.y < a.y + a.height + padding) {
+						return false;
+					}
+				}
+			}
+		}
+		return true;
+	}
+
+	std::vector<AtlasPacker::Rect> AddRandomRects(AtlasPacker& packer, Test::Random& random, int count, int minSize, int maxSize) {
+		std::vector<AtlasPacker::Rect> sizes;
+		for (int i = 0; i < count; i++) {
+			int width = minSize + (int)random.Next(maxSize - minSize + 1);
+			int height = minSize + (int)random.Next(maxSize - minSize + 1);
+			packer.Add(width, height);
+			sizes.push_back({ 0, 0, width, height });
+		}
+		return sizes;
+	}
+}
+
+TEST(AtlasPackerPlacesRectsWithoutOverlap) {
+	const int paddings[] = { 0, 1, 3 };
+	for (int padding : paddings) {
+		for (int rotation = 0; rotation < 2; rotation++) {
+			Test::Random random(padding * 2 + rotation + 1);
+			AtlasPacker packer(512, 512, padding, rotation != 0);
+			std::vector<AtlasPacker::Rect> sizes = AddRandomRects(packer, random, 400, 1, 64);
+			CHECK(packer.Pack());
+			CHECK(IsValidLayout(packer, padding, sizes));
+
+			AtlasPacker::Statistics statistics = packer.GetStatistics();
+			CHECK(statistics.rects == sizes.size());
+			CHECK(statistics.pages == (uint64_t)packer.GetPageCount());
+			CHECK(statistics.efficiency > 0.5 && statistics.efficiency <= 1.0);
+		}
+	}
+}
+
+TEST(AtlasPackerKeepsPaddingAtPageEdges) {
+	// ]傫傤ǂ̋`1y[W1
+	AtlasPacker packer(64, 32, 2);
+	int exact = packer.Add(60, 28);
+	int wide = packer.Add(61, 28);
+	int tall = packer.Add(60, 29);
+	CHECK(!packer.Pack());
+	CHECK(packer.GetPlacement(exact).page == 0);
+	CHECK(packer.GetPlacement(exact).x == 2 && packer.GetPlacement(exact).y == 2);
+	CHECK(packer.GetPlacement(wide).page == -1);
+	CHECK(packer.GetPlacement(tall).page == -1);
+	CHECK(packer.GetPageCount() == 1);
+
+	// ]Β[l߂
+	AtlasPacker tight(64, 32, 0);
+	tight.Add(64, 32);
+	CHECK(tight.Pack());
+	CHECK(tight.GetPlacement(0).x == 0 && tight.GetPlacement(0).y == 0);
+	CHECK(tight.GetStatistics().efficiency == 1.0);
+
+	// ׂ荇`̊Ԃɂ]
+	AtlasPacker pair(64, 64, 4);
+	pair.Add(20, 20);
+	pair.Add(20, 20);
+	CHECK(pair.Pack());
+	std::vector<AtlasPacker::Rect> sizes = { { 0, 0, 20, 20 }, { 0, 0, 20, 20 } };
+	CHECK(IsValidLayout(pair, 4, sizes));
+	CHECK(pair.GetPageCount() == 1);
+}
+
+TEST(AtlasPackerOverflowsIntoNewPages) {
+	// 1y[W4܂łȂ傫Ȃ̂ŁA103y[WɂȂ
+	AtlasPacker packer(128, 128, 1);
+	std::vector<AtlasPacker::Rect> sizes;
+	for (int i = 0; i < 10; i++) {
+		packer.Add(60, 60);
+		sizes.push_back({ 0, 0, 60, 60 });
+	}
+	CHECK(packer.Pack());
+	CHECK(packer.GetPageCount() == 3);
+	CHECK(IsValidLayout(packer, 1, sizes));
+
+	// y[W傫`OAc͋l߂
+	Test::Random random(7);
+	AtlasPacker mixed(256, 256, 1);
+	std::vector<AtlasPacker::Rect> fitting = AddRandomRects(mixed, random, 300, 8, 48);
+	int tooBig = mixed.Add(300, 10);
+	CHECK(!mixed.Pack());
+	CHECK(mixed.GetPlacement(tooBig).page == -1);
+	CHECK(mixed.GetPageCount() > 1);
+	CHECK(IsValidLayout(mixed, 1, fitting));
+
+	// ]΁Ãy[Wɏc̋`
+	AtlasPacker rotating(256, 64, 1, true);
+	rotating.Add(32, 200);
+	CHECK(rotating.Pack());
+	CHECK(rotating.GetPlacement(0).rotated);
+	CHECK(rotating.GetPlacement(0).width == 200 && rotating.GetPlacement(0).height == 32);
+
+	// lߒƑÕy[Ŵ͎Ă
+	CHECK(packer.Pack());
+	CHECK(packer.GetPageCount() == 3);
+	packer.Clear();
+	CHECK(packer.Pack());
+	CHECK(packer.GetPageCount() == 0);
+}
+
+BENCHMARK(AtlasPackerPack) {
+	typedef struct Case {
+		int count;
+		int minSize;
+		int maxSize;
+	};
+	const Case cases[] = { { 1000, 8, 64 }, { 5000, 4, 32 }, { 20000, 4, 32 }, { 2000, 16, 256 } };
+
+	std::printf("  rects  sizes     rotation  pages  efficiency  ms\n");
+	for (const Case& c : cases) {
+		for (int rotation = 0; rotation < 2; rotation++) {
+			Test::Random random(11);
+			AtlasPacker packer(2048, 2048, 1, rotation != 0);
+			AddRandomRects(packer, random, c.count, c.minSize, c.maxSize);
+			packer.Pack();
+			AtlasPacker::Statistics statistics = packer.GetStatistics();
+			std::printf("  %5d  %3d-%-4d  %8s  %5llu  %10.3f  %.2f\n", c.count, c.minSize, c.maxSize, rotation ? "yes" : "no",
+				(unsigned long long)statistics.pages, statistics.efficiency, statistics.seconds * 1000.0);
+		}
+	}
+}
@@ -0,0 +1,339 @@
+#include "Test.h"
+#include "CollisionWorld.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <utility>
+#include <vector>
+
+using namespace DirectX;
+
+namespace {
+	float RandomFloat(Test::Random& random) {
+		return (float)((double)random.Next() / 4294967296.0);
+	}
+
+	// CollisionWorldɓn̂Ɠ̂Alɒׂ邽߂̎ʂ
+	typedef struct ReferenceBody {
+		bool circle;
+		XMFLOAT2 center;
+		float radius;
+		std::vector<XMFLOAT2> points;
+		XMMATRIX world;
+	};
+
+	XMFLOAT2 Transform(const XMFLOAT4X4& m, const XMFLOAT2& point) {
+		return XMFLOAT2(point.x * m.m[0][0] + point.y * m.m[1][0] + m.m[3][0], point.x * m.m[0][1] + point.y * m.m[1][1] + m.m[3][1]);
+	}
+
+	// ~͏c{łuȂ̂ŁAa1̎̒ŐL΂΂悢
+	void WorldGeometry(const ReferenceBody& body, std::vector<XMFLOAT2>& points, XMFLOAT2& center, float& radius) {
+		XMFLOAT4X4 m;
+		XMStoreFloat4x4(&m, body.world);
+		points.clear();
+		for (auto& point : body.points) {
+			points.push_back(Transform(m, point));
+		}
+		center = Transform(m, body.center);
+		radius = body.radius * std::sqrt(m.m[0][0] * m.m[0][0] + m.m[0][1] * m.m[0][1]);
+	}
+
+	void Project(bool circle, const std::vector<XMFLOAT2>& points, XMFLOAT2 center, float radius, float x, float y, float& minimum, float& maximum) {
+		if (circle) {
+			float c = center.x * x + center.y * y;
+			minimum = c - radius;
+			maximum = c + radius;
+			return;
+		}
+		minimum = 1e30f;
+		maximum = -1e30f;
+		for (auto& point : points) {
+			float d = point.x * x + point.y * y;
+			minimum = std::min(minimum, d);
+			maximum = std::max(maximum, d);
+		}
+	}
+
+	// ̂܂܏́BdȂĂ΍ŏ̉oʂdepthɓ
+	// ʕ̕ӂ̖@́AS̒_̑g̖@Ɋ܂܂B~͒S瑽p`̒_ւׂ̌
+	bool ReferenceOverlap(const ReferenceBody& a, const ReferenceBody& b, float& depth) {
+		std::vector<XMFLOAT2> pointsA, pointsB;
+		XMFLOAT2 centerA, centerB;
+		float radiusA, radiusB;
+		WorldGeometry(a, pointsA, centerA, radiusA);
+		WorldGeometry(b, pointsB, centerB, radiusB);
+
+		std::vector<XMFLOAT2> axes;
+		auto addAxis = [&](float x, float y) {
+			float length = std::sqrt(x * x + y * y);
+			if (length > 1e-6f) {
+				axes.push_back(XMFLOAT2(x / length, y / length));
+			}
+		};
+		for (const std::vector<XMFLOAT2>* points : { &pointsA, &pointsB }) {
+			for (size_t i = 0; i < points->size(); i++) {
+				for (size_t j = i + 1; j < points->size(); j++) {
+					addAxis((*points)[j].y - (*points)[i].y, (*points)[i].x - (*points)[j].x);
+				}
+			}
+		}
+		if (a.circle && b.circle) {
+			addAxis(centerB.x - centerA.x, centerB.y - centerA.y);
+		}
+		else if (a.circle || b.circle) {
+			XMFLOAT2 center = a.circle ? centerA : centerB;
+			for (auto& point : a.circle ? pointsB : pointsA) {
+				addAxis(point.x - center.x, point.y - center.y);
+			}
+		}
+		addAxis(1.0f, 0.0f);
+
+		depth = 1e30f;
+		for (auto& axis : axes) {
+			float minimumA, maximumA, minimumB, maximumB;
+			Project(a.circle, pointsA, centerA, radiusA, axis.x, axis.y, minimumA, maximumA);
+			Project(b.circle, pointsB, centerB, radiusB, axis.x, axis.y, minimumB, maximumB);
+			float overlap = std::min(maximumA - minimumB, maximumB - minimumA);
+			if (overlap <= 0.0f) {
+				depth = overlap;
+				return false;
+			}
+			depth = std::min(depth, overlap);
+		}
+		return true;
+	}
+
+	class ReferenceWorld
+	{
+	public:
+		CollisionWorld world;
+		std::vector<ReferenceBody> bodies;
+		std::vector<uint32_t> live;
+		Test::Random random;
+
+		ReferenceWorld(uint64_t seed) : random(seed) {}
+
+		// ~A`A3`8_̓ʕč
+		uint32_t Add() {
+			ReferenceBody body = {};
+			uint32_t id;
+			uint32_t kind = random.Next(4);
+			if (kind == 0) {
+				body.circle = true;
+				body.radius = 2.0f + RandomFloat(random) * 8.0f;
+				body.center = XMFLOAT2(RandomFloat(random) * 2.0f - 1.0f, RandomFloat(random) * 2.0f - 1.0f);
+				id = world.AddCircle(body.radius, body.center);
+			}
+			else {
+				if (kind == 1) {
+					float w = 2.0f + RandomFloat(random) * 10.0f;
+					float h = 2.0f + RandomFloat(random) * 10.0f;
+					body.points = { { -w, -h }, { w, -h }, { w, h }, { -w, h } };
+				}
+				else {
+					uint32_t count = 3 + random.Next(6);
+					for (uint32_t i = 0; i < count; i++) {
+						body.points.push_back(XMFLOAT2(RandomFloat(random) * 20.0f - 10.0f, RandomFloat(random) * 20.0f - 10.0f));
+					}
+				}
+				id = world.AddPolygon(body.points.data(), (uint32_t)body.points.size());
+			}
+			if (id >= bodies.size()) {
+				bodies.resize(id + 1);
+			}
+			bodies[id] = body;
+			live.push_back(id);
+			Place(id);
+			return id;
+		}
+
+		// ͉]ɒuAs̋`̔ʂ
+		void Place(uint32_t id) {
+			float rotation = random.Next(2) == 0 ? RandomFloat(random) * 6.28f : 0.0f;
+			float scale = 0.5f + RandomFloat(random) * 1.5f;
+			float scaleY = bodies[id].circle || random.Next(3) != 0 ? scale : scale * 1.3f;
+			bodies[id].world = XMMatrixScaling(scale, scaleY, 1.0f) * XMMatrixRotationZ(rotation) *
+				XMMatrixTranslation(RandomFloat(random) * 300.0f, RandomFloat(random) * 200.0f, 0.0f);
+			world.SetTransform(id, bodies[id].world);
+		}
+
+		void Remove(size_t index) {
+			world.Remove(live[index]);
+			live.erase(live.begin() + index);
+		}
+	};
+}
+
+TEST(CollisionWorldMatchesBruteForceSat) {
+	ReferenceWorld reference(1);
+	for (int i = 0; i < 300; i++) {
+		reference.Add();
+	}
+
+	uint32_t missing = 0;
+	uint32_t extra = 0;
+	uint32_t duplicated = 0;
+	uint32_t wrongDepth = 0;
+	uint32_t notSeparated = 0;
+	uint32_t overlaps = 0;
+	for (int frame = 0; frame < 20; frame++) {
+		// ꕔ𓮂AABԍ̎g
+		for (int i = 0; i < 30; i++) {
+			reference.Place(reference.live[reference.random.Next((uint32_t)reference.live.size())]);
+		}
+		for (int i = 0; i < 5; i++) {
+			reference.Remove(reference.random.Next((uint32_t)reference.live.size()));
+		}
+		for (int i = 0; i < 5; i++) {
+			reference.Add();
+		}
+		reference.world.Update();
+
+		std::map<std::pair<uint32_t, uint32_t>, CollisionWorld::Contact> contacts;
+		for (auto& contact : reference.world.GetContacts()) {
+			if (contact.a >= contact.b || contacts.count({ contact.a, contact.b }) != 0) {
+				duplicated++;
+			}
+			contacts[{ contact.a, contact.b }] = contact;
+		}
+		CHECK(reference.world.GetStatistics().contacts == reference.world.GetContacts().size());
+		CHECK(reference.world.GetStatistics().candidates >= reference.world.GetContacts().size());
+
+		auto& live = reference.live;
+		for (size_t i = 0; i < live.size(); i++) {
+			for (size_t j = i + 1; j < live.size(); j++) {
+				uint32_t a = std::min(live[i], live[j]);
+				uint32_t b = std::max(live[i], live[j]);
+				float depth;
+				bool overlap = ReferenceOverlap(reference.bodies[a], reference.bodies[b], depth);
+				auto found = contacts.find({ a, b });
+
+				// ڂĂ邾̑g͊ۂߌ덷łǂɂȂ肤
+				if (overlap != (found != contacts.end())) {
+					if (std::fabs(depth) > 1e-3f) {
+						overlap ? missing++ : extra++;
+					}
+					continue;
+				}
+				if (!overlap) {
+					continue;
+				}
+				overlaps++;
+
+				const CollisionWorld::Contact& contact = found->second;
+				if (std::fabs(contact.depth - depth) > 1e-2f * (1.0f + depth)) {
+					wrongDepth++;
+				}
+				// @̌ɉoʂb𓮂Η
+				ReferenceBody moved = reference.bodies[b];
+				float push = contact.depth + 0.01f;
+				moved.world = moved.world * XMMatrixTranslation(contact.normal.x * push, contact.normal.y * push, 0.0f);
+				float left;
+				if (ReferenceOverlap(reference.bodies[a], moved, left) && left > 2e-2f) {
+					notSeparated++;
+				}
+			}
+		}
+	}
+
+	CHECK(missing == 0);
+	CHECK(extra == 0);
+	CHECK(duplicated == 0);
+	CHECK(wrongDepth == 0);
+	CHECK(notSeparated == 0);
+	// dȂg\ɂāAׂƂɂȂĂ
+	CHECK(overlaps > 500);
+}
+
+TEST(CollisionWorldReportsTouchingAndSeparatedPairs) {
+	CollisionWorld world;
+	const XMFLOAT2 square[] = { { -1.0f, -1.0f }, { 1.0f, -1.0f }, { 1.0f, 1.0f }, { -1.0f, 1.0f } };
+	uint32_t a = world.AddPolygon(square, 4);
+	uint32_t b = world.AddPolygon(square, 4);
+	uint32_t c = world.AddCircle(1.0f);
+
+	// ab0.5dȂAc͂ǂ炩Ă
+	world.SetTransform(b, XMMatrixTranslation(1.5f, 0.0f, 0.0f));
+	world.SetTransform(c, XMMatrixTranslation(10.0f, 10.0f, 0.0f));
+	world.Update();
+	CHECK(world.GetContacts().size() == 1);
+	if (world.GetContacts().size() == 1) {
+		auto& contact = world.GetContacts()[0];
+		CHECK(contact.a == a && contact.b == b);
+		CHECK(std::fabs(contact.depth - 0.5f) < 1e-4f);
+		CHECK(std::fabs(contact.normal.x - 1.0f) < 1e-4f && std::fabs(contact.normal.y) < 1e-4f);
+	}
+
+	// ƏdȂ͏A菜͕̂񍐂Ȃ
+	world.SetTransform(b, XMMatrixTranslation(2.5f, 0.0f, 0.0f));
+	world.SetTransform(c, XMMatrixTranslation(0.0f, 1.5f, 0.0f));
+	world.Update();
+	CHECK(world.GetContacts().size() == 1 && world.GetContacts()[0].b == c);
+	world.Remove(c);
+	world.Update();
+	CHECK(world.GetContacts().empty());
+	CHECK(world.GetStatistics().bodies == 2);
+}
+
+BENCHMARK(CollisionWorld100kBodies) {
+	// ~E`E]Op`10ABLςďdȂ̖xς
+	const int BODIES = 100000;
+	const int FRAMES = 60;
+	const XMFLOAT2 box[] = { { -4.0f, -4.0f }, { 4.0f, -4.0f }, { 4.0f, 4.0f }, { -4.0f, 4.0f } };
+	const XMFLOAT2 triangle[] = { { -5.0f, -4.0f }, { 5.0f, -4.0f }, { 0.0f, 6.0f } };
+
+	std::printf("  width   first ms  broad ms  narrow ms  swaps/frame  candidates/frame  contacts/frame\n");
+	const float widths[] = { 8000.0f, 4000.0f, 2000.0f };
+	for (float width : widths) {
+		Test::Random random(2);
+		CollisionWorld world;
+		std::vector<float> x(BODIES), y(BODIES), vx(BODIES), vy(BODIES), rotation(BODIES);
+		for (int i = 0; i < BODIES; i++) {
+			switch (i % 3) {
+			case 0: world.AddCircle(4.0f); break;
+			case 1: world.AddPolygon(box, 4); break;
+			default: world.AddPolygon(triangle, 3); break;
+			}
+			x[i] = RandomFloat(random) * width;
+			y[i] = RandomFloat(random) * width * 0.5f;
+			vx[i] = RandomFloat(random) * 2.0f - 1.0f;
+			vy[i] = RandomFloat(random) * 2.0f - 1.0f;
+			rotation[i] = i % 3 == 2 ? RandomFloat(random) * 6.28f : 0.0f;
+		}
+
+		double first = 0.0;
+		double broadphase = 0.0;
+		double narrowphase = 0.0;
+		uint64_t swaps = 0;
+		uint64_t candidates = 0;
+		uint64_t contacts = 0;
+		for (int frame = 0; frame <= FRAMES; frame++) {
+			for (int i = 0; i < BODIES; i++) {
+				x[i] += vx[i];
+				y[i] += vy[i];
+				if (i % 3 == 2) {
+					rotation[i] += 0.01f;
+				}
+				world.SetTransform(i, XMMatrixRotationZ(rotation[i]) * XMMatrixTranslation(x[i], y[i], 0.0f));
+			}
+			world.Update();
+
+			// ŏ̃t[͑ŜׂŕĎ
+			CollisionWorld::Statistics statistics = world.GetStatistics();
+			if (frame == 0) {
+				first = statistics.broadphaseSeconds + statistics.narrowphaseSeconds;
+				continue;
+			}
+			broadphase += statistics.broadphaseSeconds;
+			narrowphase += statistics.narrowphaseSeconds;
+			swaps += statistics.swaps;
+			candidates += statistics.candidates;
+			contacts += statistics.contacts;
+		}
+
+		std::printf("  %5.0f  %9.2f  %8.2f  %9.2f  %11llu  %16llu  %14llu\n", width, first * 1000.0,
+			broadphase * 1000.0 / FRAMES, narrowphase * 1000.0 / FRAMES, (unsigned long long)(swaps / FRAMES),
+			(unsigned long long)(candidates / FRAMES), (unsigned long long)(contacts / FRAMES));
+	}
+}
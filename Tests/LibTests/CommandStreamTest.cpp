@@ -0,0 +1,308 @@
+#include "Test.h"
+#include "CommandStream.h"
+#include "SoftwareRasterizer.h"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+	const float IDENTITY[16] = {
+		1.0f, 0.0f, 0.0f, 0.0f,
+		0.0f, 1.0f, 0.0f, 0.0f,
+		0.0f, 0.0f, 1.0f, 0.0f,
+		0.0f, 0.0f, 0.0f, 1.0f
+	};
+
+	// 󂯎Ăяo𕶎ɂĕׂĐ
+	class LogTarget : public CommandStreamTarget
+	{
+	public:
+		std::vector<std::string> calls;
+		std::vector<float> floats;
+		std::vector<uint8_t> pixels;
+		std::vector<uint16_t> chars;
+
+		void Log(const char* format, uint32_t a = 0, uint32_t b = 0, uint32_t c = 0, uint32_t d = 0) {
+			char text[64];
+			std::snprintf(text, sizeof(text), format, a, b, c, d);
+			calls.push_back(text);
+		}
+
+		void BeginDraw() override { Log("begin"); }
+		void EndDraw() override { Log("end"); }
+		void SetPipeline(uint32_t pipeline) override { Log("pipeline %u", pipeline); }
+		void SetDescriptorHeap(uint32_t heap) override { Log("heap %u", heap); }
+		void DefineMesh(uint32_t mesh, StreamTopology topology, const float* vertices, uint32_t vertexCount, const uint16_t* indices, uint32_t indexCount) override {
+			Log("mesh %u %u %u %u", mesh, (uint32_t)topology, vertexCount, indexCount);
+			floats.insert(floats.end(), vertices, vertices + CommandStreamWriter::VERTEX_FLOATS * vertexCount);
+			chars.insert(chars.end(), indices, indices + indexCount);
+		}
+		void DefineTexture(uint32_t texture, int width, int height, const uint8_t* data) override {
+			Log("texture %u %u %u", texture, (uint32_t)width, (uint32_t)height);
+			pixels.insert(pixels.end(), data, data + (size_t)width * height * 4);
+		}
+		void BindTexture(uint32_t texture) override { Log("bind %u", texture); }
+		void DrawMesh(uint32_t mesh, const float* world) override {
+			Log("draw %u", mesh);
+			floats.insert(floats.end(), world, world + 16);
+		}
+		void DrawString(uint32_t font, const uint16_t* text, uint32_t length, const float* pos, const float* color) override {
+			Log("string %u %u", font, length);
+			floats.insert(floats.end(), pos, pos + 2);
+			floats.insert(floats.end(), color, color + 4);
+			chars.insert(chars.end(), text, text + length);
+		}
+	};
+
+	RasterVertex Vertex(float x, float y, float u, float v) {
+		RasterVertex vertex = {};
+		vertex.position[0] = x;
+		vertex.position[1] = y;
+		vertex.color[0] = 1.0f;
+		vertex.color[1] = 1.0f;
+		vertex.color[2] = 1.0f;
+		vertex.uv[0] = u;
+		vertex.uv[1] = v;
+		return vertex;
+	}
+
+	// 2̎Op`łłlp`
+	void Quad(float x, float y, float size, RasterVertex* vertices, uint16_t* indices) {
+		vertices[0] = Vertex(x, y, 0.0f, 0.0f);
+		vertices[1] = Vertex(x + size, y, 1.0f, 0.0f);
+		vertices[2] = Vertex(x, y + size, 0.0f, 1.0f);
+		vertices[3] = Vertex(x + size, y + size, 1.0f, 1.0f);
+		const uint16_t quad[] = { 0, 1, 2, 2, 1, 3 };
+		std::memcpy(indices, quad, sizeof(quad));
+	}
+
+	// 2x2̎s͗lBs̊ԂɋlߕāAۑɋl߂邱Ƃm߂
+	const int TEXTURE_PITCH = 12;
+	const uint8_t TEXTURE_PIXELS[TEXTURE_PITCH * 2] = {
+		255, 0, 0, 255, 0, 255, 0, 255, 7, 7, 7, 7,
+		0, 0, 255, 255, 255, 255, 255, 255, 7, 7, 7, 7,
+	};
+
+	// Sނ̖߂1ȏgXg[B߂̐؂ڂ̈ʒuԂ
+	std::vector<size_t> WriteSample(CommandStreamWriter& writer) {
+		std::vector<size_t> boundaries;
+		auto mark = [&]() { boundaries.push_back(writer.GetData().size()); };
+
+		RasterVertex vertices[4];
+		uint16_t indices[6];
+		Quad(4.0f, 4.0f, 8.0f, vertices, indices);
+		RasterVertex line[2] = { Vertex(0.0f, 20.0f, 0.0f, 0.0f), Vertex(30.0f, 25.0f, 0.0f, 0.0f) };
+		float world[16];
+		std::memcpy(world, IDENTITY, sizeof(world));
+		world[12] = 2.0f;
+		const float pos[2] = { 3.0f, 4.0f };
+		const float color[4] = { 0.25f, 0.5f, 0.75f, 1.0f };
+
+		mark();
+		writer.BeginDraw(); mark();
+		writer.SetPipeline((uint32_t)RasterPipeline::NORMAL); mark();
+		writer.SetDescriptorHeap(0); mark();
+		writer.DefineMesh(1, StreamTopology::TRIANGLE_LIST, &vertices[0].position[0], 4, indices, 6); mark();
+		writer.DefineMesh(2, StreamTopology::LINE_LIST, &line[0].position[0], 2, nullptr, 0); mark();
+		writer.DrawMesh(1, IDENTITY); mark();
+		writer.DrawMesh(2, world); mark();
+		writer.SetPipeline((uint32_t)RasterPipeline::TEXTURE); mark();
+		writer.DefineTexture(3, 2, 2, TEXTURE_PITCH, TEXTURE_PIXELS); mark();
+		writer.SetDescriptorHeap(0); mark();
+		writer.BindTexture(3); mark();
+		writer.DrawMesh(1, world); mark();
+		writer.DrawString(4, L"abc", 3, pos, color); mark();
+		writer.SetPipeline((uint32_t)RasterPipeline::TEXTURE); mark();
+		writer.EndDraw(); mark();
+		return boundaries;
+	}
+
+	// 1t[draws`Aۂ̃Q[ɋ߂L^
+	// 8񂲂ƂɃpCvC؂ւAeNX`̕`ł̓eNX`ƃfBXNv^q[vݒ肵
+	void WriteFrame(CommandStreamWriter& writer, uint32_t draws, bool define) {
+		RasterVertex vertices[4];
+		uint16_t indices[6];
+		Quad(0.0f, 0.0f, 16.0f, vertices, indices);
+		static const uint8_t pixels[16 * 16 * 4] = {};
+
+		writer.BeginDraw();
+		writer.SetPipeline((uint32_t)RasterPipeline::NORMAL);
+		writer.SetDescriptorHeap(0);
+		if (define) {
+			writer.DefineMesh(1, StreamTopology::TRIANGLE_LIST, &vertices[0].position[0], 4, indices, 6);
+			writer.DefineTexture(2, 16, 16, 16 * 4, pixels);
+		}
+		float world[16];
+		std::memcpy(world, IDENTITY, sizeof(world));
+		for (uint32_t i = 0; i < draws; i++) {
+			bool textured = (i / 8) % 2 == 1;
+			if (i % 8 == 0) {
+				writer.SetPipeline((uint32_t)(textured ? RasterPipeline::TEXTURE : RasterPipeline::NORMAL));
+			}
+			if (textured) {
+				writer.SetDescriptorHeap(0);
+				writer.BindTexture(2);
+			}
+			world[12] = (float)(i % 64) * 20.0f;
+			world[13] = (float)(i / 64 % 36) * 20.0f;
+			writer.DrawMesh(1, world);
+		}
+		writer.EndDraw();
+	}
+}
+
+TEST(CommandStreamRoundTrip) {
+	CommandStreamWriter writer;
+	WriteSample(writer);
+
+	// t@CʂĂeɂȂ
+	std::string fileName = "CommandStreamTest.stream";
+	CHECK(writer.Save(fileName));
+	std::vector<uint8_t> data;
+	CHECK(CommandStreamPlayer::Load(fileName, data));
+	std::remove(fileName.c_str());
+	CHECK(data == writer.GetData());
+	CHECK(data.size() % 4 == 0);
+
+	LogTarget target;
+	CommandStreamStatistics statistics;
+	CHECK(CommandStreamPlayer::Replay(data, &target, &statistics));
+
+	const std::vector<std::string> expected = {
+		"begin", "pipeline 0", "heap 0", "mesh 1 0 4 6", "mesh 2 1 2 0", "draw 1", "draw 2",
+		"pipeline 1", "texture 3 2 2", "heap 0", "bind 3", "draw 1", "string 4 3", "pipeline 1", "end"
+	};
+	CHECK(target.calls == expected);
+
+	// lߕfc
+	const uint8_t packed[] = { 255, 0, 0, 255, 0, 255, 0, 255, 0, 0, 255, 255, 255, 255, 255, 255 };
+	CHECK(target.pixels == std::vector<uint8_t>(packed, packed + sizeof(packed)));
+	CHECK((target.chars == std::vector<uint16_t>{ 0, 1, 2, 2, 1, 3, 'a', 'b', 'c' }));
+	// _42As3AʒuƐF
+	CHECK(target.floats.size() == CommandStreamWriter::VERTEX_FLOATS * 6 + 16 * 3 + 6);
+	CHECK(target.floats.size() >= 6 && target.floats[target.floats.size() - 6] == 3.0f && target.floats.back() == 1.0f);
+
+	CHECK(statistics.frames == 1);
+	CHECK(statistics.draws == 3);
+	CHECK(statistics.strings == 1);
+	CHECK(statistics.pipelineSets == 3);
+	CHECK(statistics.pipelineChanges == 2);
+	CHECK(statistics.descriptorHeapSets == 2);
+	CHECK(statistics.descriptorHeapChanges == 1);
+	CHECK(statistics.textureBinds == 1);
+	CHECK(statistics.meshDefinitions == 2);
+	CHECK(statistics.textureDefinitions == 1);
+	CHECK(statistics.bytes == data.size());
+
+	// Đ悪ĂvɂȂ
+	CommandStreamStatistics decoded;
+	CHECK(CommandStreamPlayer::Replay(data, nullptr, &decoded));
+	CHECK(decoded.draws == statistics.draws && decoded.pipelineChanges == statistics.pipelineChanges && decoded.bytes == statistics.bytes);
+}
+
+TEST(CommandStreamRejectsTruncatedStreams) {
+	CommandStreamWriter writer;
+	std::vector<size_t> boundaries = WriteSample(writer);
+	const std::vector<uint8_t>& data = writer.GetData();
+
+	// ߂̐؂ڂŏÎ͓ǂ߂āA߂̓rŏÎ͓ǂ߂Ȃ
+	size_t next = 0;
+	for (size_t size = 0; size < data.size(); size++) {
+		while (next < boundaries.size() && boundaries[next] < size) {
+			next++;
+		}
+		bool boundary = next < boundaries.size() && boundaries[next] == size;
+		std::vector<uint8_t> prefix(data.begin(), data.begin() + size);
+		CHECK(CommandStreamPlayer::Replay(prefix, nullptr) == boundary);
+	}
+
+	// m̖߂ƋȃeNX`
+	std::vector<uint8_t> corrupt = data;
+	uint32_t unknown = 0xdeadbeef;
+	std::memcpy(&corrupt[boundaries[0]], &unknown, sizeof(unknown));
+	CHECK(!CommandStreamPlayer::Replay(corrupt, nullptr));
+
+	corrupt = data;
+	uint32_t width = 0xffffffff;
+	std::memcpy(&corrupt[boundaries[8] + 8], &width, sizeof(width));
+	CHECK(!CommandStreamPlayer::Replay(corrupt, nullptr));
+}
+
+TEST(CommandStreamReplaysIntoRasterizer) {
+	// L^̂Đʂ́A`𒼐ڍsʂƉf܂ňv
+	CommandStreamWriter writer;
+	WriteSample(writer);
+
+	SoftwareRasterizer replayed(64, 48, 2);
+	RasterizerReplayTarget target(&replayed);
+	CHECK(CommandStreamPlayer::Replay(writer.GetData(), &target));
+
+	SoftwareRasterizer direct(64, 48, 2);
+	RasterVertex vertices[4];
+	uint16_t indices[6];
+	Quad(4.0f, 4.0f, 8.0f, vertices, indices);
+	RasterVertex line[2] = { Vertex(0.0f, 20.0f, 0.0f, 0.0f), Vertex(30.0f, 25.0f, 0.0f, 0.0f) };
+	float world[16];
+	std::memcpy(world, IDENTITY, sizeof(world));
+	world[12] = 2.0f;
+	const uint8_t packed[] = { 255, 0, 0, 255, 0, 255, 0, 255, 0, 0, 255, 255, 255, 255, 255, 255 };
+	RasterTexture texture = {};
+	texture.pixels = packed;
+	texture.width = 2;
+	texture.height = 2;
+	texture.rowPitch = 8;
+
+	direct.Clear(0.0f, 0.0f, 0.0f, 1.0f);
+	direct.SetPipeline(RasterPipeline::NORMAL);
+	direct.DrawIndexed(vertices, 4, indices, 6, IDENTITY);
+	direct.DrawLines(line, 2, world);
+	direct.SetPipeline(RasterPipeline::TEXTURE);
+	direct.SetTexture(texture);
+	direct.DrawIndexed(vertices, 4, indices, 6, world);
+	direct.Flush();
+
+	size_t size = (size_t)direct.GetWidth() * direct.GetHeight();
+	CHECK(std::memcmp(replayed.GetPixels(), direct.GetPixels(), size * sizeof(uint32_t)) == 0);
+	// `ĂȂ̂Ɉv̂ł͂Ȃ
+	size_t drawn = 0;
+	for (size_t i = 0; i < size; i++) {
+		drawn += replayed.GetPixels()[i] != 0xff000000;
+	}
+	CHECK(drawn > 64);
+}
+
+BENCHMARK(CommandStreamSubmission) {
+	// L^iWriterjA͂̍ĐA\tgEFAX^CUւ̍Đ1`悠̎
+	const uint32_t FRAMES = 60;
+	std::printf("  draws/frame  record ns/draw  decode ns/draw  raster us/draw  bytes/draw  heap sets/frame  pipeline changes/frame\n");
+	const uint32_t drawCounts[] = { 100, 1000, 10000 };
+	for (uint32_t draws : drawCounts) {
+		CommandStreamWriter writer;
+		double start = Test::Now();
+		for (uint32_t frame = 0; frame < FRAMES; frame++) {
+			WriteFrame(writer, draws, frame == 0);
+		}
+		double recordSeconds = Test::Now() - start;
+		double totalDraws = (double)draws * FRAMES;
+
+		CommandStreamStatistics statistics = {};
+		start = Test::Now();
+		const int DECODE_REPEATS = 10;
+		for (int i = 0; i < DECODE_REPEATS; i++) {
+			CommandStreamPlayer::Replay(writer.GetData(), nullptr, &statistics);
+		}
+		double decodeSeconds = (Test::Now() - start) / DECODE_REPEATS;
+
+		SoftwareRasterizer rasterizer(1280, 720);
+		RasterizerReplayTarget target(&rasterizer);
+		start = Test::Now();
+		CommandStreamPlayer::Replay(writer.GetData(), &target);
+		double rasterSeconds = Test::Now() - start;
+
+		std::printf("  %11u  %14.1f  %14.1f  %14.2f  %10.1f  %15.1f  %22.1f\n", draws,
+			recordSeconds / totalDraws * 1e9, decodeSeconds / totalDraws * 1e9, rasterSeconds / totalDraws * 1e6,
+			(double)statistics.bytes / totalDraws, (double)statistics.descriptorHeapSets / FRAMES, (double)statistics.pipelineChanges / FRAMES);
+	}
+}
@@ -0,0 +1,126 @@
+#include "Test.h"
+#include "DescriptorIndexAllocator.h"
+
+#include <utility>
+#include <vector>
+
+TEST(DescriptorIndexAllocatorCoalescesNeighbours) {
+	DescriptorIndexAllocator allocator(8);
+
+	uint32_t a = allocator.Allocate(2);
+	uint32_t b = allocator.Allocate(2);
+	uint32_t c = allocator.Allocate(2);
+	CHECK(a == 0 && b == 2 && c == 4);
+
+	// ꂽ2ԂƋ󂫔͈͂
+	allocator.Free(a, 2, 0);
+	allocator.Free(c, 2, 0);
+	allocator.Reclaim(0);
+	DescriptorIndexAllocator::Statistics statistics = allocator.GetStatistics();
+	CHECK(statistics.freeRangeCount == 2);
+	CHECK(statistics.free == 6);
+	CHECK(statistics.largestFreeRange == 4);
+	CHECK(allocator.GetFragmentation() > 0.0f);
+
+	// Ԃ1ԂƑOƂ܂Ƃ߂1ɂȂ
+	allocator.Free(b, 2, 0);
+	allocator.Reclaim(0);
+	statistics = allocator.GetStatistics();
+	CHECK(statistics.freeRangeCount == 1);
+	CHECK(statistics.free == 8);
+	CHECK(statistics.largestFreeRange == 8);
+	CHECK(statistics.allocated == 0);
+	CHECK(allocator.GetFragmentation() == 0.0f);
+	CHECK(allocator.Allocate(8) == 0);
+}
+
+TEST(DescriptorIndexAllocatorCoalescesInAnyOrder) {
+	// ǂ̏ŕԂĂŌɂ1͈̔͂ɖ߂
+	for (uint64_t seed = 1; seed <= 20; seed++) {
+		Test::Random random(seed);
+		DescriptorIndexAllocator allocator(64);
+
+		std::vector<uint32_t> indices;
+		for (int i = 0; i < 64; i++) {
+			indices.push_back(allocator.Allocate());
+		}
+		CHECK(allocator.Allocate() == DescriptorIndexAllocator::INVALID_INDEX);
+
+		for (size_t i = indices.size(); i > 1; i--) {
+			std::swap(indices[i - 1], indices[random.Next((uint32_t)i)]);
+		}
+		for (uint32_t index : indices) {
+			allocator.Free(index, 1, 0);
+			allocator.Reclaim(0);
+		}
+
+		DescriptorIndexAllocator::Statistics statistics = allocator.GetStatistics();
+		CHECK(statistics.freeRangeCount == 1);
+		CHECK(statistics.largestFreeRange == 64);
+	}
+}
+
+TEST(DescriptorIndexAllocatorDefersFreeUntilFence) {
+	DescriptorIndexAllocator allocator(4);
+
+	uint32_t a = allocator.Allocate(2);
+	uint32_t b = allocator.Allocate(2);
+	allocator.Free(a, 2, 5);
+	allocator.Free(b, 2, 7);
+
+	// tFXiނ܂ł͕ԂԍgȂ
+	CHECK(allocator.Allocate() == DescriptorIndexAllocator::INVALID_INDEX);
+	CHECK(allocator.GetStatistics().pending == 4);
+
+	allocator.Reclaim(4);
+	CHECK(allocator.GetStatistics().pending == 4);
+	CHECK(allocator.Allocate() == DescriptorIndexAllocator::INVALID_INDEX);
+
+	// 5܂ŏI΁A5ŕԂ̂߂
+	allocator.Reclaim(5);
+	DescriptorIndexAllocator::Statistics statistics = allocator.GetStatistics();
+	CHECK(statistics.pending == 2);
+	CHECK(statistics.free == 2);
+	CHECK(statistics.recycled == 1);
+	CHECK(allocator.Allocate(2) == a);
+	CHECK(allocator.Allocate() == DescriptorIndexAllocator::INVALID_INDEX);
+
+	allocator.Reclaim(100);
+	statistics = allocator.GetStatistics();
+	CHECK(statistics.pending == 0);
+	CHECK(statistics.recycled == 2);
+	CHECK(allocator.Allocate(2) == b);
+}
+
+TEST(DescriptorIndexAllocatorReportsExhaustion) {
+	DescriptorIndexAllocator allocator(4, 3, 2);
+	CHECK(allocator.GetCapacity() == 10);
+
+	// 傫v͎sAmۂȂ
+	CHECK(allocator.Allocate(5) == DescriptorIndexAllocator::INVALID_INDEX);
+	CHECK(allocator.GetStatistics().allocated == 0);
+
+	// fЉĂƁA󂫂̍vĂAŎȂΎs
+	uint32_t a = allocator.Allocate();
+	allocator.Allocate();
+	uint32_t c = allocator.Allocate();
+	allocator.Allocate();
+	allocator.Free(a, 1, 0);
+	allocator.Free(c, 1, 0);
+	allocator.Reclaim(0);
+	CHECK(allocator.GetStatistics().free == 2);
+	CHECK(allocator.Allocate(2) == DescriptorIndexAllocator::INVALID_INDEX);
+	CHECK(allocator.GetStatistics().failures == 2);
+
+	// ĝė̈̓t[Ƃɋ؂Aꂽ玸s
+	allocator.BeginFrame(1);
+	CHECK(allocator.AllocateTransient(2) == 4 + 3);
+	CHECK(allocator.AllocateTransient(1) == 4 + 3 + 2);
+	CHECK(allocator.AllocateTransient(1) == DescriptorIndexAllocator::INVALID_INDEX);
+	CHECK(allocator.AllocateTransient(0xffffffff) == DescriptorIndexAllocator::INVALID_INDEX);
+	CHECK(allocator.GetStatistics().transientPeak == 3);
+	CHECK(allocator.GetStatistics().failures == 4);
+
+	allocator.BeginFrame(2);
+	CHECK(allocator.AllocateTransient(3) == 4);
+}
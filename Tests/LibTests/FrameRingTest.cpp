@@ -0,0 +1,208 @@
+#include "Test.h"
+#include "FrameRing.h"
+
+#include <chrono>
+#include <deque>
+#include <thread>
+#include <vector>
+
+namespace {
+	// ҂ƁA̒l܂őɏIƂɂtFX
+	class ImmediateFence : public FrameFence
+	{
+	public:
+		uint64_t signaled = 0;
+		uint64_t completed = 0;
+		std::vector<uint64_t> waits;
+
+		void Signal(uint64_t value) override { signaled = value; }
+		uint64_t GetCompletedValue() override { return completed; }
+		void Wait(uint64_t value) override {
+			waits.push_back(value);
+			if (completed < value) {
+				completed = value;
+			}
+		}
+	};
+
+	// 1t[gpuSecondsGPU^tFXBSignalɑÕt[̌֐ς
+	class TimedFence : public FrameFence
+	{
+	private:
+		typedef struct Submission {
+			uint64_t value;
+			double finishTime;
+		};
+
+		double gpuSeconds;
+		uint64_t completed = 0;
+		double lastFinish = 0.0;
+		std::deque<Submission> pending;
+
+		void Retire(double now) {
+			while (!pending.empty() && pending.front().finishTime <= now) {
+				completed = pending.front().value;
+				pending.pop_front();
+			}
+		}
+
+	public:
+		TimedFence(double gpuSeconds) : gpuSeconds(gpuSeconds) {}
+
+		void Signal(uint64_t value) override {
+			double now = Test::Now();
+			lastFinish = (lastFinish > now ? lastFinish : now) + gpuSeconds;
+			pending.push_back({ value, lastFinish });
+		}
+		uint64_t GetCompletedValue() override {
+			Retire(Test::Now());
+			return completed;
+		}
+		void Wait(uint64_t value) override {
+			for (auto& submission : pending) {
+				if (submission.value >= value) {
+					std::this_thread::sleep_for(std::chrono::duration<double>(submission.finishTime - Test::Now()));
+					break;
+				}
+			}
+			Retire(Test::Now());
+		}
+	};
+
+	void Spin(double seconds) {
+		double end = Test::Now() + seconds;
+		while (Test::Now() < end) {
+		}
+	}
+}
+
+TEST(FrameRingDoesNotWaitForCompletedFrames) {
+	ImmediateFence fence;
+	FrameRing ring(&fence, 3);
+
+	for (unsigned int frame = 0; frame < 9; frame++) {
+		// GPUɒǂtĂ
+		fence.completed = fence.signaled;
+		ring.BeginFrame(frame % 3);
+		ring.EndFrame();
+	}
+	CHECK(fence.waits.empty());
+	CHECK(ring.GetWaitCount() == 0);
+	CHECK(ring.GetLastSignaledValue() == 9);
+}
+
+TEST(FrameRingWaitsOnlyForReusedSlot) {
+	ImmediateFence fence;
+	FrameRing ring(&fence, 3);
+
+	// ŏ3t[͂ǂ̃XbggĂȂ̂ő҂Ȃ
+	for (unsigned int frame = 0; frame < 3; frame++) {
+		ring.BeginFrame(frame);
+		CHECK(ring.EndFrame() == frame + 1);
+	}
+	CHECK(fence.waits.empty());
+
+	// GPU1t[IĂȂ΁AėpXbg̒liŐV̒lł͂Ȃj҂
+	ring.BeginFrame(0);
+	CHECK(fence.waits.size() == 1 && fence.waits[0] == 1);
+	CHECK(ring.EndFrame() == 4);
+	CHECK(ring.GetFenceValue(0) == 4);
+
+	// Xbg1̒li2j͑҂li1jȂ̂ŁA܂IĂȂ
+	ring.BeginFrame(1);
+	CHECK(fence.waits.size() == 2 && fence.waits[1] == 2);
+	ring.EndFrame();
+
+	// Xbg2̒li3j܂GPUiłΑ҂Ȃ
+	fence.completed = 3;
+	ring.BeginFrame(2);
+	CHECK(fence.waits.size() == 2);
+	CHECK(ring.GetWaitCount() == 2);
+	CHECK(ring.IsFrameComplete(2));
+	CHECK(!ring.IsFrameComplete(0));
+}
+
+TEST(FrameRingFlushWaitsForEverythingAndResetsSlots) {
+	ImmediateFence fence;
+	FrameRing ring(&fence, 2);
+
+	ring.BeginFrame(0);
+	ring.EndFrame();
+	ring.BeginFrame(1);
+	ring.EndFrame();
+
+	uint64_t value = ring.Flush();
+	CHECK(value == 3);
+	CHECK(fence.signaled == 3);
+	CHECK(!fence.waits.empty() && fence.waits.back() == 3);
+	CHECK(fence.completed == 3);
+	for (unsigned int i = 0; i < ring.GetFrameCount(); i++) {
+		CHECK(ring.GetFenceValue(i) == 3);
+		CHECK(ring.IsFrameComplete(i));
+	}
+
+	// Flusȟ͂ǂ̃Xbg҂Ȃ
+	size_t waits = fence.waits.size();
+	ring.BeginFrame(0);
+	ring.EndFrame();
+	CHECK(fence.waits.size() == waits);
+	CHECK(ring.GetLastSignaledValue() == 4);
+}
+
+TEST(FrameRingOverlapsCpuAndGpu) {
+	// CPUGPUɓꍇA2t[ȏ゠΂قڏdȂ
+	TimedFence fence(0.002);
+	FrameRing ring(&fence, 2);
+
+	double start = Test::Now();
+	for (unsigned int frame = 0; frame < 50; frame++) {
+		ring.BeginFrame(frame % 2);
+		Spin(0.002);
+		ring.EndFrame();
+	}
+	ring.Flush();
+	double seconds = Test::Now() - start;
+
+	// Ȃ0.2bB̗h0.15b
+	CHECK(seconds < 0.15);
+}
+
+BENCHMARK(FrameRingThroughput) {
+	// CPŰL^GPU̎sɂꂼꌈ܂Ԃꍇ́AtbVt[Ƃ̔r
+	const double cpuSeconds = 0.004;
+	const double gpuSeconds[] = { 0.002, 0.004, 0.006 };
+	const unsigned int frames = 200;
+
+	std::printf("  cpu %.1f ms/frame, %u frames\n", cpuSeconds * 1e3, frames);
+	std::printf("  gpu ms   flush     1 frame   2 frames  3 frames  (ms/frame, waits)\n");
+	for (double gpu : gpuSeconds) {
+		std::printf("  %.1f    ", gpu * 1e3);
+
+		// t[GPŮ҂iύXO̓j
+		{
+			TimedFence fence(gpu);
+			FrameRing ring(&fence, 1);
+			double start = Test::Now();
+			for (unsigned int frame = 0; frame < frames; frame++) {
+				ring.BeginFrame(0);
+				Spin(cpuSeconds);
+				ring.Flush();
+			}
+			std::printf("  %6.2f  ", (Test::Now() - start) / frames * 1e3);
+		}
+
+		for (unsigned int count = 1; count <= 3; count++) {
+			TimedFence fence(gpu);
+			FrameRing ring(&fence, count);
+			double start = Test::Now();
+			for (unsigned int frame = 0; frame < frames; frame++) {
+				ring.BeginFrame(frame % count);
+				Spin(cpuSeconds);
+				ring.EndFrame();
+			}
+			ring.Flush();
+			std::printf("  %6.2f %3u", (Test::Now() - start) / frames * 1e3, ring.GetWaitCount());
+		}
+		std::printf("\n");
+	}
+}
@@ -0,0 +1,149 @@
+#include "Test.h"
+#include "PipelineCacheFile.h"
+
+#include <cstring>
+#include <vector>
+
+namespace {
+	const size_t HEADER_SIZE = 12;
+	const size_t ENTRY_HEADER_SIZE = 8 + 5 + 4;
+
+	PipelineKey MakeKey(PipelineShader pixelShader, BlendMode blend) {
+		PipelineKey key;
+		key.pixelShader = pixelShader;
+		key.blend = blend;
+		return key;
+	}
+
+	// Ƀ`FbNTtAǧ܂œ͂悤ɂ
+	void Reseal(std::vector<uint8_t>& data) {
+		uint64_t checksum = HashBytes(data.data(), data.size());
+		const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&checksum);
+		data.insert(data.end(), bytes, bytes + sizeof(checksum));
+	}
+
+	std::vector<uint8_t> Body(const std::vector<uint8_t>& data) {
+		return std::vector<uint8_t>(data.begin(), data.end() - sizeof(uint64_t));
+	}
+
+	// blob̑傫51̃t@Ci3oCg̋lߕj
+	std::vector<uint8_t> SingleEntry() {
+		PipelineCacheFile cache;
+		const uint8_t blob[] = { 1, 2, 3, 4, 5 };
+		cache.Store(42, MakeKey(PipelineShader::TEXTURE_PS, BlendMode::ALPHA), blob, sizeof(blob));
+		std::vector<uint8_t> data;
+		cache.Serialize(data);
+		return data;
+	}
+
+	bool Rejects(const std::vector<uint8_t>& data) {
+		PipelineCacheFile cache;
+		const uint8_t blob[] = { 9 };
+		cache.Store(1, PipelineKey(), blob, sizeof(blob));
+		// sꍇ͑O̓ecȂ
+		return !cache.Deserialize(data) && cache.GetEntries().empty() && cache.Find(1) == nullptr;
+	}
+}
+
+TEST(PipelineCacheFileRoundTrip) {
+	PipelineCacheFile cache;
+	std::vector<uint8_t> blobs[3] = { {}, { 1, 2, 3, 4, 5 }, { 8, 7, 6, 5, 4, 3, 2, 1 } };
+	cache.Store(10, MakeKey(PipelineShader::BASIC_PS, BlendMode::DISABLED), blobs[0].data(), blobs[0].size());
+	cache.Store(20, MakeKey(PipelineShader::TEXTURE_PS, BlendMode::ALPHA), blobs[1].data(), blobs[1].size());
+	cache.Store(30, MakeKey(PipelineShader::SPRITE_PS, BlendMode::ADDITIVE), blobs[2].data(), blobs[2].size());
+	CHECK(cache.IsDirty());
+
+	std::vector<uint8_t> data;
+	cache.Serialize(data);
+	CHECK((data.size() - sizeof(uint64_t)) % 4 == 0);
+
+	PipelineCacheFile loaded;
+	CHECK(loaded.Deserialize(data));
+	CHECK(!loaded.IsDirty());
+	CHECK(loaded.GetEntries().size() == 3);
+	for (int i = 0; i < 3; i++) {
+		const PipelineCacheFile::Entry* entry = loaded.Find((uint64_t)(i + 1) * 10);
+		CHECK(entry != nullptr && entry->blob == blobs[i]);
+		CHECK(entry != nullptr && entry->key == cache.Find((uint64_t)(i + 1) * 10)->key);
+	}
+
+	// ̃LbVǂݏł
+	PipelineCacheFile empty;
+	empty.Serialize(data);
+	CHECK(loaded.Deserialize(data));
+	CHECK(loaded.GetEntries().empty());
+}
+
+TEST(PipelineCacheFileRejectsTruncatedFiles) {
+	std::vector<uint8_t> data = SingleEntry();
+	for (size_t size = 0; size < data.size(); size++) {
+		CHECK(Rejects(std::vector<uint8_t>(data.begin(), data.begin() + size)));
+	}
+}
+
+TEST(PipelineCacheFileRejectsBadChecksum) {
+	std::vector<uint8_t> data = SingleEntry();
+	for (size_t i = 0; i < data.size(); i++) {
+		std::vector<uint8_t> corrupt = data;
+		corrupt[i] ^= 0x01;
+		CHECK(Rejects(corrupt));
+	}
+}
+
+TEST(PipelineCacheFileRejectsWrongVersion) {
+	std::vector<uint8_t> body = Body(SingleEntry());
+	uint32_t version = PipelineCacheFile::VERSION + 1;
+	std::memcpy(&body[4], &version, sizeof(version));
+	Reseal(body);
+	CHECK(Rejects(body));
+
+	body = Body(SingleEntry());
+	uint32_t magic = 0;
+	std::memcpy(&body[0], &magic, sizeof(magic));
+	Reseal(body);
+	CHECK(Rejects(body));
+}
+
+TEST(PipelineCacheFileRejectsMalformedEntries) {
+	{
+		// lߕĖ{̂̏I4oCgE炸炷iȑO͋l߂ʒu{̂zĔ͈͊Oǂłj
+		std::vector<uint8_t> body = Body(SingleEntry());
+		body.resize(body.size() - 3);
+		Reseal(body);
+		CHECK(Rejects(body));
+	}
+	{
+		// 傫{̂Ɏ܂Ȃi67͋lߕ̕܂Ŋ܂߂Ύ܂̂ŉĂȂj
+		const uint32_t sizes[] = { 8, 9, 1000, 0xfffffffc, 0xffffffff };
+		for (uint32_t size : sizes) {
+			std::vector<uint8_t> body = Body(SingleEntry());
+			std::memcpy(&body[HEADER_SIZE + 13], &size, sizeof(size));
+			Reseal(body);
+			CHECK(Rejects(body));
+		}
+	}
+	{
+		// ۂ葽EȂ
+		const uint32_t counts[] = { 0, 2, 0xffffffff };
+		for (uint32_t count : counts) {
+			std::vector<uint8_t> body = Body(SingleEntry());
+			std::memcpy(&body[8], &count, sizeof(count));
+			Reseal(body);
+			CHECK(Rejects(body));
+		}
+	}
+	{
+		// ͈͊ÕL[
+		std::vector<uint8_t> body = Body(SingleEntry());
+		body[HEADER_SIZE + 8 + 1] = (uint8_t)PipelineShader::COUNT;
+		Reseal(body);
+		CHECK(Rejects(body));
+	}
+	{
+		// ڂ̓rŖ{̂I
+		std::vector<uint8_t> body = Body(SingleEntry());
+		body.resize(HEADER_SIZE + ENTRY_HEADER_SIZE - 1 + 3);
+		Reseal(body);
+		CHECK(Rejects(body));
+	}
+}
@@ -0,0 +1,147 @@
+#include "Test.h"
+#include "ThreadPool.h"
+
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+	// ID3D12GraphicsCommandList̑ɁA߂ԍƈ̕тŗ߂邾̃Xg
+	class FakeCommandList
+	{
+	public:
+		enum Command : uint32_t {
+			SET_PIPELINE = 1,
+			SET_CONSTANT,
+			SET_VERTEX_BUFFER,
+			DRAW,
+			CLOSE
+		};
+
+		std::vector<uint32_t> commands;
+
+		void Reset() { commands.clear(); }
+		void SetPipelineState(uint32_t pipeline) { commands.push_back(SET_PIPELINE); commands.push_back(pipeline); }
+		void SetConstant(const float* matrix) {
+			commands.push_back(SET_CONSTANT);
+			size_t at = commands.size();
+			commands.resize(at + 16);
+			std::memcpy(&commands[at], matrix, sizeof(float) * 16);
+		}
+		void SetVertexBuffer(uint32_t mesh) { commands.push_back(SET_VERTEX_BUFFER); commands.push_back(mesh); }
+		void Draw(uint32_t indexCount) { commands.push_back(DRAW); commands.push_back(indexCount); }
+		void Close() { commands.push_back(CLOSE); }
+	};
+
+	// Renderer::RecordParallelƓiCŏAƂɋL^ĕAԍɕׂj
+	// threadCountSetRecordThreadCountƓĂяo܂
+	class FakeRecorder
+	{
+	private:
+		std::unique_ptr<ThreadPool> threads;
+		std::vector<FakeCommandList> lists;
+
+	public:
+		FakeRecorder(int threadCount) {
+			if (threadCount != 1) {
+				threads = std::make_unique<ThreadPool>(threadCount - 1);
+			}
+		}
+
+		void RecordParallel(int partCount, const std::function<void(int part, FakeCommandList* list)>& record) {
+			lists.resize(partCount);
+			for (int i = 0; i < partCount; i++) {
+				lists[i].Reset();
+				lists[i].SetPipelineState(1);
+			}
+
+			auto body = [&](int i) {
+				record(i, &lists[i]);
+				lists[i].Close();
+			};
+			if (threads != nullptr) {
+				threads->ParallelFor(partCount, body);
+			}
+			else {
+				for (int i = 0; i < partCount; i++) {
+					body(i);
+				}
+			}
+		}
+
+		std::vector<uint32_t> Submit() {
+			std::vector<uint32_t> submitted;
+			for (auto& list : lists) {
+				submitted.insert(submitted.end(), list.commands.begin(), list.commands.end());
+			}
+			return submitted;
+		}
+	};
+
+	// Shape::DrawƓx̎diWsĒ萔AbVݒ肵ĕ`j
+	void RecordDraws(FakeCommandList* list, int first, int count) {
+		for (int i = first; i < first + count; i++) {
+			float angle = (float)i * 0.01f;
+			float c = std::cos(angle);
+			float s = std::sin(angle);
+			float world[16] = {
+				c, s, 0.0f, 0.0f,
+				-s, c, 0.0f, 0.0f,
+				0.0f, 0.0f, 1.0f, 0.0f,
+				(float)(i % 640), (float)(i / 640), 0.0f, 1.0f
+			};
+			list->SetConstant(world);
+			list->SetVertexBuffer((uint32_t)(i % 3));
+			list->Draw(6);
+		}
+	}
+}
+
+TEST(RecordParallelKeepsPartOrder) {
+	// Xbhɂ炸A̔ԍɕׂʂ1XbhŋL^̂ƓɂȂ
+	const int partCount = 13;
+	const int drawsPerPart = 50;
+	auto record = [&](int part, FakeCommandList* list) { RecordDraws(list, part * drawsPerPart, drawsPerPart); };
+
+	FakeRecorder serial(1);
+	serial.RecordParallel(partCount, record);
+	std::vector<uint32_t> expected = serial.Submit();
+
+	for (int threads : { 2, 4, 16 }) {
+		FakeRecorder recorder(threads);
+		for (int frame = 0; frame < 5; frame++) {
+			recorder.RecordParallel(partCount, record);
+			CHECK(recorder.Submit() == expected);
+		}
+	}
+}
+
+BENCHMARK(RecordParallelScaling) {
+	// 1t[drawCount̕`partCountɕċL^
+	const int drawCount = 20000;
+	const int partCount = 64;
+	const int frames = 50;
+	const int drawsPerPart = drawCount / partCount;
+	auto record = [&](int part, FakeCommandList* list) { RecordDraws(list, part * drawsPerPart, drawsPerPart); };
+
+	std::printf("  %d draws in %d parts, %d frames, %u hardware threads\n", drawCount, partCount, frames, std::thread::hardware_concurrency());
+	std::printf("  threads  ms/frame  speedup\n");
+	double baseline = 0.0;
+	for (int threads : { 1, 2, 4, 8, 16 }) {
+		FakeRecorder recorder(threads);
+		recorder.RecordParallel(partCount, record);
+
+		double start = Test::Now();
+		for (int frame = 0; frame < frames; frame++) {
+			recorder.RecordParallel(partCount, record);
+		}
+		double seconds = (Test::Now() - start) / frames;
+		if (threads == 1) {
+			baseline = seconds;
+		}
+		std::printf("  %7d  %8.3f  %6.2fx\n", threads, seconds * 1e3, baseline / seconds);
+	}
+}
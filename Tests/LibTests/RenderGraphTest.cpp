@@ -0,0 +1,345 @@
+#include "Test.h"
+#include "RenderGraph.h"
+#include "FrameRing.h"
+
+#include <memory>
+#include <string>
+
+namespace {
+	size_t CountBarriers(const std::vector<GraphBarrier>& barriers, GraphBarrierType type) {
+		size_t count = 0;
+		for (auto& barrier : barriers) {
+			if (barrier.type == type) {
+				count++;
+			}
+		}
+		return count;
+	}
+
+	bool HasError(RenderGraph& graph, const std::string& pass) {
+		return !graph.Compile() && !graph.IsCompiled() && graph.GetError().compare(0, pass.size(), pass) == 0;
+	}
+
+	// GPU1t[xĒǂtFX
+	class LaggingFence : public FrameFence
+	{
+	public:
+		uint64_t signaled = 0;
+		uint64_t completed = 0;
+
+		void Signal(uint64_t value) override {
+			completed = signaled;
+			signaled = value;
+		}
+		uint64_t GetCompletedValue() override { return completed; }
+		void Wait(uint64_t value) override {
+			if (completed < value) {
+				completed = value;
+			}
+		}
+	};
+
+	// RenderGraphExecutorƓKŁAq[vƔzu\[X̑̃IuWFNg蒼Ď
+	class TransientPlacer
+	{
+	private:
+		typedef struct Placed {
+			std::shared_ptr<int> resource;
+			uint64_t offset;
+			uint64_t size;
+		};
+
+		FrameRing* frameRing;
+		std::shared_ptr<int> heap;
+		uint64_t heapCapacity = 0;
+		std::vector<Placed> placed;
+
+		void Retire(std::shared_ptr<int> object) {
+			retired.Retire(std::move(object), frameRing->GetLastSignaledValue() + 1);
+		}
+
+		std::shared_ptr<int> Create() {
+			std::shared_ptr<int> object = std::make_shared<int>(0);
+			created.push_back(object);
+			return object;
+		}
+
+	public:
+		FrameRetireList<std::shared_ptr<int>> retired;
+		std::vector<std::weak_ptr<int>> created;
+
+		TransientPlacer(FrameRing* frameRing) : frameRing(frameRing) {}
+
+		void Place(RenderGraph& graph, uint32_t id, uint64_t size) {
+			if (graph.GetTransientHeapSize() > heapCapacity) {
+				if (heap != nullptr) {
+					Retire(heap);
+				}
+				for (auto& entry : placed) {
+					if (entry.resource != nullptr) {
+						Retire(entry.resource);
+					}
+					entry.resource = nullptr;
+				}
+				heap = Create();
+				heapCapacity = graph.GetTransientHeapSize();
+			}
+
+			if (id >= placed.size()) {
+				placed.resize(id + 1);
+			}
+			Placed& entry = placed[id];
+			uint64_t offset = graph.GetTransientOffset(id);
+			if (entry.resource == nullptr || entry.offset != offset || entry.size != size) {
+				if (entry.resource != nullptr) {
+					Retire(entry.resource);
+				}
+				entry.resource = Create();
+				entry.offset = offset;
+				entry.size = size;
+			}
+		}
+
+		void BeginFrame() { retired.Release(frameRing->GetCompletedValue()); }
+
+		size_t CountLive() {
+			size_t count = heap != nullptr ? 1 : 0;
+			for (auto& entry : placed) {
+				count += entry.resource != nullptr ? 1 : 0;
+			}
+			return count;
+		}
+
+		size_t CountAlive() {
+			size_t count = 0;
+			for (auto& object : created) {
+				count += object.expired() ? 0 : 1;
+			}
+			return count;
+		}
+	};
+}
+
+TEST(RenderGraphMergesReadStates) {
+	RenderGraph graph;
+	uint32_t target = graph.CreateTransient("target", { 256, 1 });
+	uint32_t backBuffer = graph.Import("backBuffer", ResourceState::PRESENT, ResourceState::PRESENT);
+
+	uint32_t draw = graph.AddPass("draw");
+	graph.Write(draw, target, ResourceState::RENDER_TARGET);
+	uint32_t blur = graph.AddPass("blur");
+	graph.Read(blur, target, ResourceState::PIXEL_SHADER_RESOURCE);
+	uint32_t copy = graph.AddPass("copy");
+	graph.Read(copy, target, ResourceState::COPY_SOURCE);
+	graph.Write(copy, backBuffer, ResourceState::COPY_DEST);
+	CHECK(graph.Compile());
+
+	// 쐬̏Ԃ͍ŏɏޏԂȂ̂ŁAŏ̃pXł͐؂ւȂ
+	CHECK(graph.GetInitialState(target) == ResourceState::RENDER_TARGET);
+	CHECK(graph.GetBarriers(draw).empty());
+
+	// ēǂ2̃pX̏Ԃ1̐؂ւɂ܂Ƃ߂
+	auto& blurBarriers = graph.GetBarriers(blur);
+	CHECK(blurBarriers.size() == 1);
+	CHECK(blurBarriers[0].type == GraphBarrierType::TRANSITION);
+	CHECK(blurBarriers[0].before == ResourceState::RENDER_TARGET);
+	CHECK(blurBarriers[0].after == (ResourceState::PIXEL_SHADER_RESOURCE | ResourceState::COPY_SOURCE));
+
+	auto& copyBarriers = graph.GetBarriers(copy);
+	CHECK(copyBarriers.size() == 1);
+	CHECK(copyBarriers[0].resource == backBuffer);
+	CHECK(copyBarriers[0].after == ResourceState::COPY_DEST);
+
+	// ŌɊÕ\[X͌߂ꂽԂցAꎞ\[X͍쐬̏Ԃ֖߂
+	auto& finalBarriers = graph.GetFinalBarriers();
+	CHECK(finalBarriers.size() == 2);
+	for (auto& barrier : finalBarriers) {
+		if (barrier.resource == backBuffer) {
+			CHECK(barrier.after == ResourceState::PRESENT);
+		}
+		else {
+			CHECK(barrier.resource == target);
+			CHECK(barrier.after == ResourceState::RENDER_TARGET);
+		}
+	}
+
+	RenderGraph::Statistics statistics = graph.GetStatistics();
+	CHECK(statistics.transitions == 4);
+	CHECK(statistics.batches == 3);
+}
+
+TEST(RenderGraphMergesReadsInOnePass) {
+	RenderGraph graph;
+	uint32_t texture = graph.Import("texture", ResourceState::COMMON, ResourceState::COMMON);
+
+	uint32_t pass = graph.AddPass("pass");
+	graph.Read(pass, texture, ResourceState::PIXEL_SHADER_RESOURCE);
+	graph.Read(pass, texture, ResourceState::COPY_SOURCE);
+	CHECK(graph.Compile());
+
+	auto& barriers = graph.GetBarriers(pass);
+	CHECK(barriers.size() == 1);
+	CHECK(barriers[0].after == (ResourceState::PIXEL_SHADER_RESOURCE | ResourceState::COPY_SOURCE));
+}
+
+TEST(RenderGraphAliasesDisjointTransients) {
+	RenderGraph graph;
+	uint32_t first = graph.CreateTransient("first", { 100, 1 });
+	uint32_t second = graph.CreateTransient("second", { 100, 1 });
+	uint32_t whole = graph.CreateTransient("whole", { 50, 64 });
+
+	uint32_t pass0 = graph.AddPass("pass0");
+	graph.Write(pass0, first, ResourceState::RENDER_TARGET);
+	graph.Write(pass0, whole, ResourceState::RENDER_TARGET);
+	uint32_t pass1 = graph.AddPass("pass1");
+	graph.Read(pass1, first, ResourceState::PIXEL_SHADER_RESOURCE);
+	uint32_t pass2 = graph.AddPass("pass2");
+	graph.Write(pass2, second, ResourceState::RENDER_TARGET);
+	uint32_t pass3 = graph.AddPass("pass3");
+	graph.Read(pass3, second, ResourceState::PIXEL_SHADER_RESOURCE);
+	graph.Read(pass3, whole, ResourceState::PIXEL_SHADER_RESOURCE);
+	CHECK(graph.Compile());
+
+	// gԂdȂȂ2͓ʒuASԎĝ͂̌̑ʒu
+	CHECK(graph.GetTransientOffset(first) == 0);
+	CHECK(graph.GetTransientOffset(second) == 0);
+	CHECK(graph.GetTransientOffset(whole) == 128);
+	CHECK(graph.GetTransientHeapSize() == 178);
+	CHECK(graph.GetStatistics().transientBytes == 250);
+
+	// gn߂pX̑OŁAO܂ŎgĂ\[X̐؂ւ
+	auto& barriers = graph.GetBarriers(pass2);
+	CHECK(barriers.size() == 1);
+	CHECK(barriers[0].type == GraphBarrierType::ALIASING);
+	CHECK(barriers[0].resource == second);
+	CHECK(barriers[0].resourceBefore == first);
+	CHECK(CountBarriers(graph.GetBarriers(pass0), GraphBarrierType::ALIASING) == 0);
+	CHECK(graph.GetStatistics().aliasingBarriers == 1);
+}
+
+TEST(RenderGraphKeepsOverlappingTransientsApart) {
+	// gԂ1pXłdȂΓɒuȂ
+	RenderGraph graph;
+	uint32_t a = graph.CreateTransient("a", { 64, 1 });
+	uint32_t b = graph.CreateTransient("b", { 64, 1 });
+
+	uint32_t pass0 = graph.AddPass("pass0");
+	graph.Write(pass0, a, ResourceState::RENDER_TARGET);
+	uint32_t pass1 = graph.AddPass("pass1");
+	graph.Read(pass1, a, ResourceState::PIXEL_SHADER_RESOURCE);
+	graph.Write(pass1, b, ResourceState::RENDER_TARGET);
+	CHECK(graph.Compile());
+
+	CHECK(graph.GetTransientOffset(a) != graph.GetTransientOffset(b));
+	CHECK(graph.GetTransientHeapSize() == 128);
+	CHECK(CountBarriers(graph.GetBarriers(pass1), GraphBarrierType::ALIASING) == 0);
+}
+
+TEST(RenderGraphReportsDeclarationErrors) {
+	{
+		RenderGraph graph;
+		uint32_t pass = graph.AddPass("unknown");
+		graph.Read(pass, 3, ResourceState::PIXEL_SHADER_RESOURCE);
+		CHECK(HasError(graph, "unknown"));
+	}
+	{
+		// ǂݍ݂̏Ԃŏ
+		RenderGraph graph;
+		uint32_t texture = graph.Import("texture", ResourceState::COMMON, ResourceState::COMMON);
+		uint32_t pass = graph.AddPass("mismatch");
+		graph.Write(pass, texture, ResourceState::PIXEL_SHADER_RESOURCE);
+		CHECK(HasError(graph, "mismatch"));
+	}
+	{
+		// pXŏ݂Ɠǂݍ݂Ɏg
+		RenderGraph graph;
+		uint32_t texture = graph.Import("texture", ResourceState::COMMON, ResourceState::COMMON);
+		uint32_t pass = graph.AddPass("conflict");
+		graph.Write(pass, texture, ResourceState::RENDER_TARGET);
+		graph.Read(pass, texture, ResourceState::PIXEL_SHADER_RESOURCE);
+		CHECK(HasError(graph, "conflict"));
+	}
+	{
+		// ꎞ\[X͓êŁAޑOɓǂ߂Ȃ
+		RenderGraph graph;
+		uint32_t target = graph.CreateTransient("target", { 16, 1 });
+		uint32_t pass = graph.AddPass("uninitialized");
+		graph.Read(pass, target, ResourceState::PIXEL_SHADER_RESOURCE);
+		CHECK(HasError(graph, "uninitialized"));
+	}
+	{
+		// ΂xRpCł
+		RenderGraph graph;
+		uint32_t target = graph.CreateTransient("target", { 16, 1 });
+		uint32_t pass = graph.AddPass("retry");
+		graph.Read(pass, target, ResourceState::PIXEL_SHADER_RESOURCE);
+		CHECK(!graph.Compile());
+		graph.Clear();
+		target = graph.CreateTransient("target", { 16, 1 });
+		pass = graph.AddPass("retry");
+		graph.Write(pass, target, ResourceState::RENDER_TARGET);
+		CHECK(graph.Compile());
+		CHECK(graph.GetError().empty());
+	}
+}
+
+TEST(RenderGraphReleasesRetiredTransientsOnRecompile) {
+	const unsigned int FRAME_COUNT = 2;
+	LaggingFence fence;
+	FrameRing ring(&fence, FRAME_COUNT);
+	TransientPlacer placer(&ring);
+	Test::Random random(7);
+	RenderGraph graph;
+
+	bool bounded = true;
+	bool sameGraphKeepsObjects = true;
+	unsigned int frameIndex = 0;
+	ring.BeginFrame(frameIndex);
+	for (uint32_t frame = 0; frame < 300; frame++) {
+		// t[gݒAƂǂ傫{ςĔzuƃq[v̑傫𓮂
+		bool change = frame % 8 == 0;
+		uint32_t count = 2 + (change ? random.Next(3) : 0);
+		uint64_t size = 256 * (1 + (change ? random.Next(frame / 16 + 1) : 0));
+
+		size_t createdBefore = placer.created.size();
+		graph.Clear();
+		std::vector<uint32_t> targets;
+		for (uint32_t i = 0; i < count; i++) {
+			targets.push_back(graph.CreateTransient("target" + std::to_string(i), { size + i * 64, 64 }));
+		}
+		for (uint32_t i = 0; i < count; i++) {
+			uint32_t pass = graph.AddPass("pass" + std::to_string(i));
+			graph.Write(pass, targets[i], ResourceState::RENDER_TARGET);
+			if (i > 0) {
+				graph.Read(pass, targets[i - 1], ResourceState::PIXEL_SHADER_RESOURCE);
+			}
+		}
+		CHECK(graph.Compile());
+		for (uint32_t i = 0; i < count; i++) {
+			placer.Place(graph, targets[i], size + i * 64);
+		}
+		// ς̃t[͌̕тɖ߂̂ŁA͍̎蒼Ȃ
+		if (frame % 8 >= 2 && placer.created.size() != createdBefore) {
+			sameGraphKeepsObjects = false;
+		}
+
+		ring.EndFrame();
+		frameIndex = (frameIndex + 1) % FRAME_COUNT;
+		ring.BeginFrame(frameIndex);
+		placer.BeginFrame();
+
+		// cĂ͎̂gp̃q[vƃ\[XAGPU܂gIĂȂ2t[
+		if (placer.CountAlive() != placer.CountLive() + placer.retired.GetCount() || placer.retired.GetCount() > 2 * (1 + 4)) {
+			bounded = false;
+		}
+	}
+	CHECK(bounded);
+	CHECK(sameGraphKeepsObjects);
+	CHECK(placer.created.size() > 40);
+
+	// ׂđ҂Ă΁AÂׂ̂͂Ď
+	ring.Flush();
+	placer.BeginFrame();
+	CHECK(placer.retired.GetCount() == 0);
+	CHECK(placer.CountAlive() <= 1 + 4);
+}
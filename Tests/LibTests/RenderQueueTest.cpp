@@ -0,0 +1,91 @@
+#include "Test.h"
+#include "RenderQueue.h"
+
+#include <vector>
+
+namespace {
+	std::vector<uint32_t> Payloads(RenderQueue& queue) {
+		std::vector<uint32_t> payloads;
+		for (auto& item : queue.GetItems()) {
+			payloads.push_back(item.payload);
+		}
+		return payloads;
+	}
+}
+
+TEST(RenderQueueSortsByLayerPipelineTextureDepth) {
+	// ʂ̍ڂقǋtɂȂ悤ɓo^Aʂ̍ڂD悳邱Ƃm߂
+	RenderQueue queue;
+	queue.Push(0, 1, 1, 2.0f, 3);
+	queue.Push(0, 1, 1, 1.0f, 2);
+	queue.Push(0, 1, 0, 5.0f, 1);
+	queue.Push(0, 0, 9, 9.0f, 0);
+	queue.Push(1, 0, 0, 0.0f, 6);
+	queue.Push(0, 2, 0, 0.0f, 4);
+	queue.Push(0, 2, 0, 0.5f, 5);
+	queue.Sort();
+	CHECK((Payloads(queue) == std::vector<uint32_t>{ 0, 1, 2, 3, 4, 5, 6 }));
+
+	// [x͕̒l0łl̏ɕ
+	queue.Clear();
+	const float depths[] = { 3.5f, -0.0f, -2.0f, 1e-30f, -1e30f, 0.25f };
+	for (uint32_t i = 0; i < 6; i++) {
+		queue.Push(0, 0, 0, depths[i], i);
+	}
+	queue.Sort();
+	CHECK((Payloads(queue) == std::vector<uint32_t>{ 4, 2, 1, 3, 5, 0 }));
+}
+
+TEST(RenderQueueKeepsSubmitOrderForEqualKeys) {
+	RenderQueue queue;
+	for (uint32_t i = 0; i < 1000; i++) {
+		queue.Push(3, 1, 7, 1.0f, i);
+	}
+	queue.Sort();
+	std::vector<uint32_t> payloads = Payloads(queue);
+	bool ordered = true;
+	for (uint32_t i = 0; i < payloads.size(); i++) {
+		ordered &= payloads[i] == i;
+	}
+	CHECK(payloads.size() == 1000 && ordered);
+
+	// `揇Œ̃C[̓pCvC[xɂ炸o^AC[ǂ͔ԍ
+	queue.Clear();
+	queue.SetPainterOrder(2, true);
+	CHECK(queue.IsPainterOrder(2) && !queue.IsPainterOrder(1));
+	queue.Push(2, 3, 5, 9.0f, 2);
+	queue.Push(1, 1, 0, 0.0f, 1);
+	queue.Push(2, 0, 1, 1.0f, 3);
+	queue.Push(2, 2, 0, -1.0f, 4);
+	queue.Push(0, 2, 0, 0.0f, 0);
+	queue.Sort();
+	CHECK((Payloads(queue) == std::vector<uint32_t>{ 0, 1, 2, 3, 4 }));
+}
+
+TEST(RenderQueueCountsStateChanges) {
+	RenderQueue queue;
+	// pCvCƃeNX`݂ɕςт́AבւƎނƂɂ܂Ƃ܂
+	for (uint32_t i = 0; i < 12; i++) {
+		queue.Push(0, i % 2, i % 3, 0.0f, i);
+	}
+	queue.Sort();
+
+	RenderQueue::Statistics statistics = queue.GetStatistics();
+	CHECK(statistics.items == 12);
+	CHECK(statistics.pipelineChangesBefore == 12);
+	CHECK(statistics.textureChangesBefore == 12);
+	CHECK(statistics.pipelineChangesAfter == 2);
+	CHECK(statistics.textureChangesAfter == 6);
+
+	// vClearł͏ASort̂тɑ
+	queue.Clear();
+	queue.Push(0, 0, 0, 0.0f, 0);
+	queue.Sort();
+	statistics = queue.GetStatistics();
+	CHECK(statistics.items == 13);
+	CHECK(statistics.pipelineChangesAfter == 3);
+
+	queue.ResetStatistics();
+	statistics = queue.GetStatistics();
+	CHECK(statistics.items == 0 && statistics.pipelineChangesBefore == 0 && statistics.textureChangesAfter == 0);
+}
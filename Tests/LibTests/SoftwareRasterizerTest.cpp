@@ -0,0 +1,269 @@
+#include "Test.h"
+#include "SoftwareRasterizer.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+namespace {
+	const uint32_t BLACK = 0xff000000;
+	const uint32_t RED = 0xff0000ff;
+	const uint32_t GREEN = 0xff00ff00;
+
+	const float IDENTITY[16] = {
+		1.0f, 0.0f, 0.0f, 0.0f,
+		0.0f, 1.0f, 0.0f, 0.0f,
+		0.0f, 0.0f, 1.0f, 0.0f,
+		0.0f, 0.0f, 0.0f, 1.0f
+	};
+
+	// ̃r[s͉f̈ʒû܂܎ĝŁA_͉ʂ̍Wœn
+	RasterVertex Vertex(float x, float y, uint32_t color) {
+		RasterVertex vertex = {};
+		vertex.position[0] = x;
+		vertex.position[1] = y;
+		vertex.color[0] = (float)(color & 0xff) / 255.0f;
+		vertex.color[1] = (float)((color >> 8) & 0xff) / 255.0f;
+		vertex.color[2] = (float)((color >> 16) & 0xff) / 255.0f;
+		return vertex;
+	}
+
+	void DrawTriangle(SoftwareRasterizer& rasterizer, float x0, float y0, float x1, float y1, float x2, float y2, uint32_t color) {
+		RasterVertex vertices[] = { Vertex(x0, y0, color), Vertex(x1, y1, color), Vertex(x2, y2, color) };
+		const uint16_t indices[] = { 0, 1, 2 };
+		rasterizer.DrawIndexed(vertices, 3, indices, 3, IDENTITY);
+	}
+
+	void DrawLine(SoftwareRasterizer& rasterizer, float x0, float y0, float x1, float y1, uint32_t color) {
+		RasterVertex vertices[] = { Vertex(x0, y0, color), Vertex(x1, y1, color) };
+		rasterizer.DrawLines(vertices, 2, IDENTITY);
+	}
+
+	uint32_t Pixel(SoftwareRasterizer& rasterizer, int x, int y) {
+		return rasterizer.GetPixels()[(size_t)y * rasterizer.GetWidth() + x];
+	}
+
+	size_t CountPixels(SoftwareRasterizer& rasterizer, uint32_t color) {
+		size_t count = 0;
+		for (int i = 0; i < rasterizer.GetWidth() * rasterizer.GetHeight(); i++) {
+			count += rasterizer.GetPixels()[i] == color;
+		}
+		return count;
+	}
+
+	// `f傤Ǌ҂ʒuɂ邩
+	bool PixelsAre(SoftwareRasterizer& rasterizer, uint32_t color, const std::vector<std::pair<int, int>>& expected) {
+		for (auto& pixel : expected) {
+			if (Pixel(rasterizer, pixel.first, pixel.second) != color) {
+				return false;
+			}
+		}
+		return CountPixels(rasterizer, color) == expected.size();
+	}
+
+	// ʂAṽt[̕ɂ
+	void Begin(SoftwareRasterizer& rasterizer) {
+		rasterizer.Clear(0.0f, 0.0f, 0.0f, 1.0f);
+		rasterizer.ResetStatistics();
+	}
+
+	uint64_t DrawnPixels(SoftwareRasterizer& rasterizer) {
+		return rasterizer.GetStatistics().pixels;
+	}
+}
+
+TEST(SoftwareRasterizerTriangleEdges) {
+	SoftwareRasterizer rasterizer(128, 128, 2);
+
+	// f̋Eɍ킹`́A̕ӂ܂݉E̕ӂ܂܂Ȃ̂16x16f傤
+	Begin(rasterizer);
+	DrawTriangle(rasterizer, 8.0f, 8.0f, 24.0f, 8.0f, 8.0f, 24.0f, RED);
+	DrawTriangle(rasterizer, 24.0f, 8.0f, 24.0f, 24.0f, 8.0f, 24.0f, GREEN);
+	rasterizer.Flush();
+	// Ίp̏̉f̒S̓gbvtg[łǂ炩`
+	CHECK(DrawnPixels(rasterizer) == 256);
+	CHECK(CountPixels(rasterizer, RED) + CountPixels(rasterizer, GREEN) == 256);
+	CHECK(Pixel(rasterizer, 8, 8) == RED);
+	CHECK(Pixel(rasterizer, 23, 23) == GREEN);
+	CHECK(Pixel(rasterizer, 7, 8) == BLACK && Pixel(rasterizer, 8, 7) == BLACK);
+	CHECK(Pixel(rasterizer, 24, 23) == BLACK && Pixel(rasterizer, 23, 24) == BLACK);
+
+	// łf`
+	Begin(rasterizer);
+	DrawTriangle(rasterizer, 8.0f, 8.0f, 8.0f, 24.0f, 24.0f, 8.0f, RED);
+	DrawTriangle(rasterizer, 24.0f, 8.0f, 8.0f, 24.0f, 24.0f, 24.0f, GREEN);
+	rasterizer.Flush();
+	CHECK(DrawnPixels(rasterizer) == 256);
+
+	// ^C̋ځi64j܂`dȂȂ
+	Begin(rasterizer);
+	DrawTriangle(rasterizer, 54.0f, 54.0f, 74.0f, 54.0f, 54.0f, 74.0f, RED);
+	DrawTriangle(rasterizer, 74.0f, 54.0f, 74.0f, 74.0f, 54.0f, 74.0f, RED);
+	rasterizer.Flush();
+	CHECK(DrawnPixels(rasterizer) == 400);
+	CHECK(CountPixels(rasterizer, RED) == 400);
+	CHECK(Pixel(rasterizer, 63, 63) == RED && Pixel(rasterizer, 64, 64) == RED && Pixel(rasterizer, 73, 73) == RED);
+
+	// ʂ͂ݏoOp`͉ʂ̒`
+	Begin(rasterizer);
+	DrawTriangle(rasterizer, -1e6f, -1e6f, 3e6f, -1e6f, -1e6f, 3e6f, RED);
+	rasterizer.Flush();
+	CHECK(CountPixels(rasterizer, RED) == 128 * 128);
+
+	// ʐς̖Op`NaN͕`Ȃ
+	Begin(rasterizer);
+	DrawTriangle(rasterizer, 0.0f, 0.0f, 50.0f, 50.0f, 100.0f, 100.0f, RED);
+	DrawTriangle(rasterizer, std::numeric_limits<float>::quiet_NaN(), 0.0f, 50.0f, 0.0f, 0.0f, 50.0f, RED);
+	rasterizer.Flush();
+	CHECK(DrawnPixels(rasterizer) == 0);
+}
+
+TEST(SoftwareRasterizerLines) {
+	SoftwareRasterizer rasterizer(128, 128, 2);
+
+	// ̐͗[̉f܂
+	Begin(rasterizer);
+	DrawLine(rasterizer, 2.5f, 3.5f, 12.5f, 3.5f, RED);
+	rasterizer.Flush();
+	std::vector<std::pair<int, int>> expected;
+	for (int x = 2; x <= 12; x++) {
+		expected.push_back({ x, 3 });
+	}
+	CHECK(PixelsAre(rasterizer, RED, expected));
+
+	// 45x̐ƁAX1/2̐i͎ľܓ̈ʒuj
+	Begin(rasterizer);
+	DrawLine(rasterizer, 0.5f, 0.5f, 9.5f, 9.5f, RED);
+	DrawLine(rasterizer, 20.5f, 10.5f, 30.5f, 15.5f, GREEN);
+	rasterizer.Flush();
+	expected.clear();
+	for (int i = 0; i <= 9; i++) {
+		expected.push_back({ i, i });
+	}
+	CHECK(PixelsAre(rasterizer, RED, expected));
+	expected = { { 20, 10 }, { 21, 11 }, { 22, 11 }, { 23, 12 }, { 24, 12 }, { 25, 13 }, { 26, 13 }, { 27, 14 }, { 28, 14 }, { 29, 15 }, { 30, 15 } };
+	CHECK(PixelsAre(rasterizer, GREEN, expected));
+
+	// cŋt̐厲̉fƂ1
+	Begin(rasterizer);
+	DrawLine(rasterizer, 40.5f, 100.5f, 37.5f, 10.5f, RED);
+	rasterizer.Flush();
+	CHECK(DrawnPixels(rasterizer) == 91);
+	CHECK(Pixel(rasterizer, 40, 100) == RED && Pixel(rasterizer, 37, 10) == RED);
+
+	// ^Čpڂœr؂ꂽ肸ꂽ肵Ȃ
+	Begin(rasterizer);
+	DrawLine(rasterizer, 0.5f, 0.5f, 127.5f, 127.5f, RED);
+	DrawLine(rasterizer, 127.5f, 0.5f, 0.5f, 63.5f, GREEN);
+	rasterizer.Flush();
+	CHECK(DrawnPixels(rasterizer) == 256);
+	bool continuous = true;
+	int previousY = 0;
+	for (int x = 127; x >= 0; x--) {
+		int found = -1;
+		for (int y = 0; y < 128; y++) {
+			if (Pixel(rasterizer, x, y) == GREEN) {
+				found = y;
+			}
+		}
+		if (found < 0 || found < previousY || found > previousY + 1) {
+			continuous = false;
+		}
+		previousY = found;
+	}
+	CHECK(continuous);
+}
+
+TEST(SoftwareRasterizerClipsLongLines) {
+	SoftwareRasterizer rasterizer(200, 200, 2);
+
+	// ʂ肸ƒAʂ̒̉f1Ƃɕ`
+	const float lengths[] = { 1e4f, 1e8f, 1e10f, 1e30f, 3e38f };
+	for (float length : lengths) {
+		Begin(rasterizer);
+		DrawLine(rasterizer, -length, 100.5f, length, 100.5f, RED);
+		DrawLine(rasterizer, 50.5f, length, 50.5f, -length, GREEN);
+		rasterizer.Flush();
+		CHECK(DrawnPixels(rasterizer) == 400);
+		CHECK(Pixel(rasterizer, 0, 100) == RED && Pixel(rasterizer, 199, 100) == RED);
+		CHECK(Pixel(rasterizer, 50, 0) == GREEN && Pixel(rasterizer, 50, 199) == GREEN);
+
+		// Ίp
+		Begin(rasterizer);
+		DrawLine(rasterizer, -length, -length, length, length, RED);
+		rasterizer.Flush();
+		uint64_t pixels = DrawnPixels(rasterizer);
+		if (length <= 1e10f) {
+			// _̕ϊ̌덷Œ[1f邱Ƃ͂邪A厲̉f͑S`
+			bool nearDiagonal = true;
+			for (int y = 0; y < 200; y++) {
+				for (int x = 0; x < 200; x++) {
+					if (Pixel(rasterizer, x, y) == RED && std::abs(x - y) > 1) {
+						nearDiagonal = false;
+					}
+				}
+			}
+			CHECK(pixels == 200);
+			CHECK(CountPixels(rasterizer, RED) == 200);
+			CHECK(nearDiagonal);
+		}
+		else {
+			// ؂ʒǔ덷͑傫Aʂ̊Oɂ͕`A厲̉f̐𒴂Ȃ
+			CHECK(pixels <= 201);
+		}
+	}
+
+	// ʂɊ|ȂEENaN͕`Ȃ
+	Begin(rasterizer);
+	DrawLine(rasterizer, -1e30f, -5.0f, 1e30f, -5.0f, RED);
+	DrawLine(rasterizer, -INFINITY, 10.5f, INFINITY, 10.5f, RED);
+	DrawLine(rasterizer, std::numeric_limits<float>::quiet_NaN(), 10.5f, 20.0f, 10.5f, RED);
+	rasterizer.Flush();
+	CHECK(DrawnPixels(rasterizer) == 0);
+}
+
+BENCHMARK(SoftwareRasterizerThroughput) {
+	const int width = 1280;
+	const int height = 720;
+	const int frames = 20;
+
+	// ȎOp`𑽂Aʂ𕢂傫ȎOp`A𑽂`
+	Test::Random random(3);
+	std::vector<float> small(20000 * 2), lines(20000 * 4);
+	for (size_t i = 0; i < small.size(); i += 2) {
+		small[i] = (float)random.Next(width);
+		small[i + 1] = (float)random.Next(height);
+	}
+	for (size_t i = 0; i < lines.size(); i += 4) {
+		lines[i] = (float)random.Next(width);
+		lines[i + 1] = (float)random.Next(height);
+		lines[i + 2] = (float)random.Next(width);
+		lines[i + 3] = (float)random.Next(height);
+	}
+
+	std::printf("  %dx%d, %d frames\n", width, height, frames);
+	std::printf("  threads  ms/frame  Mpixels/s  primitives/frame\n");
+	for (int threads : { 1, 2, 4, 8 }) {
+		SoftwareRasterizer rasterizer(width, height, threads);
+		double start = Test::Now();
+		for (int frame = 0; frame < frames; frame++) {
+			rasterizer.Clear(0.0f, 0.0f, 0.0f, 1.0f);
+			for (int i = 0; i < 8; i++) {
+				DrawTriangle(rasterizer, -100.0f, -100.0f, (float)width * 2.0f, -100.0f, -100.0f, (float)height * 2.0f, RED + i);
+			}
+			for (size_t i = 0; i < small.size(); i += 2) {
+				DrawTriangle(rasterizer, small[i], small[i + 1], small[i] + 12.0f, small[i + 1], small[i], small[i + 1] + 12.0f, GREEN);
+			}
+			for (size_t i = 0; i < lines.size(); i += 4) {
+				DrawLine(rasterizer, lines[i], lines[i + 1], lines[i + 2], lines[i + 3], RED);
+			}
+			rasterizer.Flush();
+		}
+		double seconds = (Test::Now() - start) / frames;
+
+		RasterStatistics statistics = rasterizer.GetStatistics();
+		std::printf("  %7d  %8.2f  %9.1f  %16llu\n", threads, seconds * 1e3,
+			(double)statistics.pixels / frames / seconds / 1e6, (unsigned long long)((statistics.triangles + statistics.lines) / frames));
+	}
+}
@@ -0,0 +1,316 @@
+#include "Test.h"
+#include "HashedGrid.h"
+#include "LooseQuadtree.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace {
+	typedef SpatialIndex::Box Box;
+
+	// Ŝ̕𖈉񒲂ׂ邾̎B֐ĝŁAʂ͑̎ƈv͂
+	class BruteForceIndex : public SpatialIndex
+	{
+	protected:
+		void Link(uint32_t id) override { objects[id].cell = 0; }
+		void Unlink(uint32_t) override {}
+		void Relink(uint32_t) override {}
+		void Gather(const Box& box, std::vector<uint32_t>& result) override {
+			for (uint32_t id = 0; id < objects.size(); id++) {
+				if (objects[id].cell != INVALID_ID && Overlaps(objects[id].box, box)) {
+					result.push_back(id);
+				}
+			}
+		}
+		void GatherRay(const Ray2D& ray, std::vector<RayHit>& result) override {
+			for (uint32_t id = 0; id < objects.size(); id++) {
+				float distance;
+				if (objects[id].cell != INVALID_ID && IntersectRay(ray, objects[id].box, distance)) {
+					result.push_back({ id, distance });
+				}
+			}
+		}
+	};
+
+	const float WORLD = 1000.0f;
+	const float NOT_A_NUMBER = std::numeric_limits<float>::quiet_NaN();
+
+	float RandomFloat(Test::Random& random, float minimum, float maximum) {
+		return minimum + (maximum - minimum) * ((float)random.Next() / 4294967296.0f);
+	}
+
+	// ͐E̒̏ȔAX傫ȔEE̊O̔ENaN܂ޔ
+	Box RandomBox(Test::Random& random) {
+		switch (random.Next(40)) {
+		case 0:
+			return { -FLT_MAX, -FLT_MAX, FLT_MAX, FLT_MAX };
+		case 1:
+			return { -INFINITY, 0.0f, INFINITY, 1.0f };
+		case 2:
+			return { NOT_A_NUMBER, 0.0f, 1.0f, 1.0f };
+		case 3:
+			return { 0.0f, NOT_A_NUMBER, NOT_A_NUMBER, 1.0f };
+		case 4: {
+			// ÊƊOɂ鏬Ȕ
+			float x = random.Next(2) == 0 ? -1e30f : 3e38f;
+			return { x, x, x, x };
+		}
+		case 5: {
+			float x = RandomFloat(random, -1e9f, 1e9f);
+			float y = RandomFloat(random, -1e9f, 1e9f);
+			return { x, y, x + 10.0f, y + 10.0f };
+		}
+		case 6:
+		case 7: {
+			float x = RandomFloat(random, -2.0f * WORLD, 2.0f * WORLD);
+			float y = RandomFloat(random, -2.0f * WORLD, 2.0f * WORLD);
+			return { x, y, x + RandomFloat(random, 0.0f, WORLD), y + RandomFloat(random, 0.0f, WORLD) };
+		}
+		default: {
+			float x = RandomFloat(random, -1.2f * WORLD, 1.2f * WORLD);
+			float y = RandomFloat(random, -1.2f * WORLD, 1.2f * WORLD);
+			return { x, y, x + RandomFloat(random, 0.0f, 40.0f), y + RandomFloat(random, 0.0f, 40.0f) };
+		}
+		}
+	}
+
+	DirectX::SimpleMath::Ray RandomRay(Test::Random& random, float& maxDistance) {
+		using DirectX::SimpleMath::Vector3;
+		float x = RandomFloat(random, -1.5f * WORLD, 1.5f * WORLD);
+		float y = RandomFloat(random, -1.5f * WORLD, 1.5f * WORLD);
+		float angle = RandomFloat(random, 0.0f, 6.2831853f);
+		Vector3 direction(std::cos(angle), std::sin(angle), 0.0f);
+		switch (random.Next(8)) {
+		case 0:
+			// ʂ̉ɌC
+			direction = Vector3(0.0f, 0.0f, 1.0f);
+			break;
+		case 1:
+			direction = Vector3(random.Next(2) == 0 ? 1.0f : -1.0f, 0.0f, 0.0f);
+			break;
+		case 2:
+			direction = Vector3(0.0f, random.Next(2) == 0 ? 1.0f : -1.0f, 0.0f);
+			break;
+		}
+		maxDistance = random.Next(4) == 0 ? FLT_MAX : RandomFloat(random, 0.0f, 3.0f * WORLD);
+		return DirectX::SimpleMath::Ray(Vector3(x, y, 0.0f), direction);
+	}
+
+	bool SameHits(const std::vector<SpatialIndex::RayHit>& a, const std::vector<SpatialIndex::RayHit>& b) {
+		if (a.size() != b.size()) {
+			return false;
+		}
+		for (size_t i = 0; i < a.size(); i++) {
+			if (a[i].id != b[i].id || a[i].distance != b[i].distance) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	std::vector<uint32_t> SortedBox(SpatialIndex& index, const Box& box) {
+		std::vector<uint32_t> result;
+		index.QueryBox(box, result);
+		std::sort(result.begin(), result.end());
+		return result;
+	}
+
+	std::vector<uint32_t> SortedPoint(SpatialIndex& index, float x, float y) {
+		std::vector<uint32_t> result;
+		index.QueryPoint(x, y, result);
+		std::sort(result.begin(), result.end());
+		return result;
+	}
+}
+
+TEST(SpatialIndexMatchesBruteForce) {
+	// ɓo^EړE폜ΔԍɂȂ̂ŁAʂ̂܂ܔׂ
+	std::unique_ptr<SpatialIndex> indices[] = {
+		std::make_unique<LooseQuadtree>(Box{ -WORLD, -WORLD, WORLD, WORLD }, 6),
+		std::make_unique<HashedGrid>(32.0f),
+	};
+	BruteForceIndex reference;
+
+	Test::Random random(17);
+	std::vector<uint32_t> live;
+	for (int i = 0; i < 2000; i++) {
+		Box box = RandomBox(random);
+		uint32_t id = reference.Insert(box, nullptr);
+		for (auto& index : indices) {
+			CHECK(index->Insert(box, nullptr) == id);
+		}
+		live.push_back(id);
+	}
+
+	int mismatches = 0;
+	for (int round = 0; round < 40; round++) {
+		for (int i = 0; i < 200; i++) {
+			uint32_t at = random.Next((uint32_t)live.size());
+			if (random.Next(10) == 0) {
+				// ē꒼A󂢂ԍg񂳂悤ɂ
+				reference.Remove(live[at]);
+				for (auto& index : indices) {
+					index->Remove(live[at]);
+				}
+				Box box = RandomBox(random);
+				live[at] = reference.Insert(box, nullptr);
+				for (auto& index : indices) {
+					mismatches += index->Insert(box, nullptr) != live[at];
+				}
+			}
+			else {
+				Box box = RandomBox(random);
+				reference.Move(live[at], box);
+				for (auto& index : indices) {
+					index->Move(live[at], box);
+				}
+			}
+		}
+
+		for (int i = 0; i < 20; i++) {
+			Box box = RandomBox(random);
+			float x = RandomFloat(random, -1.2f * WORLD, 1.2f * WORLD);
+			float y = RandomFloat(random, -1.2f * WORLD, 1.2f * WORLD);
+			float maxDistance;
+			DirectX::SimpleMath::Ray ray = RandomRay(random, maxDistance);
+
+			std::vector<uint32_t> expectedBox = SortedBox(reference, box);
+			std::vector<uint32_t> expectedPoint = SortedPoint(reference, x, y);
+			std::vector<SpatialIndex::RayHit> expectedRay, hits;
+			reference.QueryRay(ray, maxDistance, expectedRay);
+			for (auto& index : indices) {
+				mismatches += SortedBox(*index, box) != expectedBox;
+				mismatches += SortedPoint(*index, x, y) != expectedPoint;
+				index->QueryRay(ray, maxDistance, hits);
+				mismatches += !SameHits(hits, expectedRay);
+			}
+		}
+	}
+	CHECK(mismatches == 0);
+
+	// Ŝ𕢂ׂ͂Ắ̕iNaN܂ނ̂jԂ
+	std::vector<uint32_t> everything = SortedBox(reference, { -FLT_MAX, -FLT_MAX, FLT_MAX, FLT_MAX });
+	CHECK(everything.size() > live.size() / 2);
+	for (auto& index : indices) {
+		CHECK(SortedBox(*index, { -FLT_MAX, -FLT_MAX, FLT_MAX, FLT_MAX }) == everything);
+		CHECK(SortedBox(*index, { -INFINITY, -INFINITY, INFINITY, INFINITY }) == everything);
+		CHECK(SortedBox(*index, { NOT_A_NUMBER, NOT_A_NUMBER, NOT_A_NUMBER, NOT_A_NUMBER }).empty());
+	}
+}
+
+TEST(HashedGridHandlesExtremeBoxes) {
+	// Z̈ʒuint32_tɎ܂Ȃo^Eł
+	HashedGrid grid(1.0f);
+	uint32_t far = grid.Insert({ 3e9f, -3e9f, 3e9f, -3e9f }, nullptr);
+	uint32_t huge = grid.Insert({ -FLT_MAX, -FLT_MAX, FLT_MAX, FLT_MAX }, nullptr);
+	uint32_t nan = grid.Insert({ NOT_A_NUMBER, NOT_A_NUMBER, NOT_A_NUMBER, NOT_A_NUMBER }, nullptr);
+	uint32_t near = grid.Insert({ 0.25f, 0.25f, 0.75f, 0.75f }, nullptr);
+
+	std::vector<uint32_t> result = SortedBox(grid, { -FLT_MAX, -FLT_MAX, FLT_MAX, FLT_MAX });
+	CHECK((result == std::vector<uint32_t>{ far, huge, near }));
+	result = SortedPoint(grid, 3e9f, -3e9f);
+	CHECK((result == std::vector<uint32_t>{ far, huge }));
+	result = SortedPoint(grid, 0.5f, 0.5f);
+	CHECK((result == std::vector<uint32_t>{ huge, near }));
+
+	// ֓Ă߂Ă
+	grid.Move(near, { 1e20f, 1e20f, 1e20f, 1e20f });
+	CHECK((SortedPoint(grid, 1e20f, 1e20f) == std::vector<uint32_t>{ huge, near }));
+	grid.Move(near, { 0.25f, 0.25f, 0.75f, 0.75f });
+	CHECK((SortedPoint(grid, 0.5f, 0.5f) == std::vector<uint32_t>{ huge, near }));
+	grid.Remove(nan);
+	CHECK(grid.GetCount() == 3);
+}
+
+TEST(SpatialIndexQueriesReplaceResult) {
+	// 3̌͂ǂresult̑O̓eĂ
+	HashedGrid grid(16.0f);
+	uint32_t id = grid.Insert({ 0.0f, 0.0f, 8.0f, 8.0f }, nullptr);
+
+	std::vector<uint32_t> result = { 100, 200 };
+	grid.QueryBox({ -1.0f, -1.0f, 1.0f, 1.0f }, result);
+	CHECK((result == std::vector<uint32_t>{ id }));
+	result = { 100, 200 };
+	grid.QueryPoint(4.0f, 4.0f, result);
+	CHECK((result == std::vector<uint32_t>{ id }));
+	grid.QueryPoint(40.0f, 40.0f, result);
+	CHECK(result.empty());
+
+	std::vector<SpatialIndex::RayHit> hits = { { 100, 0.0f } };
+	using DirectX::SimpleMath::Vector3;
+	grid.QueryRay(DirectX::SimpleMath::Ray(Vector3(-10.0f, 4.0f, 0.0f), Vector3(1.0f, 0.0f, 0.0f)), 100.0f, hits);
+	CHECK(hits.size() == 1 && hits[0].id == id && hits[0].distance == 10.0f);
+}
+
+BENCHMARK(SpatialIndexMovingObjects) {
+	// 100̂̂̕1𖈃t[Aʂقǂ͈̔͂
+	const uint32_t objectCount = 1000000;
+	const uint32_t movingCount = objectCount / 10;
+	const float worldSize = 50000.0f;
+	const int frames = 10;
+	const int queriesPerFrame = 100;
+
+	std::printf("  %u objects, %u moving per frame, %d frames\n", objectCount, movingCount, frames);
+	std::printf("  index          insert ms  move ms/frame  relinks/frame  query us  found/query  tested/query\n");
+	for (int backend = 0; backend < 2; backend++) {
+		std::unique_ptr<SpatialIndex> index;
+		if (backend == 0) {
+			index = std::make_unique<LooseQuadtree>(Box{ 0.0f, 0.0f, worldSize, worldSize }, 10);
+		}
+		else {
+			index = std::make_unique<HashedGrid>(64.0f);
+		}
+
+		Test::Random random(5);
+		std::vector<Box> boxes(objectCount);
+		for (auto& box : boxes) {
+			float x = RandomFloat(random, 0.0f, worldSize);
+			float y = RandomFloat(random, 0.0f, worldSize);
+			float size = RandomFloat(random, 4.0f, 48.0f);
+			box = { x, y, x + size, y + size };
+		}
+
+		double start = Test::Now();
+		for (auto& box : boxes) {
+			index->Insert(box, nullptr);
+		}
+		double insertSeconds = Test::Now() - start;
+
+		index->ResetStatistics();
+		double moveSeconds = 0.0;
+		double querySeconds = 0.0;
+		uint64_t found = 0;
+		std::vector<uint32_t> result;
+		for (int frame = 0; frame < frames; frame++) {
+			start = Test::Now();
+			for (uint32_t i = 0; i < movingCount; i++) {
+				uint32_t id = random.Next(objectCount);
+				float dx = RandomFloat(random, -8.0f, 8.0f);
+				float dy = RandomFloat(random, -8.0f, 8.0f);
+				Box& box = boxes[id];
+				box = { box.minX + dx, box.minY + dy, box.maxX + dx, box.maxY + dy };
+				index->Move(id, box);
+			}
+			moveSeconds += Test::Now() - start;
+
+			start = Test::Now();
+			for (int i = 0; i < queriesPerFrame; i++) {
+				float x = RandomFloat(random, 0.0f, worldSize - 1920.0f);
+				float y = RandomFloat(random, 0.0f, worldSize - 1080.0f);
+				index->QueryBox({ x, y, x + 1920.0f, y + 1080.0f }, result);
+				found += result.size();
+			}
+			querySeconds += Test::Now() - start;
+		}
+
+		SpatialIndex::Statistics statistics = index->GetStatistics();
+		uint64_t queries = (uint64_t)frames * queriesPerFrame;
+		std::printf("  %-13s  %9.1f  %13.2f  %13.0f  %8.1f  %11.0f  %12.0f\n", backend == 0 ? "LooseQuadtree" : "HashedGrid",
+			insertSeconds * 1e3, moveSeconds / frames * 1e3, (double)statistics.relinks / frames,
+			querySeconds / queries * 1e6, (double)found / queries, (double)statistics.tested / queries);
+	}
+}
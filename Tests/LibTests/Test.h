@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+
+// foCXgȂNX̒P̃eXgƃx`}[N
+// TESTBENCHMARKŊ֐o^Amain܂Ƃ߂ČĂԁBCHECK͎sĂAŌɎs̐Ԃ
+namespace Test {
+	typedef void (*Function)();
+
+	int RegisterTest(const char* name, Function function);
+	int RegisterBenchmark(const char* name, Function function);
+	void Fail(const char* file, int line, const char* expression);
+
+	/// <summary>
+	/// oߎԁibj
+	/// </summary>
+	double Now();
+
+	/// <summary>
+	/// Čł闐ixorshiftj
+	/// </summary>
+	class Random
+	{
+	private:
+		uint64_t state;
+
+	public:
+		Random(uint64_t seed) { state = seed * 0x9e3779b97f4a7c15ull + 1; }
+
+		uint32_t Next() {
+			state ^= state << 13;
+			state ^= state >> 7;
+			state ^= state << 17;
+			return (uint32_t)(state >> 32);
+		}
+		uint32_t Next(uint32_t range) { return (uint32_t)(((uint64_t)Next() * range) >> 32); }
+	};
+}
+
+#define TEST(name) \
+	static void name(); \
+	static int name##Registered = Test::RegisterTest(#name, name); \
+	static void name()
+
+#define BENCHMARK(name) \
+	static void name(); \
+	static int name##Registered = Test::RegisterBenchmark(#name, name); \
+	static void name()
+
+#define CHECK(expression) \
+	do { \
+		if (!(expression)) { \
+			Test::Fail(__FILE__, __LINE__, #expression); \
+		} \
+	} while (0)
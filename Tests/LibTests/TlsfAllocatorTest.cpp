@@ -0,0 +1,241 @@
+#include "Test.h"
+#include "TlsfAllocator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace {
+	// mۂƉ̋L^BResourceAllocatorƓA̓t[̃tFXŒx点
+	enum class TraceAction {
+		ALLOCATE,
+		FREE,
+		END_FRAME
+	};
+
+	typedef struct TraceEvent {
+		TraceAction action;
+		uint32_t id;
+		uint64_t size;
+		uint64_t alignment;
+	};
+
+	typedef struct TraceProfile {
+		const char* name;
+		uint64_t minSize;
+		uint64_t maxSize;
+		uint64_t alignment;
+		uint32_t allocationsPerFrame;
+		uint32_t maxLifetime;		// t[
+	};
+
+	// 傫͑ΐňlɑIԁîA傫̂Ȃj
+	const TraceProfile PROFILES[] = {
+		{ "buffers", 256, 64 * 1024, 256, 64, 4 },
+		{ "textures", 4 * 1024, 4 * 1024 * 1024, 64 * 1024, 4, 120 },
+		{ "mixed", 256, 2 * 1024 * 1024, 4 * 1024, 24, 30 },
+	};
+
+	const uint32_t FRAMES_IN_FLIGHT = 2;
+
+	std::vector<TraceEvent> MakeTrace(const TraceProfile& profile, uint32_t frames, uint64_t seed) {
+		Test::Random random(seed);
+		std::vector<TraceEvent> trace;
+		std::vector<std::vector<uint32_t>> expiring(frames + profile.maxLifetime + 1);
+		uint32_t nextId = 0;
+
+		double logMin = std::log((double)profile.minSize);
+		double logMax = std::log((double)profile.maxSize);
+		for (uint32_t frame = 0; frame < frames; frame++) {
+			for (uint32_t i = 0; i < profile.allocationsPerFrame; i++) {
+				double t = (double)random.Next() / 4294967296.0;
+				uint64_t size = (uint64_t)std::exp(logMin + (logMax - logMin) * t);
+				uint64_t alignment = random.Next(4) == 0 ? profile.alignment : 1;
+				trace.push_back({ TraceAction::ALLOCATE, nextId, size, alignment });
+				expiring[frame + 1 + random.Next(profile.maxLifetime)].push_back(nextId);
+				nextId++;
+			}
+			for (uint32_t id : expiring[frame]) {
+				trace.push_back({ TraceAction::FREE, id, 0, 0 });
+			}
+			trace.push_back({ TraceAction::END_FRAME, 0, 0, 0 });
+		}
+		return trace;
+	}
+
+	typedef struct ReplayResult {
+		uint64_t operations;
+		uint64_t failures;
+		uint64_t peakAllocated;
+		float peakFragmentation;
+		bool valid;
+	};
+
+	// gp͈̔͂eʂ̒ɂAĂāA݂ɏdȂȂ
+	bool CheckAllocations(TlsfAllocator& allocator, const std::vector<TlsfAllocator::Allocation>& live, const std::vector<uint64_t>& alignments) {
+		std::vector<std::pair<uint64_t, uint64_t>> ranges;
+		uint64_t total = 0;
+		for (size_t id = 0; id < live.size(); id++) {
+			const TlsfAllocator::Allocation& allocation = live[id];
+			if (allocation.offset == TlsfAllocator::INVALID_OFFSET) {
+				continue;
+			}
+			if (allocation.offset % alignments[id] != 0 || allocation.offset + allocation.size > allocator.GetCapacity()) {
+				return false;
+			}
+			ranges.push_back({ allocation.offset, allocation.offset + allocation.size });
+			total += allocation.size;
+		}
+
+		std::sort(ranges.begin(), ranges.end());
+		for (size_t i = 1; i < ranges.size(); i++) {
+			if (ranges[i].first < ranges[i - 1].second) {
+				return false;
+			}
+		}
+		return total == allocator.GetAllocated();
+	}
+
+	// checkEvery0Ȃm߂ɑ𑪂
+	ReplayResult Replay(TlsfAllocator& allocator, const std::vector<TraceEvent>& trace, uint32_t checkEvery) {
+		ReplayResult result = {};
+		result.valid = true;
+
+		std::vector<TlsfAllocator::Allocation> live;
+		std::vector<uint64_t> alignments;
+		uint64_t frame = 0;
+		for (auto& event : trace) {
+			switch (event.action) {
+			case TraceAction::ALLOCATE:
+				if (live.size() <= event.id) {
+					live.resize(event.id + 1, { TlsfAllocator::INVALID_OFFSET, 0, 0 });
+					alignments.resize(event.id + 1, 1);
+				}
+				live[event.id] = allocator.Allocate(event.size, event.alignment);
+				alignments[event.id] = event.alignment;
+				if (live[event.id].offset == TlsfAllocator::INVALID_OFFSET) {
+					result.failures++;
+				}
+				else if (live[event.id].size < event.size) {
+					result.valid = false;
+				}
+				break;
+			case TraceAction::FREE:
+				// x点ĂԂ͈͎͂gpȂ̂ŁAm߂Ώۂ͉`_ŊO
+				allocator.Free(live[event.id], frame);
+				live[event.id].offset = TlsfAllocator::INVALID_OFFSET;
+				break;
+			case TraceAction::END_FRAME:
+				frame++;
+				if (frame > FRAMES_IN_FLIGHT) {
+					allocator.Reclaim(frame - FRAMES_IN_FLIGHT);
+				}
+				result.peakAllocated = std::max(result.peakAllocated, allocator.GetAllocated());
+				result.peakFragmentation = std::max(result.peakFragmentation, allocator.GetFragmentation());
+				break;
+			}
+			result.operations++;
+
+			if (checkEvery != 0 && result.operations % checkEvery == 0) {
+				// ҂̕gpɐĂ̂ŁAĔׂ
+				TlsfAllocator::Statistics statistics = allocator.GetStatistics();
+				uint64_t total = 0;
+				for (auto& allocation : live) {
+					if (allocation.offset != TlsfAllocator::INVALID_OFFSET) {
+						total += allocation.size;
+					}
+				}
+				if (total != statistics.allocated - statistics.pending || statistics.free != statistics.capacity - statistics.allocated) {
+					result.valid = false;
+				}
+			}
+		}
+
+		// ŌɂׂĕԂ1̋󂫃ubNɖ߂
+		for (auto& allocation : live) {
+			allocator.Free(allocation);
+		}
+		allocator.Reclaim(~0ull);
+		TlsfAllocator::Statistics statistics = allocator.GetStatistics();
+		if (!allocator.IsEmpty() || statistics.freeBlockCount != 1 || statistics.largestFreeBlock != allocator.GetCapacity()) {
+			result.valid = false;
+		}
+		return result;
+	}
+}
+
+TEST(TlsfAllocatorTracesKeepRangesDisjoint) {
+	// x点ɋL^𗬂A񂷂ׂĂ͈̔͂m߂
+	for (auto& profile : PROFILES) {
+		for (uint64_t seed = 1; seed <= 3; seed++) {
+			std::vector<TraceEvent> trace = MakeTrace(profile, 60, seed);
+			TlsfAllocator allocator(64 * 1024 * 1024);
+
+			std::vector<TlsfAllocator::Allocation> live;
+			std::vector<uint64_t> alignments;
+			bool valid = true;
+			for (auto& event : trace) {
+				if (event.action == TraceAction::ALLOCATE) {
+					live.resize(std::max(live.size(), (size_t)event.id + 1), { TlsfAllocator::INVALID_OFFSET, 0, 0 });
+					alignments.resize(live.size(), 1);
+					live[event.id] = allocator.Allocate(event.size, event.alignment);
+					alignments[event.id] = event.alignment;
+				}
+				else if (event.action == TraceAction::FREE) {
+					allocator.Free(live[event.id]);
+					live[event.id].offset = TlsfAllocator::INVALID_OFFSET;
+				}
+				if (!CheckAllocations(allocator, live, alignments)) {
+					valid = false;
+					break;
+				}
+			}
+			CHECK(valid);
+
+			for (auto& allocation : live) {
+				allocator.Free(allocation);
+			}
+			TlsfAllocator::Statistics statistics = allocator.GetStatistics();
+			CHECK(allocator.IsEmpty());
+			CHECK(statistics.freeBlockCount == 1);
+			CHECK(statistics.largestFreeBlock == allocator.GetCapacity());
+			CHECK(allocator.GetFragmentation() == 0.0f);
+		}
+	}
+}
+
+TEST(TlsfAllocatorTracesWithDeferredFrees) {
+	for (auto& profile : PROFILES) {
+		std::vector<TraceEvent> trace = MakeTrace(profile, 200, 11);
+		TlsfAllocator allocator(256 * 1024 * 1024);
+		ReplayResult result = Replay(allocator, trace, 1);
+		CHECK(result.valid);
+		CHECK(result.failures == 0);
+	}
+}
+
+TEST(TlsfAllocatorTracesUnderPressure) {
+	// ȂeʂŗƎs͂邪AꂸɑSԂ
+	std::vector<TraceEvent> trace = MakeTrace(PROFILES[1], 200, 5);
+	TlsfAllocator allocator(16 * 1024 * 1024);
+	ReplayResult result = Replay(allocator, trace, 16);
+	CHECK(result.valid);
+	CHECK(result.failures > 0);
+	CHECK(allocator.GetStatistics().failures == result.failures);
+}
+
+BENCHMARK(TlsfAllocatorTraceReplay) {
+	std::printf("  profile    events   ns/event  failures  peak MB  peak fragmentation\n");
+	for (auto& profile : PROFILES) {
+		std::vector<TraceEvent> trace = MakeTrace(profile, 2000, 3);
+		TlsfAllocator allocator(256 * 1024 * 1024);
+
+		double start = Test::Now();
+		ReplayResult result = Replay(allocator, trace, 0);
+		double seconds = Test::Now() - start;
+
+		std::printf("  %-9s %7llu  %8.1f  %8llu  %7.1f  %.3f\n", profile.name,
+			(unsigned long long)result.operations, seconds / (double)result.operations * 1e9,
+			(unsigned long long)result.failures, (double)result.peakAllocated / (1024.0 * 1024.0), result.peakFragmentation);
+	}
+}
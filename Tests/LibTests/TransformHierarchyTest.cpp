@@ -0,0 +1,284 @@
+#include "Test.h"
+#include "TransformHierarchy.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <vector>
+
+using namespace DirectX;
+
+namespace {
+	float RandomFloat(Test::Random& random) {
+		return (float)((double)random.Next() / 4294967296.0);
+	}
+
+	// eq֌WfɎA񍪂|ċ߂ʂ
+	typedef struct ReferenceNode {
+		bool alive;
+		uint32_t parent;
+		XMFLOAT3 position;
+		XMFLOAT3 rotation;
+		XMFLOAT3 scale;
+	};
+
+	class ReferenceHierarchy
+	{
+	public:
+		TransformHierarchy hierarchy;
+		std::vector<ReferenceNode> nodes;
+		std::vector<uint32_t> live;
+		Test::Random random;
+
+		ReferenceHierarchy(uint64_t seed) : random(seed) {}
+
+		uint32_t RandomLive() {
+			return live[random.Next((uint32_t)live.size())];
+		}
+
+		uint32_t Create() {
+			uint32_t parent = live.empty() || random.Next(8) == 0 ? TransformHierarchy::INVALID_NODE : RandomLive();
+			uint32_t id = hierarchy.Create(parent);
+			if (id >= nodes.size()) {
+				nodes.resize(id + 1);
+			}
+			// ԍ͍폜m[ĥ̂gƂ
+			CHECK(!nodes[id].alive);
+			nodes[id] = { true, parent, { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f }, { 1.0f, 1.0f, 1.0f } };
+			live.push_back(id);
+			return id;
+		}
+
+		bool IsAncestor(uint32_t ancestor, uint32_t node) {
+			for (uint32_t p = node; p != TransformHierarchy::INVALID_NODE; p = nodes[p].parent) {
+				if (p == ancestor) {
+					return true;
+				}
+			}
+			return false;
+		}
+
+		void SetParent(uint32_t node, uint32_t parent) {
+			hierarchy.SetParent(node, parent);
+			// ̎qeɂꍇ͖
+			if (parent == TransformHierarchy::INVALID_NODE || !IsAncestor(node, parent)) {
+				nodes[node].parent = parent;
+			}
+		}
+
+		// qƏ̂ŁAʂ̏̕ŏ
+		void Destroy(uint32_t node) {
+			hierarchy.Destroy(node);
+			std::vector<uint32_t> survivors;
+			for (uint32_t id : live) {
+				if (IsAncestor(node, id)) {
+					nodes[id].alive = false;
+				}
+				else {
+					survivors.push_back(id);
+				}
+			}
+			live = std::move(survivors);
+		}
+
+		void Move(uint32_t node) {
+			XMFLOAT3 position(RandomFloat(random) * 20.0f - 10.0f, RandomFloat(random) * 20.0f - 10.0f, 0.0f);
+			hierarchy.SetPosition(node, position);
+			nodes[node].position = position;
+
+			// Z̉]ɂāAUpdate̋ߓʂ
+			uint32_t kind = random.Next(4);
+			if (kind == 0) {
+				XMFLOAT3 rotation(0.0f, 0.0f, RandomFloat(random) * 6.28f);
+				hierarchy.SetRotation(node, rotation);
+				nodes[node].rotation = rotation;
+			}
+			else if (kind == 1) {
+				XMFLOAT3 rotation(RandomFloat(random) * 0.5f, RandomFloat(random) * 0.5f, RandomFloat(random) * 6.28f);
+				hierarchy.SetRotation(node, rotation);
+				nodes[node].rotation = rotation;
+			}
+			else if (kind == 2) {
+				XMFLOAT3 scale(0.5f + RandomFloat(random), 0.5f + RandomFloat(random), 1.0f);
+				hierarchy.SetScale(node, scale);
+				nodes[node].scale = scale;
+			}
+		}
+
+		XMMATRIX World(uint32_t node) {
+			const ReferenceNode& reference = nodes[node];
+			XMMATRIX local = XMMatrixScaling(reference.scale.x, reference.scale.y, reference.scale.z) *
+				XMMatrixRotationX(reference.rotation.x) * XMMatrixRotationY(reference.rotation.y) * XMMatrixRotationZ(reference.rotation.z) *
+				XMMatrixTranslation(reference.position.x, reference.position.y, reference.position.z);
+			return reference.parent == TransformHierarchy::INVALID_NODE ? local : local * World(reference.parent);
+		}
+
+		// [hsƐeAm[hׂ̐Ďʂƈv邩
+		bool Matches() {
+			if (hierarchy.GetNodeCount() != live.size()) {
+				return false;
+			}
+			for (uint32_t id : live) {
+				if (hierarchy.GetParent(id) != nodes[id].parent) {
+					return false;
+				}
+				XMFLOAT4X4 expected, actual;
+				XMStoreFloat4x4(&expected, World(id));
+				XMStoreFloat4x4(&actual, hierarchy.GetWorldMatrix(id));
+				for (int row = 0; row < 4; row++) {
+					for (int column = 0; column < 4; column++) {
+						float e = expected.m[row][column];
+						if (std::fabs(e - actual.m[row][column]) > 1e-3f * (1.0f + std::fabs(e))) {
+							return false;
+						}
+					}
+				}
+			}
+			return true;
+		}
+	};
+
+	// q̐branching̖؂𕝗D̏ɍibranching0Ȃ炷ׂčjB[Ԃ
+	uint32_t BuildTree(TransformHierarchy& hierarchy, uint32_t count, uint32_t branching) {
+		std::vector<uint32_t> depths(count);
+		uint32_t maxDepth = 0;
+		for (uint32_t i = 0; i < count; i++) {
+			uint32_t parent = branching == 0 || i == 0 ? TransformHierarchy::INVALID_NODE : (i - 1) / branching;
+			hierarchy.Create(parent);
+			depths[i] = parent == TransformHierarchy::INVALID_NODE ? 1 : depths[parent] + 1;
+			maxDepth = std::max(maxDepth, depths[i]);
+		}
+		return maxDepth;
+	}
+}
+
+TEST(TransformHierarchyRandomEditsMatchReference) {
+	ReferenceHierarchy reference(3);
+	for (int i = 0; i < 200; i++) {
+		reference.Move(reference.Create());
+	}
+
+	bool matches = true;
+	bool quiet = true;
+	for (int frame = 0; frame < 200 && matches; frame++) {
+		// EEtւEAm[h̔ԍ̎gN
+		uint32_t edits = 1 + reference.random.Next(20);
+		for (uint32_t i = 0; i < edits; i++) {
+			uint32_t action = reference.random.Next(10);
+			if (action < 2 || reference.live.size() < 20) {
+				reference.Move(reference.Create());
+			}
+			else if (action < 6) {
+				reference.Move(reference.RandomLive());
+			}
+			else if (action < 9) {
+				uint32_t parent = reference.random.Next(6) == 0 ? TransformHierarchy::INVALID_NODE : reference.RandomLive();
+				reference.SetParent(reference.RandomLive(), parent);
+			}
+			else {
+				reference.Destroy(reference.RandomLive());
+			}
+		}
+		reference.hierarchy.Update();
+		matches = reference.Matches();
+
+		// ςȂΉvZȂ
+		reference.hierarchy.Update();
+		TransformHierarchy::Statistics statistics = reference.hierarchy.GetStatistics();
+		quiet &= statistics.updated == 0 && statistics.skipped == statistics.nodes;
+	}
+	CHECK(matches);
+	CHECK(quiet);
+	CHECK(reference.hierarchy.GetStatistics().reorders > 0);
+}
+
+TEST(TransformHierarchyUpdatesOnlyChangedSubtrees) {
+	TransformHierarchy hierarchy;
+	uint32_t root = hierarchy.Create();
+	uint32_t left = hierarchy.Create(root);
+	uint32_t leftChild = hierarchy.Create(left);
+	uint32_t right = hierarchy.Create(root);
+	hierarchy.Update();
+	CHECK(hierarchy.GetStatistics().updated == 4);
+
+	// t𓮂ƗtA}𓮂Ƃ̕؂vZ
+	hierarchy.SetPosition(leftChild, XMFLOAT3(1.0f, 0.0f, 0.0f));
+	hierarchy.Update();
+	CHECK(hierarchy.GetStatistics().updated == 1);
+
+	hierarchy.SetPosition(left, XMFLOAT3(0.0f, 2.0f, 0.0f));
+	hierarchy.Update();
+	CHECK(hierarchy.GetStatistics().updated == 2);
+	CHECK(hierarchy.GetStatistics().skipped == 1);
+	XMFLOAT4X4 world;
+	XMStoreFloat4x4(&world, hierarchy.GetWorldMatrix(leftChild));
+	CHECK(world.m[3][0] == 1.0f && world.m[3][1] == 2.0f);
+
+	// tւq͐VeɕtēA؂͐Ȃ
+	hierarchy.SetParent(leftChild, right);
+	hierarchy.SetPosition(right, XMFLOAT3(5.0f, 0.0f, 0.0f));
+	hierarchy.Destroy(left);
+	hierarchy.Update();
+	XMStoreFloat4x4(&world, hierarchy.GetWorldMatrix(leftChild));
+	CHECK(world.m[3][0] == 6.0f && world.m[3][1] == 0.0f);
+	CHECK(hierarchy.GetNodeCount() == 3);
+	CHECK(hierarchy.GetParent(leftChild) == right);
+
+	// ̎qɂ͕tւȂ
+	hierarchy.SetParent(root, leftChild);
+	CHECK(hierarchy.GetParent(root) == TransformHierarchy::INVALID_NODE);
+}
+
+BENCHMARK(TransformHierarchy100kNodes) {
+	const uint32_t NODES = 100000;
+	const int REPEATS = 20;
+	// 0ׂ͂čA11{̍
+	const uint32_t branchings[] = { 0, 316, 18, 4, 2, 1 };
+
+	std::printf("  branching  depth  all moved ms  1%% moved ms  roots moved ms  unchanged ms  1%% reparented ms\n");
+	for (uint32_t branching : branchings) {
+		TransformHierarchy hierarchy;
+		uint32_t depth = BuildTree(hierarchy, NODES, branching);
+		hierarchy.Update();
+		Test::Random random(5);
+
+		auto measure = [&](const std::function<void()>& edit) {
+			double total = 0.0;
+			for (int i = 0; i < REPEATS; i++) {
+				edit();
+				double start = Test::Now();
+				hierarchy.Update();
+				total += Test::Now() - start;
+			}
+			return total / REPEATS * 1000.0;
+		};
+		float offset = 0.0f;
+		double all = measure([&] {
+			offset += 1.0f;
+			for (uint32_t id = 0; id < NODES; id++) {
+				hierarchy.SetPosition(id, XMFLOAT3(offset, 0.0f, 0.0f));
+			}
+		});
+		double some = measure([&] {
+			offset += 1.0f;
+			for (uint32_t i = 0; i < NODES / 100; i++) {
+				hierarchy.SetPosition(random.Next(NODES), XMFLOAT3(offset, 0.0f, 0.0f));
+			}
+		});
+		double roots = measure([&] {
+			offset += 1.0f;
+			hierarchy.SetRotation(0, XMFLOAT3(0.0f, 0.0f, offset));
+		});
+		double unchanged = measure([] {});
+		// tւ͕גɂȂB̎qI񂾏ꍇ͖̂ŁA牓֕tւ
+		double reparented = measure([&] {
+			for (uint32_t i = 0; i < NODES / 100; i++) {
+				uint32_t node = 1 + random.Next(NODES - 1);
+				hierarchy.SetParent(node, random.Next(node));
+			}
+		});
+
+		std::printf("  %9u  %5u  %12.2f  %11.2f  %14.2f  %12.2f  %16.2f\n",
+			branching, depth, all, some, roots, unchanged, reparented);
+	}
+}
@@ -0,0 +1,74 @@
+// foCXgȂNX̒P̃eXg
+// LibTests [Öꕔ]
+//   OɊ܂ޕw肵ꍇ͂̃eXgs
+// LibTests -bench [Öꕔ]
+//   x`}[NsČʂ\
+#include "Test.h"
+
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+	typedef struct Entry {
+		const char* name;
+		Test::Function function;
+	};
+
+	// o^͐ÓI̒ōŝŁA֐̒̐ÓIϐɒu
+	std::vector<Entry>& Tests() {
+		static std::vector<Entry> tests;
+		return tests;
+	}
+
+	std::vector<Entry>& Benchmarks() {
+		static std::vector<Entry> benchmarks;
+		return benchmarks;
+	}
+
+	int failures = 0;
+}
+
+int Test::RegisterTest(const char* name, Function function) {
+	Tests().push_back({ name, function });
+	return 0;
+}
+
+int Test::RegisterBenchmark(const char* name, Function function) {
+	Benchmarks().push_back({ name, function });
+	return 0;
+}
+
+void Test::Fail(const char* file, int line, const char* expression) {
+	std::printf("  %s(%d): CHECK(%s) failed\n", file, line, expression);
+	failures++;
+}
+
+double Test::Now() {
+	return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+int main(int argc, char* argv[]) {
+	bool bench = argc > 1 && std::strcmp(argv[1], "-bench") == 0;
+	const char* filter = argc > (bench ? 2 : 1) ? argv[bench ? 2 : 1] : nullptr;
+
+	int run = 0;
+	int failed = 0;
+	for (auto& entry : bench ? Benchmarks() : Tests()) {
+		if (filter != nullptr && std::strstr(entry.name, filter) == nullptr) {
+			continue;
+		}
+
+		int before = failures;
+		std::printf("%s\n", entry.name);
+		entry.function();
+		run++;
+		if (failures != before) {
+			failed++;
+		}
+	}
+
+	std::printf("%d run, %d failed\n", run, failed);
+	return failed == 0 ? 0 : 1;
+}
@@ -1,22 +1,33 @@
 #include "Text.h"
+#include "DescriptorAllocator.h"
 #include "Renderer.h"
+#include "RenderBackend.h"
 
 Text::Text(ID3D12Device* device, ID3D12CommandQueue* commandQueue, D3D12_VIEWPORT viewPort, Renderer* renderer, std::wstring fontFileName) {
+	Initialize(device, commandQueue, viewPort, renderer, fontFileName.c_str(), nullptr, 0);
+}
+
+Text::Text(ID3D12Device* device, ID3D12CommandQueue* commandQueue, D3D12_VIEWPORT viewPort, Renderer* renderer, const uint8_t* fontData, size_t fontSize) {
+	Initialize(device, commandQueue, viewPort, renderer, nullptr, fontData, fontSize);
+}
+
+void Text::Initialize(ID3D12Device* device, ID3D12CommandQueue* commandQueue, D3D12_VIEWPORT viewPort, Renderer* renderer, const wchar_t* fontFileName, const uint8_t* fontData, size_t fontSize) {
 	DirectX::ResourceUploadBatch resUploadBatch(device);
 	resUploadBatch.Begin();
 	DirectX::RenderTargetState rtState(DXGI_FORMAT_R8G8B8A8_UNORM, DXGI_FORMAT_D32_FLOAT);
 	DirectX::SpriteBatchPipelineStateDescription pipelineStateDescription(rtState);
 	spriteBatch = new DirectX::SpriteBatch(device, resUploadBatch, pipelineStateDescription);
 
-	D3D12_DESCRIPTOR_HEAP_DESC desc = {};
-	desc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
-	desc.NodeMask = 0;
-	desc.NumDescriptors = 1;
-	desc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
-	device->CreateDescriptorHeap(&desc, IID_PPV_ARGS(descriptorHeap.ReleaseAndGetAddressOf()));
+	fontDescriptor = DescriptorAllocator::Allocate();
 
-	spriteFont = new DirectX::SpriteFont(device, resUploadBatch, fontFileName.c_str(),
-		descriptorHeap->GetCPUDescriptorHandleForHeapStart(), descriptorHeap->GetGPUDescriptorHandleForHeapStart());
+	if (fontFileName != nullptr) {
+		spriteFont = new DirectX::SpriteFont(device, resUploadBatch, fontFileName,
+			DescriptorAllocator::GetCpuHandle(fontDescriptor), DescriptorAllocator::GetGpuHandle(fontDescriptor));
+	}
+	else {
+		spriteFont = new DirectX::SpriteFont(device, resUploadBatch, fontData, fontSize,
+			DescriptorAllocator::GetCpuHandle(fontDescriptor), DescriptorAllocator::GetGpuHandle(fontDescriptor));
+	}
 
 	auto future = resUploadBatch.End(commandQueue);
 	renderer->RunCommand();
@@ -24,9 +35,19 @@ Text::Text(ID3D12Device* device, ID3D12CommandQueue* commandQueue, D3D12_VIEWPOR
 	spriteBatch->SetViewport(viewPort);
 }
 
+Text::~Text() {
+	delete spriteFont;
+	delete spriteBatch;
+
+	DescriptorAllocator::Free(fontDescriptor);
+}
+
 void Text::Draw(ID3D12GraphicsCommandList* commandList, std::wstring text, DirectX::XMFLOAT2 pos, DirectX::XMVECTOR color) {
-	commandList->SetDescriptorHeaps(1, descriptorHeap.GetAddressOf());
 	spriteBatch->Begin(commandList);
 	spriteFont->DrawString(spriteBatch, text.c_str(), pos, color);
 	spriteBatch->End();
+}
+
+void Text::Draw(RenderBackend* backend, std::wstring text, DirectX::XMFLOAT2 pos, DirectX::XMVECTOR color) {
+	backend->DrawString(this, text, pos, color);
 }
\ No newline at end of file
@@ -12,12 +12,22 @@ private:
 	DirectX::SpriteFont* spriteFont = nullptr;
 	DirectX::SpriteBatch* spriteBatch = nullptr;
 
-	
-	Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> descriptorHeap;
+	UINT fontDescriptor;
 
 public:
 	Text(ID3D12Device* device, ID3D12CommandQueue* commandQueue, D3D12_VIEWPORT viewPort, class Renderer* renderer, std::wstring fontFileName);
+	/// <summary>
+	/// .spritefontiAZbgpbNȂǁjBdata͍͕sv
+	/// </summary>
+	Text(ID3D12Device* device, ID3D12CommandQueue* commandQueue, D3D12_VIEWPORT viewPort, class Renderer* renderer, const uint8_t* fontData, size_t fontSize);
+	~Text();
+
+private:
+	void Initialize(ID3D12Device* device, ID3D12CommandQueue* commandQueue, D3D12_VIEWPORT viewPort, class Renderer* renderer, const wchar_t* fontFileName, const uint8_t* fontData, size_t fontSize);
+
+public:
 
 	void Draw(ID3D12GraphicsCommandList* commandList, std::wstring text, DirectX::XMFLOAT2 pos, DirectX::XMVECTOR color);
+	void Draw(class RenderBackend* backend, std::wstring text, DirectX::XMFLOAT2 pos, DirectX::XMVECTOR color);
 };
 
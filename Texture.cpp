@@ -1,16 +1,63 @@
 #include "Texture.h"
 #include "DirectXTex.h"
 #include "Debugger.h"
+#include "DescriptorAllocator.h"
 #include <vector>
 #include "d3dx12.h"
 #include "Renderer.h"
 #include "Box.h"
+#include "RenderBackend.h"
+#include "AssetPack.h"
+#include "TextureAtlas.h"
+#include "TextureStreamer.h"
 
 using Microsoft::WRL::ComPtr;
 
-Texture::Texture(std::wstring fileName, Renderer* renderer, int x, int y, int splitX, int splitY, Shape* customShape) {
-	CreateTexture(fileName, renderer);
+Texture::Texture(std::wstring fileName, Renderer* renderer, int x, int y, int splitX, int splitY, Shape* customShape, MipPolicy mipPolicy) {
+	srvDescriptor = DescriptorIndexAllocator::INVALID_INDEX;
+	atlas = nullptr;
+	atlasRegion = -1;
+	CreateTexture(fileName, renderer, mipPolicy);
 
+	InitializeShape(renderer != nullptr ? renderer->GetDevice() : nullptr, x, y, splitX, splitY, customShape);
+}
+
+Texture::Texture(AssetPack* pack, const std::string& name, Renderer* renderer, int x, int y, int splitX, int splitY, Shape* customShape, MipPolicy mipPolicy) {
+	srvDescriptor = DescriptorIndexAllocator::INVALID_INDEX;
+	atlas = nullptr;
+	atlasRegion = -1;
+
+	// kȂ}bv𒼐ړǂށBLZ4̏ꍇ͓WĴTextureStreamerɗa
+	std::vector<uint8_t> storage;
+	AssetSpan span = pack->Get(name, storage);
+	if (span.data == nullptr) {
+		Debugger::ErrorCheck(HRESULT_FROM_WIN32(ERROR_FILE_NOT_FOUND));
+	}
+	CreateTexture(std::wstring(name.begin(), name.end()), span.data, span.size, std::move(storage), renderer, mipPolicy);
+
+	InitializeShape(renderer != nullptr ? renderer->GetDevice() : nullptr, x, y, splitX, splitY, customShape);
+}
+
+Texture::Texture(TextureAtlas* atlas, int region, int x, int y, int splitX, int splitY, Shape* customShape) {
+	// fBXNv^̓AgX̃y[Ŵ̂g
+	srvDescriptor = DescriptorIndexAllocator::INVALID_INDEX;
+	this->atlas = atlas;
+	atlasRegion = region;
+
+	auto& placed = atlas->GetRegion(region);
+	metadata = {};
+	metadata.width = placed.width;
+	metadata.height = placed.height;
+	metadata.depth = 1;
+	metadata.arraySize = 1;
+	metadata.mipLevels = 1;
+	metadata.format = DXGI_FORMAT_R8G8B8A8_UNORM;
+	metadata.dimension = DirectX::TEX_DIMENSION_TEXTURE2D;
+
+	InitializeShape(atlas->GetRenderer()->GetDevice(), x, y, splitX, splitY, customShape);
+}
+
+void Texture::InitializeShape(ID3D12Device* device, int x, int y, int splitX, int splitY, Shape* customShape) {
 	splitUV = { 1.0f, 1.0f };
 	splitNum = { (float)splitX, (float)splitY };
 	this->customShape = customShape != nullptr;
@@ -19,10 +66,9 @@ Texture::Texture(std::wstring fileName, Renderer* renderer, int x, int y, int sp
 		splitUV.x = 1.0f / (float)splitX;
 		splitUV.y = 1.0f / (float)splitY;
 
-		auto image = scratchImage.GetImage(0, 0, 0);
-		DirectX::XMFLOAT2 imageScale = { image->width * splitUV.x, image->height * splitUV.y };
+		DirectX::XMFLOAT2 imageScale = { metadata.width * splitUV.x, metadata.height * splitUV.y };
 
-		shape = new Box(x, y, x + imageScale.x, y + imageScale.y, renderer->GetDevice());
+		shape = new Box(x, y, x + imageScale.x, y + imageScale.y, device);
 	}
 	else {
 		shape = customShape;
@@ -34,104 +80,108 @@ Texture::Texture(std::wstring fileName, Renderer* renderer, int x, int y, int sp
 }
 
 Texture::~Texture() {
+	if (streamRequest != nullptr) {
+		streamRequest->cancelled = true;
+	}
+
 	if (!customShape) {
 		delete shape;
 		shape = nullptr;
 	}
-}
 
-void Texture::CreateTexture(std::wstring fileName, Renderer* renderer) {
-	Debugger::ErrorCheck(DirectX::LoadFromWICFile(fileName.c_str(), DirectX::WIC_FLAGS_NONE, &metadata, scratchImage));
+	DescriptorAllocator::Free(srvDescriptor);
+}
 
-	auto image = scratchImage.GetImage(0, 0, 0);
+void Texture::CreateTexture(std::wstring fileName, Renderer* renderer, MipPolicy mipPolicy) {
+	// RendererꍇCPỦ摜iSoftwareRendererpj
+	if (renderer == nullptr) {
+		Debugger::ErrorCheck(TextureStreamer::LoadImageFile(fileName, &metadata, scratchImage));
+		DecompressImage();
+		return;
+	}
 
-	D3D12_HEAP_PROPERTIES prop = {};
-	prop.Type = D3D12_HEAP_TYPE_UPLOAD;
-	prop.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
-	prop.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
-	prop.CreationNodeMask = 1;
-	prop.VisibleNodeMask = 1;
+	// 傫ɓǂ݁AfR[hƓ]TextureStreamerɔCBI܂ł͔eNX`\
+	Debugger::ErrorCheck(TextureStreamer::GetImageMetadata(fileName, metadata));
 
-	D3D12_RESOURCE_DESC desc = {};
-	desc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
-	desc.Alignment = 0;
-	desc.Width = image->slicePitch;
-	desc.Height = 1;
-	desc.DepthOrArraySize = 1;
-	desc.MipLevels = 1;
-	desc.Format = DXGI_FORMAT_UNKNOWN;
-	desc.SampleDesc.Count = 1;
-	desc.SampleDesc.Quality = 0;
-	desc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
-	desc.Flags = D3D12_RESOURCE_FLAG_NONE;
+	auto streamer = renderer->GetTextureStreamer();
+	srvDescriptor = DescriptorAllocator::Allocate();
+	streamer->CreatePlaceholderView(DescriptorAllocator::GetCpuHandle(srvDescriptor));
 
-	ComPtr<ID3D12Resource> textureUpload;
-	Debugger::ErrorCheck(renderer->GetDevice()->CreateCommittedResource(&prop, D3D12_HEAP_FLAG_NONE, &desc, D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(textureUpload.ReleaseAndGetAddressOf())));
+	ID3D12Device* device = renderer->GetDevice();
+	streamRequest = streamer->Load(fileName, [this, device](ID3D12Resource* resource, DirectX::ScratchImage& image) {
+		OnStreamed(device, resource, image);
+	}, mipPolicy);
+}
 
-	UINT8* dataBegin;
-	textureUpload->Map(0, nullptr, reinterpret_cast<void**>(&dataBegin));
+void Texture::CreateTexture(const std::wstring& name, const uint8_t* data, size_t size, std::vector<uint8_t>&& storage, Renderer* renderer, MipPolicy mipPolicy) {
+	if (renderer == nullptr) {
+		Debugger::ErrorCheck(TextureStreamer::LoadImageMemory(data, size, &metadata, scratchImage));
+		DecompressImage();
+		return;
+	}
 
-	memcpy(dataBegin, image->pixels, image->slicePitch);
+	Debugger::ErrorCheck(TextureStreamer::GetImageMetadataMemory(data, size, metadata));
 
-	textureUpload->Unmap(0, nullptr);
+	auto streamer = renderer->GetTextureStreamer();
+	srvDescriptor = DescriptorAllocator::Allocate();
+	streamer->CreatePlaceholderView(DescriptorAllocator::GetCpuHandle(srvDescriptor));
 
-	prop.Type = D3D12_HEAP_TYPE_DEFAULT;
+	ID3D12Device* device = renderer->GetDevice();
+	streamRequest = streamer->Load(name, data, size, std::move(storage), [this, device](ID3D12Resource* resource, DirectX::ScratchImage& image) {
+		OnStreamed(device, resource, image);
+	}, mipPolicy);
+}
 
-	desc.Dimension = static_cast<D3D12_RESOURCE_DIMENSION>(metadata.dimension);
-	desc.Width = static_cast<UINT64>(metadata.width);
-	desc.Height = static_cast<UINT>(metadata.height);
-	desc.DepthOrArraySize = static_cast<UINT16>(metadata.arraySize);
-	desc.MipLevels = static_cast<UINT16>(metadata.mipLevels);
-	desc.Format = metadata.format;
-	desc.Layout = D3D12_TEXTURE_LAYOUT_UNKNOWN;
+void Texture::DecompressImage() {
+	// CPUł͈kꂽ摜ǂ߂Ȃ̂œWJ
+	if (DirectX::IsCompressed(metadata.format)) {
+		DirectX::ScratchImage decompressed;
+		Debugger::ErrorCheck(DirectX::Decompress(*scratchImage.GetImage(0, 0, 0), DXGI_FORMAT_R8G8B8A8_UNORM, decompressed));
+		scratchImage = std::move(decompressed);
+		metadata = scratchImage.GetMetadata();
+	}
+}
 
-	Debugger::ErrorCheck(renderer->GetDevice()->CreateCommittedResource(&prop, D3D12_HEAP_FLAG_NONE, &desc, D3D12_RESOURCE_STATE_COPY_DEST, nullptr, IID_PPV_ARGS(texbuff.ReleaseAndGetAddressOf())));
+void Texture::OnStreamed(ID3D12Device* device, ID3D12Resource* resource, DirectX::ScratchImage& image) {
+	texbuff = resource;
+	scratchImage = std::move(image);
 
-	D3D12_DESCRIPTOR_HEAP_DESC heapDesc = {};
-	heapDesc.NodeMask = 0;
-	heapDesc.NumDescriptors = 1;
-	heapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
-	heapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
-	Debugger::ErrorCheck(renderer->GetDevice()->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(basicDescHeap.ReleaseAndGetAddressOf())));
+	// ǂݍݎɃ~bv}bvꍇ́Awb_[ǂ񂾒i葝Ă
+	metadata.mipLevels = resource->GetDesc().MipLevels;
 
 	D3D12_SHADER_RESOURCE_VIEW_DESC shaderResourceViewDesc = {};
 	shaderResourceViewDesc.Format = metadata.format;
 	shaderResourceViewDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
 	shaderResourceViewDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
-	shaderResourceViewDesc.Texture2D.MipLevels = static_cast<UINT>(metadata.mipLevels);
-
-	renderer->GetDevice()->CreateShaderResourceView(texbuff.Get(), &shaderResourceViewDesc, basicDescHeap->GetCPUDescriptorHandleForHeapStart());
-	basicDescHeap->SetName(L"texture");
-
-	D3D12_TEXTURE_COPY_LOCATION dest;
-	dest.pResource = texbuff.Get();
-	dest.Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
-	dest.SubresourceIndex = 0;
-	D3D12_TEXTURE_COPY_LOCATION src;
-	src.pResource = textureUpload.Get();
-	src.Type = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;
-	src.PlacedFootprint.Offset = 0;
-	src.PlacedFootprint.Footprint.Format = desc.Format;
-	src.PlacedFootprint.Footprint.Width = static_cast<UINT>(desc.Width);
-	src.PlacedFootprint.Footprint.Height = static_cast<UINT>(desc.Height);
-	src.PlacedFootprint.Footprint.Depth = static_cast<UINT>(desc.DepthOrArraySize);
-	src.PlacedFootprint.Footprint.RowPitch = static_cast<UINT>(image->rowPitch);
-
-	renderer->GetCommandList()->CopyTextureRegion(&dest, 0, 0, 0, &src, nullptr);
-
-	auto barrier = CD3DX12_RESOURCE_BARRIER::Transition(texbuff.Get(), D3D12_RESOURCE_STATE_COPY_DEST, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
-	renderer->GetCommandList()->ResourceBarrier(1, &barrier);
-
-	renderer->RunCommand();
+	shaderResourceViewDesc.Texture2D.MipLevels = (UINT)metadata.mipLevels;
+
+	// L^ς݂̃t[ÂfBXNv^QƂĂ̂ŁAVmۂčւ
+	UINT descriptor = DescriptorAllocator::Allocate();
+	device->CreateShaderResourceView(texbuff.Get(), &shaderResourceViewDesc, DescriptorAllocator::GetCpuHandle(descriptor));
+	DescriptorAllocator::Free(srvDescriptor);
+	srvDescriptor = descriptor;
+
+	streamRequest = nullptr;
 }
 
 void Texture::Draw(ID3D12GraphicsCommandList* cmdList, int indexX, int indexY) {
-	cmdList->SetDescriptorHeaps(1, basicDescHeap.GetAddressOf());
-	cmdList->SetGraphicsRootDescriptorTable(2, basicDescHeap->GetGPUDescriptorHandleForHeapStart());
+	Bind(cmdList);
 
 	shape->Draw(cmdList);
 }
 
+void Texture::Bind(ID3D12GraphicsCommandList* cmdList) {
+	cmdList->SetGraphicsRootDescriptorTable(2, DescriptorAllocator::GetGpuHandle(GetDescriptor()));
+}
+
+UINT Texture::GetDescriptor() {
+	return atlas != nullptr ? atlas->GetDescriptor(atlasRegion) : srvDescriptor;
+}
+
+void Texture::Draw(RenderBackend* backend) {
+	backend->DrawTexture(this);
+}
+
 void Texture::SetImageArray(int indexX, int indexY) {
 	float x = (((float)indexX + 1.0f) / splitNum.x) - ((float)indexX / splitNum.x);
 	float y = (((float)indexY + 1.0f) / splitNum.y) - ((float)indexY / splitNum.y);
@@ -140,6 +190,19 @@ void Texture::SetImageArray(int indexX, int indexY) {
 	for (int i = 0; i < normalUV.size(); i++) {
 		uv[i].x = normalUV[i].x * x + x * (float)indexX;
 		uv[i].y = normalUV[i].y * y + y * (float)indexY;
+		if (atlas != nullptr) {
+			uv[i] = atlas->ToAtlasUV(atlasRegion, uv[i]);
+		}
 	}
 	shape->SetUV(uv);
+}
+
+void Texture::GetSourceRect(int indexX, int indexY, float* rect) {
+	float width = (float)metadata.width / splitNum.x;
+	float height = (float)metadata.height / splitNum.y;
+
+	rect[0] = width * (float)indexX;
+	rect[1] = height * (float)indexY;
+	rect[2] = width;
+	rect[3] = height;
 }
\ No newline at end of file
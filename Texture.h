@@ -2,6 +2,7 @@
 
 #include <d3d12.h>
 #include "DirectXTex.h"
+#include "TextureStreamer.h"
 
 #include <wrl.h>
 
@@ -11,7 +12,7 @@
 class Texture
 {
 private:
-	Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> basicDescHeap = nullptr;
+	UINT srvDescriptor;
 	Microsoft::WRL::ComPtr<ID3D12Resource> texbuff = nullptr;
 	class Shape* shape;
 
@@ -24,18 +25,58 @@ private:
 
 	bool customShape;
 
+	class TextureAtlas* atlas;
+	int atlasRegion;
+
+	std::shared_ptr<TextureStreamer::Request> streamRequest;
+
 public:
-	Texture(std::wstring fileName, class Renderer* renderer, int x, int y, int splitX = 1, int splitY = 1, class Shape* customShape = nullptr);
+	/// <summary>
+	/// mipPolicyGENERATEɂƓǂݍݎɃ~bv}bvikĕ\̌BhbgGNONÊ܂܁j
+	/// </summary>
+	Texture(std::wstring fileName, class Renderer* renderer, int x, int y, int splitX = 1, int splitY = 1, class Shape* customShape = nullptr, MipPolicy mipPolicy = MipPolicy::NONE);
+	/// <summary>
+	/// AZbgpbNǂށipbN͓ǂݍ݂I܂ŊJĂƁj
+	/// </summary>
+	Texture(class AssetPack* pack, const std::string& name, class Renderer* renderer, int x, int y, int splitX = 1, int splitY = 1, class Shape* customShape = nullptr, MipPolicy mipPolicy = MipPolicy::NONE);
+	/// <summary>
+	/// AgXɋl߂摜giAgX͂̃eNX`ɔj邱Ɓj
+	/// </summary>
+	Texture(class TextureAtlas* atlas, int region, int x, int y, int splitX = 1, int splitY = 1, class Shape* customShape = nullptr);
 	~Texture();
 
 private:
-	void CreateTexture(std::wstring fileName, class Renderer* renderer);
+	void CreateTexture(std::wstring fileName, class Renderer* renderer, MipPolicy mipPolicy);
+	void CreateTexture(const std::wstring& name, const uint8_t* data, size_t size, std::vector<uint8_t>&& storage, class Renderer* renderer, MipPolicy mipPolicy);
+	void DecompressImage();
+	void OnStreamed(ID3D12Device* device, ID3D12Resource* resource, DirectX::ScratchImage& image);
+	void InitializeShape(ID3D12Device* device, int x, int y, int splitX, int splitY, class Shape* customShape);
 
 public:
 	void Draw(ID3D12GraphicsCommandList* cmdList, int indexX = 0, int indexY = 0);
+	void Draw(class RenderBackend* backend);
+	void Bind(ID3D12GraphicsCommandList* cmdList);
+	/// <summary>
+	/// BindŐݒ肷fBXNv^iAgX̃y[WȂ瓯lj
+	/// </summary>
+	UINT GetDescriptor();
 	void SetImageArray(int indexX, int indexY);
 
+	/// <summary>
+	/// SetImageArrayƓʒuAsNZPʂx, y, , ŕԂiXvCg`pj
+	/// </summary>
+	void GetSourceRect(int indexX, int indexY, float* rect);
+
 	class Shape* GetShape() { return shape; }
+	class TextureAtlas* GetAtlas() { return atlas; }
+	int GetAtlasRegion() { return atlasRegion; }
+	/// <summary>
+	/// ǂݍݒƃAgX̃eNX`ApbNDDS𒼐ړ]̂nullptrԂ
+	/// </summary>
+	const DirectX::Image* GetImage() { return scratchImage.GetImage(0, 0, 0); }
+	bool IsLoaded() { return streamRequest == nullptr; }
+	int GetWidth() { return (int)metadata.width; }
+	int GetHeight() { return (int)metadata.height; }
 
 };
 
@@ -0,0 +1,159 @@
+#include "TextureAtlas.h"
+#include "Debugger.h"
+#include "DescriptorAllocator.h"
+#include "Renderer.h"
+
+#include <cstring>
+
+TextureAtlas::TextureAtlas(Renderer* renderer, int pageSize, int padding, bool allowRotation) : packer(pageSize, pageSize, padding, allowRotation) {
+	this->renderer = renderer;
+	built = false;
+}
+
+TextureAtlas::~TextureAtlas() {
+	for (auto& page : pages) {
+		if (page.request != nullptr) {
+			page.request->cancelled = true;
+		}
+		DescriptorAllocator::Free(page.descriptor);
+	}
+}
+
+int TextureAtlas::Add(const std::wstring& fileName) {
+	DirectX::ScratchImage image;
+	Debugger::ErrorCheck(DirectX::LoadFromWICFile(fileName.c_str(), DirectX::WIC_FLAGS_NONE, nullptr, image));
+	return Add(fileName, *image.GetImage(0, 0, 0));
+}
+
+int TextureAtlas::Add(const std::wstring& name, const DirectX::Image& image) {
+	// y[WR8G8B8A8Ȃ̂őĂ
+	DirectX::ScratchImage copy;
+	if (image.format == DXGI_FORMAT_R8G8B8A8_UNORM) {
+		Debugger::ErrorCheck(copy.InitializeFromImage(image));
+	}
+	else {
+		Debugger::ErrorCheck(DirectX::Convert(image, DXGI_FORMAT_R8G8B8A8_UNORM, DirectX::TEX_FILTER_DEFAULT, DirectX::TEX_THRESHOLD_DEFAULT, copy));
+	}
+
+	names.push_back(name);
+	images.push_back(std::move(copy));
+	regions.push_back({ -1, 0, 0, (int)image.width, (int)image.height, false });
+	return packer.Add((int)image.width, (int)image.height);
+}
+
+bool TextureAtlas::Build() {
+	if (built) {
+		return false;
+	}
+
+	bool allPacked = packer.Pack();
+
+	std::vector<DirectX::ScratchImage> pageImages(packer.GetPageCount());
+	for (auto& pageImage : pageImages) {
+		Debugger::ErrorCheck(pageImage.Initialize2D(DXGI_FORMAT_R8G8B8A8_UNORM, packer.GetPageWidth(), packer.GetPageHeight(), 1, 1));
+		std::memset(pageImage.GetPixels(), 0, pageImage.GetPixelsSize());
+	}
+
+	for (size_t i = 0; i < regions.size(); i++) {
+		auto& placement = packer.GetPlacement((int)i);
+		Region& region = regions[i];
+		region.page = placement.page;
+		region.x = placement.x;
+		region.y = placement.y;
+		region.rotated = placement.rotated;
+		if (region.page < 0) {
+			continue;
+		}
+
+		const DirectX::Image* src = images[i].GetImage(0, 0, 0);
+		const DirectX::Image* dst = pageImages[region.page].GetImage(0, 0, 0);
+		if (!region.rotated) {
+			for (int y = 0; y < region.height; y++) {
+				std::memcpy(dst->pixels + (size_t)(region.y + y) * dst->rowPitch + (size_t)region.x * 4, src->pixels + (size_t)y * src->rowPitch, (size_t)region.width * 4);
+			}
+		}
+		else {
+			// (x, y)u`(height - 1 - y, x)Ɏʂ
+			for (int y = 0; y < region.height; y++) {
+				const uint8_t* srcRow = src->pixels + (size_t)y * src->rowPitch;
+				size_t dstX = (size_t)(region.x + region.height - 1 - y) * 4;
+				for (int x = 0; x < region.width; x++) {
+					std::memcpy(dst->pixels + (size_t)(region.y + x) * dst->rowPitch + dstX, srcRow + (size_t)x * 4, 4);
+				}
+			}
+		}
+	}
+
+	// CPỦ摜̓y[WɎʂ̂ŎȂ
+	images.clear();
+
+	auto streamer = renderer->GetTextureStreamer();
+	ID3D12Device* device = renderer->GetDevice();
+
+	pages.resize(pageImages.size());
+	for (size_t i = 0; i < pages.size(); i++) {
+		Page& page = pages[i];
+		page.descriptor = DescriptorAllocator::Allocate();
+		streamer->CreatePlaceholderView(DescriptorAllocator::GetCpuHandle(page.descriptor));
+
+		page.request = streamer->Upload(L"atlas page " + std::to_wstring(i), std::move(pageImages[i]), [this, i, device](ID3D12Resource* resource, DirectX::ScratchImage& image) {
+			Page& page = pages[i];
+			page.resource = resource;
+
+			D3D12_SHADER_RESOURCE_VIEW_DESC desc = {};
+			desc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+			desc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+			desc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
+			desc.Texture2D.MipLevels = 1;
+
+			// L^ς݂̃t[ÂfBXNv^QƂĂ̂ŁAVmۂčւ
+			UINT descriptor = DescriptorAllocator::Allocate();
+			device->CreateShaderResourceView(resource, &desc, DescriptorAllocator::GetCpuHandle(descriptor));
+			DescriptorAllocator::Free(page.descriptor);
+			page.descriptor = descriptor;
+
+			page.request = nullptr;
+		});
+	}
+
+	built = true;
+	return allPacked;
+}
+
+int TextureAtlas::Find(const std::wstring& name) {
+	for (size_t i = 0; i < names.size(); i++) {
+		if (names[i] == name) {
+			return (int)i;
+		}
+	}
+	return -1;
+}
+
+DirectX::XMFLOAT2 TextureAtlas::ToAtlasUV(int region, DirectX::XMFLOAT2 uv) {
+	const Region& r = regions[region];
+	float pageWidth = (float)packer.GetPageWidth();
+	float pageHeight = (float)packer.GetPageHeight();
+
+	if (!r.rotated) {
+		return { (r.x + uv.x * r.width) / pageWidth, (r.y + uv.y * r.height) / pageHeight };
+	}
+	// (u, v)͒u`(1 - v, u)ɂ
+	return { (r.x + (1.0f - uv.y) * r.height) / pageWidth, (r.y + uv.x * r.width) / pageHeight };
+}
+
+void TextureAtlas::ToAtlasSourceRect(int region, const float* rect, float* atlasRect) {
+	const Region& r = regions[region];
+
+	if (!r.rotated) {
+		atlasRect[0] = r.x + rect[0];
+		atlasRect[1] = r.y + rect[1];
+		atlasRect[2] = rect[2];
+		atlasRect[3] = rect[3];
+	}
+	else {
+		atlasRect[0] = r.x + r.height - rect[1] - rect[3];
+		atlasRect[1] = r.y + rect[0];
+		atlasRect[2] = rect[3];
+		atlasRect[3] = rect[2];
+	}
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <d3d12.h>
+#include <DirectXMath.h>
+#include "DirectXTex.h"
+#include "AtlasPacker.h"
+#include "TextureStreamer.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+// ȉ摜܂Ƃ߂đ傫ȃy[Wɋl߁Ay[WƂ1̃eNX`Ƃē]
+// y[W̉摜͓fBXNv^ɂȂ̂ŁAXvCg1̕`ɂ܂Ƃ܂
+class TextureAtlas
+{
+public:
+	typedef struct Region {
+		int page;
+		int x;			// y[ẄʒuisNZj
+		int y;
+		int width;		// ̉摜̑傫
+		int height;
+		bool rotated;	// v90x񂵂ĒuĂ
+	};
+
+private:
+	typedef struct Page {
+		UINT descriptor;
+		Microsoft::WRL::ComPtr<ID3D12Resource> resource;
+		std::shared_ptr<TextureStreamer::Request> request;
+	};
+
+	class Renderer* renderer;
+	AtlasPacker packer;
+
+	std::vector<std::wstring> names;
+	std::vector<DirectX::ScratchImage> images;
+	std::vector<Region> regions;
+	std::vector<Page> pages;
+	bool built;
+
+public:
+	/// <param name="allowRotation">񂵂ĒuƂ悭l܂邪AShapeɓ\ꍇUVŖ߂̂Ōڂ͕ςȂ</param>
+	TextureAtlas(class Renderer* renderer, int pageSize = 2048, int padding = 1, bool allowRotation = true);
+	~TextureAtlas();
+
+public:
+	/// <summary>
+	/// 摜ǂݍŒǉBBuild̑OɌĂԂ
+	/// </summary>
+	int Add(const std::wstring& fileName);
+	int Add(const std::wstring& name, const DirectX::Image& image);
+
+	/// <summary>
+	/// l߂ăy[WA]n߂i]I܂ł͔eNX`ɂȂjBxĂׂ
+	/// </summary>
+	/// <returns>y[WɓȂ摜false</returns>
+	bool Build();
+
+	int Find(const std::wstring& name);
+	const Region& GetRegion(int region) { return regions[region]; }
+	UINT GetDescriptor(int region) { return pages[regions[region].page].descriptor; }
+
+	/// <summary>
+	/// ̉摜̒UVi0`1jy[WUVɂ
+	/// </summary>
+	DirectX::XMFLOAT2 ToAtlasUV(int region, DirectX::XMFLOAT2 uv);
+	/// <summary>
+	/// ̉摜̒̃sNZPʂx, y, , Ay[W̒uꂽ`ɂ
+	/// </summary>
+	void ToAtlasSourceRect(int region, const float* rect, float* atlasRect);
+
+	class Renderer* GetRenderer() { return renderer; }
+	int GetPageCount() { return (int)pages.size(); }
+	int GetPageWidth() { return packer.GetPageWidth(); }
+	int GetPageHeight() { return packer.GetPageHeight(); }
+	bool IsBuilt() { return built; }
+
+	AtlasPacker::Statistics GetStatistics() { return packer.GetStatistics(); }
+};
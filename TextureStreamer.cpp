@@ -0,0 +1,478 @@
+#include "TextureStreamer.h"
+#include "Debugger.h"
+#include "QueueFence.h"
+#include "ThreadPool.h"
+#include "d3dx12.h"
+
+#include <cstring>
+#include <cwctype>
+#include <fstream>
+
+using Microsoft::WRL::ComPtr;
+
+namespace {
+	// WIC̓XbhƂCOM̏KvȂ̂ŁA[J[ōŏɎgɏ
+	struct ComScope {
+		HRESULT result;
+		ComScope() { result = CoInitializeEx(nullptr, COINIT_MULTITHREADED); }
+		~ComScope() {
+			if (SUCCEEDED(result)) {
+				CoUninitialize();
+			}
+		}
+	};
+
+	double Seconds(std::chrono::steady_clock::time_point begin, std::chrono::steady_clock::time_point end) {
+		return std::chrono::duration<double>(end - begin).count();
+	}
+}
+
+TextureStreamer::TextureStreamer(ID3D12Device* device, int threadCount) {
+	this->device = device;
+	fenceValue = 0;
+	decodingCount = 0;
+	statistics = {};
+
+	D3D12_COMMAND_QUEUE_DESC desc = {};
+	desc.Flags = D3D12_COMMAND_QUEUE_FLAG_NONE;
+	desc.NodeMask = 0;
+	desc.Priority = D3D12_COMMAND_QUEUE_PRIORITY_NORMAL;
+	desc.Type = D3D12_COMMAND_LIST_TYPE_COPY;
+	Debugger::ErrorCheck(device->CreateCommandQueue(&desc, IID_PPV_ARGS(copyQueue.ReleaseAndGetAddressOf())));
+
+	auto allocator = AcquireAllocator();
+	Debugger::ErrorCheck(device->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_COPY, allocator.Get(), nullptr, IID_PPV_ARGS(copyList.ReleaseAndGetAddressOf())));
+	copyList->Close();
+	freeAllocators.push_back(allocator);
+
+	fence = std::make_unique<QueueFence>(device, copyQueue.Get());
+	threadPool = std::make_unique<ThreadPool>(threadCount);
+
+	CreatePlaceholder();
+}
+
+TextureStreamer::~TextureStreamer() {
+	// fR[ĥ̂I点ĂARs[L[̊҂
+	threadPool.reset();
+	fence->Wait(fenceValue);
+}
+
+ComPtr<ID3D12CommandAllocator> TextureStreamer::AcquireAllocator() {
+	if (!freeAllocators.empty()) {
+		auto allocator = freeAllocators.back();
+		freeAllocators.pop_back();
+		Debugger::ErrorCheck(allocator->Reset());
+		return allocator;
+	}
+
+	ComPtr<ID3D12CommandAllocator> allocator;
+	Debugger::ErrorCheck(device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_COPY, IID_PPV_ARGS(allocator.ReleaseAndGetAddressOf())));
+	return allocator;
+}
+
+void TextureStreamer::CreatePlaceholder() {
+	auto request = std::make_shared<Request>();
+	request->cancelled = false;
+	request->failed = false;
+	request->source = nullptr;
+	request->sourceSize = 0;
+	request->mipPolicy = MipPolicy::NONE;
+	Debugger::ErrorCheck(request->image.Initialize2D(DXGI_FORMAT_R8G8B8A8_UNORM, 1, 1, 1, 1));
+	std::memset(request->image.GetPixels(), 0xff, request->image.GetPixelsSize());
+	SetImages(*request);
+
+	Batch batch = {};
+	batch.requests.push_back(request);
+	RecordBatch(batch);
+	Submit(batch);
+
+	fence->Wait(fenceValue);
+	placeholder = request->resource;
+	ResourceAllocator::FreeBuffer(batch.upload);
+}
+
+std::shared_ptr<TextureStreamer::Request> TextureStreamer::Load(const std::wstring& fileName, std::function<void(ID3D12Resource* resource, DirectX::ScratchImage& image)> onReady, MipPolicy mipPolicy) {
+	auto request = std::make_shared<Request>();
+	request->fileName = fileName;
+	request->cancelled = false;
+	request->failed = false;
+	request->source = nullptr;
+	request->sourceSize = 0;
+	request->mipPolicy = mipPolicy;
+	request->requestTime = std::chrono::steady_clock::now();
+	request->decodeSeconds = 0.0;
+	request->onReady = std::move(onReady);
+
+	statistics.requests++;
+	decodingCount++;
+	threadPool->Enqueue([this, request] { Decode(request); });
+
+	return request;
+}
+
+std::shared_ptr<TextureStreamer::Request> TextureStreamer::Load(const std::wstring& name, const uint8_t* data, size_t size, std::vector<uint8_t>&& storage, std::function<void(ID3D12Resource* resource, DirectX::ScratchImage& image)> onReady, MipPolicy mipPolicy) {
+	auto request = std::make_shared<Request>();
+	request->fileName = name;
+	request->cancelled = false;
+	request->failed = false;
+	request->source = data;
+	request->sourceSize = size;
+	request->mipPolicy = mipPolicy;
+	request->sourceStorage = std::move(storage);
+	request->requestTime = std::chrono::steady_clock::now();
+	request->decodeSeconds = 0.0;
+	request->onReady = std::move(onReady);
+
+	statistics.requests++;
+	decodingCount++;
+	threadPool->Enqueue([this, request] { Decode(request); });
+
+	return request;
+}
+
+std::shared_ptr<TextureStreamer::Request> TextureStreamer::Upload(const std::wstring& name, DirectX::ScratchImage&& image, std::function<void(ID3D12Resource* resource, DirectX::ScratchImage& image)> onReady) {
+	auto request = std::make_shared<Request>();
+	request->fileName = name;
+	request->cancelled = false;
+	request->failed = false;
+	request->source = nullptr;
+	request->sourceSize = 0;
+	request->mipPolicy = MipPolicy::NONE;
+	request->image = std::move(image);
+	SetImages(*request);
+	request->requestTime = std::chrono::steady_clock::now();
+	request->decodeSeconds = 0.0;
+	request->onReady = std::move(onReady);
+
+	statistics.requests++;
+	std::lock_guard<std::mutex> lock(mutex);
+	decoded.push_back(request);
+
+	return request;
+}
+
+bool TextureStreamer::IsCooked(const std::wstring& fileName) {
+	if (fileName.size() < 4) {
+		return false;
+	}
+	std::wstring extension = fileName.substr(fileName.size() - 4);
+	for (auto& c : extension) {
+		c = (wchar_t)std::towlower(c);
+	}
+	return extension == L".dds";
+}
+
+HRESULT TextureStreamer::LoadImageFile(const std::wstring& fileName, DirectX::TexMetadata* metadata, DirectX::ScratchImage& image) {
+	if (!IsCooked(fileName)) {
+		return DirectX::LoadFromWICFile(fileName.c_str(), DirectX::WIC_FLAGS_NONE, metadata, image);
+	}
+
+	// DDS̓~bv}bvƈkς݂̒ĝ܂܎ĝŁAǂݍނł悢
+	std::ifstream file(fileName.c_str(), std::ios::binary | std::ios::ate);
+	if (!file) {
+		return HRESULT_FROM_WIN32(ERROR_FILE_NOT_FOUND);
+	}
+	std::vector<uint8_t> data((size_t)file.tellg());
+	file.seekg(0);
+	file.read(reinterpret_cast<char*>(data.data()), data.size());
+	if (!file) {
+		return HRESULT_FROM_WIN32(ERROR_READ_FAULT);
+	}
+	return DirectX::LoadFromDDSMemory(data.data(), data.size(), DirectX::DDS_FLAGS_NONE, metadata, image);
+}
+
+HRESULT TextureStreamer::GetImageMetadata(const std::wstring& fileName, DirectX::TexMetadata& metadata) {
+	if (IsCooked(fileName)) {
+		return DirectX::GetMetadataFromDDSFile(fileName.c_str(), DirectX::DDS_FLAGS_NONE, metadata);
+	}
+	return DirectX::GetMetadataFromWICFile(fileName.c_str(), DirectX::WIC_FLAGS_NONE, metadata);
+}
+
+HRESULT TextureStreamer::LoadImageMemory(const uint8_t* data, size_t size, DirectX::TexMetadata* metadata, DirectX::ScratchImage& image) {
+	if (size >= 4 && std::memcmp(data, "DDS ", 4) == 0) {
+		return DirectX::LoadFromDDSMemory(data, size, DirectX::DDS_FLAGS_NONE, metadata, image);
+	}
+	return DirectX::LoadFromWICMemory(data, size, DirectX::WIC_FLAGS_NONE, metadata, image);
+}
+
+HRESULT TextureStreamer::GetImageMetadataMemory(const uint8_t* data, size_t size, DirectX::TexMetadata& metadata) {
+	if (size >= 4 && std::memcmp(data, "DDS ", 4) == 0) {
+		return DirectX::GetMetadataFromDDSMemory(data, size, DirectX::DDS_FLAGS_NONE, metadata);
+	}
+	return DirectX::GetMetadataFromWICMemory(data, size, DirectX::WIC_FLAGS_NONE, metadata);
+}
+
+void TextureStreamer::GenerateMips(Request& request) {
+	auto& metadata = request.image.GetMetadata();
+	if (request.mipPolicy != MipPolicy::GENERATE || metadata.mipLevels > 1 || DirectX::IsCompressed(metadata.format) || (metadata.width == 1 && metadata.height == 1)) {
+		return;
+	}
+
+	// Ȃ`̏ꍇ1̂܂ܓ]
+	DirectX::ScratchImage mipChain;
+	if (SUCCEEDED(DirectX::GenerateMipMaps(request.image.GetImages(), request.image.GetImageCount(), metadata, DirectX::TEX_FILTER_DEFAULT, 0, mipChain))) {
+		request.image = std::move(mipChain);
+	}
+}
+
+void TextureStreamer::SetImages(Request& request) {
+	request.metadata = request.image.GetMetadata();
+	request.images.assign(request.image.GetImages(), request.image.GetImages() + request.image.GetImageCount());
+}
+
+bool TextureStreamer::MapDDSImages(Request& request) {
+	DirectX::TexMetadata metadata;
+	if (FAILED(DirectX::GetMetadataFromDDSMemory(request.source, request.sourceSize, DirectX::DDS_FLAGS_NONE, metadata))) {
+		return false;
+	}
+	if (metadata.dimension != DirectX::TEX_DIMENSION_TEXTURE2D || metadata.arraySize != 1 || metadata.depth != 1 || metadata.IsCubemap()) {
+		return false;
+	}
+
+	// wb_["DDS "DDS_HEADER(124oCg)ŁADX10̊gwb_[(20oCg)Ƃ
+	size_t offset = 4 + 124;
+	if (request.sourceSize >= offset && std::memcmp(request.source + 84, "DX10", 4) == 0) {
+		offset += 20;
+	}
+
+	// 24bitRGBȂǓǂݍݎɕϊKvȌ`́A傫Ȃ̂łŒe
+	std::vector<DirectX::Image> images;
+	size_t width = metadata.width;
+	size_t height = metadata.height;
+	for (size_t mip = 0; mip < metadata.mipLevels; mip++) {
+		DirectX::Image image = {};
+		image.width = width;
+		image.height = height;
+		image.format = metadata.format;
+		if (FAILED(DirectX::ComputePitch(metadata.format, width, height, image.rowPitch, image.slicePitch))) {
+			return false;
+		}
+		if (request.sourceSize < offset || request.sourceSize - offset < image.slicePitch) {
+			return false;
+		}
+		image.pixels = const_cast<uint8_t*>(request.source + offset);
+		images.push_back(image);
+
+		offset += image.slicePitch;
+		width = width > 1 ? width / 2 : 1;
+		height = height > 1 ? height / 2 : 1;
+	}
+	if (offset != request.sourceSize) {
+		return false;
+	}
+
+	request.metadata = metadata;
+	request.images = std::move(images);
+	return true;
+}
+
+void TextureStreamer::Decode(std::shared_ptr<Request> request) {
+	thread_local ComScope com;
+
+	if (!request->cancelled) {
+		auto startTime = std::chrono::steady_clock::now();
+		// ~bv}bvō̂ŁA摜ƂɕɂȂ
+		if (request->source == nullptr) {
+			request->failed = FAILED(LoadImageFile(request->fileName, nullptr, request->image));
+			if (!request->failed) {
+				GenerateMips(*request);
+				SetImages(*request);
+			}
+		}
+		else if (!MapDDSImages(*request)) {
+			request->failed = FAILED(LoadImageMemory(request->source, request->sourceSize, nullptr, request->image));
+			if (!request->failed) {
+				GenerateMips(*request);
+				SetImages(*request);
+			}
+		}
+		request->decodeSeconds = Seconds(startTime, std::chrono::steady_clock::now());
+	}
+
+	std::lock_guard<std::mutex> lock(mutex);
+	decoded.push_back(request);
+	decodingCount--;
+}
+
+D3D12_RESOURCE_DESC TextureStreamer::GetResourceDesc(const Request& request) {
+	auto& metadata = request.metadata;
+	return CD3DX12_RESOURCE_DESC::Tex2D(metadata.format, (UINT64)metadata.width, (UINT)metadata.height, 1, (UINT16)metadata.mipLevels);
+}
+
+uint64_t TextureStreamer::GetUploadSize(const Request& request) {
+	auto desc = GetResourceDesc(request);
+	UINT64 uploadSize;
+	device->GetCopyableFootprints(&desc, 0, desc.MipLevels, 0, nullptr, nullptr, nullptr, &uploadSize);
+	return uploadSize;
+}
+
+void TextureStreamer::RecordUpload(Request& request, ID3D12Resource* upload, UINT8* data, uint64_t offset) {
+	// Rs[L[ł̓oAgȂ̂ŁACOMMONōRs[̈Öق̏iɔC
+	// ]COMMONɖ߂A`L[ōŏɓǂގPIXEL_SHADER_RESOURCE֏i
+	auto desc = GetResourceDesc(request);
+	UINT mipLevels = desc.MipLevels;
+	request.resource = ResourceAllocator::CreateTexture(desc, D3D12_RESOURCE_STATE_COMMON);
+
+	std::vector<D3D12_PLACED_SUBRESOURCE_FOOTPRINT> footprints(mipLevels);
+	std::vector<UINT> rowCounts(mipLevels);
+	std::vector<UINT64> rowSizes(mipLevels);
+	device->GetCopyableFootprints(&desc, 0, mipLevels, offset, footprints.data(), rowCounts.data(), rowSizes.data(), nullptr);
+
+	// s̕D3D12_TEXTURE_DATA_PITCH_ALIGNMENTɑKv̂1sʂ
+	// BCk̏ꍇAs4x4ubN1ɂȂ
+	for (UINT mip = 0; mip < mipLevels; mip++) {
+		const DirectX::Image* image = &request.images[mip];
+		auto& footprint = footprints[mip];
+		for (UINT y = 0; y < rowCounts[mip]; y++) {
+			std::memcpy(data + footprint.Offset + (size_t)y * footprint.Footprint.RowPitch, image->pixels + (size_t)y * image->rowPitch, (size_t)rowSizes[mip]);
+		}
+
+		CD3DX12_TEXTURE_COPY_LOCATION dest(request.resource.Get(), mip);
+		CD3DX12_TEXTURE_COPY_LOCATION src(upload, footprint);
+		copyList->CopyTextureRegion(&dest, 0, 0, 0, &src, nullptr);
+	}
+}
+
+uint64_t TextureStreamer::RecordBatch(Batch& batch) {
+	// ׂẴeNX`ׂ̂Ẵ~bv}bv1̃Abv[hobt@ɋl߂
+	std::vector<uint64_t> offsets;
+	uint64_t bytes = 0;
+	for (auto& request : batch.requests) {
+		bytes = (bytes + D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT - 1) & ~(uint64_t)(D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT - 1);
+		offsets.push_back(bytes);
+		bytes += GetUploadSize(*request);
+	}
+
+	// ͈͂̈ʒu̓tbgvg̑i512j̔{Ȃ̂ŁAy[W̃obt@̐擪̈ʒuŏ
+	batch.upload = ResourceAllocator::AllocateBuffer(bytes, D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT);
+
+	batch.allocator = AcquireAllocator();
+	copyList->Reset(batch.allocator.Get(), nullptr);
+
+	UINT8* data = batch.upload.cpuAddress - batch.upload.offset;
+	for (size_t i = 0; i < batch.requests.size(); i++) {
+		RecordUpload(*batch.requests[i], batch.upload.resource, data, batch.upload.offset + offsets[i]);
+	}
+
+	return bytes;
+}
+
+void TextureStreamer::Submit(Batch& batch) {
+	copyList->Close();
+
+	ID3D12CommandList* lists[] = { copyList.Get() };
+	copyQueue->ExecuteCommandLists(1, lists);
+
+	fenceValue++;
+	fence->Signal(fenceValue);
+	batch.fenceValue = fenceValue;
+}
+
+void TextureStreamer::Complete(Request& request, double uploadSeconds) {
+	if (request.cancelled) {
+		return;
+	}
+
+	Latency latency;
+	latency.fileName = request.fileName;
+	latency.decodeSeconds = request.decodeSeconds;
+	latency.uploadSeconds = uploadSeconds;
+	latency.totalSeconds = Seconds(request.requestTime, std::chrono::steady_clock::now());
+	latency.failed = request.failed;
+	latencies.push_back(latency);
+
+	if (request.failed) {
+		statistics.failed++;
+	}
+	else {
+		statistics.completed++;
+		request.onReady(request.resource.Get(), request.image);
+	}
+
+	// 摜Ɛ؂ւ̓eNX`ɓn̂ŁAł͎Ȃ
+	request.onReady = nullptr;
+	request.image.Release();
+	request.images.clear();
+	request.source = nullptr;
+	request.sourceStorage.clear();
+	request.sourceStorage.shrink_to_fit();
+}
+
+void TextureStreamer::Update() {
+	auto now = std::chrono::steady_clock::now();
+
+	// ]Î؂ւ
+	uint64_t completed = fence->GetCompletedValue();
+	for (auto it = batches.begin(); it != batches.end();) {
+		if (it->fenceValue > completed) {
+			++it;
+			continue;
+		}
+		for (auto& request : it->requests) {
+			Complete(*request, Seconds(request->submitTime, now));
+		}
+		freeAllocators.push_back(it->allocator);
+		ResourceAllocator::FreeBuffer(it->upload);
+		it = batches.erase(it);
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		while (!decoded.empty()) {
+			pending.push_back(decoded.front());
+			decoded.pop_front();
+		}
+	}
+
+	// fR[hÎ܂Ƃ߂1œ]
+	Batch batch = {};
+	uint64_t bytes = 0;
+	while (!pending.empty() && bytes < MAX_BATCH_BYTES) {
+		auto request = pending.front();
+		pending.pop_front();
+
+		if (request->cancelled) {
+			continue;
+		}
+		if (request->failed) {
+			Complete(*request, 0.0);
+			continue;
+		}
+
+		bytes += GetUploadSize(*request);
+		request->submitTime = now;
+		batch.requests.push_back(request);
+	}
+
+	if (!batch.requests.empty()) {
+		bytes = RecordBatch(batch);
+		Submit(batch);
+		statistics.batches++;
+		statistics.bytes += bytes;
+		batches.push_back(std::move(batch));
+	}
+}
+
+void TextureStreamer::WaitAll() {
+	while (!IsIdle()) {
+		threadPool->WaitIdle();
+		Update();
+		if (!batches.empty()) {
+			fence->Wait(batches.back().fenceValue);
+		}
+	}
+}
+
+bool TextureStreamer::IsIdle() {
+	std::lock_guard<std::mutex> lock(mutex);
+	return decodingCount == 0 && decoded.empty() && pending.empty() && batches.empty();
+}
+
+void TextureStreamer::CreatePlaceholderView(D3D12_CPU_DESCRIPTOR_HANDLE handle) {
+	D3D12_SHADER_RESOURCE_VIEW_DESC desc = {};
+	desc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+	desc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+	desc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
+	desc.Texture2D.MipLevels = 1;
+	device->CreateShaderResourceView(placeholder.Get(), &desc, handle);
+}
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <wrl.h>
+#include <d3d12.h>
+#include "DirectXTex.h"
+#include "ResourceAllocator.h"
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+enum class MipPolicy {
+	NONE,		// 1̂܂܁ihbgGȂǁj
+	GENERATE	// ǂݍݎɃ~bv}bvikĕ\́j
+};
+
+// eNX`[J[XbhŃfR[hARs[L[ł܂Ƃ߂GPU֓]
+// ]I܂ł1x1̔eNX`\
+// AssetCookerŕϊDDS̓fR[hA~bv}bvƂ̂܂ܓ]
+class TextureStreamer
+{
+public:
+	static const uint64_t MAX_BATCH_BYTES = 64ull * 1024 * 1024;	// 1̓]ł܂Ƃ߂ʂ̖ڈ
+
+	typedef struct Latency {
+		std::wstring fileName;
+		double decodeSeconds;
+		double uploadSeconds;	// Rs[L[ɑĂ犮܂
+		double totalSeconds;	// Load\ɐ؂ւ܂
+		bool failed;
+	};
+
+	typedef struct Statistics {
+		uint64_t requests;
+		uint64_t completed;
+		uint64_t failed;
+		uint64_t batches;
+		uint64_t bytes;
+	};
+
+	// ǂݍݒ̃eNX`Ƃ̋L
+	typedef struct Request {
+		std::wstring fileName;
+		std::atomic<bool> cancelled;
+		bool failed;
+		const uint8_t* source;					// ǂޏꍇ̌f[^iAZbgpbNȂǁj
+		size_t sourceSize;
+		std::vector<uint8_t> sourceStorage;		// f[^Kvꍇ
+		DirectX::ScratchImage image;			// fR[h摜iDDS𒼐ړ]ꍇ͋j
+		DirectX::TexMetadata metadata;
+		std::vector<DirectX::Image> images;		// ]~bv}bvBimagesourcew
+		MipPolicy mipPolicy;
+		std::chrono::steady_clock::time_point requestTime;
+		std::chrono::steady_clock::time_point submitTime;
+		double decodeSeconds;
+		Microsoft::WRL::ComPtr<ID3D12Resource> resource;
+		std::function<void(ID3D12Resource* resource, DirectX::ScratchImage& image)> onReady;
+	};
+
+private:
+	typedef struct Batch {
+		uint64_t fenceValue;
+		Microsoft::WRL::ComPtr<ID3D12CommandAllocator> allocator;
+		std::vector<std::shared_ptr<Request>> requests;
+		ResourceAllocator::BufferRange upload;
+	};
+
+	ID3D12Device* device;
+	Microsoft::WRL::ComPtr<ID3D12CommandQueue> copyQueue;
+	Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList> copyList;
+	std::vector<Microsoft::WRL::ComPtr<ID3D12CommandAllocator>> freeAllocators;
+	std::unique_ptr<class QueueFence> fence;
+	uint64_t fenceValue;
+
+	Microsoft::WRL::ComPtr<ID3D12Resource> placeholder;
+
+	std::unique_ptr<class ThreadPool> threadPool;
+	std::mutex mutex;
+	std::deque<std::shared_ptr<Request>> decoded;		// [J[݁AUpdateŎo
+	std::deque<std::shared_ptr<Request>> pending;		// ]҂
+	std::vector<Batch> batches;
+	std::atomic<int> decodingCount;
+
+	std::vector<Latency> latencies;
+	Statistics statistics;
+
+public:
+	TextureStreamer(ID3D12Device* device, int threadCount = 0);
+	~TextureStreamer();
+
+private:
+	Microsoft::WRL::ComPtr<ID3D12CommandAllocator> AcquireAllocator();
+	void Decode(std::shared_ptr<Request> request);
+	static void GenerateMips(Request& request);
+	static void SetImages(Request& request);
+	static bool MapDDSImages(Request& request);
+	static D3D12_RESOURCE_DESC GetResourceDesc(const Request& request);
+	uint64_t GetUploadSize(const Request& request);
+	void RecordUpload(Request& request, ID3D12Resource* upload, UINT8* data, uint64_t offset);
+	uint64_t RecordBatch(Batch& batch);
+	void Submit(Batch& batch);
+	void Complete(Request& request, double uploadSeconds);
+	void CreatePlaceholder();
+
+public:
+	/// <summary>
+	/// ǂݍ݂n߂ĂɕԂB]IUpdate̒onReadyĂ΂
+	/// LZ鎞͖߂lcancelledtrueɂ
+	/// </summary>
+	std::shared_ptr<Request> Load(const std::wstring& fileName, std::function<void(ID3D12Resource* resource, DirectX::ScratchImage& image)> onReady, MipPolicy mipPolicy = MipPolicy::NONE);
+	/// <summary>
+	/// ̉摜t@CǂݍށBdata͓]I܂ŗLł邱
+	/// datastorage̒wꍇstorageƗaBDDS̓fR[hRs[data]
+	/// </summary>
+	std::shared_ptr<Request> Load(const std::wstring& name, const uint8_t* data, size_t size, std::vector<uint8_t>&& storage, std::function<void(ID3D12Resource* resource, DirectX::ScratchImage& image)> onReady, MipPolicy mipPolicy = MipPolicy::NONE);
+	/// <summary>
+	/// fR[hς݂̉摜]iAgX̃y[WȂǁj
+	/// </summary>
+	std::shared_ptr<Request> Upload(const std::wstring& name, DirectX::ScratchImage&& image, std::function<void(ID3D12Resource* resource, DirectX::ScratchImage& image)> onReady);
+
+	/// <summary>
+	/// t[ĂсAfR[hÎ]A]Î؂ւ
+	/// </summary>
+	void Update();
+
+	/// <summary>
+	/// ǂݍݒׂ̂̂Đ؂ւ܂ő҂
+	/// </summary>
+	void WaitAll();
+
+	/// <summary>
+	/// ǂݍݒɕ\eNX`SRV
+	/// </summary>
+	void CreatePlaceholderView(D3D12_CPU_DESCRIPTOR_HANDLE handle);
+
+	/// <summary>
+	/// gq.dds
+	/// </summary>
+	static bool IsCooked(const std::wstring& fileName);
+	/// <summary>
+	/// DDSȂ炻̂܂܁AȊOWICŃfR[hēǂݍ
+	/// </summary>
+	static HRESULT LoadImageFile(const std::wstring& fileName, DirectX::TexMetadata* metadata, DirectX::ScratchImage& image);
+	static HRESULT GetImageMetadata(const std::wstring& fileName, DirectX::TexMetadata& metadata);
+	/// <summary>
+	/// 擪"DDS "ȂDDSAȊOWICœǂݍ
+	/// </summary>
+	static HRESULT LoadImageMemory(const uint8_t* data, size_t size, DirectX::TexMetadata* metadata, DirectX::ScratchImage& image);
+	static HRESULT GetImageMetadataMemory(const uint8_t* data, size_t size, DirectX::TexMetadata& metadata);
+
+	const std::vector<Latency>& GetLatencies() { return latencies; }
+	void ClearLatencies() { latencies.clear(); }
+	Statistics GetStatistics() { return statistics; }
+	bool IsIdle();
+};
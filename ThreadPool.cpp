@@ -0,0 +1,116 @@
+#include "ThreadPool.h"
+
+#include <memory>
+
+ThreadPool::ThreadPool(int threadCount) {
+	if (threadCount <= 0) {
+		threadCount = (int)std::thread::hardware_concurrency();
+		if (threadCount <= 0) {
+			threadCount = 1;
+		}
+	}
+
+	runningCount = 0;
+	quit = false;
+
+	for (int i = 0; i < threadCount; i++) {
+		workers.emplace_back([this] { WorkerLoop(); });
+	}
+}
+
+ThreadPool::~ThreadPool() {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		quit = true;
+	}
+	taskCondition.notify_all();
+
+	for (auto& worker : workers) {
+		worker.join();
+	}
+}
+
+void ThreadPool::WorkerLoop() {
+	while (true) {
+		std::function<void()> task;
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			taskCondition.wait(lock, [this] { return quit || !tasks.empty(); });
+			if (tasks.empty()) {
+				return;
+			}
+			task = std::move(tasks.front());
+			tasks.pop_front();
+			runningCount++;
+		}
+
+		task();
+
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			runningCount--;
+			if (runningCount == 0 && tasks.empty()) {
+				idleCondition.notify_all();
+			}
+		}
+	}
+}
+
+void ThreadPool::Enqueue(std::function<void()> task) {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		tasks.push_back(std::move(task));
+	}
+	taskCondition.notify_one();
+}
+
+void ThreadPool::ParallelFor(int count, const std::function<void(int)>& func) {
+	if (count <= 0) {
+		return;
+	}
+
+	// JnOɕԂĂ܂ꍇłSȂ悤ɁAԂ͋L|C^Ŏ
+	struct State {
+		std::atomic<int> next;
+		std::atomic<int> finished;
+		std::mutex mutex;
+		std::condition_variable condition;
+		const std::function<void(int)>* func;
+		int count;
+	};
+	auto state = std::make_shared<State>();
+	state->next = 0;
+	state->finished = 0;
+	state->func = &func;
+	state->count = count;
+
+	auto body = [state] {
+		int index;
+		while ((index = state->next.fetch_add(1)) < state->count) {
+			(*state->func)(index);
+			if (state->finished.fetch_add(1) + 1 == state->count) {
+				std::lock_guard<std::mutex> lock(state->mutex);
+				state->condition.notify_all();
+			}
+		}
+	};
+
+	// ĂяõXbhɎQ
+	int helperCount = (int)workers.size();
+	if (helperCount > count - 1) {
+		helperCount = count - 1;
+	}
+	for (int i = 0; i < helperCount; i++) {
+		Enqueue(body);
+	}
+
+	body();
+
+	std::unique_lock<std::mutex> lock(state->mutex);
+	state->condition.wait(lock, [&] { return state->finished.load() == count; });
+}
+
+void ThreadPool::WaitIdle() {
+	std::unique_lock<std::mutex> lock(mutex);
+	idleCondition.wait(lock, [this] { return runningCount == 0 && tasks.empty(); });
+}
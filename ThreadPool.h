@@ -0,0 +1,38 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool
+{
+private:
+	std::vector<std::thread> workers;
+	std::deque<std::function<void()>> tasks;
+	std::mutex mutex;
+	std::condition_variable taskCondition;
+	std::condition_variable idleCondition;
+	int runningCount;
+	bool quit;
+
+public:
+	ThreadPool(int threadCount = 0);
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+private:
+	void WorkerLoop();
+
+public:
+	void Enqueue(std::function<void()> task);
+	void ParallelFor(int count, const std::function<void(int)>& func);
+	void WaitIdle();
+
+	int GetThreadCount() { return (int)workers.size(); }
+};
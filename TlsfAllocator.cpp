@@ -0,0 +1,313 @@
+#include "TlsfAllocator.h"
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace {
+	uint32_t FindLowestBit(uint64_t value) {
+#ifdef _MSC_VER
+		unsigned long index;
+		_BitScanForward64(&index, value);
+		return index;
+#else
+		return (uint32_t)__builtin_ctzll(value);
+#endif
+	}
+
+	uint32_t FindHighestBit(uint64_t value) {
+#ifdef _MSC_VER
+		unsigned long index;
+		_BitScanReverse64(&index, value);
+		return index;
+#else
+		return 63 - (uint32_t)__builtin_clzll(value);
+#endif
+	}
+
+	uint64_t AlignUp(uint64_t value, uint64_t alignment) {
+		return (value + alignment - 1) & ~(alignment - 1);
+	}
+}
+
+TlsfAllocator::TlsfAllocator(uint64_t capacity, uint64_t granularity) {
+	this->granularity = granularity;
+	granularityShift = FindHighestBit(granularity);
+	this->capacity = capacity & ~(granularity - 1);
+
+	firstLevelBitmap = 0;
+	for (uint32_t fl = 0; fl < FL_COUNT; fl++) {
+		secondLevelBitmaps[fl] = 0;
+		for (uint32_t sl = 0; sl < SL_COUNT; sl++) {
+			freeLists[fl][sl] = INVALID_BLOCK;
+		}
+	}
+
+	allocated = 0;
+	allocatedBlockCount = 0;
+	statistics = {};
+
+	if (this->capacity > 0) {
+		uint32_t index = NewBlock();
+		blocks[index].offset = 0;
+		blocks[index].size = this->capacity;
+		InsertFreeBlock(index);
+	}
+}
+
+void TlsfAllocator::Mapping(uint64_t size, uint32_t& firstLevel, uint32_t& secondLevel) {
+	// granularityPʂŐÂ1iڂ0ɂ܂Ƃ߂2iڂ1Pʂ
+	uint64_t units = size >> granularityShift;
+	if (units < SL_COUNT) {
+		firstLevel = 0;
+		secondLevel = (uint32_t)units;
+		return;
+	}
+	uint32_t highest = FindHighestBit(units);
+	firstLevel = highest - SL_BITS + 1;
+	secondLevel = (uint32_t)(units >> (highest - SL_BITS)) - SL_COUNT;
+}
+
+uint32_t TlsfAllocator::FindFreeBlock(uint64_t size) {
+	// 敪̐擪̃ubNK悤ɁA1̋敪̋ڂ܂Ő؂グĂT
+	uint64_t units = size >> granularityShift;
+	if (units >= SL_COUNT) {
+		uint32_t highest = FindHighestBit(units);
+		size += (1ull << (highest - SL_BITS + granularityShift)) - 1;
+	}
+	if (size > capacity) {
+		return INVALID_BLOCK;
+	}
+
+	uint32_t fl, sl;
+	Mapping(size, fl, sl);
+
+	uint32_t secondLevelMap = secondLevelBitmaps[fl] & (0xffffffffu << sl);
+	if (secondLevelMap == 0) {
+		uint64_t firstLevelMap = fl + 1 < FL_COUNT ? firstLevelBitmap & (0xffffffffffffffffull << (fl + 1)) : 0;
+		if (firstLevelMap == 0) {
+			return INVALID_BLOCK;
+		}
+		fl = FindLowestBit(firstLevelMap);
+		secondLevelMap = secondLevelBitmaps[fl];
+	}
+	sl = FindLowestBit(secondLevelMap);
+	return freeLists[fl][sl];
+}
+
+void TlsfAllocator::InsertFreeBlock(uint32_t index) {
+	Block& block = blocks[index];
+	uint32_t fl, sl;
+	Mapping(block.size, fl, sl);
+
+	block.free = true;
+	block.prevFree = INVALID_BLOCK;
+	block.nextFree = freeLists[fl][sl];
+	if (block.nextFree != INVALID_BLOCK) {
+		blocks[block.nextFree].prevFree = index;
+	}
+	freeLists[fl][sl] = index;
+	firstLevelBitmap |= 1ull << fl;
+	secondLevelBitmaps[fl] |= 1u << sl;
+}
+
+void TlsfAllocator::RemoveFreeBlock(uint32_t index) {
+	Block& block = blocks[index];
+	uint32_t fl, sl;
+	Mapping(block.size, fl, sl);
+
+	if (block.prevFree != INVALID_BLOCK) {
+		blocks[block.prevFree].nextFree = block.nextFree;
+	}
+	else {
+		freeLists[fl][sl] = block.nextFree;
+		if (block.nextFree == INVALID_BLOCK) {
+			secondLevelBitmaps[fl] &= ~(1u << sl);
+			if (secondLevelBitmaps[fl] == 0) {
+				firstLevelBitmap &= ~(1ull << fl);
+			}
+		}
+	}
+	if (block.nextFree != INVALID_BLOCK) {
+		blocks[block.nextFree].prevFree = block.prevFree;
+	}
+	block.free = false;
+}
+
+uint32_t TlsfAllocator::NewBlock() {
+	uint32_t index;
+	if (!unusedBlocks.empty()) {
+		index = unusedBlocks.back();
+		unusedBlocks.pop_back();
+	}
+	else {
+		index = (uint32_t)blocks.size();
+		blocks.emplace_back();
+	}
+	Block& block = blocks[index];
+	block = {};
+	block.prevPhysical = INVALID_BLOCK;
+	block.nextPhysical = INVALID_BLOCK;
+	block.prevFree = INVALID_BLOCK;
+	block.nextFree = INVALID_BLOCK;
+	return index;
+}
+
+uint32_t TlsfAllocator::Split(uint32_t index, uint64_t size) {
+	// 擪sizeindexɎcAVubNɂĕԂ
+	uint32_t rest = NewBlock();
+	Block& block = blocks[index];
+	Block& restBlock = blocks[rest];
+	restBlock.offset = block.offset + size;
+	restBlock.size = block.size - size;
+	restBlock.prevPhysical = index;
+	restBlock.nextPhysical = block.nextPhysical;
+	if (block.nextPhysical != INVALID_BLOCK) {
+		blocks[block.nextPhysical].prevPhysical = rest;
+	}
+	block.size = size;
+	block.nextPhysical = rest;
+	return rest;
+}
+
+void TlsfAllocator::Merge(uint32_t index, uint32_t next) {
+	// nextindexɋz
+	Block& block = blocks[index];
+	Block& nextBlock = blocks[next];
+	block.size += nextBlock.size;
+	block.nextPhysical = nextBlock.nextPhysical;
+	if (nextBlock.nextPhysical != INVALID_BLOCK) {
+		blocks[nextBlock.nextPhysical].prevPhysical = index;
+	}
+	unusedBlocks.push_back(next);
+}
+
+TlsfAllocator::Allocation TlsfAllocator::Allocate(uint64_t size, uint64_t alignment) {
+	Allocation result = { INVALID_OFFSET, 0, INVALID_BLOCK };
+
+	size = AlignUp(size > 0 ? size : 1, granularity);
+	if (alignment < granularity) {
+		alignment = granularity;
+	}
+
+	// 镪̗]T𑫂傫ŒT
+	uint64_t searchSize = size + (alignment - granularity);
+	uint32_t index = searchSize >= size ? FindFreeBlock(searchSize) : INVALID_BLOCK;
+	if (index == INVALID_BLOCK) {
+		statistics.failures++;
+		return result;
+	}
+	RemoveFreeBlock(index);
+
+	// 邽߂ɋ󂯂擪͋󂫃ubNƂĖ߂iÕubN͎gpȂ̂Ō͂Ȃj
+	uint64_t padding = AlignUp(blocks[index].offset, alignment) - blocks[index].offset;
+	if (padding > 0) {
+		uint32_t aligned = Split(index, padding);
+		InsertFreeBlock(index);
+		index = aligned;
+	}
+	if (blocks[index].size > size) {
+		InsertFreeBlock(Split(index, size));
+	}
+
+	Block& block = blocks[index];
+	allocated += block.size;
+	allocatedBlockCount++;
+	statistics.allocations++;
+
+	result.offset = block.offset;
+	result.size = block.size;
+	result.block = index;
+	return result;
+}
+
+void TlsfAllocator::Free(const Allocation& allocation) {
+	if (allocation.offset == INVALID_OFFSET) {
+		return;
+	}
+
+	uint32_t index = allocation.block;
+	allocated -= blocks[index].size;
+	allocatedBlockCount--;
+	statistics.frees++;
+
+	uint32_t prev = blocks[index].prevPhysical;
+	if (prev != INVALID_BLOCK && blocks[prev].free) {
+		RemoveFreeBlock(prev);
+		Merge(prev, index);
+		index = prev;
+	}
+	uint32_t next = blocks[index].nextPhysical;
+	if (next != INVALID_BLOCK && blocks[next].free) {
+		RemoveFreeBlock(next);
+		Merge(index, next);
+	}
+	InsertFreeBlock(index);
+}
+
+void TlsfAllocator::Free(const Allocation& allocation, uint64_t fenceValue) {
+	if (allocation.offset == INVALID_OFFSET) {
+		return;
+	}
+
+	// GPUgI܂ł͍ėpȂ
+	pendingFrees.push_back({ allocation.block, fenceValue });
+}
+
+void TlsfAllocator::Reclaim(uint64_t completedFenceValue) {
+	size_t kept = 0;
+	for (size_t i = 0; i < pendingFrees.size(); i++) {
+		if (pendingFrees[i].fenceValue <= completedFenceValue) {
+			uint32_t index = pendingFrees[i].block;
+			Free({ blocks[index].offset, blocks[index].size, index });
+		}
+		else {
+			pendingFrees[kept++] = pendingFrees[i];
+		}
+	}
+	pendingFrees.resize(kept);
+}
+
+TlsfAllocator::Statistics TlsfAllocator::GetStatistics() {
+	Statistics result = statistics;
+	result.capacity = capacity;
+	result.allocated = allocated;
+	result.free = capacity - allocated;
+	result.allocatedBlockCount = allocatedBlockCount;
+	result.pending = 0;
+	for (auto& pending : pendingFrees) {
+		result.pending += blocks[pending.block].size;
+	}
+
+	result.freeBlockCount = 0;
+	result.largestFreeBlock = 0;
+	for (uint32_t fl = 0; fl < FL_COUNT; fl++) {
+		for (uint32_t sl = 0; sl < SL_COUNT; sl++) {
+			for (uint32_t index = freeLists[fl][sl]; index != INVALID_BLOCK; index = blocks[index].nextFree) {
+				result.freeBlockCount++;
+				if (blocks[index].size > result.largestFreeBlock) {
+					result.largestFreeBlock = blocks[index].size;
+				}
+			}
+		}
+	}
+	return result;
+}
+
+float TlsfAllocator::GetFragmentation() {
+	uint64_t free = capacity - allocated;
+	if (free == 0 || firstLevelBitmap == 0) {
+		return 0.0f;
+	}
+
+	// ő̃ubN͈ԏ̋敪̒ɂ
+	uint32_t fl = FindHighestBit(firstLevelBitmap);
+	uint32_t sl = FindHighestBit(secondLevelBitmaps[fl]);
+	uint64_t largest = 0;
+	for (uint32_t index = freeLists[fl][sl]; index != INVALID_BLOCK; index = blocks[index].nextFree) {
+		if (blocks[index].size > largest) {
+			largest = blocks[index].size;
+		}
+	}
+	return 1.0f - (float)largest / (float)free;
+}
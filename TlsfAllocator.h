@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// q[v͈̔͂ǗTLSFiTwo-Level Segregated FitjAP[^[ifoCXsvj
+// 󂫃ubN傫2iK̋敪Ƃ̃XgɕArbgZň莞ԂŌ
+// ubN͑Ő󂫃ubNƌ
+class TlsfAllocator
+{
+public:
+	static const uint64_t INVALID_OFFSET = 0xffffffffffffffffull;
+
+	typedef struct Allocation {
+		uint64_t offset;	// sꍇINVALID_OFFSET
+		uint64_t size;		// granularityɐ؂グ傫
+		uint32_t block;
+	};
+
+	typedef struct Statistics {
+		uint64_t capacity;
+		uint64_t allocated;
+		uint64_t free;
+		uint64_t pending;
+		uint64_t largestFreeBlock;
+		uint32_t freeBlockCount;
+		uint32_t allocatedBlockCount;
+		uint64_t allocations;
+		uint64_t frees;
+		uint64_t failures;
+	};
+
+private:
+	static const uint32_t SL_BITS = 4;
+	static const uint32_t SL_COUNT = 1 << SL_BITS;
+	static const uint32_t FL_COUNT = 64;
+	static const uint32_t INVALID_BLOCK = 0xffffffff;
+
+	typedef struct Block {
+		uint64_t offset;
+		uint64_t size;
+		uint32_t prevPhysical;	// AhXŗׂ̃ubN
+		uint32_t nextPhysical;
+		uint32_t prevFree;		// 敪̋󂫃Xg
+		uint32_t nextFree;
+		bool free;
+	};
+
+	typedef struct PendingFree {
+		uint32_t block;
+		uint64_t fenceValue;
+	};
+
+	uint64_t capacity;
+	uint64_t granularity;
+	uint32_t granularityShift;
+
+	std::vector<Block> blocks;
+	std::vector<uint32_t> unusedBlocks;		// ŎgȂȂblocks̔ԍ
+
+	uint64_t firstLevelBitmap;
+	uint32_t secondLevelBitmaps[FL_COUNT];
+	uint32_t freeLists[FL_COUNT][SL_COUNT];
+
+	std::vector<PendingFree> pendingFrees;
+	uint64_t allocated;
+	uint32_t allocatedBlockCount;
+
+	Statistics statistics;
+
+public:
+	/// <summary>
+	/// capacity͈̔͂ǗBmۂ傫ƈʒugranularityi2̗ݏj̔{ɂȂ
+	/// </summary>
+	TlsfAllocator(uint64_t capacity, uint64_t granularity = 256);
+
+private:
+	void Mapping(uint64_t size, uint32_t& firstLevel, uint32_t& secondLevel);
+	uint32_t FindFreeBlock(uint64_t size);
+	void InsertFreeBlock(uint32_t index);
+	void RemoveFreeBlock(uint32_t index);
+	uint32_t NewBlock();
+	uint32_t Split(uint32_t index, uint64_t size);
+	void Merge(uint32_t index, uint32_t next);
+
+public:
+	/// <summary>
+	/// alignmenti2̗ݏjɑʒumۂB󂫂ꍇoffsetINVALID_OFFSET
+	/// </summary>
+	Allocation Allocate(uint64_t size, uint64_t alignment = 1);
+	/// <summary>
+	/// ɉ
+	/// </summary>
+	void Free(const Allocation& allocation);
+	/// <summary>
+	/// tFXfenceValueɒB܂ł͍ėpȂ
+	/// </summary>
+	void Free(const Allocation& allocation, uint64_t fenceValue);
+	void Reclaim(uint64_t completedFenceValue);
+
+	uint64_t GetCapacity() { return capacity; }
+	uint64_t GetAllocated() { return allocated; }
+	bool IsEmpty() { return allocatedBlockCount == 0; }
+	Statistics GetStatistics();
+
+	// 󂫗eʂ̂ő̘ÄɓȂi0ȂfЉȂj
+	float GetFragmentation();
+};
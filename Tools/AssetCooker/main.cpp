@@ -0,0 +1,124 @@
+// 摜~bv}bvtEBCkς݂DDSɕϊR}hCc[
+// AssetCooker [-bc1|-bc3|-bc7|-none] [-nomips] [-quick] [-force] [-j Xbh] t@C܂̓tH_...
+#include "AssetCooker.h"
+
+#include <cstdio>
+#include <cwchar>
+#include <string>
+#include <vector>
+
+namespace {
+	bool IsImageFile(const std::wstring& fileName) {
+		static const wchar_t* extensions[] = { L".png", L".jpg", L".jpeg", L".bmp", L".tif", L".tiff", L".gif" };
+
+		size_t dot = fileName.find_last_of(L'.');
+		if (dot == std::wstring::npos) {
+			return false;
+		}
+		std::wstring extension = fileName.substr(dot);
+		for (auto candidate : extensions) {
+			if (_wcsicmp(extension.c_str(), candidate) == 0) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	// tH_̏ꍇ͒̉摜ׂďW߂
+	void CollectFiles(const std::wstring& path, std::vector<std::wstring>& files) {
+		DWORD attributes = GetFileAttributesW(path.c_str());
+		if (attributes == INVALID_FILE_ATTRIBUTES) {
+			fwprintf(stderr, L"not found: %ls\n", path.c_str());
+			return;
+		}
+		if ((attributes & FILE_ATTRIBUTE_DIRECTORY) == 0) {
+			files.push_back(path);
+			return;
+		}
+
+		WIN32_FIND_DATAW data;
+		HANDLE find = FindFirstFileW((path + L"\\*").c_str(), &data);
+		if (find == INVALID_HANDLE_VALUE) {
+			return;
+		}
+		do {
+			std::wstring name = data.cFileName;
+			if (name == L"." || name == L"..") {
+				continue;
+			}
+			std::wstring child = path + L"\\" + name;
+			if (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
+				CollectFiles(child, files);
+			}
+			else if (IsImageFile(name)) {
+				files.push_back(child);
+			}
+		} while (FindNextFileW(find, &data));
+		FindClose(find);
+	}
+
+	void PrintUsage() {
+		fwprintf(stderr, L"usage: AssetCooker [-bc1|-bc3|-bc7|-none] [-nomips] [-quick] [-force] [-j threads] files or folders...\n");
+	}
+}
+
+int wmain(int argc, wchar_t** argv) {
+	AssetCooker::Options options;
+	std::vector<std::wstring> files;
+
+	for (int i = 1; i < argc; i++) {
+		std::wstring arg = argv[i];
+		if (arg == L"-bc1") options.compression = AssetCooker::Compression::BC1;
+		else if (arg == L"-bc3") options.compression = AssetCooker::Compression::BC3;
+		else if (arg == L"-bc7") options.compression = AssetCooker::Compression::BC7;
+		else if (arg == L"-none") options.compression = AssetCooker::Compression::NONE;
+		else if (arg == L"-nomips") options.generateMips = false;
+		else if (arg == L"-quick") options.quick = true;
+		else if (arg == L"-force") options.force = true;
+		else if (arg == L"-j" && i + 1 < argc) options.threadCount = _wtoi(argv[++i]);
+		else if (arg[0] == L'-') {
+			PrintUsage();
+			return 1;
+		}
+		else CollectFiles(arg, files);
+	}
+
+	if (files.empty()) {
+		PrintUsage();
+		return 1;
+	}
+
+	LARGE_INTEGER frequency, start, end;
+	QueryPerformanceFrequency(&frequency);
+	QueryPerformanceCounter(&start);
+
+	AssetCooker cooker(options);
+	auto results = cooker.CookAll(files);
+
+	QueryPerformanceCounter(&end);
+
+	int failed = 0;
+	int skipped = 0;
+	size_t sourceBytes = 0;
+	size_t cookedBytes = 0;
+	for (auto& result : results) {
+		if (FAILED(result.result)) {
+			fwprintf(stderr, L"failed (0x%08x): %ls\n", (unsigned)result.result, result.source.c_str());
+			failed++;
+			continue;
+		}
+		if (result.skipped) {
+			skipped++;
+			continue;
+		}
+		wprintf(L"%ls -> %ls (format %d, %zu mips, %zu -> %zu bytes, %.3fs)\n",
+			result.source.c_str(), result.destination.c_str(), (int)result.format, result.mipLevels, result.sourceBytes, result.cookedBytes, result.seconds);
+		sourceBytes += result.sourceBytes;
+		cookedBytes += result.cookedBytes;
+	}
+
+	wprintf(L"%zu files, %d skipped, %d failed, %zu -> %zu bytes, %.3fs\n",
+		results.size(), skipped, failed, sourceBytes, cookedBytes, (double)(end.QuadPart - start.QuadPart) / frequency.QuadPart);
+
+	return failed == 0 ? 0 : 1;
+}
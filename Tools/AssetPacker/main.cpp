@@ -0,0 +1,215 @@
+// tH_̒gAssetPackɂ܂Ƃ߂R}hCc[
+// AssetPacker [-store] o̓t@C tH_
+//   tH_̑΃pX𖼑OɂBPNGEJPEGEDDS͖kAȊOLZ4ŏkޏꍇk
+// AssetPacker -bench pbNt@C tH_ []
+//   gõt@CǂޏꍇƃpbNǂޏꍇ̎Ԃׂ
+#include "AssetPack.h"
+#include "AssetPackWriter.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <dirent.h>
+#include <sys/stat.h>
+#endif
+
+namespace {
+	// relative͋؂蕶/ɂAtH_̑΃pX
+	void CollectFiles(const std::string& root, const std::string& relative, std::vector<std::string>& files) {
+		std::string directory = relative.empty() ? root : root + "/" + relative;
+#ifdef _WIN32
+		WIN32_FIND_DATAA data;
+		HANDLE find = FindFirstFileA((directory + "\\*").c_str(), &data);
+		if (find == INVALID_HANDLE_VALUE) {
+			return;
+		}
+		do {
+			std::string name = data.cFileName;
+			if (name == "." || name == "..") {
+				continue;
+			}
+			std::string child = relative.empty() ? name : relative + "/" + name;
+			if (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
+				CollectFiles(root, child, files);
+			}
+			else {
+				files.push_back(child);
+			}
+		} while (FindNextFileA(find, &data));
+		FindClose(find);
+#else
+		DIR* dir = opendir(directory.c_str());
+		if (dir == nullptr) {
+			return;
+		}
+		while (dirent* entry = readdir(dir)) {
+			std::string name = entry->d_name;
+			if (name == "." || name == "..") {
+				continue;
+			}
+			std::string child = relative.empty() ? name : relative + "/" + name;
+			struct stat status;
+			if (stat((root + "/" + child).c_str(), &status) != 0) {
+				continue;
+			}
+			if (S_ISDIR(status.st_mode)) {
+				CollectFiles(root, child, files);
+			}
+			else {
+				files.push_back(child);
+			}
+		}
+		closedir(dir);
+#endif
+	}
+
+	// ɈkĂÊ܂GPU֓]̂LZ4ɂȂ
+	bool ShouldCompress(const std::string& name) {
+		static const char* extensions[] = { ".png", ".jpg", ".jpeg", ".dds" };
+
+		std::string lower = AssetPack::NormalizeName(name);
+		for (auto extension : extensions) {
+			size_t length = std::string(extension).size();
+			if (lower.size() >= length && lower.compare(lower.size() - length, length, extension) == 0) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	double Seconds(std::chrono::steady_clock::time_point begin) {
+		return std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+	}
+
+	// ǂ񂾂ŏIȂ悤ɁAׂẴoCgɐG
+	uint64_t Touch(const uint8_t* data, size_t size) {
+		uint64_t sum = 0;
+		for (size_t i = 0; i < size; i++) {
+			sum += data[i];
+		}
+		return sum;
+	}
+
+	int Pack(const std::string& output, const std::string& root, bool store) {
+		std::vector<std::string> files;
+		CollectFiles(root, "", files);
+
+		AssetPackWriter writer;
+		for (auto& file : files) {
+			if (!writer.AddFile(root + "/" + file, file, !store && ShouldCompress(file))) {
+				fprintf(stderr, "failed: %s\n", file.c_str());
+				return 1;
+			}
+		}
+
+		auto startTime = std::chrono::steady_clock::now();
+		if (!writer.Save(output)) {
+			fprintf(stderr, "failed to write %s\n", output.c_str());
+			return 1;
+		}
+
+		auto statistics = writer.GetStatistics();
+		printf("%u entries (%u lz4), %llu -> %llu bytes, file %llu bytes, %.3fs\n",
+			statistics.entries, statistics.compressed, (unsigned long long)statistics.rawBytes, (unsigned long long)statistics.storedBytes,
+			(unsigned long long)statistics.fileBytes, Seconds(startTime));
+		return 0;
+	}
+
+	int Bench(const std::string& packFile, const std::string& root, int iterations) {
+		// pbN̖O͏ɂȂĂ̂ŁAõt@C̖O̓tH_W߂
+		std::vector<std::string> files;
+		CollectFiles(root, "", files);
+		{
+			AssetPack pack;
+			if (!pack.Open(packFile)) {
+				fprintf(stderr, "failed to open %s\n", packFile.c_str());
+				return 1;
+			}
+			for (auto& file : files) {
+				if (pack.Find(file) == nullptr) {
+					fprintf(stderr, "not in pack: %s\n", file.c_str());
+					return 1;
+				}
+			}
+		}
+
+		double looseSeconds = 0.0;
+		double packSeconds = 0.0;
+		uint64_t looseSum = 0;
+		uint64_t packSum = 0;
+		uint64_t bytes = 0;
+
+		for (int iteration = 0; iteration < iterations; iteration++) {
+			// õt@CF1Jēǂ
+			auto startTime = std::chrono::steady_clock::now();
+			std::vector<uint8_t> buffer;
+			for (auto& file : files) {
+				std::ifstream stream(root + "/" + file, std::ios::binary | std::ios::ate);
+				if (!stream) {
+					fprintf(stderr, "failed to open %s\n", file.c_str());
+					return 1;
+				}
+				buffer.resize((size_t)stream.tellg());
+				stream.seekg(0);
+				stream.read(reinterpret_cast<char*>(buffer.data()), buffer.size());
+				looseSum += Touch(buffer.data(), buffer.size());
+			}
+			looseSeconds += Seconds(startTime);
+
+			// pbNF1}bvĖڎ
+			startTime = std::chrono::steady_clock::now();
+			AssetPack pack;
+			pack.Open(packFile);
+			std::vector<uint8_t> storage;
+			for (auto& file : files) {
+				AssetSpan span = pack.Get(file, storage);
+				packSum += Touch(span.data, span.size);
+				bytes += span.size;
+			}
+			pack.Close();
+			packSeconds += Seconds(startTime);
+		}
+
+		if (looseSum != packSum) {
+			fprintf(stderr, "contents differ between loose files and pack\n");
+			return 1;
+		}
+
+		printf("%zu files, %.1f MB per pass, %d passes\n", files.size(), bytes / (double)iterations / (1024.0 * 1024.0), iterations);
+		printf("loose: %.3f ms/pass\n", looseSeconds * 1000.0 / iterations);
+		printf("pack : %.3f ms/pass (%.2fx)\n", packSeconds * 1000.0 / iterations, looseSeconds / packSeconds);
+		return 0;
+	}
+
+	void PrintUsage() {
+		fprintf(stderr, "usage: AssetPacker [-store] output.pack folder\n");
+		fprintf(stderr, "       AssetPacker -bench input.pack folder [iterations]\n");
+	}
+}
+
+int main(int argc, char** argv) {
+	std::vector<std::string> args(argv + 1, argv + argc);
+
+	if (args.size() >= 3 && args[0] == "-bench") {
+		int iterations = args.size() >= 4 ? std::atoi(args[3].c_str()) : 5;
+		return Bench(args[1], args[2], iterations > 0 ? iterations : 1);
+	}
+
+	bool store = false;
+	if (!args.empty() && args[0] == "-store") {
+		store = true;
+		args.erase(args.begin());
+	}
+	if (args.size() != 2) {
+		PrintUsage();
+		return 1;
+	}
+	return Pack(args[0], args[1], store);
+}
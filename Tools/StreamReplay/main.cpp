@@ -0,0 +1,135 @@
+// RecordingRendererŋL^`R}h̃Xg[ĐR}hCc[
+// StreamReplay input.stream []
+//   ͂̍ĐJԂAt[E`搔EԂ̐؂ւ̐1`悠̎Ԃ\
+// StreamReplay -raster input.stream   [output.ppm]
+//   SoftwareRasterizerɍĐ1t[̎Ԃ\AŌ̃t[PPMŕۑ
+#include "CommandStream.h"
+#include "SoftwareRasterizer.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+	double Seconds(std::chrono::steady_clock::time_point begin) {
+		return std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+	}
+
+	bool Load(const std::string& input, std::vector<uint8_t>& data) {
+		if (!CommandStreamPlayer::Load(input, data)) {
+			fprintf(stderr, "failed to read %s\n", input.c_str());
+			return false;
+		}
+		return true;
+	}
+
+	void PrintStatistics(const CommandStreamStatistics& statistics) {
+		double frames = statistics.frames > 0 ? (double)statistics.frames : 1.0;
+		printf("%llu frames, %llu bytes\n", (unsigned long long)statistics.frames, (unsigned long long)statistics.bytes);
+		printf("per frame: %.1f draws, %.1f strings, %.1f texture binds\n", statistics.draws / frames, statistics.strings / frames, statistics.textureBinds / frames);
+		printf("per frame: %.1f pipeline sets (%.1f changes), %.1f descriptor heap sets (%.1f changes)\n",
+			statistics.pipelineSets / frames, statistics.pipelineChanges / frames, statistics.descriptorHeapSets / frames, statistics.descriptorHeapChanges / frames);
+		printf("definitions: %llu meshes, %llu textures\n", (unsigned long long)statistics.meshDefinitions, (unsigned long long)statistics.textureDefinitions);
+	}
+
+	int Decode(const std::string& input, int iterations) {
+		std::vector<uint8_t> data;
+		if (!Load(input, data)) {
+			return 1;
+		}
+
+		CommandStreamStatistics statistics = {};
+		double seconds = 0.0;
+		for (int iteration = 0; iteration < iterations; iteration++) {
+			if (!CommandStreamPlayer::Replay(data, nullptr, &statistics)) {
+				fprintf(stderr, "%s is not a valid command stream\n", input.c_str());
+				return 1;
+			}
+			seconds += statistics.seconds;
+		}
+
+		PrintStatistics(statistics);
+		uint64_t commands = statistics.draws + statistics.strings > 0 ? statistics.draws + statistics.strings : 1;
+		printf("decode: %.3f ms/pass, %.1f ns/draw\n", seconds * 1000.0 / iterations, seconds * 1e9 / iterations / commands);
+		return 0;
+	}
+
+	// R8G8B8A8̉foCiPPMɂiAt@͎̂Ăj
+	bool SavePpm(const std::string& output, SoftwareRasterizer& rasterizer) {
+		std::ofstream file(output, std::ios::binary);
+		if (!file) {
+			return false;
+		}
+		file << "P6\n" << rasterizer.GetWidth() << " " << rasterizer.GetHeight() << "\n255\n";
+		const uint32_t* pixels = rasterizer.GetPixels();
+		std::vector<uint8_t> row((size_t)rasterizer.GetWidth() * 3);
+		for (int y = 0; y < rasterizer.GetHeight(); y++) {
+			for (int x = 0; x < rasterizer.GetWidth(); x++) {
+				uint32_t pixel = pixels[(size_t)y * rasterizer.GetWidth() + x];
+				row[x * 3 + 0] = (uint8_t)(pixel & 0xff);
+				row[x * 3 + 1] = (uint8_t)((pixel >> 8) & 0xff);
+				row[x * 3 + 2] = (uint8_t)((pixel >> 16) & 0xff);
+			}
+			file.write(reinterpret_cast<const char*>(row.data()), row.size());
+		}
+		return (bool)file;
+	}
+
+	int Raster(const std::string& input, int width, int height, const std::string& output) {
+		std::vector<uint8_t> data;
+		if (!Load(input, data)) {
+			return 1;
+		}
+
+		SoftwareRasterizer rasterizer(width, height);
+		RasterizerReplayTarget target(&rasterizer);
+		CommandStreamStatistics statistics = {};
+		auto startTime = std::chrono::steady_clock::now();
+		if (!CommandStreamPlayer::Replay(data, &target, &statistics)) {
+			fprintf(stderr, "%s is not a valid command stream\n", input.c_str());
+			return 1;
+		}
+		double seconds = Seconds(startTime);
+
+		PrintStatistics(statistics);
+		RasterStatistics raster = rasterizer.GetStatistics();
+		double frames = statistics.frames > 0 ? (double)statistics.frames : 1.0;
+		printf("raster: %.3f ms/frame, %.1f triangles/frame, %.1f lines/frame, %.0f pixels/frame\n",
+			seconds * 1000.0 / frames, raster.triangles / frames, raster.lines / frames, raster.pixels / frames);
+
+		if (!output.empty() && !SavePpm(output, rasterizer)) {
+			fprintf(stderr, "failed to write %s\n", output.c_str());
+			return 1;
+		}
+		return 0;
+	}
+
+	void PrintUsage() {
+		fprintf(stderr, "usage: StreamReplay input.stream [iterations]\n");
+		fprintf(stderr, "       StreamReplay -raster input.stream width height [output.ppm]\n");
+	}
+}
+
+int main(int argc, char** argv) {
+	std::vector<std::string> args(argv + 1, argv + argc);
+
+	if (args.size() >= 4 && args[0] == "-raster") {
+		int width = std::atoi(args[2].c_str());
+		int height = std::atoi(args[3].c_str());
+		if (width <= 0 || height <= 0) {
+			PrintUsage();
+			return 1;
+		}
+		return Raster(args[1], width, height, args.size() >= 5 ? args[4] : "");
+	}
+
+	if (args.empty() || args.size() > 2 || args[0][0] == '-') {
+		PrintUsage();
+		return 1;
+	}
+	int iterations = args.size() >= 2 ? std::atoi(args[1].c_str()) : 10;
+	return Decode(args[0], iterations > 0 ? iterations : 1);
+}
@@ -0,0 +1,297 @@
+#include "TransformHierarchy.h"
+#include "Shape.h"
+
+#include <chrono>
+
+const uint32_t TransformHierarchy::INVALID_NODE;
+
+TransformHierarchy::TransformHierarchy() {
+	orderDirty = false;
+	statistics = {};
+}
+
+void TransformHierarchy::MarkDirty(uint32_t index) {
+	flags[index] |= LOCAL_DIRTY;
+
+	// ܂ł̓rɊɈ󂪂΁A̐̑cɂtĂ
+	for (uint32_t p = index; p != INVALID_NODE && (flags[p] & SUBTREE_DIRTY) == 0; p = parentIndices[p]) {
+		flags[p] |= SUBTREE_DIRTY;
+	}
+}
+
+uint32_t TransformHierarchy::Create(uint32_t parent) {
+	uint32_t id;
+	if (!freeIds.empty()) {
+		id = freeIds.back();
+		freeIds.pop_back();
+	}
+	else {
+		id = (uint32_t)indices.size();
+		indices.push_back(INVALID_NODE);
+		parentIds.push_back(INVALID_NODE);
+		destroyed.push_back(0);
+	}
+
+	uint32_t index = (uint32_t)nodeIds.size();
+	uint32_t parentIndex = parent != INVALID_NODE ? indices[parent] : INVALID_NODE;
+	indices[id] = index;
+	parentIds[id] = parent;
+	destroyed[id] = 0;
+
+	Local local = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f }, { 1.0f, 1.0f, 1.0f } };
+	parentIndices.push_back(parentIndex);
+	subtreeEnds.push_back(index + 1);
+	flags.push_back(0);
+	locals.push_back(local);
+	localMatrices.push_back(DirectX::XMMatrixIdentity());
+	worldMatrices.push_back(DirectX::XMMatrixIdentity());
+	shapes.push_back(nullptr);
+	nodeIds.push_back(id);
+
+	// e̕؂z̖܂őĂꍇie珇ɍꍇj́AɑĂт͕Ȃ
+	if (parentIndex != INVALID_NODE && !orderDirty) {
+		if (subtreeEnds[parentIndex] == index) {
+			for (uint32_t p = parentIndex; p != INVALID_NODE; p = parentIndices[p]) {
+				subtreeEnds[p]++;
+			}
+		}
+		else {
+			orderDirty = true;
+		}
+	}
+
+	MarkDirty(index);
+	return id;
+}
+
+void TransformHierarchy::Destroy(uint32_t node) {
+	if (node == INVALID_NODE || indices[node] == INVALID_NODE) {
+		return;
+	}
+
+	// q͕גɒHȂȂ̂ŁA܂Ƃ߂Ď菜
+	destroyed[node] = 1;
+	shapes[indices[node]] = nullptr;
+	orderDirty = true;
+}
+
+void TransformHierarchy::SetParent(uint32_t node, uint32_t parent) {
+	if (parentIds[node] == parent) {
+		return;
+	}
+
+	// ̎qeɂƗւɂȂ̂Ŗ
+	for (uint32_t p = parent; p != INVALID_NODE; p = parentIds[p]) {
+		if (p == node) {
+			return;
+		}
+	}
+
+	parentIds[node] = parent;
+	parentIndices[indices[node]] = parent != INVALID_NODE ? indices[parent] : INVALID_NODE;
+	orderDirty = true;
+	MarkDirty(indices[node]);
+}
+
+void TransformHierarchy::SetPosition(uint32_t node, DirectX::XMFLOAT3 position) {
+	uint32_t index = indices[node];
+	locals[index].position = position;
+	MarkDirty(index);
+}
+
+void TransformHierarchy::SetRotation(uint32_t node, DirectX::XMFLOAT3 rotation) {
+	uint32_t index = indices[node];
+	locals[index].rotation = rotation;
+	MarkDirty(index);
+}
+
+void TransformHierarchy::SetScale(uint32_t node, DirectX::XMFLOAT3 scale) {
+	uint32_t index = indices[node];
+	locals[index].scale = scale;
+	MarkDirty(index);
+}
+
+void TransformHierarchy::Attach(uint32_t node, Shape* shape) {
+	uint32_t index = indices[node];
+	shapes[index] = shape;
+	if (shape != nullptr) {
+		// Updateōsݒ肳
+		MarkDirty(index);
+	}
+}
+
+void TransformHierarchy::Reorder() {
+	uint32_t count = (uint32_t)nodeIds.size();
+	uint32_t idCount = (uint32_t)indices.size();
+
+	// q̃XgB̕яŐ擪ɍނ̂ŁAXg͋tɂȂ
+	std::vector<uint32_t> firstChildren(idCount, INVALID_NODE);
+	std::vector<uint32_t> nextSiblings(idCount, INVALID_NODE);
+	std::vector<uint32_t> roots;
+	for (uint32_t i = 0; i < count; i++) {
+		uint32_t id = nodeIds[i];
+		if (destroyed[id]) {
+			continue;
+		}
+		uint32_t parent = parentIds[id];
+		if (parent == INVALID_NODE) {
+			roots.push_back(id);
+		}
+		else {
+			nextSiblings[id] = firstChildren[parent];
+			firstChildren[parent] = id;
+		}
+	}
+
+	// [D̍sɕׂBt̃Xgςނ̂ŁAo͌̕яɂȂ
+	// 폜m[h̎q͂ǂHȂ̂Ŋ܂܂Ȃ
+	std::vector<uint32_t> order;
+	order.reserve(count);
+	std::vector<uint32_t> stack;
+	for (auto root : roots) {
+		stack.push_back(root);
+		while (!stack.empty()) {
+			uint32_t id = stack.back();
+			stack.pop_back();
+			order.push_back(id);
+			for (uint32_t child = firstChildren[id]; child != INVALID_NODE; child = nextSiblings[child]) {
+				stack.push_back(child);
+			}
+		}
+	}
+
+	uint32_t newCount = (uint32_t)order.size();
+	std::vector<uint32_t> newIndices(idCount, INVALID_NODE);
+	for (uint32_t i = 0; i < newCount; i++) {
+		newIndices[order[i]] = i;
+	}
+
+	std::vector<uint32_t> newParentIndices(newCount);
+	std::vector<uint32_t> newSubtreeEnds(newCount);
+	std::vector<uint8_t> newFlags(newCount);
+	std::vector<Local> newLocals(newCount);
+	std::vector<DirectX::XMMATRIX> newLocalMatrices(newCount);
+	std::vector<DirectX::XMMATRIX> newWorldMatrices(newCount);
+	std::vector<Shape*> newShapes(newCount);
+	for (uint32_t i = 0; i < newCount; i++) {
+		uint32_t id = order[i];
+		uint32_t oldIndex = indices[id];
+		newParentIndices[i] = parentIds[id] != INVALID_NODE ? newIndices[parentIds[id]] : INVALID_NODE;
+		newFlags[i] = flags[oldIndex] & ~SUBTREE_DIRTY;
+		newLocals[i] = locals[oldIndex];
+		newLocalMatrices[i] = localMatrices[oldIndex];
+		newWorldMatrices[i] = worldMatrices[oldIndex];
+		newShapes[i] = shapes[oldIndex];
+	}
+
+	// qe֌āA؂̑傫ƕύẌW߂
+	for (uint32_t i = 0; i < newCount; i++) {
+		newSubtreeEnds[i] = 1;
+	}
+	for (uint32_t i = newCount; i-- > 0;) {
+		if (newFlags[i] & (LOCAL_DIRTY | SUBTREE_DIRTY)) {
+			newFlags[i] |= SUBTREE_DIRTY;
+		}
+		uint32_t parent = newParentIndices[i];
+		if (parent != INVALID_NODE) {
+			newSubtreeEnds[parent] += newSubtreeEnds[i];
+			if (newFlags[i] & SUBTREE_DIRTY) {
+				newFlags[parent] |= SUBTREE_DIRTY;
+			}
+		}
+	}
+	for (uint32_t i = 0; i < newCount; i++) {
+		newSubtreeEnds[i] += i;
+	}
+
+	// HȂm[h̔ԍԂ
+	for (uint32_t id = 0; id < idCount; id++) {
+		if (indices[id] != INVALID_NODE && newIndices[id] == INVALID_NODE) {
+			parentIds[id] = INVALID_NODE;
+			destroyed[id] = 0;
+			freeIds.push_back(id);
+		}
+	}
+
+	indices = std::move(newIndices);
+	nodeIds = std::move(order);
+	parentIndices = std::move(newParentIndices);
+	subtreeEnds = std::move(newSubtreeEnds);
+	flags = std::move(newFlags);
+	locals = std::move(newLocals);
+	localMatrices = std::move(newLocalMatrices);
+	worldMatrices = std::move(newWorldMatrices);
+	shapes = std::move(newShapes);
+}
+
+DirectX::XMMATRIX TransformHierarchy::ComputeLocalMatrix(const Local& local) {
+	// 2DőZ̉]́AgE]Eړ|ɒڑgݗĂ
+	if (local.rotation.x == 0.0f && local.rotation.y == 0.0f) {
+		float sinZ, cosZ;
+		DirectX::XMScalarSinCos(&sinZ, &cosZ, local.rotation.z);
+		DirectX::XMMATRIX matrix;
+		matrix.r[0] = DirectX::XMVectorSet(cosZ * local.scale.x, sinZ * local.scale.x, 0.0f, 0.0f);
+		matrix.r[1] = DirectX::XMVectorSet(-sinZ * local.scale.y, cosZ * local.scale.y, 0.0f, 0.0f);
+		matrix.r[2] = DirectX::XMVectorSet(0.0f, 0.0f, local.scale.z, 0.0f);
+		matrix.r[3] = DirectX::XMVectorSet(local.position.x, local.position.y, local.position.z, 1.0f);
+		return matrix;
+	}
+
+	// ShapeƓɊ|
+	return DirectX::XMMatrixScaling(local.scale.x, local.scale.y, local.scale.z) *
+		DirectX::XMMatrixRotationX(local.rotation.x) * DirectX::XMMatrixRotationY(local.rotation.y) * DirectX::XMMatrixRotationZ(local.rotation.z) *
+		DirectX::XMMatrixTranslation(local.position.x, local.position.y, local.position.z);
+}
+
+void TransformHierarchy::Update() {
+	auto startTime = std::chrono::steady_clock::now();
+
+	if (orderDirty) {
+		Reorder();
+		orderDirty = false;
+		statistics.reorders++;
+	}
+
+	uint32_t count = (uint32_t)nodeIds.size();
+	statistics.nodes = count;
+	statistics.updated = 0;
+	statistics.visited = 0;
+	statistics.skipped = 0;
+
+	// e͕KqOɂ̂ŁAO1񑖍ΐẽ[hs͋܂Ă
+	uint8_t* nodeFlags = flags.data();
+	const uint32_t* parents = parentIndices.data();
+	DirectX::XMMATRIX* worlds = worldMatrices.data();
+	for (uint32_t i = 0; i < count;) {
+		uint8_t flag = nodeFlags[i];
+		uint32_t parent = parents[i];
+		bool parentChanged = parent != INVALID_NODE && (nodeFlags[parent] & CHANGED) != 0;
+
+		// qςĂ炸AeĂȂΕ؂Ɣ΂
+		if ((flag & SUBTREE_DIRTY) == 0 && !parentChanged) {
+			statistics.skipped += subtreeEnds[i] - i;
+			i = subtreeEnds[i];
+			continue;
+		}
+		statistics.visited++;
+
+		if (flag & LOCAL_DIRTY) {
+			localMatrices[i] = ComputeLocalMatrix(locals[i]);
+		}
+		if ((flag & LOCAL_DIRTY) || parentChanged) {
+			worlds[i] = parent == INVALID_NODE ? localMatrices[i] : DirectX::XMMatrixMultiply(localMatrices[i], worlds[parent]);
+			nodeFlags[i] = CHANGED;
+			statistics.updated++;
+
+			if (shapes[i] != nullptr) {
+				shapes[i]->SetWorldMatrix(worlds[i]);
+			}
+		}
+		else {
+			nodeFlags[i] = 0;
+		}
+		i++;
+	}
+
+	statistics.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <DirectXMath.h>
+
+#include <cstdint>
+#include <vector>
+
+// }`̐eq֌WiԂƖCAUĨplƎqvfȂǁj
+// m[h͐eqOɗ鏇i[DjŕȔzɕׁAUpdate1̑Ń[hs߂
+// ؂͈̔͂Ă̂ŁAύX̖؂͊ۂƔ΂
+class TransformHierarchy
+{
+public:
+	static const uint32_t INVALID_NODE = 0xffffffff;
+
+	typedef struct Statistics {
+		uint32_t nodes;
+		uint32_t updated;		// [hsvZm[h
+		uint32_t visited;
+		uint32_t skipped;		// ύX̖؂ƂĔ΂m[h
+		uint64_t reorders;
+		double seconds;			// OUpdateiג܂ށj
+	};
+
+private:
+	enum Flag : uint8_t {
+		LOCAL_DIRTY = 1,		// ̍WE]Eg傪ς
+		SUBTREE_DIRTY = 2,		// q̂ǂꂩς
+		CHANGED = 4,			// OUpdateŃ[hs񂪕ςiqQƂj
+	};
+
+	typedef struct Local {
+		DirectX::XMFLOAT3 position;
+		DirectX::XMFLOAT3 rotation;
+		DirectX::XMFLOAT3 scale;
+	};
+
+	// ȉׂ͕̔z
+	std::vector<uint32_t> parentIndices;
+	std::vector<uint32_t> subtreeEnds;		// q͈̔͂̏Iïʒu+؂̑傫j
+	std::vector<uint8_t> flags;
+	std::vector<Local> locals;
+	std::vector<DirectX::XMMATRIX> localMatrices;
+	std::vector<DirectX::XMMATRIX> worldMatrices;
+	std::vector<class Shape*> shapes;
+	std::vector<uint32_t> nodeIds;
+
+	// ȉ̓m[h̔ԍňziԍ͕גĂςȂj
+	std::vector<uint32_t> indices;			// 폜ς݂INVALID_NODE
+	std::vector<uint32_t> parentIds;
+	std::vector<uint8_t> destroyed;
+	std::vector<uint32_t> freeIds;
+
+	bool orderDirty;
+	Statistics statistics;
+
+public:
+	TransformHierarchy();
+
+	TransformHierarchy(const TransformHierarchy&) = delete;
+	TransformHierarchy& operator=(const TransformHierarchy&) = delete;
+
+private:
+	void MarkDirty(uint32_t index);
+	void Reorder();
+	static DirectX::XMMATRIX ComputeLocalMatrix(const Local& local);
+
+public:
+	/// <summary>
+	/// m[hBparentINVALID_NODEȂ獪ɂȂ
+	/// </summary>
+	uint32_t Create(uint32_t parent = INVALID_NODE);
+	/// <summary>
+	/// qƍ폜iUpdateŔz񂩂菜j
+	/// </summary>
+	void Destroy(uint32_t node);
+	void SetParent(uint32_t node, uint32_t parent);
+	uint32_t GetParent(uint32_t node) { return parentIds[node]; }
+
+	/// <summary>
+	/// eɑ΂WE]Eg
+	/// </summary>
+	void SetPosition(uint32_t node, DirectX::XMFLOAT3 position);
+	void SetRotation(uint32_t node, DirectX::XMFLOAT3 rotation);
+	void SetScale(uint32_t node, DirectX::XMFLOAT3 scale);
+	DirectX::XMFLOAT3 GetPosition(uint32_t node) { return locals[indices[node]].position; }
+	DirectX::XMFLOAT3 GetRotation(uint32_t node) { return locals[indices[node]].rotation; }
+	DirectX::XMFLOAT3 GetScale(uint32_t node) { return locals[indices[node]].scale; }
+
+	/// <summary>
+	/// }`ѕtAUpdateŃ[hs񂪕ςɐ}`ɐݒ肷
+	/// ѕtĂԂ͐}`SetPositionł͂Ȃm[h̒lς邱Ɓi}`GetPosition͍XVȂj
+	/// }`폜Onullptrŉ邱
+	/// </summary>
+	void Attach(uint32_t node, class Shape* shape);
+
+	/// <summary>
+	/// ςm[hƂ̎q̃[hsvZ
+	/// </summary>
+	void Update();
+
+	/// <summary>
+	/// OUpdateŋ߂[hs
+	/// </summary>
+	DirectX::XMMATRIX GetWorldMatrix(uint32_t node) { return worldMatrices[indices[node]]; }
+
+	uint32_t GetNodeCount() { return (uint32_t)nodeIds.size(); }
+	Statistics GetStatistics() { return statistics; }
+};
@@ -23,6 +23,7 @@ Triangle::Triangle(int x, int y, int length, ID3D12Device* device, DirectX::XMFL
 	indices[2] = 2;
 
 	CreateShape(vertices, indices, device);
+	SetShapeType(ShapeType::TRIANGLE, DirectX::XMFLOAT2((float)length, (float)length));
 
 	SetTransform(DirectX::XMMatrixTranslation(x, y, 0), DirectX::XMMatrixIdentity(), DirectX::XMMatrixIdentity());
 }
\ No newline at end of file
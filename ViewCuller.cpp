@@ -0,0 +1,87 @@
+#include "ViewCuller.h"
+
+#include <chrono>
+
+ViewCuller::ViewCuller() {
+	limits = { 0.0f, 0.0f, 0.0f, 0.0f };
+	statistics = {};
+}
+
+ViewCuller::Bounds ViewCuller::ComputeBounds(const DirectX::XMFLOAT3* positions, size_t count, size_t stride) {
+	if (count == 0) {
+		return { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
+	}
+
+	const uint8_t* bytes = reinterpret_cast<const uint8_t*>(positions);
+	DirectX::XMVECTOR minimum = DirectX::XMLoadFloat3(positions);
+	DirectX::XMVECTOR maximum = minimum;
+	for (size_t i = 1; i < count; i++) {
+		DirectX::XMVECTOR position = DirectX::XMLoadFloat3(reinterpret_cast<const DirectX::XMFLOAT3*>(bytes + i * stride));
+		minimum = DirectX::XMVectorMin(minimum, position);
+		maximum = DirectX::XMVectorMax(maximum, position);
+	}
+
+	Bounds bounds;
+	DirectX::XMStoreFloat3(&bounds.center, DirectX::XMVectorScale(DirectX::XMVectorAdd(minimum, maximum), 0.5f));
+	DirectX::XMStoreFloat3(&bounds.extents, DirectX::XMVectorScale(DirectX::XMVectorSubtract(maximum, minimum), 0.5f));
+	return bounds;
+}
+
+void ViewCuller::Transform(DirectX::FXMVECTOR center, DirectX::FXMVECTOR extents, DirectX::FXMMATRIX world, DirectX::XMVECTOR& worldCenter, DirectX::XMVECTOR& worldExtents) {
+	// S͍sňڂA傫͊e̍s̐ΒlōLi]Ă̔K܂ށj
+	worldCenter = DirectX::XMVector3Transform(center, world);
+	worldExtents = DirectX::XMVectorMultiply(DirectX::XMVectorSplatX(extents), DirectX::XMVectorAbs(world.r[0]));
+	worldExtents = DirectX::XMVectorMultiplyAdd(DirectX::XMVectorSplatY(extents), DirectX::XMVectorAbs(world.r[1]), worldExtents);
+	worldExtents = DirectX::XMVectorMultiplyAdd(DirectX::XMVectorSplatZ(extents), DirectX::XMVectorAbs(world.r[2]), worldExtents);
+}
+
+ViewCuller::Bounds ViewCuller::TransformBounds(const Bounds& bounds, DirectX::FXMMATRIX world) {
+	DirectX::XMVECTOR worldCenter;
+	DirectX::XMVECTOR worldExtents;
+	Transform(DirectX::XMLoadFloat3(&bounds.center), DirectX::XMLoadFloat3(&bounds.extents), world, worldCenter, worldExtents);
+
+	Bounds result;
+	DirectX::XMStoreFloat3(&result.center, worldCenter);
+	DirectX::XMStoreFloat3(&result.extents, worldExtents);
+	return result;
+}
+
+void ViewCuller::SetViewRect(float left, float top, float right, float bottom) {
+	limits = { right, bottom, -left, -top };
+}
+
+void ViewCuller::Cull(const Bounds* bounds, const DirectX::XMMATRIX* worlds, size_t count, uint8_t* visible) {
+	auto startTime = std::chrono::steady_clock::now();
+
+	DirectX::XMVECTOR limit = DirectX::XMLoadFloat4(&limits);
+	uint64_t drawn = 0;
+	for (size_t i = 0; i < count; i++) {
+		const DirectX::XMMATRIX& world = worlds[i];
+		DirectX::XMVECTOR center = DirectX::XMLoadFloat3(&bounds[i].center);
+		DirectX::XMVECTOR extents = DirectX::XMLoadFloat3(&bounds[i].extents);
+
+		DirectX::XMVECTOR worldCenter;
+		DirectX::XMVECTOR worldExtents;
+		Transform(center, extents, world, worldCenter, worldExtents);
+
+		// (minX, minY, -maxX, -maxY) <= (right, bottom, -left, -top) 1̔rŔ肷
+		DirectX::XMVECTOR minimum = DirectX::XMVectorSubtract(worldCenter, worldExtents);
+		DirectX::XMVECTOR negativeMaximum = DirectX::XMVectorNegate(DirectX::XMVectorAdd(worldCenter, worldExtents));
+		DirectX::XMVECTOR test = DirectX::XMVectorPermute<DirectX::XM_PERMUTE_0X, DirectX::XM_PERMUTE_0Y, DirectX::XM_PERMUTE_1X, DirectX::XM_PERMUTE_1Y>(minimum, negativeMaximum);
+		uint8_t inside = DirectX::XMVector4LessOrEqual(test, limit) ? 1 : 0;
+		visible[i] = inside;
+		drawn += inside;
+	}
+
+	statistics.tested += count;
+	statistics.drawn += drawn;
+	statistics.culled += count - drawn;
+	statistics.seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+bool ViewCuller::IsVisible(const Bounds& bounds, DirectX::FXMMATRIX world) {
+	DirectX::XMMATRIX matrix = world;
+	uint8_t visible;
+	Cull(&bounds, &matrix, 1, &visible);
+	return visible != 0;
+}
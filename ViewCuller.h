@@ -0,0 +1,60 @@
+#pragma once
+
+#include <DirectXMath.h>
+
+#include <cstddef>
+#include <cstdint>
+
+// }`̋E{bNX[hsŕϊAʂ̋`ɓ邩𔻒肷ifoCXsvj
+// 2D`Ȃ̂XYŔ肷
+class ViewCuller
+{
+public:
+	// [JWł̎sE{bNX
+	typedef struct Bounds {
+		DirectX::XMFLOAT3 center;
+		DirectX::XMFLOAT3 extents;	// Seʂ܂ł̋
+	};
+
+	typedef struct Statistics {
+		uint64_t tested;
+		uint64_t culled;
+		uint64_t drawn;		// `ɓA`ɉ񂵂
+		double seconds;
+	};
+
+private:
+	// (right, bottom, -left, -top)
+	DirectX::XMFLOAT4 limits;
+	Statistics statistics;
+
+public:
+	ViewCuller();
+
+private:
+	static void Transform(DirectX::FXMVECTOR center, DirectX::FXMVECTOR extents, DirectX::FXMMATRIX world, DirectX::XMVECTOR& worldCenter, DirectX::XMVECTOR& worldExtents);
+
+public:
+	/// <summary>
+	/// _̍ŏEő傩狫E{bNX
+	/// </summary>
+	static Bounds ComputeBounds(const DirectX::XMFLOAT3* positions, size_t count, size_t stride);
+	/// <summary>
+	/// [hsŕϊAsɈ͂ݒ
+	/// </summary>
+	static Bounds TransformBounds(const Bounds& bounds, DirectX::FXMMATRIX world);
+
+	/// <summary>
+	/// Ɏgʂ̋`isNZj
+	/// </summary>
+	void SetViewRect(float left, float top, float right, float bottom);
+
+	/// <summary>
+	/// ܂Ƃ߂Ĕ肵Avisible1i`悷j0iʊOj
+	/// </summary>
+	void Cull(const Bounds* bounds, const DirectX::XMMATRIX* worlds, size_t count, uint8_t* visible);
+	bool IsVisible(const Bounds& bounds, DirectX::FXMMATRIX world);
+
+	Statistics GetStatistics() { return statistics; }
+	void ResetStatistics() { statistics = {}; }
+};
@@ -6,11 +6,11 @@
 #include "Keyboard.h"
 #include "Mouse.h"
 
-Window::Window(int width, int height, double frameRate) {
+Window::Window(int width, int height, double frameRate, int frameCount) {
 	windowClass = {};
 	hwnd = WindowCreate(windowClass, width, height);
 
-	renderer = std::make_unique<Renderer>(width, height, hwnd);
+	renderer = std::make_unique<Renderer>(width, height, hwnd, frameCount);
 
 	FPS::Initialize(frameRate);
 
@@ -24,33 +24,60 @@ Window::~Window() {
 }
 
 bool Window::Run(std::function<void()> process) {
-	if (PeekMessage(&msg, nullptr, 0, 0, PM_REMOVE)) {
-		TranslateMessage(&msg);
-		DispatchMessage(&msg);
-	}
-	if (msg.message == WM_QUIT) {
+	if (!ProcessMessage()) {
 		return false;
 	}
 
 	FPS::Run([&] {
-		renderer->BeginDraw();
-
-		process();
+		Draw(process);
+		return true;
+	});
 
-		renderer->EndDraw();
+	return true;
+}
 
-		if (!Show) {
-			ShowWindow(hwnd, SW_SHOW);
-			UpdateWindow(hwnd);
-			Show = true;
-		}
+bool Window::Run(std::function<void()> update, std::function<void()> render) {
+	if (!ProcessMessage()) {
+		return false;
+	}
 
+	FPS::Run([&] {
+		update();
+		return true;
+	}, [&] {
+		Draw(render);
 		return true;
 	});
 
 	return true;
 }
 
+bool Window::ProcessMessage() {
+	// FPS::Ruñ͎t[܂Ŗ̂ŁA܂bZ[W͂őS
+	while (PeekMessage(&msg, nullptr, 0, 0, PM_REMOVE)) {
+		if (msg.message == WM_QUIT) {
+			return false;
+		}
+		TranslateMessage(&msg);
+		DispatchMessage(&msg);
+	}
+	return true;
+}
+
+void Window::Draw(const std::function<void()>& process) {
+	renderer->BeginDraw();
+
+	process();
+
+	renderer->EndDraw();
+
+	if (!Show) {
+		ShowWindow(hwnd, SW_SHOW);
+		UpdateWindow(hwnd);
+		Show = true;
+	}
+}
+
 HWND Window::WindowCreate(WNDCLASSEX& windowClass, int width, int height) {
 	windowClass.cbSize = sizeof(WNDCLASSEX);
 	windowClass.lpfnWndProc = (WNDPROC)WindowProc;
@@ -16,16 +16,22 @@ private:
 	bool Show;
 
 public:
-	Window(int width, int height, double frameRate = 60.0);
+	Window(int width, int height, double frameRate = 60.0, int frameCount = 2);
 	~Window();
 
 public:
 	bool Run(std::function<void()> process);
+	/// <summary>
+	/// ŒXebvŎsBupdateFPS::GetFixedDeltaTimei߁ArenderFPS::GetAlphaŕԂĕ`
+	/// </summary>
+	bool Run(std::function<void()> update, std::function<void()> render);
 	class Renderer* GetRenderer() { return renderer.get(); }
 	HWND GetHandle() { return hwnd; }
 
 private:
 	HWND WindowCreate(WNDCLASSEX& windowClass, int width, int height);
+	bool ProcessMessage();
+	void Draw(const std::function<void()>& process);
 	static LRESULT WindowProc(HWND hwnd, UINT msg, WPARAM wparam, LPARAM lparam);
 };
 